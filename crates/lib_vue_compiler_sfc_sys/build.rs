@@ -20,10 +20,18 @@ fn main() {
     let dist_dir = workspace_root.join("dist");
     fs::create_dir_all(&dist_dir).expect("Failed to create dist directory");
 
+    // The `split-units` feature also builds each compiler unit on its own, so
+    // runtimes can load only the units they use
+    let split_units = env::var_os("CARGO_FEATURE_SPLIT_UNITS").is_some();
+
     // Bundle the Vue compiler JS (always run to ensure it's up to date)
     let tools_dir = workspace_root.join("tools");
+    let mut bundle_args = vec!["--experimental-strip-types", "--no-warnings", "bundle.ts"];
+    if split_units {
+        bundle_args.push("--units");
+    }
     let bundle_status = Command::new("node")
-        .args(["--experimental-strip-types", "--no-warnings", "bundle.ts"])
+        .args(&bundle_args)
         .current_dir(&tools_dir)
         .status()
         .expect("Failed to run bundle.ts");
@@ -31,30 +39,71 @@ fn main() {
         panic!("Failed to bundle Vue compiler JS");
     }
 
-    // Compile JS to native object with Static Hermes
+    // Compile JS to native objects with Static Hermes
     let shermes = hermes_build.join("bin/shermes");
-    let vue_compiler_o = dist_dir.join("vue-compiler.o");
-    let vue_compiler_js = dist_dir.join("vue-compiler.js");
-    let shermes_status = Command::new(&shermes)
-        .args([
-            "-O",
-            "-c",
-            "-exported-unit=vue_compiler",
-            "-o",
-            vue_compiler_o.to_str().unwrap(),
-            vue_compiler_js.to_str().unwrap(),
-        ])
-        .status()
-        .expect("Failed to run shermes");
-    if !shermes_status.success() {
-        panic!("Failed to compile Vue compiler with shermes");
+    let mut units = vec![("vue_compiler", "vue-compiler")];
+    if split_units {
+        units.extend([
+            ("vue_compiler_parse", "vue-compiler-parse"),
+            ("vue_compiler_script", "vue-compiler-script"),
+            ("vue_compiler_template", "vue-compiler-template"),
+            ("vue_compiler_style", "vue-compiler-style"),
+        ]);
     }
+    let mut unit_objects = Vec::new();
+    let mut bundle = Vec::new();
+    for (unit, file) in units {
+        let unit_o = dist_dir.join(format!("{file}.o"));
+        let unit_js = dist_dir.join(format!("{file}.js"));
+        let shermes_status = Command::new(&shermes)
+            .args([
+                "-O",
+                "-c",
+                &format!("-exported-unit={unit}"),
+                "-o",
+                unit_o.to_str().unwrap(),
+                unit_js.to_str().unwrap(),
+            ])
+            .status()
+            .expect("Failed to run shermes");
+        if !shermes_status.success() {
+            panic!("Failed to compile Vue compiler with shermes");
+        }
+        bundle.extend(fs::read(&unit_js).expect("Failed to read bundled Vue compiler JS"));
+        unit_objects.push(unit_o);
+    }
+
+    // Version key of the disk cache: the bundled compiler version plus a hash
+    // of the bundles, so a changed bridge or dependency never reads old entries
+    let compiler_sfc_package = tools_dir.join("node_modules/@vue/compiler-sfc/package.json");
+    let compiler_sfc_version = fs::read_to_string(&compiler_sfc_package)
+        .ok()
+        .and_then(|json| package_version(&json))
+        .unwrap_or_else(|| "unknown".to_string());
+    let cache_version = format!("{}-{:016x}", compiler_sfc_version, fnv1a(&bundle));
 
     // Compile the C++ wrapper
-    cc::Build::new()
+    let mut build = cc::Build::new();
+    // The `stats` feature turns on the runtime instrumentation counters
+    if env::var_os("CARGO_FEATURE_STATS").is_some() {
+        build.define("VUE_FFI_STATS", None);
+    }
+    if split_units {
+        build.define("VUE_SPLIT_UNITS", None);
+    }
+    build
         .cpp(true)
         .file(manifest_dir.join("ffi/cpp/runtime.cpp"))
         .file(manifest_dir.join("ffi/cpp/vue_sfc.cpp"))
+        .file(manifest_dir.join("ffi/cpp/descriptor_buffer.cpp"))
+        .file(manifest_dir.join("ffi/cpp/scoped_css.cpp"))
+        .file(manifest_dir.join("ffi/cpp/sfc_scanner.cpp"))
+        .file(manifest_dir.join("ffi/cpp/pool.cpp"))
+        .file(manifest_dir.join("ffi/cpp/disk_cache.cpp"))
+        .define(
+            "VUE_SFC_CACHE_VERSION",
+            format!("\"{}\"", cache_version).as_str(),
+        )
         .include(manifest_dir.join("ffi/cpp"))
         .include(hermes_home.join("API"))
         .include(hermes_home.join("API/jsi"))
@@ -64,8 +113,10 @@ fn main() {
         .flag("-std=c++17")
         .compile("wrapper");
 
-    // Link the compiled Vue compiler object
-    println!("cargo:rustc-link-arg={}", vue_compiler_o.display());
+    // Link the compiled Vue compiler objects
+    for unit_o in &unit_objects {
+        println!("cargo:rustc-link-arg={}", unit_o.display());
+    }
 
     // Link Hermes libraries
     println!(
@@ -118,12 +169,60 @@ fn main() {
         "cargo:rerun-if-changed={}",
         manifest_dir.join("ffi/cpp/vue_sfc.cpp").display()
     );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/marshal.h").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/descriptor_buffer.cpp").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/scoped_css.h").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/scoped_css.cpp").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/sfc_scanner.h").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/sfc_scanner.cpp").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/pool.h").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/pool.cpp").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/pool_internal.h").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/disk_cache.h").display()
+    );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/cpp/disk_cache.cpp").display()
+    );
     println!(
         "cargo:rerun-if-changed={}",
         manifest_dir
             .join("ffi/js/vue_compiler_sfc_bridge.js")
             .display()
     );
+    println!(
+        "cargo:rerun-if-changed={}",
+        manifest_dir.join("ffi/js/units").display()
+    );
     println!(
         "cargo:rerun-if-changed={}",
         tools_dir.join("bundle.ts").display()
@@ -132,4 +231,19 @@ fn main() {
         "cargo:rerun-if-changed={}",
         tools_dir.join("package.json").display()
     );
+    println!("cargo:rerun-if-changed={}", compiler_sfc_package.display());
+}
+
+/// Extracts the top-level `"version"` field of a package.json.
+fn package_version(json: &str) -> Option<String> {
+    let rest = &json[json.find("\"version\"")? + "\"version\"".len()..];
+    let rest = &rest[rest.find('"')? + 1..];
+    Some(rest[..rest.find('"')?].to_string())
+}
+
+/// 64-bit FNV-1a hash.
+fn fnv1a(bytes: &[u8]) -> u64 {
+    bytes.iter().fold(0xcbf29ce484222325, |hash, &byte| {
+        (hash ^ u64::from(byte)).wrapping_mul(0x100000001b3)
+    })
 }
@@ -0,0 +1,515 @@
+/**
+ * @file descriptor_buffer.cpp
+ * @brief Binary descriptor format: serialization, rehydration and block scans.
+ *
+ * Serialization walks the descriptor snapshot (see
+ * vue_descriptor_materialize()), so it costs no JS calls beyond the ones the
+ * snapshot makes once. Rehydration rebuilds the plain block objects with JSI
+ * and lets the bridge fill in what the compiler derives from them. Block
+ * scans encode a snapshot built by the native scanner (sfc_scanner.h)
+ * without a runtime.
+ */
+
+#include "vue_sfc.h"
+#include "marshal.h"
+#include "runtime_internal.h"
+#include "sfc_scanner.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr char kMagic[4] = {'V', 'S', 'F', 'D'};
+
+constexpr size_t kHeaderSize = 40;
+constexpr size_t kBlockSize = 84;
+constexpr size_t kAttrSize = 20;
+constexpr size_t kStrSize = 8;
+
+enum BlockKind : uint8_t {
+    kTemplate = 0,
+    kScript = 1,
+    kScriptSetup = 2,
+    kStyle = 3,
+    kCustom = 4,
+};
+
+enum BlockFlags : uint8_t {
+    kScoped = 1 << 0,
+    kHasModule = 1 << 1,
+    kHasSetup = 1 << 2,
+};
+
+constexpr uint16_t kSlotted = 1 << 0;
+constexpr uint32_t kBoolAttr = 1 << 0;
+
+/**
+ * Builds a buffer: a zeroed, fixed-size record region followed by string
+ * bytes appended as records reference them.
+ */
+class Writer {
+public:
+    explicit Writer(size_t fixed_size) : bytes_(fixed_size, 0) {}
+
+    void u8(size_t at, uint8_t value) {
+        bytes_[at] = value;
+    }
+
+    void u16(size_t at, uint16_t value) {
+        bytes_[at] = static_cast<uint8_t>(value);
+        bytes_[at + 1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    void u32(size_t at, uint64_t value) {
+        if (value > std::numeric_limits<uint32_t>::max()) {
+            overflow_ = true;
+        }
+        for (int i = 0; i < 4; i++) {
+            bytes_[at + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void str(size_t at, VueStr value) {
+        u32(at, bytes_.size());
+        u32(at + 4, value.len);
+        bytes_.insert(bytes_.end(), value.data, value.data + value.len);
+    }
+
+    void pos(size_t at, const VuePosition& value) {
+        u32(at, value.offset);
+        u32(at + 4, value.line);
+        u32(at + 8, value.column);
+    }
+
+    /// Returns the finished buffer, or nullptr if any value exceeded 32 bits.
+    std::unique_ptr<std::vector<uint8_t>> finish() {
+        u32(8, bytes_.size());
+        if (overflow_) {
+            return nullptr;
+        }
+        return std::make_unique<std::vector<uint8_t>>(std::move(bytes_));
+    }
+
+private:
+    std::vector<uint8_t> bytes_;
+    bool overflow_ = false;
+};
+
+std::unique_ptr<std::vector<uint8_t>> encode(const VueDescriptorSnapshot& view) {
+    struct Block {
+        const VueBlockSnapshot* block;
+        BlockKind kind;
+    };
+    std::vector<Block> blocks;
+    if (view.template_block) {
+        blocks.push_back({view.template_block, kTemplate});
+    }
+    if (view.script) {
+        blocks.push_back({view.script, kScript});
+    }
+    if (view.script_setup) {
+        blocks.push_back({view.script_setup, kScriptSetup});
+    }
+    for (size_t i = 0; i < view.styles_count; i++) {
+        blocks.push_back({&view.styles[i], kStyle});
+    }
+    for (size_t i = 0; i < view.custom_blocks_count; i++) {
+        blocks.push_back({&view.custom_blocks[i], kCustom});
+    }
+
+    size_t attr_count = 0;
+    for (const auto& entry : blocks) {
+        attr_count += entry.block->attrs_count;
+    }
+
+    size_t blocks_at = kHeaderSize;
+    size_t attrs_at = blocks_at + blocks.size() * kBlockSize;
+    size_t css_vars_at = attrs_at + attr_count * kAttrSize;
+    Writer out(css_vars_at + view.css_vars_count * kStrSize);
+
+    for (size_t i = 0; i < 4; i++) {
+        out.u8(i, static_cast<uint8_t>(kMagic[i]));
+    }
+    out.u16(4, VUE_DESCRIPTOR_FORMAT_VERSION);
+    out.u16(6, view.slotted ? kSlotted : 0);
+    out.u32(12, blocks.size());
+    out.u32(16, attr_count);
+    out.u32(20, view.css_vars_count);
+    out.str(24, view.filename);
+    out.str(32, view.source);
+
+    size_t attr_index = 0;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        const VueBlockSnapshot& block = *blocks[i].block;
+        size_t at = blocks_at + i * kBlockSize;
+        uint8_t flags = (block.scoped ? kScoped : 0)
+            | (block.has_module ? kHasModule : 0)
+            | (block.has_setup ? kHasSetup : 0);
+        out.u8(at, blocks[i].kind);
+        out.u8(at + 1, flags);
+        out.u32(at + 4, attr_index);
+        out.u32(at + 8, block.attrs_count);
+        out.str(at + 12, block.type);
+        out.str(at + 20, block.content);
+        out.str(at + 28, block.lang);
+        out.str(at + 36, block.src);
+        out.str(at + 44, block.module);
+        out.str(at + 52, block.setup);
+        out.pos(at + 60, block.loc.start);
+        out.pos(at + 72, block.loc.end);
+
+        for (size_t a = 0; a < block.attrs_count; a++, attr_index++) {
+            const VueBlockAttr& attr = block.attrs[a];
+            size_t attr_at = attrs_at + attr_index * kAttrSize;
+            out.str(attr_at, attr.key);
+            out.str(attr_at + 8, attr.value);
+            out.u32(attr_at + 16, attr.is_bool ? kBoolAttr : 0);
+        }
+    }
+
+    for (size_t i = 0; i < view.css_vars_count; i++) {
+        out.str(css_vars_at + i * kStrSize, view.css_vars[i]);
+    }
+
+    return out.finish();
+}
+
+/**
+ * Bounds-checked reads from a buffer. A failed check clears ok() and yields
+ * zeros or empty strings, so a malformed buffer is detected once at the end.
+ */
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t len) : data_(data), len_(len) {}
+
+    bool ok() const {
+        return ok_;
+    }
+
+    bool check(uint64_t at, uint64_t len) {
+        if (at > len_ || len > len_ - at) {
+            ok_ = false;
+        }
+        return ok_;
+    }
+
+    uint8_t u8(size_t at) {
+        return check(at, 1) ? data_[at] : 0;
+    }
+
+    uint16_t u16(size_t at) {
+        return check(at, 2) ? static_cast<uint16_t>(data_[at] | data_[at + 1] << 8) : 0;
+    }
+
+    uint32_t u32(size_t at) {
+        if (!check(at, 4)) {
+            return 0;
+        }
+        uint32_t value = 0;
+        for (int i = 0; i < 4; i++) {
+            value |= static_cast<uint32_t>(data_[at + i]) << (8 * i);
+        }
+        return value;
+    }
+
+    VueStr str(size_t at) {
+        uint32_t offset = u32(at);
+        uint32_t len = u32(at + 4);
+        if (!check(offset, len)) {
+            return VueStr{"", 0};
+        }
+        return VueStr{reinterpret_cast<const char*>(data_) + offset, len};
+    }
+
+private:
+    const uint8_t* data_;
+    size_t len_;
+    bool ok_ = true;
+};
+
+facebook::jsi::Object make_position(
+    facebook::jsi::Runtime& hermes,
+    const PropNames& props,
+    Reader& in,
+    size_t at
+) {
+    facebook::jsi::Object pos(hermes);
+    pos.setProperty(hermes, props.offset, static_cast<double>(in.u32(at)));
+    pos.setProperty(hermes, props.line, static_cast<double>(in.u32(at + 4)));
+    pos.setProperty(hermes, props.column, static_cast<double>(in.u32(at + 8)));
+    return pos;
+}
+
+/// Sets a string property, or leaves it unset if the string is empty.
+void set_optional(
+    facebook::jsi::Runtime& hermes,
+    facebook::jsi::Object& obj,
+    const facebook::jsi::PropNameID& name,
+    VueStr value
+) {
+    if (value.len > 0) {
+        obj.setProperty(hermes, name, make_js_string(hermes, value.data, value.len));
+    }
+}
+
+/**
+ * Rebuilds one block object the way compiler-sfc's parser shapes it; the
+ * bridge adds the derived parts (loc.source, the template AST).
+ */
+facebook::jsi::Object make_block(
+    facebook::jsi::Runtime& hermes,
+    const PropNames& props,
+    Reader& in,
+    size_t at,
+    size_t attrs_at
+) {
+    uint8_t kind = in.u8(at);
+    uint8_t flags = in.u8(at + 1);
+    facebook::jsi::Object block(hermes);
+
+    VueStr type = in.str(at + 12);
+    VueStr content = in.str(at + 20);
+    block.setProperty(hermes, props.type, make_js_string(hermes, type.data, type.len));
+    block.setProperty(hermes, props.content, make_js_string(hermes, content.data, content.len));
+    set_optional(hermes, block, props.lang, in.str(at + 28));
+    set_optional(hermes, block, props.src, in.str(at + 36));
+
+    facebook::jsi::Object loc(hermes);
+    loc.setProperty(hermes, props.start, make_position(hermes, props, in, at + 60));
+    loc.setProperty(hermes, props.end, make_position(hermes, props, in, at + 72));
+    block.setProperty(hermes, props.loc, loc);
+
+    if (kind == kStyle) {
+        block.setProperty(hermes, props.scoped, (flags & kScoped) != 0);
+        if (flags & kHasModule) {
+            VueStr module = in.str(at + 44);
+            if (module.len > 0) {
+                block.setProperty(hermes, props.module, make_js_string(hermes, module.data, module.len));
+            } else {
+                block.setProperty(hermes, props.module, true);
+            }
+        }
+    }
+    if ((kind == kScript || kind == kScriptSetup) && (flags & kHasSetup)) {
+        VueStr setup = in.str(at + 52);
+        if (setup.len > 0) {
+            block.setProperty(hermes, props.setup, make_js_string(hermes, setup.data, setup.len));
+        } else {
+            block.setProperty(hermes, props.setup, true);
+        }
+    }
+
+    facebook::jsi::Object attrs(hermes);
+    uint32_t first = in.u32(at + 4);
+    uint32_t count = in.u32(at + 8);
+    for (uint64_t i = first; i < uint64_t{first} + count && in.ok(); i++) {
+        size_t attr_at = attrs_at + i * kAttrSize;
+        VueStr key = in.str(attr_at);
+        VueStr value = in.str(attr_at + 8);
+        auto jsKey = make_js_string(hermes, key.data, key.len);
+        if (in.u32(attr_at + 16) & kBoolAttr) {
+            attrs.setProperty(hermes, jsKey, true);
+        } else {
+            attrs.setProperty(hermes, jsKey, make_js_string(hermes, value.data, value.len));
+        }
+    }
+    block.setProperty(hermes, props.attrs, attrs);
+    return block;
+}
+
+}  // namespace
+
+// ============================================================================
+// Descriptor Serialization
+// ============================================================================
+
+extern "C" const uint8_t* vue_descriptor_serialize(
+    HermesRuntime rt,
+    HermesHandle handle,
+    size_t* out_len
+) {
+    if (!rt || !out_len) {
+        return nullptr;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    // Materializing times itself as marshal_out; only the encode is added.
+    const VueDescriptorSnapshot* view = vue_descriptor_materialize(rt, handle);
+    auto* entry = rt->get_handle(handle);
+    if (!view || !entry) {
+        return nullptr;
+    }
+
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    if (!entry->encoded) {
+        entry->encoded = encode(*view);
+        if (!entry->encoded) {
+            return nullptr;
+        }
+        VUE_STATS_ADD(rt, bytes_out, entry->encoded->size());
+    }
+
+    *out_len = entry->encoded->size();
+    return entry->encoded->data();
+}
+
+extern "C" HermesHandle vue_descriptor_deserialize(
+    HermesRuntime rt,
+    const uint8_t* data,
+    size_t len
+) {
+    if (!rt || !data || len < kHeaderSize
+        || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    Reader in(data, len);
+    if (in.u16(4) != VUE_DESCRIPTOR_FORMAT_VERSION || in.u32(8) > len) {
+        return 0;
+    }
+    in = Reader(data, in.u32(8));
+
+    uint64_t block_count = in.u32(12);
+    uint64_t attr_count = in.u32(16);
+    uint64_t css_var_count = in.u32(20);
+    uint64_t blocks_at = kHeaderSize;
+    uint64_t attrs_at = blocks_at + block_count * kBlockSize;
+    uint64_t css_vars_at = attrs_at + attr_count * kAttrSize;
+    if (!in.check(kHeaderSize, css_vars_at + css_var_count * kStrSize - kHeaderSize)) {
+        return 0;
+    }
+
+    VUE_STATS_ADD(rt, bytes_in, len);
+
+    auto& hermes = rt->runtime();
+    const auto& props = rt->props();
+    facebook::jsi::Object desc(hermes);
+
+    VueStr filename = in.str(24);
+    VueStr source = in.str(32);
+    desc.setProperty(hermes, props.filename, make_js_string(hermes, filename.data, filename.len));
+    desc.setProperty(hermes, props.source, make_js_string(hermes, source.data, source.len));
+    desc.setProperty(hermes, props.slotted, (in.u16(6) & kSlotted) != 0);
+    desc.setProperty(hermes, props.template_block, nullptr);
+    desc.setProperty(hermes, props.script, nullptr);
+    desc.setProperty(hermes, props.script_setup, nullptr);
+
+    std::vector<facebook::jsi::Object> styles;
+    std::vector<facebook::jsi::Object> customBlocks;
+    uint8_t singles = 0;
+    for (uint64_t i = 0; i < block_count; i++) {
+        size_t at = blocks_at + i * kBlockSize;
+        uint8_t kind = in.u8(at);
+        if (kind > kCustom || in.u32(at + 4) > attr_count
+            || in.u32(at + 8) > attr_count - in.u32(at + 4)) {
+            return 0;
+        }
+
+        auto block = make_block(hermes, props, in, at, attrs_at);
+        switch (kind) {
+        case kTemplate:
+        case kScript:
+        case kScriptSetup: {
+            // At most one of each.
+            uint8_t bit = static_cast<uint8_t>(1 << kind);
+            if (singles & bit) {
+                return 0;
+            }
+            singles |= bit;
+            const auto& name = kind == kTemplate ? props.template_block
+                : kind == kScript ? props.script
+                : props.script_setup;
+            desc.setProperty(hermes, name, block);
+            break;
+        }
+        case kStyle:
+            styles.push_back(std::move(block));
+            break;
+        default:
+            customBlocks.push_back(std::move(block));
+            break;
+        }
+    }
+
+    auto toArray = [&hermes](std::vector<facebook::jsi::Object>& objects) {
+        facebook::jsi::Array array(hermes, objects.size());
+        for (size_t i = 0; i < objects.size(); i++) {
+            array.setValueAtIndex(hermes, i, std::move(objects[i]));
+        }
+        return array;
+    };
+    desc.setProperty(hermes, props.styles, toArray(styles));
+    desc.setProperty(hermes, props.custom_blocks, toArray(customBlocks));
+
+    facebook::jsi::Array cssVars(hermes, css_var_count);
+    for (uint64_t i = 0; i < css_var_count; i++) {
+        VueStr name = in.str(css_vars_at + i * kStrSize);
+        cssVars.setValueAtIndex(hermes, i, make_js_string(hermes, name.data, name.len));
+    }
+    desc.setProperty(hermes, props.css_vars, cssVars);
+
+    if (!in.ok()) {
+        return 0;
+    }
+
+    if (!rt->require_units(VUE_UNIT_PARSE)) {
+        return 0;
+    }
+    auto result = rt->rehydrate_descriptor_fn->call(hermes, desc);
+    return rt->allocate_handle(std::move(result));
+}
+
+// ============================================================================
+// Block Scanning
+// ============================================================================
+
+struct VueSfcScanImpl {
+    std::unique_ptr<std::vector<uint8_t>> encoded;
+};
+
+extern "C" VueSfcScan vue_sfc_scan(
+    const char* source,
+    size_t source_len,
+    const char* filename,
+    size_t filename_len
+) {
+    if ((!source && source_len) || (!filename && filename_len)) {
+        return nullptr;
+    }
+
+    DescriptorSnapshot snapshot;
+    if (!scan_sfc(
+            std::string_view(source ? source : "", source_len),
+            std::string_view(filename ? filename : "", filename_len),
+            snapshot
+        )) {
+        return nullptr;
+    }
+    auto encoded = encode(snapshot.view);
+    if (!encoded) {
+        return nullptr;
+    }
+    return new VueSfcScanImpl{std::move(encoded)};
+}
+
+extern "C" const uint8_t* vue_sfc_scan_data(VueSfcScan scan, size_t* out_len) {
+    if (!scan || !out_len) {
+        return nullptr;
+    }
+
+    *out_len = scan->encoded->size();
+    return scan->encoded->data();
+}
+
+extern "C" void vue_sfc_scan_free(VueSfcScan scan) {
+    delete scan;
+}
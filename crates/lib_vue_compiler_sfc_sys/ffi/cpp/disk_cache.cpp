@@ -0,0 +1,538 @@
+/**
+ * @file disk_cache.cpp
+ * @brief Memory-mapped, append-only compile cache implementation.
+ */
+
+#include "disk_cache.h"
+#include "pool_internal.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Defined by build.rs from the bundled @vue/compiler-sfc version and a hash
+// of the compiled bridge.
+#ifndef VUE_SFC_CACHE_VERSION
+#define VUE_SFC_CACHE_VERSION "dev"
+#endif
+
+namespace {
+
+constexpr char kFileMagic[4] = {'V', 'S', 'F', 'C'};
+constexpr uint32_t kFormatVersion = 2;
+constexpr uint32_t kRecordMagic = 0x43455256;  // "VREC"
+
+constexpr uint64_t kKeySeedLo = 0;
+constexpr uint64_t kKeySeedHi = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kChecksumSeed = 0x165667B19E3779F9ull;
+
+/**
+ * 128-bit content address of an input.
+ */
+struct Key {
+    uint64_t lo;
+    uint64_t hi;
+
+    bool operator==(const Key& other) const {
+        return lo == other.lo && hi == other.hi;
+    }
+};
+
+struct KeyHash {
+    size_t operator()(const Key& key) const {
+        return static_cast<size_t>(key.lo);
+    }
+};
+
+Key make_key(const VueSfcInput& in, const VueCompileOptions& options) {
+    return Key{hash_input(kKeySeedLo, in, options), hash_input(kKeySeedHi, in, options)};
+}
+
+/**
+ * Everything of an input but its source, stored with each record and
+ * compared on lookup like CompileCache::Key, so only a source hash collision
+ * at equal length could alias two inputs.
+ */
+struct Identity {
+    uint64_t source_len;
+    std::string filename;
+    std::string id;
+    uint8_t flags;
+
+    bool operator==(const Identity& other) const {
+        return source_len == other.source_len
+            && filename == other.filename
+            && id == other.id
+            && flags == other.flags;
+    }
+};
+
+Identity make_identity(const VueSfcInput& in, const VueCompileOptions& options) {
+    return Identity{
+        in.source_len,
+        std::string(in.filename, in.filename_len),
+        std::string(in.id, in.id_len),
+        option_flags(options)};
+}
+
+/**
+ * Fixed-size header in front of every record's body: the filename, the id,
+ * then the payload. The checksum covers the whole body.
+ */
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t payload_len;
+    uint64_t key_lo;
+    uint64_t key_hi;
+    uint64_t checksum;
+    uint64_t source_len;
+    uint32_t filename_len;
+    uint32_t id_len;
+    uint32_t option_flags;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(RecordHeader) == 56, "RecordHeader must have no padding");
+
+/**
+ * Returns the length of a record's body.
+ */
+size_t body_len(const RecordHeader& record) {
+    return size_t{record.filename_len} + record.id_len + record.payload_len;
+}
+
+// ============================================================================
+// Payload Encoding
+// ============================================================================
+//
+// A payload is js, css, the errors and the warnings. Strings are a u32
+// length followed by their bytes; lists are a u32 count followed by strings.
+
+void append_u32(std::string& out, uint32_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+bool append_string(std::string& out, const std::string& value) {
+    if (value.size() > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    append_u32(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+    return true;
+}
+
+bool append_list(std::string& out, const std::vector<std::string>& values) {
+    if (values.size() > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    append_u32(out, static_cast<uint32_t>(values.size()));
+    for (const auto& value : values) {
+        if (!append_string(out, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool encode(const VueCompiledSfcImpl& result, std::string& out) {
+    return append_string(out, result.js)
+        && append_string(out, result.css)
+        && append_list(out, result.errors)
+        && append_list(out, result.warnings)
+        && out.size() <= std::numeric_limits<uint32_t>::max();
+}
+
+/**
+ * Bounds-checked reader over a payload.
+ */
+class PayloadReader {
+public:
+    PayloadReader(const char* data, size_t len) : pos(data), end(data + len) {}
+
+    bool read_u32(uint32_t& value) {
+        if (static_cast<size_t>(end - pos) < sizeof(value)) {
+            return false;
+        }
+        std::memcpy(&value, pos, sizeof(value));
+        pos += sizeof(value);
+        return true;
+    }
+
+    bool read_string(std::string& value) {
+        uint32_t len;
+        if (!read_u32(len) || static_cast<size_t>(end - pos) < len) {
+            return false;
+        }
+        value.assign(pos, len);
+        pos += len;
+        return true;
+    }
+
+    bool read_list(std::vector<std::string>& values) {
+        uint32_t count;
+        if (!read_u32(count)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            if (!read_string(values.emplace_back())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool at_end() const {
+        return pos == end;
+    }
+
+private:
+    const char* pos;
+    const char* end;
+};
+
+bool decode(const char* data, size_t len, VueCompiledSfcImpl& out) {
+    PayloadReader reader(data, len);
+    return reader.read_string(out.js)
+        && reader.read_string(out.css)
+        && reader.read_list(out.errors)
+        && reader.read_list(out.warnings)
+        && reader.at_end();
+}
+
+// ============================================================================
+// File Helpers
+// ============================================================================
+
+/**
+ * File header: magic, format version and the version key.
+ */
+std::string file_header() {
+    std::string header(kFileMagic, sizeof(kFileMagic));
+    append_u32(header, kFormatVersion);
+    append_string(header, VUE_SFC_CACHE_VERSION);
+    return header;
+}
+
+/**
+ * Holds an exclusive advisory lock on a file for its lifetime.
+ */
+class FileLock {
+public:
+    explicit FileLock(int fd) : fd(fd) {
+        while (flock(fd, LOCK_EX) != 0 && errno == EINTR) {
+        }
+    }
+
+    ~FileLock() {
+        flock(fd, LOCK_UN);
+    }
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+private:
+    int fd;
+};
+
+bool write_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t written = write(fd, data, len);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        len -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+}  // namespace
+
+/**
+ * Internal cache structure.
+ */
+struct VueDiskCacheImpl {
+    int fd = -1;
+
+    /// Read-only mapping of the file as it was when opened.
+    const char* map = nullptr;
+    size_t map_len = 0;
+
+    /// Guards the indexes; the file itself is guarded by FileLock.
+    std::mutex mutex;
+
+    /// Key -> offset of its latest record header in the mapping.
+    std::unordered_map<Key, size_t, KeyHash> mapped;
+
+    /// A record appended by this process after the file was mapped.
+    struct Appended {
+        Identity identity;
+        std::string payload;
+    };
+
+    /// Records appended by this process after the file was mapped.
+    std::unordered_map<Key, Appended, KeyHash> appended;
+
+    ~VueDiskCacheImpl() {
+        if (map) {
+            munmap(const_cast<char*>(map), map_len);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    /**
+     * Validates the header, maps the file and indexes its records.
+     *
+     * A file with a foreign header is reset. A torn record at the end, left
+     * by a writer that died mid-append, is truncated so later appends stay
+     * reachable.
+     */
+    bool load() {
+        FileLock lock(fd);
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            return false;
+        }
+        size_t size = static_cast<size_t>(st.st_size);
+        const std::string header = file_header();
+
+        if (size > 0) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                return false;
+            }
+            map = static_cast<const char*>(mapping);
+            map_len = size;
+        }
+
+        if (size < header.size() || std::memcmp(map, header.data(), header.size()) != 0) {
+            if (map) {
+                munmap(const_cast<char*>(map), map_len);
+                map = nullptr;
+                map_len = 0;
+            }
+            if (ftruncate(fd, 0) != 0 || !write_all(fd, header.data(), header.size())) {
+                return false;
+            }
+            return true;
+        }
+
+        size_t offset = header.size();
+        while (size - offset >= sizeof(RecordHeader)) {
+            RecordHeader record;
+            std::memcpy(&record, map + offset, sizeof(record));
+            size_t available = size - offset - sizeof(record);
+            if (record.magic != kRecordMagic || body_len(record) > available) {
+                break;
+            }
+            mapped[Key{record.key_lo, record.key_hi}] = offset;
+            offset += sizeof(record) + body_len(record);
+        }
+
+        if (offset < size && ftruncate(fd, static_cast<off_t>(offset)) != 0) {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Finds the payload for an input, verifying mapped records' checksums.
+     * A record that fails verification is dropped from the index; one whose
+     * identity differs is only a miss, since it is still valid for its own
+     * input.
+     */
+    bool find(const Key& key, const Identity& identity, const char*& payload, size_t& len) {
+        auto own = appended.find(key);
+        if (own != appended.end()) {
+            if (!(own->second.identity == identity)) {
+                return false;
+            }
+            payload = own->second.payload.data();
+            len = own->second.payload.size();
+            return true;
+        }
+
+        auto it = mapped.find(key);
+        if (it == mapped.end()) {
+            return false;
+        }
+        RecordHeader record;
+        std::memcpy(&record, map + it->second, sizeof(record));
+        const char* body = map + it->second + sizeof(record);
+        if (hash_bytes(kChecksumSeed, body, body_len(record)) != record.checksum) {
+            mapped.erase(it);
+            return false;
+        }
+        if (record.source_len != identity.source_len
+            || record.option_flags != identity.flags
+            || record.filename_len != identity.filename.size()
+            || record.id_len != identity.id.size()
+            || std::memcmp(body, identity.filename.data(), record.filename_len) != 0
+            || std::memcmp(body + record.filename_len, identity.id.data(), record.id_len) != 0) {
+            return false;
+        }
+        payload = body + record.filename_len + record.id_len;
+        len = record.payload_len;
+        return true;
+    }
+};
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+extern "C" VueDiskCache vue_disk_cache_open(const char* dir, size_t dir_len) {
+    if (!dir || dir_len == 0) {
+        return nullptr;
+    }
+
+    std::string path(dir, dir_len);
+    if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+        return nullptr;
+    }
+    path += "/vue-sfc-";
+    path += VUE_SFC_CACHE_VERSION;
+    path += ".cache";
+
+    auto cache = std::make_unique<VueDiskCacheImpl>();
+    cache->fd = open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (cache->fd < 0 || !cache->load()) {
+        return nullptr;
+    }
+    return cache.release();
+}
+
+extern "C" void vue_disk_cache_close(VueDiskCache cache) {
+    delete cache;
+}
+
+extern "C" const char* vue_disk_cache_version(void) {
+    return VUE_SFC_CACHE_VERSION;
+}
+
+extern "C" size_t vue_disk_cache_entry_count(VueDiskCache cache) {
+    if (!cache) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    size_t count = cache->mapped.size();
+    for (const auto& entry : cache->appended) {
+        if (cache->mapped.find(entry.first) == cache->mapped.end()) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// ============================================================================
+// Lookup and Store
+// ============================================================================
+
+extern "C" VueCompiledSfc vue_disk_cache_get(
+    VueDiskCache cache,
+    const VueSfcInput* input,
+    const VueCompileOptions* options
+) {
+    if (!cache || !input) {
+        return nullptr;
+    }
+
+    VueCompileOptions opts{};
+    if (options) {
+        opts = *options;
+    }
+    Key key = make_key(*input, opts);
+    Identity identity = make_identity(*input, opts);
+
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    const char* payload;
+    size_t len;
+    if (!cache->find(key, identity, payload, len)) {
+        return nullptr;
+    }
+
+    auto result = std::make_unique<VueCompiledSfcImpl>();
+    if (!decode(payload, len, *result)) {
+        cache->mapped.erase(key);
+        return nullptr;
+    }
+    return result.release();
+}
+
+extern "C" bool vue_disk_cache_put(
+    VueDiskCache cache,
+    const VueSfcInput* input,
+    const VueCompileOptions* options,
+    VueCompiledSfc result
+) {
+    if (!cache || !input || !result) {
+        return false;
+    }
+
+    VueCompileOptions opts{};
+    if (options) {
+        opts = *options;
+    }
+    Key key = make_key(*input, opts);
+    Identity identity = make_identity(*input, opts);
+    if (identity.filename.size() > std::numeric_limits<uint32_t>::max()
+        || identity.id.size() > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+
+    std::string payload;
+    if (!encode(*result, payload)) {
+        return false;
+    }
+
+    std::string body = identity.filename + identity.id + payload;
+    RecordHeader header{
+        kRecordMagic,
+        static_cast<uint32_t>(payload.size()),
+        key.lo,
+        key.hi,
+        hash_bytes(kChecksumSeed, body.data(), body.size()),
+        identity.source_len,
+        static_cast<uint32_t>(identity.filename.size()),
+        static_cast<uint32_t>(identity.id.size()),
+        identity.flags,
+        0};
+    std::string record(reinterpret_cast<const char*>(&header), sizeof(header));
+    record += body;
+
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    {
+        FileLock fileLock(cache->fd);
+        struct stat st;
+        if (fstat(cache->fd, &st) != 0) {
+            return false;
+        }
+        if (!write_all(cache->fd, record.data(), record.size())) {
+            // Drop the partial record so later appends stay reachable.
+            (void)ftruncate(cache->fd, st.st_size);
+            return false;
+        }
+    }
+
+    cache->appended[key] = VueDiskCacheImpl::Appended{std::move(identity), std::move(payload)};
+    return true;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file disk_cache.h
+ * @brief Persistent compile cache shared across processes.
+ *
+ * A VueDiskCache stores owned compile results (VueCompiledSfc) in an
+ * append-only file inside a cache directory. The file is memory-mapped when
+ * the cache is opened, so a hit copies the result out of the mapping without
+ * parsing anything and without a HermesRuntime: a run whose inputs are all
+ * cached never has to create one.
+ *
+ * ## File Format
+ *
+ * One file per cache version, `vue-sfc-<version>.cache`, holding a header
+ * followed by records. Each record is addressed by a 128-bit hash of source,
+ * filename, id and options, and also stores the source length, filename, id
+ * and option flags, which a lookup compares as well. A checksum covers
+ * everything after the record header. Records are only appended; a later
+ * record for the same key shadows earlier ones, and shadowed records are
+ * never reclaimed, so the file only grows until its version changes or it
+ * is deleted.
+ *
+ * ## Staleness and Integrity
+ *
+ * - The version (vue_disk_cache_version()) is derived at build time from the
+ *   bundled @vue/compiler-sfc version and the compiled bridge, and is part
+ *   of both the file name and its header
+ * - A record whose checksum does not match is never served
+ * - A record torn by a crashed writer is truncated on the next open
+ *
+ * ## Thread Safety
+ *
+ * - All vue_disk_cache_* functions may be called from any thread
+ * - Several processes may open and append to the same directory; appends are
+ *   serialized with an advisory file lock. Records appended by another
+ *   process become visible when the cache is reopened
+ */
+
+#ifndef VUE_DISK_CACHE_H
+#define VUE_DISK_CACHE_H
+
+#include "pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * Opaque pointer to an open disk cache.
+ */
+typedef struct VueDiskCacheImpl* VueDiskCache;
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+/**
+ * Opens (creating if needed) the cache file in a directory and maps it.
+ *
+ * The directory itself is created if missing; its parent must exist.
+ *
+ * @param dir Directory path (UTF-8, not null-terminated).
+ * @param dir_len Length of the path in bytes.
+ * @return Pointer to the cache, or NULL if the file cannot be opened.
+ */
+VueDiskCache vue_disk_cache_open(const char* dir, size_t dir_len);
+
+/**
+ * Unmaps and closes the cache. Safe to call with NULL.
+ */
+void vue_disk_cache_close(VueDiskCache cache);
+
+/**
+ * Gets the version key of this build (null-terminated, static).
+ */
+const char* vue_disk_cache_version(void);
+
+/**
+ * Gets the number of distinct entries readable through this cache.
+ */
+size_t vue_disk_cache_entry_count(VueDiskCache cache);
+
+// ============================================================================
+// Lookup and Store
+// ============================================================================
+
+/**
+ * Looks up the result of compiling an input.
+ *
+ * @param cache The cache.
+ * @param input The SFC to look up.
+ * @param options Compile options, or NULL for defaults.
+ * @return An owned result that must be freed with vue_compiled_sfc_free(), or
+ *         NULL on a miss or a record that failed its integrity check.
+ */
+VueCompiledSfc vue_disk_cache_get(
+    VueDiskCache cache,
+    const VueSfcInput* input,
+    const VueCompileOptions* options
+);
+
+/**
+ * Appends the result of compiling an input.
+ *
+ * The result is copied; the caller keeps ownership of it.
+ *
+ * @param cache The cache.
+ * @param input The SFC that was compiled.
+ * @param options Compile options it was compiled with, or NULL for defaults.
+ * @param result The result to store.
+ * @return false if an argument is NULL or the write failed.
+ */
+bool vue_disk_cache_put(
+    VueDiskCache cache,
+    const VueSfcInput* input,
+    const VueCompileOptions* options,
+    VueCompiledSfc result
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VUE_DISK_CACHE_H */
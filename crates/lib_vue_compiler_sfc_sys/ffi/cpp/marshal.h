@@ -0,0 +1,262 @@
+/**
+ * @file marshal.h
+ * @brief String conversion between native buffers and JS strings.
+ *
+ * This header is NOT part of the public API. It is only included by
+ * vue_sfc.cpp, which routes every string crossing the FFI through it.
+ *
+ * Hermes stores strings either as 8-bit ASCII or as UTF-16. Inputs that are
+ * pure ASCII - nearly all SFC sources, filenames and ids - are created
+ * directly as ASCII strings, skipping the UTF-8 decoder. Where the JSI
+ * exposes the raw string storage, outputs are read from it, with only the
+ * UTF-16 parts of a string going through a UTF-8 encoder, and can be
+ * streamed to a sink without an intermediate std::string.
+ */
+
+#ifndef VUE_MARSHAL_H
+#define VUE_MARSHAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <jsi/jsi.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * Returns true if no byte in the range has its high bit set.
+ *
+ * Checks 64 bytes per step with SSE2 or NEON, eight bytes per step
+ * otherwise.
+ */
+inline bool is_ascii(const char* data, size_t len) {
+    const char* end = data + len;
+
+#if defined(__SSE2__)
+    for (; end - data >= 64; data += 64) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48));
+        __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+        if (_mm_movemask_epi8(any) != 0) {
+            return false;
+        }
+    }
+    for (; end - data >= 16; data += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        if (_mm_movemask_epi8(a) != 0) {
+            return false;
+        }
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    for (; end - data >= 64; data += 64) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+        uint8x16_t any = vorrq_u8(
+            vorrq_u8(vld1q_u8(p), vld1q_u8(p + 16)),
+            vorrq_u8(vld1q_u8(p + 32), vld1q_u8(p + 48)));
+        if (vmaxvq_u8(any) >= 0x80) {
+            return false;
+        }
+    }
+    for (; end - data >= 16; data += 16) {
+        if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(data))) >= 0x80) {
+            return false;
+        }
+    }
+#endif
+
+    constexpr uint64_t kHighBits = 0x8080808080808080ull;
+    for (; end - data >= 8; data += 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        if (word & kHighBits) {
+            return false;
+        }
+    }
+    for (; data < end; data++) {
+        if (static_cast<unsigned char>(*data) & 0x80) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Creates a JS string from UTF-8 bytes, taking the ASCII path when possible.
+ */
+inline facebook::jsi::String make_js_string(
+    facebook::jsi::Runtime& hermes,
+    const char* data, size_t len
+) {
+    if (is_ascii(data, len)) {
+        return facebook::jsi::String::createFromAscii(hermes, data, len);
+    }
+    return facebook::jsi::String::createFromUtf8(
+        hermes, reinterpret_cast<const uint8_t*>(data), len);
+}
+
+/// Largest block encode_utf16() passes to its sink.
+constexpr size_t kEncodeBlock = 4096;
+
+/**
+ * Encodes UTF-16 code units as UTF-8 in blocks of at most kEncodeBlock
+ * bytes, passing each block to `sink(const char*, size_t) -> bool`. Blocks
+ * end on character boundaries. Lone surrogates become U+FFFD, as in
+ * jsi::String::utf8().
+ *
+ * @param pending_high A high surrogate left over from the previous call, or
+ *                     0; updated when `units` ends with a high surrogate.
+ * @return false if the sink asked to stop.
+ */
+template <typename Sink>
+bool encode_utf16(
+    const char16_t* units, size_t count,
+    char16_t& pending_high,
+    Sink& sink
+) {
+    char block[kEncodeBlock];
+    size_t used = 0;
+    auto put = [&block, &used](uint32_t cp) {
+        if (cp < 0x80) {
+            block[used++] = static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            block[used++] = static_cast<char>(0xC0 | (cp >> 6));
+            block[used++] = static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            block[used++] = static_cast<char>(0xE0 | (cp >> 12));
+            block[used++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            block[used++] = static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            block[used++] = static_cast<char>(0xF0 | (cp >> 18));
+            block[used++] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            block[used++] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            block[used++] = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+    };
+
+    for (size_t i = 0; i < count; i++) {
+        // Room for the worst case of one unit: the U+FFFD of a pending lone
+        // high surrogate, then a three-byte BMP character.
+        if (used > kEncodeBlock - 6) {
+            if (!sink(block, used)) {
+                return false;
+            }
+            used = 0;
+        }
+        char16_t unit = units[i];
+        if (pending_high) {
+            char16_t high = pending_high;
+            pending_high = 0;
+            if (unit >= 0xDC00 && unit <= 0xDFFF) {
+                put(0x10000 + ((static_cast<uint32_t>(high) - 0xD800) << 10) + (unit - 0xDC00));
+                continue;
+            }
+            put(0xFFFD);
+        }
+        if (unit >= 0xD800 && unit <= 0xDBFF) {
+            pending_high = unit;
+        } else if (unit >= 0xDC00 && unit <= 0xDFFF) {
+            put(0xFFFD);
+        } else {
+            put(unit);
+        }
+    }
+    return used == 0 || sink(block, used);
+}
+
+/**
+ * Streams a JS string as UTF-8 to `sink(const char*, size_t) -> bool`,
+ * stopping early if the sink returns false. Chunks end on character
+ * boundaries.
+ *
+ * With a JSI that exposes string storage, ASCII contents are passed
+ * straight from the JS heap and only UTF-16 contents are encoded, through a
+ * fixed stack block; the sink must then not touch the runtime. Otherwise
+ * the string is converted with jsi::String::utf8() and passed in one chunk.
+ *
+ * @return The number of bytes passed to the sink.
+ */
+template <typename Sink>
+size_t write_js_string(
+    facebook::jsi::Runtime& hermes,
+    const facebook::jsi::String& str,
+    Sink&& sink
+) {
+    size_t total = 0;
+    bool stopped = false;
+    auto counted = [&sink, &total, &stopped](const char* data, size_t len) {
+        if (len == 0) {
+            return true;
+        }
+        total += len;
+        stopped = !sink(data, len);
+        return !stopped;
+    };
+
+#if defined(JSI_VERSION) && JSI_VERSION >= 14
+    static constexpr char kReplacement[] = "\xEF\xBF\xBD";
+    char16_t pending_high = 0;
+    auto chunk = [&](bool ascii, const void* data, size_t num) {
+        if (stopped) {
+            return;
+        }
+        if (!ascii) {
+            encode_utf16(static_cast<const char16_t*>(data), num, pending_high, counted);
+            return;
+        }
+        if (pending_high) {
+            pending_high = 0;
+            if (!counted(kReplacement, 3)) {
+                return;
+            }
+        }
+        counted(static_cast<const char*>(data), num);
+    };
+    str.getStringData(hermes, chunk);
+    if (pending_high && !stopped) {
+        counted(kReplacement, 3);
+    }
+#else
+    std::string utf8 = str.utf8(hermes);
+    counted(utf8.data(), utf8.size());
+#endif
+    return total;
+}
+
+/**
+ * Copies a JS string out as UTF-8.
+ */
+inline std::string read_js_string(
+    facebook::jsi::Runtime& hermes,
+    const facebook::jsi::String& str
+) {
+#if defined(JSI_VERSION) && JSI_VERSION >= 14
+    std::string out;
+    write_js_string(hermes, str, [&out](const char* data, size_t len) {
+        out.append(data, len);
+        return true;
+    });
+    return out;
+#else
+    return str.utf8(hermes);
+#endif
+}
+
+/**
+ * Copies a string-valued JS value out as UTF-8.
+ */
+inline std::string read_js_string(
+    facebook::jsi::Runtime& hermes,
+    const facebook::jsi::Value& value
+) {
+    return read_js_string(hermes, value.getString(hermes));
+}
+
+#endif /* VUE_MARSHAL_H */
@@ -0,0 +1,881 @@
+/**
+ * @file pool.cpp
+ * @brief Work-stealing compiler pool implementation.
+ */
+
+#include "pool.h"
+#include "pool_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+namespace {
+
+/**
+ * Completion state shared by all jobs of one vue_pool_compile_batch() call.
+ */
+struct Batch {
+    VueCompileOptions options{};
+    size_t remaining = 0;  // Guarded by mutex.
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+/**
+ * A job submitted with vue_pool_submit(). Owns copies of its input, since
+ * the caller may release its strings as soon as the call returns.
+ */
+struct Submission {
+    VueJobTicket ticket;
+    std::string source;
+    std::string filename;
+    std::string id;
+    VueSfcInput input;
+    VueCompileOptions options;
+    VueCompiledSfc result;
+    VueJobCallback callback;
+    void* user_data;
+};
+
+/**
+ * A single SFC to compile. Batch jobs point into the caller's arrays, which
+ * outlive the batch; submitted jobs point into their Submission.
+ */
+struct Job {
+    const VueSfcInput* input;
+    const VueCompileOptions* options;
+    VueCompiledSfc* out;
+    /// Set for batch jobs.
+    Batch* batch;
+    /// Set for submitted jobs.
+    Submission* submission;
+};
+
+/**
+ * A worker thread, its runtime and its job queue.
+ *
+ * The owner pops from the front of the queue; thieves steal from the back.
+ */
+struct Worker {
+    std::thread thread;
+    std::mutex mutex;
+    std::deque<Job> queue;
+};
+
+/**
+ * Content-addressed LRU cache of compile results, shared by all workers.
+ *
+ * Keys hash the source; filename, id, source length and options are stored
+ * and compared on lookup, so only a source hash collision at equal length
+ * could alias two inputs.
+ */
+class CompileCache {
+public:
+    struct Key {
+        uint64_t hash;
+        size_t source_len;
+        std::string filename;
+        std::string id;
+        uint8_t flags;
+
+        bool operator==(const Key& other) const {
+            return hash == other.hash
+                && source_len == other.source_len
+                && filename == other.filename
+                && id == other.id
+                && flags == other.flags;
+        }
+    };
+
+    static Key make_key(const VueSfcInput& in, const VueCompileOptions& options) {
+        return Key{
+            hash_input(0, in, options), in.source_len,
+            std::string(in.filename, in.filename_len),
+            std::string(in.id, in.id_len),
+            option_flags(options)};
+    }
+
+    bool enabled() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return max_entries > 0;
+    }
+
+    /**
+     * Returns a copy of the cached result, or nullptr on a miss.
+     */
+    VueCompiledSfcImpl* lookup(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (max_entries == 0) {
+            return nullptr;
+        }
+        auto it = find(key);
+        if (it == lru.end()) {
+            misses++;
+            return nullptr;
+        }
+        hits++;
+        lru.splice(lru.begin(), lru, it);
+        return new VueCompiledSfcImpl(*it->result);
+    }
+
+    void insert(Key key, const VueCompiledSfcImpl& result) {
+        size_t size = result.byte_size() + key.filename.size() + key.id.size();
+        std::lock_guard<std::mutex> lock(mutex);
+        if (max_entries == 0 || (max_bytes > 0 && size > max_bytes)) {
+            return;
+        }
+        auto existing = find(key);
+        if (existing != lru.end()) {
+            erase(existing);
+        }
+        uint64_t hash = key.hash;
+        lru.push_front(Entry{std::move(key), std::make_unique<VueCompiledSfcImpl>(result), size});
+        index.emplace(hash, lru.begin());
+        bytes += size;
+        trim();
+    }
+
+    void set_limits(size_t entries, size_t byte_limit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        max_entries = entries;
+        max_bytes = byte_limit;
+        trim();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        lru.clear();
+        index.clear();
+        bytes = 0;
+    }
+
+    VuePoolCacheStats stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return VuePoolCacheStats{lru.size(), bytes, hits, misses, evictions};
+    }
+
+private:
+    struct Entry {
+        Key key;
+        std::unique_ptr<const VueCompiledSfcImpl> result;
+        size_t bytes;
+    };
+
+    using List = std::list<Entry>;
+
+    List::iterator find(const Key& key) {
+        auto range = index.equal_range(key.hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second->key == key) {
+                return it->second;
+            }
+        }
+        return lru.end();
+    }
+
+    void erase(List::iterator entry) {
+        auto range = index.equal_range(entry->key.hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == entry) {
+                index.erase(it);
+                break;
+            }
+        }
+        bytes -= entry->bytes;
+        lru.erase(entry);
+    }
+
+    /// Evicts from the cold end until both limits hold.
+    void trim() {
+        while (!lru.empty()
+               && (lru.size() > max_entries || (max_bytes > 0 && bytes > max_bytes))) {
+            erase(std::prev(lru.end()));
+            evictions++;
+        }
+    }
+
+    std::mutex mutex;
+    /// Most recently used first.
+    List lru;
+    std::unordered_multimap<uint64_t, List::iterator> index;
+    size_t max_entries = 0;
+    size_t max_bytes = 0;
+    size_t bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+};
+
+/// VueStrCallback that appends to a std::vector<std::string>.
+bool push_string(void* user_data, VueStr value) {
+    static_cast<std::vector<std::string>*>(user_data)->emplace_back(value.data, value.len);
+    return true;
+}
+
+/**
+ * Compiles one input on a runtime and copies the result out of the JS heap.
+ *
+ * With the cache enabled, a hit is returned without entering JS and a
+ * successful compilation is stored for later batches. `compiled` is set
+ * unless the result came from the cache.
+ */
+VueCompiledSfc run_job(HermesRuntime rt, CompileCache& cache, const Job& job, bool& compiled) {
+    const VueSfcInput& in = *job.input;
+
+    std::optional<CompileCache::Key> key;
+    compiled = false;
+    if (cache.enabled()) {
+        key = CompileCache::make_key(in, *job.options);
+        if (VueCompiledSfcImpl* cached = cache.lookup(*key)) {
+            return cached;
+        }
+    }
+
+    compiled = true;
+    auto* result = new VueCompiledSfcImpl();
+
+    try {
+        HermesHandle handle = vue_compile_sfc(
+            rt,
+            in.source, in.source_len,
+            in.filename, in.filename_len,
+            in.id, in.id_len,
+            job.options);
+        if (!handle) {
+            result->errors.emplace_back("vue_compile_sfc returned invalid handle");
+            return result;
+        }
+
+        result->js = vue_sfc_result_js(rt, handle);
+        result->css = vue_sfc_result_css(rt, handle);
+
+        vue_sfc_result_errors_for_each(rt, handle, push_string, &result->errors);
+        vue_sfc_result_warnings_for_each(rt, handle, push_string, &result->warnings);
+
+        hermes_handle_free(rt, handle);
+
+        if (key) {
+            cache.insert(std::move(*key), *result);
+        }
+    } catch (const std::exception& e) {
+        result->errors.emplace_back(e.what());
+    }
+
+    return result;
+}
+
+}  // namespace
+
+/**
+ * Internal pool structure.
+ */
+struct VuePoolImpl {
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    /// Compile results shared across workers and batches.
+    CompileCache cache;
+
+    /// Guards sleeping/waking of idle workers.
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+
+    /// Jobs pushed but not yet taken. Signed: a pop may briefly run ahead of
+    /// the increment that follows a push.
+    std::atomic<std::ptrdiff_t> queued{0};
+
+    /// Set under wake_mutex when the pool shuts down.
+    bool stopping = false;
+
+    /// Runtime configuration for every worker, if given at creation.
+    std::optional<HermesRuntimeOptions> runtime_options;
+
+    /// Collect garbage whenever a worker runs out of jobs.
+    std::atomic<bool> collect_when_idle{false};
+
+    /// Recycling limits (0 = none) and the number of runtimes replaced.
+    std::atomic<uint64_t> recycle_max_compiles{0};
+    std::atomic<size_t> recycle_max_heap_bytes{0};
+    std::atomic<uint64_t> recycled{0};
+
+    /// Last ticket handed out by vue_pool_submit().
+    std::atomic<VueJobTicket> last_ticket{0};
+
+    /// Worker whose queue receives the next submission.
+    std::atomic<size_t> next_worker{0};
+
+    /// Results of submissions without a callback, in completion order, and
+    /// the descriptors signaled while any are waiting. Guarded by
+    /// completed_mutex.
+    std::mutex completed_mutex;
+    std::deque<std::pair<VueJobTicket, VueCompiledSfc>> completed;
+    int notify_fd = -1;
+    int notify_write_fd = -1;
+
+    ~VuePoolImpl() {
+        for (auto& entry : completed) {
+            vue_compiled_sfc_free(entry.second);
+        }
+        if (notify_write_fd >= 0 && notify_write_fd != notify_fd) {
+            close(notify_write_fd);
+        }
+        if (notify_fd >= 0) {
+            close(notify_fd);
+        }
+    }
+
+    /**
+     * Makes the completion descriptor readable. Called with completed_mutex
+     * held when the first result starts waiting.
+     */
+    void signal_completed() {
+        if (notify_write_fd < 0) {
+            return;
+        }
+#ifdef __linux__
+        uint64_t one = 1;
+        ssize_t written = write(notify_write_fd, &one, sizeof(one));
+#else
+        char one = 1;
+        ssize_t written = write(notify_write_fd, &one, sizeof(one));
+#endif
+        (void)written;
+    }
+
+    /**
+     * Consumes the readiness of the completion descriptor. Called with
+     * completed_mutex held when the last waiting result is taken.
+     */
+    void clear_completed() {
+        if (notify_fd < 0) {
+            return;
+        }
+#ifdef __linux__
+        uint64_t count;
+        ssize_t got = read(notify_fd, &count, sizeof(count));
+#else
+        char buffer[64];
+        ssize_t got;
+        while ((got = read(notify_fd, buffer, sizeof(buffer))) > 0) {
+        }
+#endif
+        (void)got;
+    }
+
+    /**
+     * Creates the completion descriptor on first use. Returns -1 if the
+     * descriptor cannot be created.
+     */
+    int completion_fd() {
+        std::lock_guard<std::mutex> lock(completed_mutex);
+        if (notify_fd >= 0) {
+            return notify_fd;
+        }
+#ifdef __linux__
+        notify_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        notify_write_fd = notify_fd;
+#else
+        int fds[2];
+        if (pipe(fds) == 0) {
+            for (int fd : fds) {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+            }
+            notify_fd = fds[0];
+            notify_write_fd = fds[1];
+        }
+#endif
+        if (notify_fd >= 0 && !completed.empty()) {
+            signal_completed();
+        }
+        return notify_fd;
+    }
+
+    /**
+     * Hands a finished submission to its callback, or queues its result for
+     * vue_pool_take_completed(). Runs on the worker thread.
+     */
+    void finish_submission(Submission* submission) {
+        if (submission->callback) {
+            submission->callback(submission->user_data, submission->ticket, submission->result);
+        } else {
+            std::lock_guard<std::mutex> lock(completed_mutex);
+            completed.emplace_back(submission->ticket, submission->result);
+            if (completed.size() == 1) {
+                signal_completed();
+            }
+        }
+        delete submission;
+    }
+
+    /**
+     * Takes a job from the worker's own queue, or steals one from another
+     * worker. Returns false if every queue is empty.
+     */
+    bool take_job(size_t self, Job& job) {
+        {
+            Worker& own = *workers[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.queue.empty()) {
+                job = own.queue.front();
+                own.queue.pop_front();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        for (size_t step = 1; step < workers.size(); step++) {
+            Worker& victim = *workers[(self + step) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.queue.empty()) {
+                job = victim.queue.back();
+                victim.queue.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Creates a worker runtime with the pool's runtime options.
+     */
+    HermesRuntime create_runtime() {
+        return runtime_options
+            ? hermes_runtime_create_with_options(&*runtime_options)
+            : hermes_runtime_create();
+    }
+
+    /**
+     * Whether a runtime that ran `compiles` compilations is due for
+     * replacement under the recycling limits.
+     */
+    bool should_recycle(HermesRuntime rt, uint64_t compiles) {
+        uint64_t max_compiles = recycle_max_compiles.load();
+        if (max_compiles > 0 && compiles >= max_compiles) {
+            return true;
+        }
+        size_t max_heap_bytes = recycle_max_heap_bytes.load();
+        if (max_heap_bytes == 0) {
+            return false;
+        }
+        HermesHeapStats stats{};
+        return hermes_runtime_heap_stats(rt, &stats) && stats.heap_size > max_heap_bytes;
+    }
+
+    /**
+     * Worker thread body. Owns a runtime at any time; with recycling, the
+     * runtime is replaced between jobs (see vue_pool_set_recycle_limits()).
+     */
+    void worker_main(size_t self, std::promise<bool> ready) {
+        HermesRuntime rt = create_runtime();
+        ready.set_value(rt != nullptr);
+        if (!rt) {
+            return;
+        }
+
+        // Runtime being created in the background, and the old runtime
+        // being torn down
+        std::future<HermesRuntime> replacement;
+        std::future<void> retiring;
+        uint64_t compiles = 0;
+
+        // Swaps in the replacement runtime; waits for it if `wait` is set.
+        auto swap_runtime = [&](bool wait) {
+            if (!replacement.valid()
+                || (!wait
+                    && replacement.wait_for(std::chrono::seconds(0)) != std::future_status::ready)) {
+                return;
+            }
+            HermesRuntime fresh = replacement.get();
+            compiles = 0;
+            if (!fresh) {
+                return;
+            }
+            if (retiring.valid()) {
+                retiring.wait();
+            }
+            retiring = std::async(std::launch::async, hermes_runtime_retire, rt);
+            rt = fresh;
+            recycled.fetch_add(1);
+        };
+
+        bool ran_since_gc = false;
+        for (;;) {
+            Job job;
+            if (take_job(self, job)) {
+                bool compiled;
+                *job.out = run_job(rt, cache, job, compiled);
+                ran_since_gc = true;
+                compiles += compiled;
+                if (job.submission) {
+                    finish_submission(job.submission);
+                } else {
+                    // Decrement and notify under the lock: once remaining
+                    // reaches 0 the caller may return and destroy the batch.
+                    std::lock_guard<std::mutex> lock(job.batch->mutex);
+                    if (--job.batch->remaining == 0) {
+                        job.batch->done.notify_all();
+                    }
+                }
+
+                if (!replacement.valid() && compiled && should_recycle(rt, compiles)) {
+                    replacement = std::async(std::launch::async, &VuePoolImpl::create_runtime, this);
+                }
+                swap_runtime(false);
+                continue;
+            }
+
+            // Out of work: finish a pending replacement before sleeping.
+            if (replacement.valid()) {
+                swap_runtime(true);
+                continue;
+            }
+
+            // Out of work: the batch is draining, so collect before sleeping.
+            if (ran_since_gc && collect_when_idle.load()) {
+                hermes_runtime_collect_garbage(rt);
+                ran_since_gc = false;
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+            if (stopping && queued.load() <= 0) {
+                break;
+            }
+        }
+
+        if (retiring.valid()) {
+            retiring.wait();
+        }
+        hermes_runtime_destroy(rt);
+    }
+
+    /**
+     * Signals all workers to exit and joins them.
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+    }
+};
+
+// ============================================================================
+// Pool Lifecycle
+// ============================================================================
+
+extern "C" VuePool vue_pool_create(size_t num_workers) {
+    return vue_pool_create_with_options(num_workers, nullptr);
+}
+
+extern "C" VuePool vue_pool_create_with_options(
+    size_t num_workers,
+    const HermesRuntimeOptions* runtime_options
+) {
+    if (num_workers == 0) {
+        num_workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    auto* pool = new VuePoolImpl();
+    if (runtime_options) {
+        pool->runtime_options = *runtime_options;
+    }
+    std::vector<std::future<bool>> ready;
+    ready.reserve(num_workers);
+
+    for (size_t i = 0; i < num_workers; i++) {
+        pool->workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < num_workers; i++) {
+        std::promise<bool> promise;
+        ready.push_back(promise.get_future());
+        pool->workers[i]->thread = std::thread(
+            &VuePoolImpl::worker_main, pool, i, std::move(promise));
+    }
+
+    bool ok = true;
+    for (auto& future : ready) {
+        ok = future.get() && ok;
+    }
+
+    if (!ok) {
+        pool->shutdown();
+        delete pool;
+        return nullptr;
+    }
+
+    return pool;
+}
+
+extern "C" void vue_pool_destroy(VuePool pool) {
+    if (!pool) {
+        return;
+    }
+
+    pool->shutdown();
+    delete pool;
+}
+
+extern "C" size_t vue_pool_worker_count(VuePool pool) {
+    if (!pool) {
+        return 0;
+    }
+    return pool->workers.size();
+}
+
+extern "C" void vue_pool_set_collect_when_idle(VuePool pool, bool enabled) {
+    if (!pool) {
+        return;
+    }
+    pool->collect_when_idle.store(enabled);
+}
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+extern "C" bool vue_pool_compile_batch(
+    VuePool pool,
+    const VueSfcInput* inputs, size_t count,
+    const VueCompileOptions* options,
+    VueCompiledSfc* out_results
+) {
+    if (!pool || (count > 0 && (!inputs || !out_results))) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    Batch batch;
+    if (options) {
+        batch.options = *options;
+    }
+    batch.remaining = count;
+
+    // Largest first, dealt round-robin so every queue starts with big jobs.
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [inputs](size_t a, size_t b) {
+        return inputs[a].source_len > inputs[b].source_len;
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(pool->wake_mutex);
+        size_t numWorkers = pool->workers.size();
+        for (size_t i = 0; i < count; i++) {
+            size_t index = order[i];
+            Worker& worker = *pool->workers[i % numWorkers];
+            std::lock_guard<std::mutex> queueLock(worker.mutex);
+            worker.queue.push_back(
+                Job{&inputs[index], &batch.options, &out_results[index], &batch, nullptr});
+        }
+        pool->queued.fetch_add(static_cast<std::ptrdiff_t>(count));
+    }
+    pool->wake.notify_all();
+
+    std::unique_lock<std::mutex> lock(batch.mutex);
+    batch.done.wait(lock, [&batch] { return batch.remaining == 0; });
+    return true;
+}
+
+// ============================================================================
+// Asynchronous Jobs
+// ============================================================================
+
+extern "C" VueJobTicket vue_pool_submit(
+    VuePool pool,
+    const VueSfcInput* input,
+    const VueCompileOptions* options,
+    VueJobCallback callback,
+    void* user_data
+) {
+    if (!pool || !input) {
+        return 0;
+    }
+
+    auto* submission = new Submission();
+    submission->ticket = pool->last_ticket.fetch_add(1) + 1;
+    submission->source.assign(input->source, input->source_len);
+    submission->filename.assign(input->filename, input->filename_len);
+    submission->id.assign(input->id, input->id_len);
+    submission->input = VueSfcInput{
+        submission->source.data(), submission->source.size(),
+        submission->filename.data(), submission->filename.size(),
+        submission->id.data(), submission->id.size()};
+    submission->options = options ? *options : VueCompileOptions{};
+    submission->result = nullptr;
+    submission->callback = callback;
+    submission->user_data = user_data;
+    VueJobTicket ticket = submission->ticket;
+
+    {
+        std::lock_guard<std::mutex> lock(pool->wake_mutex);
+        size_t index = pool->next_worker.fetch_add(1) % pool->workers.size();
+        Worker& worker = *pool->workers[index];
+        std::lock_guard<std::mutex> queueLock(worker.mutex);
+        worker.queue.push_back(Job{
+            &submission->input, &submission->options, &submission->result,
+            nullptr, submission});
+        pool->queued.fetch_add(1);
+    }
+    pool->wake.notify_one();
+    return ticket;
+}
+
+extern "C" int vue_pool_completion_fd(VuePool pool) {
+    if (!pool) {
+        return -1;
+    }
+    return pool->completion_fd();
+}
+
+extern "C" VueCompiledSfc vue_pool_take_completed(VuePool pool, VueJobTicket* out_ticket) {
+    if (!pool) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pool->completed_mutex);
+    if (pool->completed.empty()) {
+        return nullptr;
+    }
+    auto [ticket, result] = pool->completed.front();
+    pool->completed.pop_front();
+    if (pool->completed.empty()) {
+        pool->clear_completed();
+    }
+    if (out_ticket) {
+        *out_ticket = ticket;
+    }
+    return result;
+}
+
+// ============================================================================
+// Compile Cache
+// ============================================================================
+
+extern "C" void vue_pool_set_cache_limits(VuePool pool, size_t max_entries, size_t max_bytes) {
+    if (!pool) {
+        return;
+    }
+    pool->cache.set_limits(max_entries, max_bytes);
+}
+
+extern "C" void vue_pool_cache_clear(VuePool pool) {
+    if (!pool) {
+        return;
+    }
+    pool->cache.clear();
+}
+
+extern "C" bool vue_pool_cache_stats(VuePool pool, VuePoolCacheStats* out) {
+    if (!pool || !out) {
+        return false;
+    }
+    *out = pool->cache.stats();
+    return true;
+}
+
+// ============================================================================
+// Runtime Recycling
+// ============================================================================
+
+extern "C" void vue_pool_set_recycle_limits(
+    VuePool pool,
+    uint64_t max_compiles,
+    size_t max_heap_bytes
+) {
+    if (!pool) {
+        return;
+    }
+    pool->recycle_max_compiles.store(max_compiles);
+    pool->recycle_max_heap_bytes.store(max_heap_bytes);
+}
+
+extern "C" uint64_t vue_pool_recycle_count(VuePool pool) {
+    if (!pool) {
+        return 0;
+    }
+    return pool->recycled.load();
+}
+
+// ============================================================================
+// Compiled Results
+// ============================================================================
+
+extern "C" const char* vue_compiled_sfc_js(VueCompiledSfc result) {
+    if (!result) {
+        return "";
+    }
+    return result->js.c_str();
+}
+
+extern "C" const char* vue_compiled_sfc_css(VueCompiledSfc result) {
+    if (!result) {
+        return "";
+    }
+    return result->css.c_str();
+}
+
+extern "C" size_t vue_compiled_sfc_error_count(VueCompiledSfc result) {
+    if (!result) {
+        return 0;
+    }
+    return result->errors.size();
+}
+
+extern "C" const char* vue_compiled_sfc_error_at(VueCompiledSfc result, size_t index) {
+    if (!result || index >= result->errors.size()) {
+        return "";
+    }
+    return result->errors[index].c_str();
+}
+
+extern "C" size_t vue_compiled_sfc_warning_count(VueCompiledSfc result) {
+    if (!result) {
+        return 0;
+    }
+    return result->warnings.size();
+}
+
+extern "C" const char* vue_compiled_sfc_warning_at(VueCompiledSfc result, size_t index) {
+    if (!result || index >= result->warnings.size()) {
+        return "";
+    }
+    return result->warnings[index].c_str();
+}
+
+extern "C" void vue_compiled_sfc_free(VueCompiledSfc result) {
+    delete result;
+}
@@ -0,0 +1,331 @@
+/**
+ * @file pool.h
+ * @brief Thread-safe compiler pool over multiple HermesRuntime instances.
+ *
+ * A VuePool owns N worker threads, each pinned to its own HermesRuntime.
+ * Jobs are distributed across per-worker queues and balanced by work
+ * stealing: an idle worker takes pending jobs from the back of another
+ * worker's queue, so one slow component never stalls the jobs queued
+ * behind it.
+ *
+ * ## Thread Safety
+ *
+ * - All vue_pool_* functions may be called from any thread
+ * - VueCompiledSfc results are plain heap data and may be read, moved and
+ *   freed on any thread
+ * - Job callbacks run on worker threads (see vue_pool_submit())
+ *
+ * ## Asynchronous Jobs
+ *
+ * vue_pool_submit() queues one SFC and returns a ticket immediately, so an
+ * event loop can keep doing I/O while workers compile. Completion is
+ * delivered either to a callback on the worker thread, or by queueing the
+ * result and making vue_pool_completion_fd() readable until every waiting
+ * result has been taken with vue_pool_take_completed().
+ *
+ * ## Compile Cache
+ *
+ * The pool can keep an LRU cache of compile results shared by all workers,
+ * keyed by a hash of source, filename, id and options. Unchanged inputs are
+ * then answered with a copy of the cached result without entering JS. The
+ * cache is disabled by default.
+ *
+ * ## Runtime Recycling
+ *
+ * A runtime's heap never shrinks back to the OS, so a long-running pool can
+ * replace worker runtimes after a number of compilations or once their heap
+ * grows past a limit (see vue_pool_set_recycle_limits()). The replacement is
+ * created on a background thread while the worker keeps compiling with its
+ * old runtime, which is torn down in the background once swapped out.
+ */
+
+#ifndef VUE_POOL_H
+#define VUE_POOL_H
+
+#include "vue_sfc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// Types
+// ============================================================================
+
+/**
+ * Opaque pointer to a compiler pool.
+ */
+typedef struct VuePoolImpl* VuePool;
+
+/**
+ * Opaque pointer to an owned compile result.
+ *
+ * Unlike handles, a VueCompiledSfc holds no JS values and is independent of
+ * any runtime. Free it with vue_compiled_sfc_free().
+ */
+typedef struct VueCompiledSfcImpl* VueCompiledSfc;
+
+/**
+ * Identifies a job submitted with vue_pool_submit(). Tickets are unique per
+ * pool and never 0.
+ */
+typedef uint64_t VueJobTicket;
+
+/**
+ * Receives the result of a submitted job.
+ *
+ * Called on the worker thread that compiled the job, which is busy until the
+ * callback returns, so it should only hand the result off. The callback owns
+ * the result and must eventually free it with vue_compiled_sfc_free(). It
+ * must not call vue_pool_destroy().
+ */
+typedef void (*VueJobCallback)(void* user_data, VueJobTicket ticket, VueCompiledSfc result);
+
+/**
+ * Counters of a pool's compile cache (see vue_pool_set_cache_limits()).
+ */
+typedef struct VuePoolCacheStats {
+    /** Results currently cached. */
+    size_t entries;
+    /** Approximate bytes held by cached results. */
+    size_t bytes;
+    /** Inputs answered from the cache without entering JS. */
+    uint64_t hits;
+    /** Inputs that were compiled while the cache was enabled. */
+    uint64_t misses;
+    /** Results dropped to stay within the limits. */
+    uint64_t evictions;
+} VuePoolCacheStats;
+
+// ============================================================================
+// Pool Lifecycle
+// ============================================================================
+
+/**
+ * Creates a pool and starts its workers.
+ *
+ * Each worker creates its runtime on its own thread; this call returns once
+ * all runtimes are initialized.
+ *
+ * @param num_workers Number of workers, or 0 for one per hardware thread.
+ * @return Pointer to the pool, or NULL if any runtime failed to initialize.
+ */
+VuePool vue_pool_create(size_t num_workers);
+
+/**
+ * Creates a pool whose worker runtimes initialize only some compiler units
+ * up front (see hermes_runtime_create_with_options()). Heap limits apply to
+ * every runtime of the process (see hermes_runtime_configure_process()).
+ *
+ * @param num_workers Number of workers, or 0 for one per hardware thread.
+ * @param runtime_options Configuration for every worker runtime, or NULL for
+ *                        defaults. Only needs to stay valid during the call.
+ * @return Pointer to the pool, or NULL if any runtime failed to initialize.
+ */
+VuePool vue_pool_create_with_options(
+    size_t num_workers,
+    const HermesRuntimeOptions* runtime_options
+);
+
+/**
+ * Stops the workers and destroys their runtimes.
+ *
+ * Submitted jobs still queued are compiled and delivered first; results
+ * never taken with vue_pool_take_completed() are freed. Must not be called
+ * while a batch is in flight or concurrently with vue_pool_submit(). Safe to
+ * call with NULL.
+ */
+void vue_pool_destroy(VuePool pool);
+
+/**
+ * Gets the number of workers.
+ */
+size_t vue_pool_worker_count(VuePool pool);
+
+/**
+ * Makes every worker run a full collection whenever it runs out of jobs,
+ * i.e. at the end of each batch, instead of when its heap fills (default off).
+ *
+ * Keeps each runtime's heap near its live size between batches, at the cost
+ * of one GC pause per worker per batch.
+ */
+void vue_pool_set_collect_when_idle(VuePool pool, bool enabled);
+
+// ============================================================================
+// Compilation
+// ============================================================================
+
+/**
+ * Compiles a batch of SFCs and blocks until all of them are done.
+ *
+ * Jobs are scheduled largest-first, which keeps the tail of the batch short
+ * when a few components dominate the total size.
+ *
+ * @param pool The pool.
+ * @param inputs Array of `count` inputs; must stay valid until the call returns.
+ * @param count Number of inputs.
+ * @param options Compile options applied to every input, or NULL for defaults.
+ * @param out_results Array of `count` slots receiving owned results, in input
+ *                    order. Each result must be freed with vue_compiled_sfc_free().
+ * @return false if pool is NULL or the arrays are NULL with a non-zero count.
+ */
+bool vue_pool_compile_batch(
+    VuePool pool,
+    const VueSfcInput* inputs, size_t count,
+    const VueCompileOptions* options,
+    VueCompiledSfc* out_results
+);
+
+// ============================================================================
+// Asynchronous Jobs
+// ============================================================================
+
+/**
+ * Queues one SFC for compilation and returns without waiting.
+ *
+ * Submitted jobs share the workers, queues and compile cache with batches.
+ *
+ * @param pool The pool.
+ * @param input The input; its strings are copied and only need to stay
+ *              valid during the call.
+ * @param options Compile options, or NULL for defaults. Copied.
+ * @param callback Receives the result on a worker thread, or NULL to queue
+ *                 the result for vue_pool_take_completed() instead.
+ * @param user_data Passed to the callback.
+ * @return The job's ticket, or 0 if pool or input is NULL.
+ */
+VueJobTicket vue_pool_submit(
+    VuePool pool,
+    const VueSfcInput* input,
+    const VueCompileOptions* options,
+    VueJobCallback callback,
+    void* user_data
+);
+
+/**
+ * Gets a descriptor that is readable while results of jobs submitted
+ * without a callback are waiting to be taken.
+ *
+ * An eventfd on Linux and the read end of a pipe elsewhere; non-blocking
+ * and close-on-exec. Register it with poll/epoll/kqueue or an async
+ * runtime's reactor, then call vue_pool_take_completed() until it returns
+ * NULL. Never read from or close it: the pool resets it when the last
+ * waiting result is taken and closes it on destroy.
+ *
+ * @return The descriptor, or -1 if pool is NULL or the descriptor could not
+ *         be created.
+ */
+int vue_pool_completion_fd(VuePool pool);
+
+/**
+ * Takes the oldest waiting result of a job submitted without a callback.
+ *
+ * @param pool The pool.
+ * @param out_ticket Receives the job's ticket if a result is returned; may
+ *                   be NULL.
+ * @return An owned result to free with vue_compiled_sfc_free(), or NULL if
+ *         none is waiting.
+ */
+VueCompiledSfc vue_pool_take_completed(VuePool pool, VueJobTicket* out_ticket);
+
+// ============================================================================
+// Compile Cache
+// ============================================================================
+
+/**
+ * Enables, resizes or disables the compile cache.
+ *
+ * Least recently used results are evicted until both limits hold. Inputs
+ * whose compilation threw are never cached; results with compile errors are.
+ *
+ * @param pool The pool.
+ * @param max_entries Maximum number of cached results, or 0 to disable the
+ *                    cache and drop its entries.
+ * @param max_bytes Maximum approximate size of cached results, or 0 for no
+ *                  byte limit.
+ */
+void vue_pool_set_cache_limits(VuePool pool, size_t max_entries, size_t max_bytes);
+
+/**
+ * Drops all cached results. Counters are kept.
+ */
+void vue_pool_cache_clear(VuePool pool);
+
+/**
+ * Reads the cache counters.
+ *
+ * @return false if pool or out is NULL.
+ */
+bool vue_pool_cache_stats(VuePool pool, VuePoolCacheStats* out);
+
+// ============================================================================
+// Runtime Recycling
+// ============================================================================
+
+/**
+ * Enables, changes or disables runtime recycling.
+ *
+ * After each job, a worker whose runtime reached either limit starts
+ * creating a fresh runtime (with the pool's runtime options) in the
+ * background. It swaps it in between jobs once it is ready, or right away
+ * when it runs out of work, and retires the old runtime with
+ * hermes_runtime_retire() on a background thread. If the replacement fails
+ * to initialize, the worker keeps its runtime and tries again later.
+ *
+ * @param pool The pool.
+ * @param max_compiles Compilations a runtime runs before it is replaced,
+ *                     or 0 for no limit. Cache hits do not count.
+ * @param max_heap_bytes Heap size (HermesHeapStats::heap_size) above which
+ *                       a runtime is replaced, or 0 for no limit.
+ */
+void vue_pool_set_recycle_limits(VuePool pool, uint64_t max_compiles, size_t max_heap_bytes);
+
+/**
+ * Gets the number of worker runtimes replaced so far by recycling.
+ */
+uint64_t vue_pool_recycle_count(VuePool pool);
+
+// ============================================================================
+// Compiled Results
+// ============================================================================
+
+/**
+ * Gets the compiled JavaScript.
+ */
+const char* vue_compiled_sfc_js(VueCompiledSfc result);
+
+/**
+ * Gets the concatenated CSS of all style blocks.
+ */
+const char* vue_compiled_sfc_css(VueCompiledSfc result);
+
+/**
+ * Gets the number of errors.
+ */
+size_t vue_compiled_sfc_error_count(VueCompiledSfc result);
+
+/**
+ * Gets an error message at the specified index.
+ */
+const char* vue_compiled_sfc_error_at(VueCompiledSfc result, size_t index);
+
+/**
+ * Gets the number of warnings.
+ */
+size_t vue_compiled_sfc_warning_count(VueCompiledSfc result);
+
+/**
+ * Gets a warning message at the specified index.
+ */
+const char* vue_compiled_sfc_warning_at(VueCompiledSfc result, size_t index);
+
+/**
+ * Frees a compile result. Safe to call with NULL.
+ */
+void vue_compiled_sfc_free(VueCompiledSfc result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VUE_POOL_H */
@@ -0,0 +1,84 @@
+/**
+ * @file pool_internal.h
+ * @brief Internal definitions shared by the pool and the disk cache.
+ *
+ * This header is NOT part of the public API. It is only included by
+ * pool.cpp and disk_cache.cpp.
+ */
+
+#ifndef VUE_POOL_INTERNAL_H
+#define VUE_POOL_INTERNAL_H
+
+#include "pool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Owned compile result, copied out of the JS heap.
+ */
+struct VueCompiledSfcImpl {
+    std::string js;
+    std::string css;
+    std::vector<std::string> errors;
+    std::vector<std::string> warnings;
+
+    /// Approximate heap footprint, used to bound the compile cache.
+    size_t byte_size() const {
+        size_t total = sizeof(*this) + js.capacity() + css.capacity();
+        for (const auto& error : errors) {
+            total += sizeof(error) + error.capacity();
+        }
+        for (const auto& warning : warnings) {
+            total += sizeof(warning) + warning.capacity();
+        }
+        return total;
+    }
+};
+
+/**
+ * 64-bit hash over a byte range, eight bytes per step.
+ */
+inline uint64_t hash_bytes(uint64_t h, const char* data, size_t len) {
+    constexpr uint64_t kMul = 0x9E3779B97F4A7C15ull;
+    h ^= len * kMul;
+    for (; len >= 8; data += 8, len -= 8) {
+        uint64_t word;
+        std::memcpy(&word, data, 8);
+        h = (h ^ word) * kMul;
+        h ^= h >> 29;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, data, len);
+    h = (h ^ tail) * kMul;
+    return h ^ (h >> 32);
+}
+
+/**
+ * Packs the compile options into one byte, bit per flag.
+ */
+inline uint8_t option_flags(const VueCompileOptions& options) {
+    return static_cast<uint8_t>(
+        options.is_prod
+        | options.source_map << 1
+        | options.keep_template_ast << 2
+        | options.keep_preamble << 3
+        | options.keep_tips << 4
+        | options.ssr << 5);
+}
+
+/**
+ * Hashes everything that determines a compile result: source, filename, id
+ * and options. Different seeds give independent hashes.
+ */
+inline uint64_t hash_input(uint64_t seed, const VueSfcInput& in, const VueCompileOptions& options) {
+    uint64_t h = hash_bytes(seed, in.source, in.source_len);
+    h = hash_bytes(h, in.filename, in.filename_len);
+    h = hash_bytes(h, in.id, in.id_len);
+    uint8_t flags = option_flags(options);
+    return hash_bytes(h, reinterpret_cast<const char*>(&flags), 1);
+}
+
+#endif /* VUE_POOL_INTERNAL_H */
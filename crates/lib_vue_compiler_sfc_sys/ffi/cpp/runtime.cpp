@@ -5,20 +5,154 @@
 
 #include "runtime_internal.h"
 
-// External declaration for the compiled Vue compiler unit
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// External declarations for the compiled Vue compiler units: the whole
+// compiler, and with VUE_SPLIT_UNITS one tree-shaken unit per part
 extern "C" SHUnit sh_export_vue_compiler;
+#ifdef VUE_SPLIT_UNITS
+extern "C" SHUnit sh_export_vue_compiler_parse;
+extern "C" SHUnit sh_export_vue_compiler_script;
+extern "C" SHUnit sh_export_vue_compiler_template;
+extern "C" SHUnit sh_export_vue_compiler_style;
+#endif
 
 // ============================================================================
 // Runtime Lifecycle
 // ============================================================================
 
-extern "C" HermesRuntime hermes_runtime_create(void) {
+namespace {
+
+/**
+ * Formats a byte count as a Static Hermes memory size, rounded up to KiB.
+ */
+std::string memory_size(size_t bytes) {
+    return std::to_string((bytes + 1023) / 1024) + "K";
+}
+
+/**
+ * Builds the _sh_init() command line for a set of options.
+ */
+std::vector<std::string> vm_args(const HermesProcessOptions& options) {
+    std::vector<std::string> args{"vuers"};
+    if (options.init_heap_bytes > 0) {
+        args.push_back("-gc-init-heap=" + memory_size(options.init_heap_bytes));
+    }
+    if (options.max_heap_bytes > 0) {
+        args.push_back("-gc-max-heap=" + memory_size(options.max_heap_bytes));
+    }
+    for (size_t i = 0; i < options.vm_flag_count; i++) {
+        if (options.vm_flags && options.vm_flags[i]) {
+            args.emplace_back(options.vm_flags[i]);
+        }
+    }
+    return args;
+}
+
+/**
+ * Process-wide VM configuration. Static Hermes parses its command line into
+ * global settings, so every _sh_init() call is serialized here and only the
+ * first one passes the configured arguments.
+ */
+struct ProcessConfig {
+    std::mutex mutex;
+    std::vector<std::string> args{"vuers"};
+    bool initialized = false;
+};
+
+ProcessConfig& process_config() {
+    // Leaked: runtimes can be created and torn down during static destruction.
+    static auto* instance = new ProcessConfig();
+    return *instance;
+}
+
+/**
+ * Initializes a Static Hermes runtime with the process configuration.
+ */
+SHRuntime* init_sh_runtime() {
+    auto& config = process_config();
+    std::lock_guard<std::mutex> lock(config.mutex);
+    if (config.initialized) {
+        return _sh_init(0, nullptr);
+    }
+    config.initialized = true;
+
+    std::vector<char*> argv;
+    for (auto& arg : config.args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+    return _sh_init(static_cast<int>(config.args.size()), argv.data());
+}
+
+void destroy_now(HermesRuntimeImpl* rt);
+
+/// Runtimes torn down with _sh_done() (see hermes_runtime_teardown_count()).
+std::atomic<uint64_t> teardown_count{0};
+
+/**
+ * Points `fn` at the global function `name`, or resets it if no loaded unit
+ * defines it.
+ */
+void resolve_function(
+    facebook::jsi::Runtime& hermes,
+    const facebook::jsi::Object& global,
+    std::unique_ptr<facebook::jsi::Function>& fn,
+    const char* name
+) {
+    auto value = global.getProperty(hermes, name);
+    if (value.isObject() && value.getObject(hermes).isFunction(hermes)) {
+        fn = std::make_unique<facebook::jsi::Function>(
+            value.getObject(hermes).getFunction(hermes));
+    } else {
+        fn.reset();
+    }
+}
+
+/**
+ * Caches references to the bridge functions of the loaded units.
+ */
+void resolve_functions(HermesRuntimeImpl* rt) {
+    auto& hermes = rt->runtime();
+    auto global = hermes.global();
+    resolve_function(hermes, global, rt->parse_fn, "parse");
+    resolve_function(hermes, global, rt->compile_script_fn, "compileScript");
+    resolve_function(hermes, global, rt->compile_template_fn, "compileTemplate");
+    resolve_function(hermes, global, rt->compile_style_fn, "compileStyle");
+    resolve_function(
+        hermes, global, rt->compile_template_from_descriptor_fn, "compileTemplateFromDescriptor");
+    resolve_function(
+        hermes, global, rt->compile_style_from_descriptor_fn, "compileStyleFromDescriptor");
+    resolve_function(hermes, global, rt->compile_sfc_fn, "compileSfc");
+    resolve_function(hermes, global, rt->compile_sfc_incremental_fn, "compileSfcIncremental");
+    resolve_function(hermes, global, rt->compile_sfc_batch_fn, "compileSfcBatch");
+    resolve_function(hermes, global, rt->rehydrate_descriptor_fn, "rehydrateDescriptor");
+    resolve_function(hermes, global, rt->scan_script_imports_fn, "scanScriptImports");
+}
+
+/**
+ * Creates and initializes a runtime from scratch.
+ *
+ * This is the expensive path: _sh_init, unit initialization (which runs the
+ * bundled compiler modules of the requested units) and the global lookups.
+ *
+ * @param options Units to initialize, or NULL for all of them.
+ */
+HermesRuntimeImpl* create_cold(const HermesRuntimeOptions* options = nullptr) {
     auto* rt = new HermesRuntimeImpl();
     rt->sh_runtime = nullptr;
     rt->jsi_runtime = nullptr;
 
     // Initialize the Static Hermes runtime
-    rt->sh_runtime = _sh_init(0, nullptr);
+    rt->sh_runtime = init_sh_runtime();
     if (!rt->sh_runtime) {
         delete rt;
         return nullptr;
@@ -26,54 +160,497 @@ extern "C" HermesRuntime hermes_runtime_create(void) {
 
     rt->jsi_runtime = _sh_get_hermes_runtime(rt->sh_runtime);
     if (!rt->jsi_runtime) {
-        delete rt;
+        destroy_now(rt);
         return nullptr;
     }
 
-    // Load the compiled Vue compiler unit
-    if (!_sh_initialize_units(rt->sh_runtime, 1, &sh_export_vue_compiler)) {
-        delete rt;
+    // Load the compiled Vue compiler units
+    uint32_t units = options && options->units ? options->units : VUE_UNIT_ALL;
+    if (!rt->require_units(units)) {
+        destroy_now(rt);
         return nullptr;
     }
 
-    // Cache references to the JavaScript functions
     auto& hermes = rt->runtime();
     auto global = hermes.global();
-    rt->parse_fn = std::make_unique<facebook::jsi::Function>(
-        global.getPropertyAsFunction(hermes, "parse"));
-    rt->compile_script_fn = std::make_unique<facebook::jsi::Function>(
-        global.getPropertyAsFunction(hermes, "compileScript"));
-    rt->compile_template_fn = std::make_unique<facebook::jsi::Function>(
-        global.getPropertyAsFunction(hermes, "compileTemplate"));
-    rt->compile_style_fn = std::make_unique<facebook::jsi::Function>(
-        global.getPropertyAsFunction(hermes, "compileStyle"));
+    rt->json_stringify_fn = std::make_unique<facebook::jsi::Function>(
+        global.getPropertyAsObject(hermes, "JSON").getPropertyAsFunction(hermes, "stringify"));
+    rt->prop_names = std::make_unique<PropNames>(hermes);
 
     return rt;
 }
 
-extern "C" void hermes_runtime_destroy(HermesRuntime rt) {
-    if (!rt) {
-        return;
+/**
+ * Process-wide state of the Hermes sampling profiler, which is enabled while
+ * any runtime samples.
+ */
+struct Sampler {
+    std::mutex mutex;
+    size_t users = 0;
+};
+
+Sampler& sampler() {
+    static auto* instance = new Sampler();
+    return *instance;
+}
+
+/// Requires the sampler mutex.
+void release_sampler(Sampler& state) {
+    if (--state.users == 0) {
+        try {
+            facebook::hermes::HermesRuntime::disableSamplingProfiler();
+        } catch (const std::exception&) {
+        }
     }
+}
+
+/// Registers a runtime with the sampling profiler, enabling it if needed.
+bool start_sampling(HermesRuntimeImpl* rt, double sample_hz) {
+    auto& state = sampler();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    try {
+        if (state.users == 0) {
+            facebook::hermes::HermesRuntime::enableSamplingProfiler(sample_hz);
+        }
+    } catch (const std::exception&) {
+        // Built without the sampling profiler
+        return false;
+    }
+    state.users++;
+
+    try {
+        rt->jsi_runtime->registerForProfiling();
+    } catch (const std::exception&) {
+        release_sampler(state);
+        return false;
+    }
+    return true;
+}
+
+/// Unregisters a runtime and returns its samples in DevTools format.
+std::string stop_sampling(HermesRuntimeImpl* rt) {
+    std::ostringstream samples;
+    try {
+        rt->jsi_runtime->sampledTraceToStreamInDevToolsFormat(samples);
+    } catch (const std::exception&) {
+        samples.str("");
+    }
+    try {
+        rt->jsi_runtime->unregisterForProfiling();
+    } catch (const std::exception&) {
+    }
+
+    auto& state = sampler();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    release_sampler(state);
+    return samples.str();
+}
+
+/// Appends nanoseconds as fractional microseconds, the Chrome trace unit.
+void append_micros(std::string& out, uint64_t nanos) {
+    std::string fraction = std::to_string(nanos % 1000);
+    out += std::to_string(nanos / 1000);
+    out += '.';
+    out.append(3 - fraction.size(), '0');
+    out += fraction;
+}
+
+/**
+ * Formats a stopped profile as Chrome trace event JSON.
+ *
+ * @param samples Hermes samples in DevTools format, or empty.
+ */
+std::string chrome_trace(const RuntimeProfile& profile, const std::string& samples) {
+    std::string out = "{\"traceEvents\":[";
+    out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+           "\"args\":{\"name\":\"Hermes runtime\"}}";
+    for (const auto& span : profile.spans) {
+        // Names are C identifiers (__func__), so need no escaping.
+        out += ",{\"name\":\"";
+        out += span.name;
+        out += "\",\"cat\":\"vue_ffi\",\"ph\":\"X\",\"ts\":";
+        append_micros(out, span.start_ns);
+        out += ",\"dur\":";
+        append_micros(out, span.dur_ns);
+        out += ",\"pid\":1,\"tid\":1}";
+    }
+    if (!samples.empty()) {
+        out += ",{\"name\":\"CpuProfile\",\"cat\":\"disabled-by-default-v8.cpu_profiler\","
+               "\"ph\":\"I\",\"s\":\"t\",\"ts\":";
+        append_micros(out, profile.start_ns);
+        out += ",\"pid\":1,\"tid\":1,\"args\":{\"data\":{\"cpuProfile\":";
+        out += samples;
+        out += "}}}";
+    }
+    out += "],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedSpans\":";
+    out += std::to_string(profile.dropped);
+    out += ",\"durationMicros\":";
+    append_micros(out, profile.stop_ns - profile.start_ns);
+    out += "}}";
+    return out;
+}
+
+/// Drops a runtime's profile, unregistering it from the sampler if needed.
+void discard_profile(HermesRuntimeImpl* rt) {
+    if (rt->profile && rt->profile->recording && rt->profile->sampling) {
+        stop_sampling(rt);
+    }
+    rt->profile.reset();
+}
+
+/**
+ * Tears a runtime down for good.
+ */
+void destroy_now(HermesRuntimeImpl* rt) {
+    discard_profile(rt);
 
     // Clear function references before destroying runtime
     rt->parse_fn.reset();
     rt->compile_script_fn.reset();
     rt->compile_template_fn.reset();
     rt->compile_style_fn.reset();
+    rt->compile_template_from_descriptor_fn.reset();
+    rt->compile_style_from_descriptor_fn.reset();
+    rt->compile_sfc_fn.reset();
+    rt->compile_sfc_incremental_fn.reset();
+    rt->compile_sfc_batch_fn.reset();
+    rt->rehydrate_descriptor_fn.reset();
+    rt->scan_script_imports_fn.reset();
+    rt->json_stringify_fn.reset();
+    rt->prop_names.reset();
 
-    // Clear handle table
-    rt->handles.clear();
-    rt->free_list.clear();
+    // Release every value the handle table still holds
+    rt->clear_handles();
+    rt->handle_chunks.clear();
 
-    // Note: We don't explicitly destroy the Hermes runtime here.
-    // The _sh_done() function should be called, but Static Hermes
-    // documentation suggests letting it leak to avoid destruction order issues.
-    // If needed, uncomment: _sh_done(rt->sh_runtime);
+    // No JSI value refers to the heap any more, so the runtime and its whole
+    // heap can go. Parked spares are the only runtimes left at exit, and
+    // they are never torn down (see spares()).
+    if (rt->sh_runtime) {
+        _sh_done(rt->sh_runtime);
+        teardown_count.fetch_add(1, std::memory_order_relaxed);
+    }
 
     delete rt;
 }
 
+/**
+ * Process-wide list of initialized, idle runtimes.
+ *
+ * Static Hermes has no heap snapshot facility, so instead of restoring a
+ * snapshot, warm start hands out runtimes whose compiler units have already
+ * been initialized: either prewarmed ahead of time or parked by a previous
+ * hermes_runtime_destroy().
+ */
+struct SpareRuntimes {
+    std::mutex mutex;
+    std::vector<HermesRuntimeImpl*> runtimes;
+    size_t capacity = 0;
+};
+
+SpareRuntimes& spares() {
+    // Leaked on purpose: parked runtimes are not torn down at exit, when
+    // static destructors may already have run.
+    static auto* instance = new SpareRuntimes();
+    return *instance;
+}
+
+/// Parks a runtime if there is room; returns false if it must be destroyed.
+bool park(HermesRuntimeImpl* rt) {
+    auto& pool = spares();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (pool.runtimes.size() >= pool.capacity) {
+        return false;
+    }
+    pool.runtimes.push_back(rt);
+    return true;
+}
+
+}  // namespace
+
+bool HermesRuntimeImpl::require_units(uint32_t units) {
+    uint32_t missing = units & VUE_UNIT_ALL & ~loaded_units;
+    if (!missing) {
+        return true;
+    }
+
+    VUE_TRACE_SPAN(this);
+
+    // Split builds load just the missing units, except for a runtime that
+    // needs everything, which gets the whole compiler in one unit
+    std::vector<std::pair<uint32_t, SHUnit*>> load;
+#ifdef VUE_SPLIT_UNITS
+    if (loaded_units != 0 || missing != VUE_UNIT_ALL) {
+        const std::pair<uint32_t, SHUnit*> split[] = {
+            {VUE_UNIT_PARSE, &sh_export_vue_compiler_parse},
+            {VUE_UNIT_SCRIPT, &sh_export_vue_compiler_script},
+            {VUE_UNIT_TEMPLATE, &sh_export_vue_compiler_template},
+            {VUE_UNIT_STYLE, &sh_export_vue_compiler_style},
+        };
+        for (const auto& unit : split) {
+            if (missing & unit.first) {
+                load.push_back(unit);
+            }
+        }
+    }
+#endif
+    if (load.empty()) {
+        load.emplace_back(VUE_UNIT_ALL, &sh_export_vue_compiler);
+    }
+
+    bool ok = true;
+    for (const auto& unit : load) {
+        if (!_sh_initialize_units(sh_runtime, 1, unit.second)) {
+            ok = false;
+            break;
+        }
+        loaded_units |= unit.first;
+    }
+    resolve_functions(this);
+    return ok;
+}
+
+extern "C" HermesRuntime hermes_runtime_create(void) {
+    {
+        auto& pool = spares();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        if (!pool.runtimes.empty()) {
+            auto* rt = pool.runtimes.back();
+            pool.runtimes.pop_back();
+            return rt;
+        }
+    }
+
+    return create_cold();
+}
+
+extern "C" HermesRuntime hermes_runtime_create_with_options(const HermesRuntimeOptions* options) {
+    if (!options) {
+        return hermes_runtime_create();
+    }
+    return create_cold(options);
+}
+
+extern "C" bool hermes_runtime_configure_process(const HermesProcessOptions* options) {
+    if (!options) {
+        return false;
+    }
+
+    auto& config = process_config();
+    std::lock_guard<std::mutex> lock(config.mutex);
+    if (config.initialized) {
+        return false;
+    }
+    config.args = vm_args(*options);
+    return true;
+}
+
+extern "C" void hermes_runtime_destroy(HermesRuntime rt) {
+    if (!rt) {
+        return;
+    }
+
+    rt->clear_handles();
+    rt->stats = HermesRuntimeStats{};
+    discard_profile(rt);
+    if (park(rt)) {
+        return;
+    }
+
+    destroy_now(rt);
+}
+
+extern "C" void hermes_runtime_retire(HermesRuntime rt) {
+    if (!rt) {
+        return;
+    }
+    destroy_now(rt);
+}
+
+extern "C" uint64_t hermes_runtime_teardown_count(void) {
+    return teardown_count.load(std::memory_order_relaxed);
+}
+
+extern "C" size_t hermes_runtime_prewarm(size_t count) {
+    auto& pool = spares();
+    size_t missing = 0;
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.capacity = std::max(pool.capacity, count);
+        missing = count > pool.runtimes.size() ? count - pool.runtimes.size() : 0;
+    }
+
+    // Initialize the missing runtimes in parallel; each is independent.
+    std::vector<HermesRuntimeImpl*> created(missing, nullptr);
+    std::vector<std::thread> threads;
+    threads.reserve(missing);
+    for (size_t i = 0; i < missing; i++) {
+        threads.emplace_back([&created, i] { created[i] = create_cold(); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto* rt : created) {
+        if (rt && !park(rt)) {
+            destroy_now(rt);
+        }
+    }
+
+    return hermes_runtime_spare_count();
+}
+
+extern "C" void hermes_runtime_set_spare_capacity(size_t capacity) {
+    std::vector<HermesRuntimeImpl*> excess;
+    {
+        auto& pool = spares();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.capacity = capacity;
+        while (pool.runtimes.size() > capacity) {
+            excess.push_back(pool.runtimes.back());
+            pool.runtimes.pop_back();
+        }
+    }
+
+    for (auto* rt : excess) {
+        destroy_now(rt);
+    }
+}
+
+extern "C" size_t hermes_runtime_spare_count(void) {
+    auto& pool = spares();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    return pool.runtimes.size();
+}
+
+// ============================================================================
+// Memory
+// ============================================================================
+
+extern "C" void hermes_runtime_collect_garbage(HermesRuntime rt) {
+    if (!rt) {
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    rt->runtime().instrumentation().collectGarbage("hermes_runtime_collect_garbage");
+    std::chrono::duration<double, std::milli> pause = std::chrono::steady_clock::now() - start;
+
+    rt->explicit_gc_count++;
+    rt->last_gc_pause_ms = pause.count();
+    rt->total_gc_pause_ms += pause.count();
+}
+
+extern "C" bool hermes_runtime_heap_stats(HermesRuntime rt, HermesHeapStats* out) {
+    if (!rt || !out) {
+        return false;
+    }
+
+    auto info = rt->runtime().instrumentation().getHeapInfo(false);
+    auto read = [&info](const char* key) -> int64_t {
+        auto it = info.find(key);
+        return it == info.end() || it->second < 0 ? 0 : it->second;
+    };
+
+    out->allocated_bytes = static_cast<size_t>(read("hermes_allocatedBytes"));
+    out->heap_size = static_cast<size_t>(read("hermes_heapSize"));
+    out->external_bytes = static_cast<size_t>(read("hermes_externalBytes"));
+    out->total_allocated_bytes = static_cast<uint64_t>(read("hermes_totalAllocatedBytes"));
+    out->gc_count = static_cast<uint64_t>(read("hermes_numCollections"));
+    out->explicit_gc_count = rt->explicit_gc_count;
+    out->last_gc_pause_ms = rt->last_gc_pause_ms;
+    out->total_gc_pause_ms = rt->total_gc_pause_ms;
+    return true;
+}
+
+// ============================================================================
+// Compiler Units
+// ============================================================================
+
+extern "C" bool hermes_runtime_split_units_enabled(void) {
+#ifdef VUE_SPLIT_UNITS
+    return true;
+#else
+    return false;
+#endif
+}
+
+extern "C" uint32_t hermes_runtime_loaded_units(HermesRuntime rt) {
+    if (!rt) {
+        return 0;
+    }
+    return rt->loaded_units;
+}
+
+// ============================================================================
+// Instrumentation
+// ============================================================================
+
+extern "C" bool hermes_runtime_stats_enabled(void) {
+#ifdef VUE_FFI_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+extern "C" bool hermes_runtime_stats(HermesRuntime rt, HermesRuntimeStats* out) {
+    if (!rt || !out) {
+        return false;
+    }
+    *out = rt->stats;
+    return true;
+}
+
+extern "C" void hermes_runtime_stats_reset(HermesRuntime rt) {
+    if (!rt) {
+        return;
+    }
+    rt->stats = HermesRuntimeStats{};
+}
+
+// ============================================================================
+// Profiling
+// ============================================================================
+
+extern "C" bool hermes_runtime_profile_start(HermesRuntime rt, double sample_hz) {
+    if (!rt || (rt->profile && rt->profile->recording)) {
+        return false;
+    }
+
+    auto profile = std::make_unique<RuntimeProfile>();
+    if (sample_hz > 0) {
+        if (!start_sampling(rt, sample_hz)) {
+            return false;
+        }
+        profile->sampling = true;
+    }
+    profile->recording = true;
+    profile->start_ns = trace_now_ns();
+    rt->profile = std::move(profile);
+    return true;
+}
+
+extern "C" const char* hermes_runtime_profile_stop(HermesRuntime rt, size_t* out_len) {
+    if (!rt || !out_len || !rt->profile || !rt->profile->recording) {
+        return nullptr;
+    }
+
+    auto& profile = *rt->profile;
+    profile.recording = false;
+    profile.stop_ns = trace_now_ns();
+    std::string samples;
+    if (profile.sampling) {
+        samples = stop_sampling(rt);
+        profile.sampling = false;
+    }
+    profile.trace = chrome_trace(profile, samples);
+    profile.spans = {};
+
+    *out_len = profile.trace.size();
+    return profile.trace.c_str();
+}
+
 // ============================================================================
 // Handle Management
 // ============================================================================
@@ -84,3 +661,24 @@ extern "C" void hermes_handle_free(HermesRuntime rt, HermesHandle handle) {
     }
     rt->free_handle(handle);
 }
+
+extern "C" bool hermes_handle_is_live(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return false;
+    }
+    return rt->get_handle(handle) != nullptr;
+}
+
+extern "C" HermesHandleScope hermes_handle_scope_open(HermesRuntime rt) {
+    if (!rt) {
+        return 0;
+    }
+    return rt->open_scope();
+}
+
+extern "C" void hermes_handle_scope_close(HermesRuntime rt, HermesHandleScope scope) {
+    if (!rt) {
+        return;
+    }
+    rt->close_scope(scope);
+}
@@ -36,22 +36,162 @@ extern "C" {
  * table. They provide a way to pass JS objects across the FFI boundary.
  *
  * - Handle 0 represents invalid/null
- * - Non-zero values are 1-indexed into the handle table
+ * - The low 32 bits are a 1-indexed slot in the handle table
+ * - The high 32 bits are the slot's generation, which changes when the slot
+ *   is freed, so a stale handle is rejected instead of aliasing a new value
  */
 typedef uint64_t HermesHandle;
 
+/**
+ * Token for an open handle scope (see hermes_handle_scope_open()).
+ *
+ * 0 represents invalid/null.
+ */
+typedef uint64_t HermesHandleScope;
+
 /**
  * Opaque pointer to a Hermes runtime instance.
  *
  * The internal structure contains:
  * - SHRuntime* (Static Hermes runtime)
  * - HermesRuntime* (JSI runtime)
- * - Handle table (vector of JS Values)
+ * - Handle table (chunked slab of JS Values)
  * - Free list for handle reuse
  * - Cached Vue compiler function references
  */
 typedef struct HermesRuntimeImpl* HermesRuntime;
 
+/**
+ * Compiler units: the parts of the bundled compiler a runtime initializes
+ * (see HermesRuntimeOptions::units and hermes_runtime_loaded_units()).
+ *
+ * - PARSE: vue_parse() and descriptor rehydration
+ * - SCRIPT: script compilation and dependency scans
+ * - TEMPLATE: template compilation
+ * - STYLE: style compilation through the JS compiler
+ *
+ * The SFC pipeline entry points need all four.
+ */
+#define VUE_UNIT_PARSE    (1u << 0)
+#define VUE_UNIT_SCRIPT   (1u << 1)
+#define VUE_UNIT_TEMPLATE (1u << 2)
+#define VUE_UNIT_STYLE    (1u << 3)
+#define VUE_UNIT_ALL      (0xFu)
+
+/**
+ * Heap and GC configuration for hermes_runtime_configure_process().
+ *
+ * Static Hermes reads these as command line options on the first runtime
+ * initialization of the process and applies them to every runtime, so they
+ * cannot differ between runtimes. Zero-initialize and set the fields you
+ * need; 0 / NULL keep the Static Hermes defaults.
+ */
+typedef struct HermesProcessOptions {
+    /** Initial GC heap size of each runtime in bytes (0 = default). */
+    size_t init_heap_bytes;
+    /**
+     * Maximum GC heap size of each runtime in bytes (0 = default).
+     * Allocation past the cap fails with a JS out-of-memory error for that
+     * call instead of growing the process.
+     */
+    size_t max_heap_bytes;
+    /**
+     * Further Static Hermes VM flags for GC tuning, in command line form
+     * (e.g. "-gc-alloc-young=false"). May be NULL when vm_flag_count is 0.
+     * Passed to Static Hermes unchecked: its option parser may exit the
+     * process on an unknown flag.
+     */
+    const char* const* vm_flags;
+    size_t vm_flag_count;
+} HermesProcessOptions;
+
+/**
+ * Per-runtime configuration for hermes_runtime_create_with_options().
+ *
+ * Zero-initialize and set the fields you need.
+ */
+typedef struct HermesRuntimeOptions {
+    /**
+     * Compiler units to initialize at creation (VUE_UNIT_* bits, 0 = all).
+     * Entry points that need a unit the runtime has not loaded load it on
+     * first use, so any subset is safe; a worker that only compiles
+     * templates can skip the script compiler and its parser entirely.
+     * Only honored by builds with VUE_SPLIT_UNITS (the `split-units` cargo
+     * feature), which ship one unit per part; other builds always load the
+     * whole compiler.
+     */
+    uint32_t units;
+} HermesRuntimeOptions;
+
+/**
+ * Heap statistics of one runtime (see hermes_runtime_heap_stats()).
+ */
+typedef struct HermesHeapStats {
+    /** Bytes currently allocated in the JS heap. */
+    size_t allocated_bytes;
+    /** Current size of the JS heap, including free space. */
+    size_t heap_size;
+    /** Native memory retained by JS objects outside the heap. */
+    size_t external_bytes;
+    /** Bytes allocated over the runtime's lifetime. */
+    uint64_t total_allocated_bytes;
+    /** Collections run by the GC, including explicit ones. */
+    uint64_t gc_count;
+    /** Collections requested with hermes_runtime_collect_garbage(). */
+    uint64_t explicit_gc_count;
+    /** Pause of the last explicit collection, in milliseconds. */
+    double last_gc_pause_ms;
+    /** Total pause of all explicit collections, in milliseconds. */
+    double total_gc_pause_ms;
+} HermesHeapStats;
+
+/**
+ * Calls and time spent in one instrumented phase.
+ */
+typedef struct VuePhaseStats {
+    uint64_t calls;
+    uint64_t nanos;
+} VuePhaseStats;
+
+/**
+ * Instrumentation counters of one runtime (see hermes_runtime_stats()).
+ *
+ * Counters are only maintained when the library is built with
+ * VUE_FFI_STATS (the `stats` cargo feature); otherwise they stay zero and
+ * the instrumentation compiles to nothing.
+ *
+ * Compile phases time the JS call alone, so argument conversion and result
+ * reads are not included; those show up in bytes_in and marshal_out.
+ */
+typedef struct HermesRuntimeStats {
+    /** vue_parse() and vue_parse_borrowed(). */
+    VuePhaseStats parse;
+    /** vue_compile_script(). */
+    VuePhaseStats compile_script;
+    /** vue_compile_template() and vue_compile_template_from_descriptor(). */
+    VuePhaseStats compile_template;
+    /**
+     * vue_compile_style() and vue_compile_style_from_descriptor(), when
+     * they fall through to the JS compiler (native_style rewrites are not
+     * JS calls and are not timed).
+     */
+    VuePhaseStats compile_style;
+    /** vue_compile_sfc(), vue_compile_sfc_incremental() and vue_compile_batch(). */
+    VuePhaseStats compile_sfc;
+    /** The batch script import scan of vue_scan_dependencies(). */
+    VuePhaseStats scan_dependencies;
+    /** Accessor calls (property reads, string conversion and copies). */
+    VuePhaseStats marshal_out;
+    /** UTF-8 bytes of sources, filenames and ids passed into JS. */
+    uint64_t bytes_in;
+    /** UTF-8 bytes converted out of the JS heap. */
+    uint64_t bytes_out;
+    /** Handles allocated, including ones since freed. */
+    uint64_t handles_allocated;
+    /** Bytes copied into handle string storage, including terminators. */
+    uint64_t string_bytes;
+} HermesRuntimeStats;
+
 // ============================================================================
 // Runtime Lifecycle
 // ============================================================================
@@ -59,7 +199,8 @@ typedef struct HermesRuntimeImpl* HermesRuntime;
 /**
  * Creates a new Hermes runtime instance.
  *
- * This function:
+ * If a spare runtime is available (see hermes_runtime_prewarm()), it is
+ * handed out immediately. Otherwise this function:
  * 1. Initializes a fresh Static Hermes runtime
  * 2. Loads the Vue compiler unit
  * 3. Caches references to Vue compiler functions (parse, compileScript, etc.)
@@ -71,16 +212,197 @@ typedef struct HermesRuntimeImpl* HermesRuntime;
  */
 HermesRuntime hermes_runtime_create(void);
 
+/**
+ * Creates a runtime that initializes only some compiler units up front.
+ *
+ * Always initializes a fresh runtime rather than taking a spare, which has
+ * every unit loaded. The runtime may still be parked by
+ * hermes_runtime_destroy(): units it skipped load on first use.
+ *
+ * @param options Configuration, or NULL for defaults (then equivalent to
+ *                hermes_runtime_create()).
+ * @return Pointer to the runtime, or NULL on failure.
+ */
+HermesRuntime hermes_runtime_create_with_options(const HermesRuntimeOptions* options);
+
+/**
+ * Sets the heap and GC configuration of every runtime of the process.
+ *
+ * Must be called before the first runtime is created (including spares from
+ * hermes_runtime_prewarm() and pool workers): Static Hermes applies VM
+ * options once, on the first initialization. May be called several times
+ * until then; the last call wins.
+ *
+ * @param options Configuration; only needs to stay valid during the call.
+ * @return false if options is NULL or a runtime was already initialized.
+ */
+bool hermes_runtime_configure_process(const HermesProcessOptions* options);
+
 /**
  * Destroys a Hermes runtime and releases all resources.
  *
  * All handles created by this runtime become invalid after this call.
+ * If the spare capacity is not reached, the runtime is parked with an empty
+ * handle table and reused by a later hermes_runtime_create(). Otherwise it
+ * is torn down with _sh_done(), which frees its whole heap.
  * Safe to call with NULL (no-op).
  *
  * @param rt The runtime to destroy.
  */
 void hermes_runtime_destroy(HermesRuntime rt);
 
+/**
+ * Tears a runtime down for good, even if it could be parked as a spare.
+ *
+ * Use it for a runtime whose heap has grown, e.g. when recycling: a parked
+ * runtime keeps its heap at the size it reached. May be called from any
+ * thread that is not using the runtime. Safe to call with NULL (no-op).
+ *
+ * @param rt The runtime to tear down.
+ */
+void hermes_runtime_retire(HermesRuntime rt);
+
+/**
+ * Returns the number of runtimes torn down with _sh_done() so far in this
+ * process, by hermes_runtime_destroy() or hermes_runtime_retire(). Parked
+ * spares are not counted.
+ */
+uint64_t hermes_runtime_teardown_count(void);
+
+// ============================================================================
+// Memory
+// ============================================================================
+
+/**
+ * Runs a full garbage collection now.
+ *
+ * Intended between batches, when live handles are few: JS values still held
+ * by handles are kept alive. The pause is recorded in HermesHeapStats.
+ *
+ * @param rt The runtime. No-op if NULL.
+ */
+void hermes_runtime_collect_garbage(HermesRuntime rt);
+
+/**
+ * Reads heap statistics of a runtime.
+ *
+ * @return false if rt or out is NULL.
+ */
+bool hermes_runtime_heap_stats(HermesRuntime rt, HermesHeapStats* out);
+
+// ============================================================================
+// Compiler Units
+// ============================================================================
+
+/**
+ * Returns true if the library was built with separately loadable compiler
+ * units (VUE_SPLIT_UNITS).
+ */
+bool hermes_runtime_split_units_enabled(void);
+
+/**
+ * Returns the compiler units a runtime has initialized so far (VUE_UNIT_*
+ * bits), or 0 if rt is NULL. Without VUE_SPLIT_UNITS this is always
+ * VUE_UNIT_ALL.
+ */
+uint32_t hermes_runtime_loaded_units(HermesRuntime rt);
+
+// ============================================================================
+// Instrumentation
+// ============================================================================
+
+/**
+ * Returns true if the library was built with instrumentation (VUE_FFI_STATS).
+ */
+bool hermes_runtime_stats_enabled(void);
+
+/**
+ * Reads the instrumentation counters of a runtime.
+ *
+ * Counters accumulate from hermes_runtime_create() (a parked spare starts
+ * from zero) until hermes_runtime_stats_reset().
+ *
+ * @return false if rt or out is NULL.
+ */
+bool hermes_runtime_stats(HermesRuntime rt, HermesRuntimeStats* out);
+
+/**
+ * Zeroes the instrumentation counters of a runtime. No-op if rt is NULL.
+ */
+void hermes_runtime_stats_reset(HermesRuntime rt);
+
+// ============================================================================
+// Profiling
+// ============================================================================
+
+/**
+ * Starts profiling a runtime.
+ *
+ * Until hermes_runtime_profile_stop(), every FFI entry point called on the
+ * runtime is recorded as a span. Spans are available in every build, not
+ * only with VUE_FFI_STATS; while no profile records, they cost one branch
+ * per call.
+ *
+ * With sample_hz > 0 the runtime is also registered with the Hermes
+ * sampling profiler, which records JS stacks of the compiler. The sampler
+ * is process-wide: its rate is set by the first runtime to start sampling
+ * and kept until the last one stops. Call from the runtime's thread.
+ *
+ * Starting discards the trace of a previous profile.
+ *
+ * @param rt The runtime.
+ * @param sample_hz Mean sampling frequency, or 0 to record spans only.
+ * @return false if rt is NULL, a profile is already recording, or sampling
+ *         was requested but this Hermes build has no sampling profiler.
+ */
+bool hermes_runtime_profile_start(HermesRuntime rt, double sample_hz);
+
+/**
+ * Stops profiling a runtime and exports the profile.
+ *
+ * The trace is Chrome trace event JSON, loadable in Perfetto and the
+ * Chrome DevTools performance panel. Spans are complete ("X") events named
+ * after the entry point. When sampling, the JS samples are a "CpuProfile"
+ * event holding the Hermes profile in DevTools format. Timestamps are steady
+ * clock microseconds, the clock the Hermes sampler uses.
+ *
+ * @param rt The runtime.
+ * @param out_len Receives the trace length in bytes.
+ * @return The trace, owned by the runtime and valid until the next
+ *         hermes_runtime_profile_start() or hermes_runtime_destroy(); NULL
+ *         if rt or out_len is NULL or no profile is recording.
+ */
+const char* hermes_runtime_profile_stop(HermesRuntime rt, size_t* out_len);
+
+// ============================================================================
+// Warm Start
+// ============================================================================
+
+/**
+ * Initializes spare runtimes ahead of time.
+ *
+ * Creates runtimes in parallel until `count` spares are available, and
+ * raises the spare capacity to at least `count`. Subsequent
+ * hermes_runtime_create() calls take a spare instead of paying for unit
+ * initialization. Thread-safe.
+ *
+ * @param count Number of spare runtimes to keep ready.
+ * @return Number of spare runtimes available afterwards.
+ */
+size_t hermes_runtime_prewarm(size_t count);
+
+/**
+ * Sets how many destroyed runtimes are parked for reuse (default 0).
+ *
+ * Spares beyond the new capacity are destroyed. Thread-safe.
+ */
+void hermes_runtime_set_spare_capacity(size_t capacity);
+
+/**
+ * Gets the number of spare runtimes currently available. Thread-safe.
+ */
+size_t hermes_runtime_spare_count(void);
+
 // ============================================================================
 // Handle Management
 // ============================================================================
@@ -108,6 +430,40 @@ static inline bool hermes_handle_is_valid(HermesHandle handle) {
     return handle != 0;
 }
 
+/**
+ * Checks if a handle refers to a live value in the runtime.
+ *
+ * Returns false for 0, for handles that were freed (directly or by closing
+ * their scope) and for handles from another runtime's slot range.
+ */
+bool hermes_handle_is_live(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Opens a handle scope.
+ *
+ * Every handle allocated while the scope is open belongs to it and is freed
+ * by hermes_handle_scope_close(), so a whole compilation can be cleaned up in
+ * one call instead of one hermes_handle_free() per handle. Freeing a handle
+ * individually before the scope closes is allowed.
+ *
+ * Scopes nest: a handle belongs to every scope open at its allocation.
+ *
+ * @param rt The runtime.
+ * @return Scope token, or 0 if rt is NULL.
+ */
+HermesHandleScope hermes_handle_scope_open(HermesRuntime rt);
+
+/**
+ * Closes a handle scope and frees its live handles.
+ *
+ * Scopes opened inside it that are still open are closed as well. Closing a
+ * scope that is already closed is a no-op.
+ *
+ * @param rt The runtime that opened the scope.
+ * @param scope Token from hermes_handle_scope_open().
+ */
+void hermes_handle_scope_close(HermesRuntime rt, HermesHandleScope scope);
+
 #ifdef __cplusplus
 }
 #endif
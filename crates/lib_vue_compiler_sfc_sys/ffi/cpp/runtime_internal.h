@@ -10,8 +10,16 @@
 #define HERMES_RUNTIME_INTERNAL_H
 
 #include "runtime.h"
+#include "vue_sfc.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -19,20 +27,414 @@
 #include <hermes/hermes.h>
 #include <jsi/jsi.h>
 
+// ============================================================================
+// Instrumentation
+// ============================================================================
+//
+// Built with VUE_FFI_STATS, the macros below update HermesRuntimeImpl::stats;
+// otherwise they expand to nothing, so instrumented code costs nothing in
+// default builds.
+
+/**
+ * Adds the time until the end of the enclosing scope to a phase.
+ */
+class PhaseTimer {
+public:
+    explicit PhaseTimer(VuePhaseStats& phase)
+        : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        phase_.calls++;
+        phase_.nanos += static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    VuePhaseStats& phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+/// Evaluates `call` (a JS call) and returns its result, timed as `phase`.
+template <typename Call>
+auto timed_call(VuePhaseStats& phase, Call&& call) {
+    PhaseTimer timer(phase);
+    return call();
+}
+
+#ifdef VUE_FFI_STATS
+#define VUE_STATS_CONCAT_INNER(a, b) a##b
+#define VUE_STATS_CONCAT(a, b) VUE_STATS_CONCAT_INNER(a, b)
+/// Times the rest of the enclosing scope as `phase` of rt's stats.
+#define VUE_STATS_SCOPE(rt, phase) \
+    PhaseTimer VUE_STATS_CONCAT(vue_stats_timer_, __LINE__)((rt)->stats.phase)
+/// Evaluates the expression after `phase`, timed as that phase.
+#define VUE_STATS_CALL(rt, phase, ...) \
+    timed_call((rt)->stats.phase, [&]() { return __VA_ARGS__; })
+/// Adds n to a counter of rt's stats.
+#define VUE_STATS_ADD(rt, field, n) ((rt)->stats.field += (n))
+#else
+#define VUE_STATS_SCOPE(rt, phase) ((void)0)
+#define VUE_STATS_CALL(rt, phase, ...) (__VA_ARGS__)
+#define VUE_STATS_ADD(rt, field, n) ((void)0)
+#endif
+
+// ============================================================================
+// Tracing
+// ============================================================================
+//
+// Unlike the counters above, spans are compiled into every build so
+// production binaries can be profiled: while no profile is recording, a span
+// costs one branch.
+
+/**
+ * One FFI call recorded by a profile. Times are steady clock nanoseconds.
+ */
+struct TraceSpanEvent {
+    /// `__func__` of the entry point.
+    const char* name;
+    uint64_t start_ns;
+    uint64_t dur_ns;
+};
+
+/**
+ * A profile of one runtime (see hermes_runtime_profile_start()).
+ */
+struct RuntimeProfile {
+    /// Spans kept per profile; later ones are counted in `dropped`.
+    static constexpr size_t kMaxSpans = size_t{1} << 20;
+
+    bool recording = false;
+    /// The runtime is registered with the Hermes sampling profiler.
+    bool sampling = false;
+    uint64_t start_ns = 0;
+    uint64_t stop_ns = 0;
+    std::vector<TraceSpanEvent> spans;
+    uint64_t dropped = 0;
+    /// The exported Chrome trace, set when the profile stops.
+    std::string trace;
+};
+
+/// Steady clock time in nanoseconds.
+inline uint64_t trace_now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Records the enclosing scope as a span of a recording profile.
+ */
+class TraceSpan {
+public:
+    TraceSpan(RuntimeProfile* profile, const char* name)
+        : profile_(profile && profile->recording ? profile : nullptr), name_(name) {
+        if (profile_) {
+            start_ns_ = trace_now_ns();
+        }
+    }
+
+    ~TraceSpan() {
+        if (!profile_) {
+            return;
+        }
+        if (profile_->spans.size() < RuntimeProfile::kMaxSpans) {
+            profile_->spans.push_back(TraceSpanEvent{name_, start_ns_, trace_now_ns() - start_ns_});
+        } else {
+            profile_->dropped++;
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    RuntimeProfile* profile_;
+    const char* name_;
+    uint64_t start_ns_ = 0;
+};
+
+#define VUE_TRACE_CONCAT_INNER(a, b) a##b
+#define VUE_TRACE_CONCAT(a, b) VUE_TRACE_CONCAT_INNER(a, b)
+/// Records the rest of the enclosing FFI entry point as a span of rt's
+/// profile. rt may be NULL.
+#define VUE_TRACE_SPAN(rt) \
+    TraceSpan VUE_TRACE_CONCAT(vue_trace_span_, __LINE__)( \
+        (rt) ? (rt)->profile.get() : nullptr, __func__)
+
+/**
+ * Interned property names for every field the FFI reads or writes.
+ *
+ * getProperty() with a C string makes Hermes create and intern the name on
+ * each call. These are created once per runtime and shared by all accessors.
+ */
+struct PropNames {
+    explicit PropNames(facebook::jsi::Runtime& rt)
+        : ast(facebook::jsi::PropNameID::forAscii(rt, "ast")),
+          attrs(facebook::jsi::PropNameID::forAscii(rt, "attrs")),
+          bindings(facebook::jsi::PropNameID::forAscii(rt, "bindings")),
+          code(facebook::jsi::PropNameID::forAscii(rt, "code")),
+          column(facebook::jsi::PropNameID::forAscii(rt, "column")),
+          content(facebook::jsi::PropNameID::forAscii(rt, "content")),
+          content_is_slice(facebook::jsi::PropNameID::forAscii(rt, "contentIsSlice")),
+          css(facebook::jsi::PropNameID::forAscii(rt, "css")),
+          css_vars(facebook::jsi::PropNameID::forAscii(rt, "cssVars")),
+          custom_blocks(facebook::jsi::PropNameID::forAscii(rt, "customBlocks")),
+          dependencies(facebook::jsi::PropNameID::forAscii(rt, "dependencies")),
+          deps(facebook::jsi::PropNameID::forAscii(rt, "deps")),
+          descriptor(facebook::jsi::PropNameID::forAscii(rt, "descriptor")),
+          dirty(facebook::jsi::PropNameID::forAscii(rt, "dirty")),
+          end(facebook::jsi::PropNameID::forAscii(rt, "end")),
+          errors(facebook::jsi::PropNameID::forAscii(rt, "errors")),
+          filename(facebook::jsi::PropNameID::forAscii(rt, "filename")),
+          imported(facebook::jsi::PropNameID::forAscii(rt, "imported")),
+          imports(facebook::jsi::PropNameID::forAscii(rt, "imports")),
+          inline_template(facebook::jsi::PropNameID::forAscii(rt, "inlineTemplate")),
+          is_from_setup(facebook::jsi::PropNameID::forAscii(rt, "isFromSetup")),
+          is_type(facebook::jsi::PropNameID::forAscii(rt, "isType")),
+          js(facebook::jsi::PropNameID::forAscii(rt, "js")),
+          lang(facebook::jsi::PropNameID::forAscii(rt, "lang")),
+          line(facebook::jsi::PropNameID::forAscii(rt, "line")),
+          loc(facebook::jsi::PropNameID::forAscii(rt, "loc")),
+          local(facebook::jsi::PropNameID::forAscii(rt, "local")),
+          map(facebook::jsi::PropNameID::forAscii(rt, "map")),
+          message(facebook::jsi::PropNameID::forAscii(rt, "message")),
+          module(facebook::jsi::PropNameID::forAscii(rt, "module")),
+          offset(facebook::jsi::PropNameID::forAscii(rt, "offset")),
+          preamble(facebook::jsi::PropNameID::forAscii(rt, "preamble")),
+          render(facebook::jsi::PropNameID::forAscii(rt, "render")),
+          scoped(facebook::jsi::PropNameID::forAscii(rt, "scoped")),
+          script(facebook::jsi::PropNameID::forAscii(rt, "script")),
+          script_setup(facebook::jsi::PropNameID::forAscii(rt, "scriptSetup")),
+          setup(facebook::jsi::PropNameID::forAscii(rt, "setup")),
+          slotted(facebook::jsi::PropNameID::forAscii(rt, "slotted")),
+          source(facebook::jsi::PropNameID::forAscii(rt, "source")),
+          src(facebook::jsi::PropNameID::forAscii(rt, "src")),
+          start(facebook::jsi::PropNameID::forAscii(rt, "start")),
+          styles(facebook::jsi::PropNameID::forAscii(rt, "styles")),
+          template_block(facebook::jsi::PropNameID::forAscii(rt, "template")),
+          tips(facebook::jsi::PropNameID::forAscii(rt, "tips")),
+          type(facebook::jsi::PropNameID::forAscii(rt, "type")),
+          warnings(facebook::jsi::PropNameID::forAscii(rt, "warnings")),
+          is_prod(facebook::jsi::PropNameID::forAscii(rt, "isProd")),
+          ssr(facebook::jsi::PropNameID::forAscii(rt, "ssr")),
+          source_map(facebook::jsi::PropNameID::forAscii(rt, "sourceMap")),
+          keep_ast(facebook::jsi::PropNameID::forAscii(rt, "keepAst")),
+          keep_preamble(facebook::jsi::PropNameID::forAscii(rt, "keepPreamble")),
+          keep_tips(facebook::jsi::PropNameID::forAscii(rt, "keepTips")) {}
+
+    // Parse results, descriptors and blocks
+    facebook::jsi::PropNameID ast;
+    facebook::jsi::PropNameID attrs;
+    facebook::jsi::PropNameID bindings;
+    facebook::jsi::PropNameID code;
+    facebook::jsi::PropNameID column;
+    facebook::jsi::PropNameID content;
+    facebook::jsi::PropNameID content_is_slice;
+    facebook::jsi::PropNameID css;
+    facebook::jsi::PropNameID css_vars;
+    facebook::jsi::PropNameID custom_blocks;
+    facebook::jsi::PropNameID dependencies;
+    facebook::jsi::PropNameID deps;
+    facebook::jsi::PropNameID descriptor;
+    facebook::jsi::PropNameID dirty;
+    facebook::jsi::PropNameID end;
+    facebook::jsi::PropNameID errors;
+    facebook::jsi::PropNameID filename;
+    facebook::jsi::PropNameID imported;
+    facebook::jsi::PropNameID imports;
+    facebook::jsi::PropNameID inline_template;
+    facebook::jsi::PropNameID is_from_setup;
+    facebook::jsi::PropNameID is_type;
+    facebook::jsi::PropNameID js;
+    facebook::jsi::PropNameID lang;
+    facebook::jsi::PropNameID line;
+    facebook::jsi::PropNameID loc;
+    facebook::jsi::PropNameID local;
+    facebook::jsi::PropNameID map;
+    facebook::jsi::PropNameID message;
+    facebook::jsi::PropNameID module;
+    facebook::jsi::PropNameID offset;
+    facebook::jsi::PropNameID preamble;
+    facebook::jsi::PropNameID render;
+    facebook::jsi::PropNameID scoped;
+    facebook::jsi::PropNameID script;
+    facebook::jsi::PropNameID script_setup;
+    facebook::jsi::PropNameID setup;
+    facebook::jsi::PropNameID slotted;
+    facebook::jsi::PropNameID source;
+    facebook::jsi::PropNameID src;
+    facebook::jsi::PropNameID start;
+    facebook::jsi::PropNameID styles;
+    facebook::jsi::PropNameID template_block;
+    facebook::jsi::PropNameID tips;
+    facebook::jsi::PropNameID type;
+    facebook::jsi::PropNameID warnings;
+
+    // Compile options (written by make_compile_options)
+    facebook::jsi::PropNameID is_prod;
+    facebook::jsi::PropNameID ssr;
+    facebook::jsi::PropNameID source_map;
+    facebook::jsi::PropNameID keep_ast;
+    facebook::jsi::PropNameID keep_preamble;
+    facebook::jsi::PropNameID keep_tips;
+};
+
+/**
+ * Backing storage for a VueDescriptorSnapshot.
+ *
+ * The view's pointers refer into the containers below, which are filled once
+ * and never resized afterwards.
+ */
+struct DescriptorSnapshot {
+    /// The flat C view handed out through the FFI.
+    VueDescriptorSnapshot view{};
+
+    /// String storage. A deque keeps element addresses stable on push_back.
+    std::deque<std::string> strings;
+
+    /// Template, script, script setup, styles and custom blocks, in that order.
+    std::vector<VueBlockSnapshot> blocks;
+
+    /// Attributes of all blocks, referenced by range from each block.
+    std::vector<VueBlockAttr> attrs;
+
+    /// CSS variable names.
+    std::vector<VueStr> css_vars;
+};
+
+/**
+ * Caller-owned source buffer a handle was parsed from (borrowed parse mode).
+ */
+struct BorrowedSource {
+    const char* data = nullptr;
+    size_t len = 0;
+};
+
+/**
+ * Per-handle storage for strings returned by accessors.
+ *
+ * Strings are memoized by (accessor, index): querying the same accessor again
+ * returns the same pointer without touching the JS heap, so the arena holds
+ * at most one copy per distinct query. Bytes live in chunks that never move,
+ * so returned pointers stay valid until the arena is cleared.
+ */
+class StringArena {
+public:
+    /**
+     * Returns the string stored for (accessor, index), or nullptr.
+     *
+     * @param accessor Identifies the accessor; callers pass `__func__`.
+     * @param index Element index for *_at accessors, 0 otherwise.
+     */
+    const char* find(const void* accessor, size_t index) const {
+        auto it = memo_.find(Key{accessor, index});
+        return it == memo_.end() ? nullptr : it->second;
+    }
+
+    /**
+     * Copies a string into the arena and memoizes it for (accessor, index).
+     *
+     * @return Null-terminated copy, valid until clear().
+     */
+    const char* store(const void* accessor, size_t index, const std::string& str) {
+        size_t needed = str.size() + 1;
+        if (chunks_.empty() || chunk_capacity_ - chunk_used_ < needed) {
+            chunk_capacity_ = std::max({kMinChunkSize, chunk_capacity_ * 2, needed});
+            chunks_.push_back(std::make_unique<char[]>(chunk_capacity_));
+            chunk_used_ = 0;
+        }
+
+        char* dest = chunks_.back().get() + chunk_used_;
+        std::memcpy(dest, str.c_str(), needed);
+        chunk_used_ += needed;
+
+        memo_[Key{accessor, index}] = dest;
+#ifdef VUE_FFI_STATS
+        if (stats) {
+            stats->string_bytes += needed;
+            stats->bytes_out += str.size();
+        }
+#endif
+        return dest;
+    }
+
+    /// Runtime counters to update on store(); set by the owning runtime.
+    HermesRuntimeStats* stats = nullptr;
+
+    /// Releases all strings and chunks.
+    void clear() {
+        memo_.clear();
+        chunks_.clear();
+        chunk_capacity_ = 0;
+        chunk_used_ = 0;
+    }
+
+private:
+    static constexpr size_t kMinChunkSize = 256;
+
+    struct Key {
+        const void* accessor;
+        size_t index;
+
+        bool operator==(const Key& other) const {
+            return accessor == other.accessor && index == other.index;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<const void*>()(key.accessor) ^ (key.index * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    std::unordered_map<Key, const char*, KeyHash> memo_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    size_t chunk_capacity_ = 0;
+    size_t chunk_used_ = 0;
+};
+
 /**
  * Entry in the handle table.
  *
  * Each entry contains:
- * - value: The JSI Value wrapped in a shared_ptr for safe copying
- * - cached_strings: Cached string extractions (owned by this entry)
+ * - value: The JSI Value, stored inline (empty while the slot is free)
+ * - strings: Memoized accessor strings (owned by this entry)
+ * - snapshot: Materialized descriptor view (descriptor handles only)
+ * - encoded: Binary descriptor from vue_descriptor_serialize() (descriptor
+ *   handles only)
+ * - borrowed: Caller's source buffer, set by vue_parse_borrowed()
+ * - generation: Bumped on free; must match the handle's high 32 bits
  */
 struct HandleEntry {
     /// The JavaScript value this handle refers to.
-    std::shared_ptr<facebook::jsi::Value> value;
+    std::optional<facebook::jsi::Value> value;
+
+    /// Strings returned by accessors on this handle, valid until it is freed.
+    StringArena strings;
+
+    /// Descriptor snapshot built by vue_descriptor_materialize(), if any.
+    std::unique_ptr<DescriptorSnapshot> snapshot;
+
+    /// Binary descriptor built by vue_descriptor_serialize(), if any.
+    std::unique_ptr<std::vector<uint8_t>> encoded;
+
+    /// Source buffer that snapshot strings may point into instead of copying.
+    BorrowedSource borrowed;
 
-    /// Cached string values extracted from this object.
-    /// Strings are stored here so their pointers remain valid until the handle is freed.
-    std::vector<std::string> cached_strings;
+    /// Current generation of this slot.
+    uint32_t generation = 1;
+};
+
+/**
+ * An open handle scope: its token and where its handles start in
+ * HermesRuntimeImpl::scoped_handles.
+ */
+struct HandleScopeFrame {
+    HermesHandleScope token;
+    size_t mark;
 };
 
 /**
@@ -43,92 +445,199 @@ struct HermesRuntimeImpl {
     SHRuntime* sh_runtime;
     facebook::hermes::HermesRuntime* jsi_runtime;
 
-    // Handle table
-    std::vector<HandleEntry> handles;
-    std::vector<uint64_t> free_list;
+    // Instrumentation counters (updated only with VUE_FFI_STATS)
+    HermesRuntimeStats stats{};
+
+    // Profile started by hermes_runtime_profile_start(), if any
+    std::unique_ptr<RuntimeProfile> profile;
+
+    // Explicit collections (hermes_runtime_collect_garbage)
+    uint64_t explicit_gc_count = 0;
+    double last_gc_pause_ms = 0;
+    double total_gc_pause_ms = 0;
+
+    // Handle table: fixed-size chunks, so entry addresses never change as
+    // the table grows and values are stored without a separate allocation.
+    static constexpr size_t kHandleChunkSize = 256;
+    std::vector<std::unique_ptr<HandleEntry[]>> handle_chunks;
+    size_t handle_slots = 0;
+    std::vector<uint32_t> free_list;
+
+    // Open handle scopes (innermost last) and the handles allocated while
+    // any scope was open, in allocation order.
+    std::vector<HandleScopeFrame> scopes;
+    std::vector<HermesHandle> scoped_handles;
+    HermesHandleScope next_scope = 1;
 
-    // Cached Vue compiler function references
+    // Compiler units initialized so far (VUE_UNIT_* bits)
+    uint32_t loaded_units = 0;
+
+    // Cached Vue compiler function references; null until the unit defining
+    // the function is loaded
     std::unique_ptr<facebook::jsi::Function> parse_fn;
     std::unique_ptr<facebook::jsi::Function> compile_script_fn;
     std::unique_ptr<facebook::jsi::Function> compile_template_fn;
     std::unique_ptr<facebook::jsi::Function> compile_style_fn;
+    std::unique_ptr<facebook::jsi::Function> compile_template_from_descriptor_fn;
+    std::unique_ptr<facebook::jsi::Function> compile_style_from_descriptor_fn;
+    std::unique_ptr<facebook::jsi::Function> compile_sfc_fn;
+    std::unique_ptr<facebook::jsi::Function> compile_sfc_incremental_fn;
+    std::unique_ptr<facebook::jsi::Function> compile_sfc_batch_fn;
+    std::unique_ptr<facebook::jsi::Function> rehydrate_descriptor_fn;
+    std::unique_ptr<facebook::jsi::Function> scan_script_imports_fn;
+    std::unique_ptr<facebook::jsi::Function> json_stringify_fn;
+
+    // Interned property names, created with the function references
+    std::unique_ptr<PropNames> prop_names;
+
+    /**
+     * Makes sure the compiler units in `units` are initialized, loading the
+     * missing ones and resolving the functions they define. Called by every
+     * entry point before it calls into the bridge. Defined in runtime.cpp.
+     *
+     * @param units VUE_UNIT_* bits.
+     * @return false if a unit failed to initialize.
+     */
+    bool require_units(uint32_t units);
 
     // -------------------------------------------------------------------------
     // Handle Management Methods
     // -------------------------------------------------------------------------
 
+    /**
+     * Releases every handle, returning the table to its freshly created state.
+     * Used before parking a runtime for reuse.
+     *
+     * Chunks are kept and generations keep counting, so handles from before
+     * the reset stay stale.
+     */
+    void clear_handles() {
+        free_list.clear();
+        for (size_t i = handle_slots; i > 0; i--) {
+            HandleEntry& entry = slot(i - 1);
+            if (entry.value) {
+                release(entry);
+            }
+            free_list.push_back(static_cast<uint32_t>(i - 1));
+        }
+        scopes.clear();
+        scoped_handles.clear();
+    }
+
     /**
      * Allocates a new handle for a JavaScript value.
      *
      * @param val The JSI Value to store (moved).
-     * @return A 1-indexed handle ID. Never returns 0.
+     * @return A handle encoding the slot and its generation. Never returns 0.
      */
     HermesHandle allocate_handle(facebook::jsi::Value&& val) {
-        auto entry = HandleEntry{
-            std::make_shared<facebook::jsi::Value>(std::move(val)),
-            {}
-        };
-
-        // Reuse a free slot if available
+        uint32_t idx;
         if (!free_list.empty()) {
-            uint64_t idx = free_list.back();
+            // Reuse a free slot if available
+            idx = free_list.back();
             free_list.pop_back();
-            handles[idx] = std::move(entry);
-            return idx + 1;  // Convert to 1-indexed
+        } else {
+            // Allocate a new slot, adding a chunk when the last one is full
+            if (handle_slots == handle_chunks.size() * kHandleChunkSize) {
+                handle_chunks.push_back(std::make_unique<HandleEntry[]>(kHandleChunkSize));
+#ifdef VUE_FFI_STATS
+                for (size_t i = 0; i < kHandleChunkSize; i++) {
+                    handle_chunks.back()[i].strings.stats = &stats;
+                }
+#endif
+            }
+            idx = static_cast<uint32_t>(handle_slots++);
         }
 
-        // Allocate a new slot
-        handles.push_back(std::move(entry));
-        return handles.size();  // 1-indexed
+        HandleEntry& entry = slot(idx);
+        entry.value.emplace(std::move(val));
+        VUE_STATS_ADD(this, handles_allocated, 1);
+
+        HermesHandle handle = (static_cast<uint64_t>(entry.generation) << 32) | (idx + 1);
+        if (!scopes.empty()) {
+            scoped_handles.push_back(handle);
+        }
+        return handle;
     }
 
     /**
      * Gets the handle entry for a given handle ID.
      *
-     * @param handle The 1-indexed handle ID.
-     * @return Pointer to the entry, or nullptr if the handle is invalid.
+     * Entry pointers stay valid until the handle is freed, even if other
+     * handles are allocated in the meantime.
+     *
+     * @param handle The handle.
+     * @return Pointer to the entry, or nullptr if the handle is invalid or stale.
      */
     HandleEntry* get_handle(HermesHandle handle) {
-        if (handle == 0 || handle > handles.size()) {
+        uint64_t idx = (handle & 0xFFFFFFFFu);
+        if (idx == 0 || idx > handle_slots) {
             return nullptr;
         }
-        auto* entry = &handles[handle - 1];
-        // Check if the slot has been freed (empty value)
-        if (!entry->value) {
+        HandleEntry& entry = slot(idx - 1);
+        if (!entry.value || entry.generation != static_cast<uint32_t>(handle >> 32)) {
             return nullptr;
         }
-        return entry;
+        return &entry;
     }
 
     /**
-     * Frees a handle and releases its resources.
+     * Frees a handle and releases its resources. Stale handles are ignored.
      *
-     * @param handle The 1-indexed handle ID.
+     * @param handle The handle.
      */
     void free_handle(HermesHandle handle) {
-        if (handle == 0 || handle > handles.size()) {
+        HandleEntry* entry = get_handle(handle);
+        if (!entry) {
             return;
         }
+        release(*entry);
+        free_list.push_back(static_cast<uint32_t>((handle & 0xFFFFFFFFu) - 1));
+    }
 
-        // Clear the entry and add to free list
-        handles[handle - 1] = HandleEntry{};
-        free_list.push_back(handle - 1);
+    /**
+     * Opens a handle scope and returns its token.
+     */
+    HermesHandleScope open_scope() {
+        HermesHandleScope token = next_scope++;
+        scopes.push_back(HandleScopeFrame{token, scoped_handles.size()});
+        return token;
     }
 
     /**
-     * Caches a string in a handle entry and returns a pointer to it.
-     *
-     * @param handle The handle to cache the string in.
-     * @param str The string to cache.
-     * @return Pointer to the cached string, or "" if the handle is invalid.
+     * Closes a scope (and every scope nested in it), freeing the handles
+     * allocated since it was opened. Unknown tokens are ignored.
      */
-    const char* cache_string(HermesHandle handle, const std::string& str) {
-        auto* entry = get_handle(handle);
-        if (!entry) {
-            return "";
+    void close_scope(HermesHandleScope token) {
+        size_t depth = scopes.size();
+        while (depth > 0 && scopes[depth - 1].token != token) {
+            depth--;
+        }
+        if (depth == 0) {
+            return;
         }
-        entry->cached_strings.push_back(str);
-        return entry->cached_strings.back().c_str();
+
+        size_t mark = scopes[depth - 1].mark;
+        scopes.resize(depth - 1);
+        for (size_t i = scoped_handles.size(); i > mark; i--) {
+            free_handle(scoped_handles[i - 1]);
+        }
+        scoped_handles.resize(mark);
+    }
+
+    /// Returns the entry at a 0-based slot index below handle_slots.
+    HandleEntry& slot(size_t idx) {
+        return handle_chunks[idx / kHandleChunkSize][idx % kHandleChunkSize];
+    }
+
+    /// Empties a live entry and bumps its generation.
+    static void release(HandleEntry& entry) {
+        entry.value.reset();
+        entry.strings.clear();
+        entry.snapshot.reset();
+        entry.encoded.reset();
+        entry.borrowed = BorrowedSource{};
+        entry.generation++;
     }
 
     // -------------------------------------------------------------------------
@@ -138,6 +647,10 @@ struct HermesRuntimeImpl {
     facebook::hermes::HermesRuntime& runtime() {
         return *jsi_runtime;
     }
+
+    const PropNames& props() const {
+        return *prop_names;
+    }
 };
 
 #endif /* HERMES_RUNTIME_INTERNAL_H */
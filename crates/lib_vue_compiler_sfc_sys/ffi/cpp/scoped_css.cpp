@@ -0,0 +1,806 @@
+/**
+ * @file scoped_css.cpp
+ * @brief Native rewriter for plain style blocks.
+ *
+ * Mirrors the three postcss plugins compileStyle() runs on plain CSS:
+ *
+ * - trim: a rule's or at-rule's non-empty leading and closing whitespace
+ *   becomes a single newline
+ * - CSS variables: `v-bind(expr)` in declaration values becomes
+ *   `var(--<id>-<escaped expr>)`
+ * - scoped: `[data-v-<id>]` is inserted after the last non-pseudo simple
+ *   selector of each selector, or before the first one if there is none
+ *
+ * Everything else is copied verbatim, which is what postcss does when it
+ * stringifies nodes it parsed and did not change. The source is walked
+ * once; whenever it reaches something whose output would depend on more
+ * of postcss than the above, it gives up and the caller falls back.
+ */
+
+#include "scoped_css.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace {
+
+constexpr size_t npos = std::string_view::npos;
+
+constexpr std::string_view kSpaces = " \t\n\r\f";
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+bool is_ident_char(char c) {
+    auto u = static_cast<unsigned char>(c);
+    return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9')
+        || c == '-' || c == '_' || u >= 0x80;
+}
+
+size_t ident_end(std::string_view s, size_t from) {
+    while (from < s.size() && is_ident_char(s[from])) {
+        from++;
+    }
+    return from;
+}
+
+bool equals_ignore_case(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        char c = a[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Finds the first of `stops` at bracket depth 0, outside strings and
+ * comments, starting at `from`.
+ *
+ * @param comment Set to true if a comment was skipped on the way.
+ * @return The index of the stop, s.size() if none was found, or npos for
+ *         unbalanced brackets, unterminated strings or comments, and for a
+ *         `{` or `}` inside brackets.
+ */
+size_t scan(std::string_view s, size_t from, std::string_view stops, bool& comment) {
+    std::string closers;
+    for (size_t i = from; i < s.size(); i++) {
+        char c = s[i];
+        if (c == '\\') {
+            i++;
+            continue;
+        }
+        if (c == '"' || c == '\'') {
+            for (i++; i < s.size() && s[i] != c; i++) {
+                if (s[i] == '\\') {
+                    i++;
+                } else if (s[i] == '\n') {
+                    return npos;
+                }
+            }
+            if (i >= s.size()) {
+                return npos;
+            }
+            continue;
+        }
+        if (c == '/' && i + 1 < s.size() && s[i + 1] == '*') {
+            size_t end = s.find("*/", i + 2);
+            if (end == npos) {
+                return npos;
+            }
+            comment = true;
+            i = end + 1;
+            continue;
+        }
+        if (closers.empty() && stops.find(c) != npos) {
+            return i;
+        }
+        if (c == '(') {
+            closers.push_back(')');
+        } else if (c == '[') {
+            closers.push_back(']');
+        } else if (c == ')' || c == ']') {
+            if (closers.empty() || closers.back() != c) {
+                return npos;
+            }
+            closers.pop_back();
+        } else if (c == '{' || c == '}') {
+            return npos;
+        }
+    }
+    return closers.empty() ? s.size() : npos;
+}
+
+/// Whitespace as matched by JS `\s` and trimmed by String.prototype.trim(),
+/// limited to ASCII.
+bool is_js_space(char c) {
+    return is_space(c) || c == '\v';
+}
+
+/**
+ * Finds the `)` closing a v-bind() argument that starts at `start`, like
+ * lexBinding() in compiler-sfc: parentheses nest and quotes hide them.
+ */
+size_t lex_binding(std::string_view value, size_t start) {
+    char quote = 0;
+    size_t depth = 0;
+    for (size_t i = start; i < value.size(); i++) {
+        char c = value[i];
+        if (quote) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '\'' || c == '"') {
+            quote = c;
+        } else if (c == '(') {
+            depth++;
+        } else if (c == ')') {
+            if (depth == 0) {
+                return i;
+            }
+            depth--;
+        }
+    }
+    return npos;
+}
+
+/// Trims a v-bind() argument and strips matching quotes around it.
+std::string_view normalize_expression(std::string_view exp) {
+    while (!exp.empty() && is_js_space(exp.front())) {
+        exp.remove_prefix(1);
+    }
+    while (!exp.empty() && is_js_space(exp.back())) {
+        exp.remove_suffix(1);
+    }
+    if (exp.size() >= 2 && (exp.front() == '\'' || exp.front() == '"')
+        && exp.back() == exp.front()) {
+        return exp.substr(1, exp.size() - 2);
+    }
+    return exp;
+}
+
+class Rewriter {
+public:
+    Rewriter(std::string_view source, std::string_view id, bool scoped, bool is_prod, std::string& out)
+        : src_(source), scoped_(scoped), is_prod_(is_prod), out_(out) {
+        if (id.substr(0, 7) == "data-v-") {
+            id.remove_prefix(7);
+        }
+        short_id_ = id;
+        attribute_ = "[data-v-";
+        attribute_ += id;
+        attribute_ += ']';
+    }
+
+    bool run() {
+        // postcss drops a byte order mark; leave that to it.
+        if (src_.substr(0, 3) == "\xEF\xBB\xBF") {
+            return false;
+        }
+        out_.reserve(src_.size() + src_.size() / 4);
+        return rules(false);
+    }
+
+private:
+    /// Skips whitespace and returns it.
+    std::string_view spaces() {
+        size_t start = pos_;
+        while (pos_ < src_.size() && is_space(src_[pos_])) {
+            pos_++;
+        }
+        return src_.substr(start, pos_ - start);
+    }
+
+    bool at_comment() const {
+        return src_.compare(pos_, 2, "/*") == 0;
+    }
+
+    bool comment() {
+        size_t end = src_.find("*/", pos_ + 2);
+        if (end == npos) {
+            return false;
+        }
+        out_ += src_.substr(pos_, end + 2 - pos_);
+        pos_ = end + 2;
+        return true;
+    }
+
+    /// Writes a rule's or at-rule's leading or closing whitespace, trimmed.
+    void trimmed(std::string_view whitespace) {
+        if (!whitespace.empty()) {
+            out_ += '\n';
+        }
+    }
+
+    /**
+     * Rewrites rules, at-rules and comments up to the end of the source
+     * (the root) or through the `}` closing an at-rule block (nested).
+     */
+    bool rules(bool nested) {
+        for (;;) {
+            std::string_view before = spaces();
+            if (pos_ == src_.size()) {
+                if (nested) {
+                    return false;
+                }
+                out_ += before;
+                return true;
+            }
+            if (src_[pos_] == '}') {
+                if (!nested) {
+                    return false;
+                }
+                trimmed(before);
+                out_ += '}';
+                pos_++;
+                return true;
+            }
+            if (at_comment()) {
+                out_ += before;
+                if (!comment()) {
+                    return false;
+                }
+                continue;
+            }
+            trimmed(before);
+            if (!(src_[pos_] == '@' ? at_rule() : rule())) {
+                return false;
+            }
+        }
+    }
+
+    bool at_rule() {
+        size_t name_end = ident_end(src_, pos_ + 1);
+        std::string_view name = src_.substr(pos_ + 1, name_end - pos_ - 1);
+        if (name.empty()) {
+            return false;
+        }
+
+        bool has_comment = false;
+        size_t end = scan(src_, name_end, ";{}", has_comment);
+        if (end == npos || end == src_.size() || has_comment || src_[end] == '}') {
+            return false;
+        }
+        out_ += src_.substr(pos_, end + 1 - pos_);
+        pos_ = end + 1;
+        if (src_[end] == ';') {
+            return true;
+        }
+
+        if (name == "keyframes" || name == "-webkit-keyframes" || name == "-moz-keyframes") {
+            // Scoped styles rename keyframes and the animations using them.
+            return !scoped_ && rules(true);
+        }
+        if (name == "media" || name == "supports" || name == "container" || name == "layer") {
+            return rules(true);
+        }
+        if (name == "font-face" || name == "property" || name == "counter-style" || name == "page") {
+            return declarations();
+        }
+        return false;
+    }
+
+    bool rule() {
+        bool has_comment = false;
+        size_t open = scan(src_, pos_, "{;}", has_comment);
+        if (open == npos || open == src_.size() || has_comment || src_[open] != '{') {
+            return false;
+        }
+        std::string_view prelude = src_.substr(pos_, open - pos_);
+        size_t selector_len = prelude.find_last_not_of(kSpaces) + 1;
+        std::string_view selector = prelude.substr(0, selector_len);
+
+        if (!scoped_) {
+            out_ += selector;
+        } else if (!scope_selector_list(selector)) {
+            return false;
+        }
+        out_ += prelude.substr(selector_len);
+        out_ += '{';
+        pos_ = open + 1;
+        return declarations();
+    }
+
+    /// Rewrites declarations and comments through the `}` closing the block.
+    bool declarations() {
+        for (;;) {
+            std::string_view before = spaces();
+            if (pos_ == src_.size()) {
+                return false;
+            }
+            if (src_[pos_] == '}') {
+                trimmed(before);
+                out_ += '}';
+                pos_++;
+                return true;
+            }
+            out_ += before;
+            if (at_comment()) {
+                if (!comment()) {
+                    return false;
+                }
+                continue;
+            }
+            if (!declaration()) {
+                return false;
+            }
+        }
+    }
+
+    bool declaration() {
+        bool has_comment = false;
+        size_t end = scan(src_, pos_, ";{}", has_comment);
+        if (end == npos || end == src_.size() || src_[end] == '{') {
+            return false;
+        }
+        bool terminated = src_[end] == ';';
+        std::string_view text = src_.substr(pos_, end - pos_);
+        if (text.empty()) {
+            return false;
+        }
+        size_t decl_len = text.find_last_not_of(kSpaces) + 1;
+        std::string_view decl = text.substr(0, decl_len);
+        bool trailing_spaces = decl_len < text.size();
+
+        size_t prop_end = decl[0] == '-' && decl.size() > 1 && decl[1] == '-'
+            ? ident_end(decl, 2)
+            : ident_end(decl, 0);
+        size_t colon = prop_end;
+        while (colon < decl.size() && is_space(decl[colon])) {
+            colon++;
+        }
+        if (prop_end == 0 || colon == decl.size() || decl[colon] != ':') {
+            return false;
+        }
+        bool custom_property = decl.substr(0, 2) == "--";
+        std::string_view value = decl.substr(colon + 1);
+
+        // postcss reports a colon in a value as a missing semicolon.
+        bool value_comment = false;
+        if (!custom_property && scan(value, 0, ":", value_comment) != value.size()) {
+            return false;
+        }
+        // A custom property keeps its trailing whitespace when the block
+        // closes right after it.
+        if (custom_property && !terminated && trailing_spaces) {
+            return false;
+        }
+
+        if (find_v_bind(value, 0).first == npos) {
+            out_ += decl;
+        } else {
+            // A changed value drops the raw value postcss keeps for comments
+            // and spaces before the semicolon.
+            if (is_prod_ || has_comment || (terminated && trailing_spaces)) {
+                return false;
+            }
+            out_ += decl.substr(0, colon + 1);
+            if (!rewrite_v_bind(value)) {
+                return false;
+            }
+        }
+
+        if (terminated) {
+            out_ += text.substr(decl_len);
+            out_ += ';';
+            pos_ = end + 1;
+        } else {
+            pos_ += decl_len;
+        }
+        return true;
+    }
+
+    /**
+     * Finds the next `v-bind\s*(` at or after `from`.
+     *
+     * @return The index of the match and of the argument after the `(`,
+     *         or npos if there is none.
+     */
+    static std::pair<size_t, size_t> find_v_bind(std::string_view value, size_t from) {
+        for (size_t match = value.find("v-bind", from); match != npos;
+             match = value.find("v-bind", match + 1)) {
+            size_t paren = match + 6;
+            while (paren < value.size() && is_js_space(value[paren])) {
+                paren++;
+            }
+            if (paren < value.size() && value[paren] == '(') {
+                return {match, paren + 1};
+            }
+        }
+        return {npos, npos};
+    }
+
+    /// Appends the value with each v-bind() replaced by its CSS variable.
+    bool rewrite_v_bind(std::string_view value) {
+        size_t copied = 0;
+        for (auto match = find_v_bind(value, 0); match.first != npos;
+             match = find_v_bind(value, match.second)) {
+            if (match.first < copied) {
+                // v-bind() inside a v-bind() argument.
+                return false;
+            }
+            size_t close = lex_binding(value, match.second);
+            if (close == npos) {
+                continue;
+            }
+            std::string_view variable =
+                normalize_expression(value.substr(match.second, close - match.second));
+
+            out_ += value.substr(copied, match.first - copied);
+            out_ += "var(--";
+            out_ += short_id_;
+            out_ += '-';
+            for (char c : variable) {
+                if (static_cast<unsigned char>(c) >= 0x80) {
+                    return false;
+                }
+                // The characters getEscapedCssVarName() escapes.
+                if (std::string_view(" !\"#$%&'()*+,./:;<=>?@[\\]^`{|}~").find(c) != npos) {
+                    out_ += '\\';
+                }
+                out_ += c;
+            }
+            out_ += ')';
+            copied = close + 1;
+        }
+        out_ += value.substr(copied);
+        return true;
+    }
+
+    bool scope_selector_list(std::string_view selectors) {
+        size_t begin = 0;
+        for (;;) {
+            bool has_comment = false;
+            size_t comma = scan(selectors, begin, ",", has_comment);
+            if (comma == npos) {
+                return false;
+            }
+            if (!scope_selector(selectors.substr(begin, comma - begin))) {
+                return false;
+            }
+            if (comma == selectors.size()) {
+                return true;
+            }
+            out_ += ',';
+            begin = comma + 1;
+        }
+    }
+
+    /// The scoping pseudo-classes and the ones the scoped plugin looks into.
+    static bool is_plain_pseudo(std::string_view name) {
+        if (name.size() >= 2 && (name[0] == 'v' || name[0] == 'V') && name[1] == '-') {
+            return false;
+        }
+        for (std::string_view special : {"deep", "slotted", "global", "is", "where"}) {
+            if (equals_ignore_case(name, special)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Adds the scope attribute to one selector of a list, after its last
+     * simple selector that isn't a pseudo-class or pseudo-element.
+     */
+    bool scope_selector(std::string_view selector) {
+        size_t lead = 0;
+        while (lead < selector.size() && is_space(selector[lead])) {
+            lead++;
+        }
+        // Whitespace before a comma belongs to the node the attribute is
+        // inserted after, which drops it.
+        if (lead == selector.size() || is_space(selector.back())) {
+            return false;
+        }
+
+        size_t insert_at = npos;
+        size_t i = lead;
+        while (i < selector.size()) {
+            char c = selector[i];
+            if (is_space(c) || c == '>' || c == '+' || c == '~') {
+                size_t j = i;
+                while (j < selector.size() && is_space(selector[j])) {
+                    j++;
+                }
+                if (j < selector.size() && (selector[j] == '>' || selector[j] == '+' || selector[j] == '~')) {
+                    j++;
+                    while (j < selector.size() && is_space(selector[j])) {
+                        j++;
+                    }
+                }
+                // Leading, trailing and doubled combinators (including the
+                // `>>>` deep combinator).
+                if (i == lead || j == selector.size() || selector[j] == '>' || selector[j] == '+'
+                    || selector[j] == '~') {
+                    return false;
+                }
+                i = j;
+            } else if (c == '.' || c == '#') {
+                size_t end = ident_end(selector, i + 1);
+                if (end == i + 1) {
+                    return false;
+                }
+                i = insert_at = end;
+            } else if (c == '[') {
+                bool has_comment = false;
+                size_t close = scan(selector, i + 1, "]", has_comment);
+                if (close == npos || close == selector.size()) {
+                    return false;
+                }
+                i = insert_at = close + 1;
+            } else if (c == ':') {
+                size_t start = i + 1 < selector.size() && selector[i + 1] == ':' ? i + 2 : i + 1;
+                size_t end = ident_end(selector, start);
+                if (end == start || !is_plain_pseudo(selector.substr(start, end - start))) {
+                    return false;
+                }
+                i = end;
+                if (i < selector.size() && selector[i] == '(') {
+                    bool has_comment = false;
+                    size_t close = scan(selector, i + 1, ")", has_comment);
+                    if (close == npos || close == selector.size()) {
+                        return false;
+                    }
+                    i = close + 1;
+                }
+            } else if (is_ident_char(c)) {
+                i = insert_at = ident_end(selector, i);
+            } else {
+                // `*`, `&`, namespaces, escapes and `/deep/`.
+                return false;
+            }
+        }
+
+        if (insert_at != npos) {
+            out_ += selector.substr(0, insert_at);
+            out_ += attribute_;
+            out_ += selector.substr(insert_at);
+            return true;
+        }
+        // Only pseudos: the attribute goes first, and the whitespace before
+        // the selector is dropped.
+        if (lead != 0) {
+            return false;
+        }
+        out_ += attribute_;
+        out_ += selector;
+        return true;
+    }
+
+    std::string_view src_;
+    size_t pos_ = 0;
+    bool scoped_;
+    bool is_prod_;
+    std::string_view short_id_;
+    std::string attribute_;
+    std::string& out_;
+};
+
+/// Finds the quote closing the string that opens at `open`, or npos if the
+/// string is unterminated.
+size_t string_end(std::string_view s, size_t open) {
+    for (size_t i = open + 1; i < s.size(); i++) {
+        if (s[i] == '\\') {
+            i++;
+        } else if (s[i] == s[open]) {
+            return i;
+        } else if (s[i] == '\n') {
+            return npos;
+        }
+    }
+    return npos;
+}
+
+/**
+ * Reads the comma-separated paths after an import at-rule name ending at
+ * `i`, stopping at the first argument that is neither a string nor url().
+ *
+ * @return The index reading stopped at.
+ */
+size_t read_import_paths(std::string_view s, size_t i, std::vector<std::string_view>& imports) {
+    for (;;) {
+        while (i < s.size() && is_space(s[i])) {
+            i++;
+        }
+        if (i < s.size() && (s[i] == '"' || s[i] == '\'')) {
+            size_t close = string_end(s, i);
+            if (close == npos) {
+                return s.size();
+            }
+            imports.push_back(s.substr(i + 1, close - i - 1));
+            i = close + 1;
+        } else if (s.size() - i >= 4 && equals_ignore_case(s.substr(i, 4), "url(")) {
+            i += 4;
+            while (i < s.size() && is_space(s[i])) {
+                i++;
+            }
+            std::string_view path;
+            if (i < s.size() && (s[i] == '"' || s[i] == '\'')) {
+                size_t close = string_end(s, i);
+                if (close == npos) {
+                    return s.size();
+                }
+                path = s.substr(i + 1, close - i - 1);
+                i = close + 1;
+                while (i < s.size() && is_space(s[i])) {
+                    i++;
+                }
+                if (i == s.size() || s[i] != ')') {
+                    return i;
+                }
+            } else {
+                size_t close = s.find(')', i);
+                if (close == npos) {
+                    return s.size();
+                }
+                path = s.substr(i, close - i);
+                while (!path.empty() && is_space(path.back())) {
+                    path.remove_suffix(1);
+                }
+                i = close;
+            }
+            i++;
+            if (!path.empty()) {
+                imports.push_back(path);
+            }
+        } else {
+            return i;
+        }
+
+        while (i < s.size() && is_space(s[i])) {
+            i++;
+        }
+        if (i == s.size() || s[i] != ',') {
+            return i;
+        }
+        i++;
+    }
+}
+
+}  // namespace
+
+bool rewrite_plain_css(
+    std::string_view source,
+    std::string_view id,
+    bool scoped,
+    bool is_prod,
+    std::string& out
+) {
+    out.clear();
+    Rewriter rewriter(source, id, scoped, is_prod, out);
+    if (!rewriter.run()) {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+bool collect_css_vars(std::string_view source, std::vector<std::string>& vars) {
+    // parseCssVars() first drops /\/\*([\s\S]*?)\*\/|\/\/.*/g matches.
+    std::string content;
+    content.reserve(source.size());
+    for (size_t i = 0; i < source.size();) {
+        if (source[i] == '/' && i + 1 < source.size()) {
+            if (source[i + 1] == '*') {
+                size_t close = source.find("*/", i + 2);
+                if (close != npos) {
+                    i = close + 2;
+                    continue;
+                }
+            } else if (source[i + 1] == '/') {
+                size_t eol = std::min(source.find_first_of("\n\r", i), source.size());
+                std::string_view line = source.substr(i, eol - i);
+                if (line.find("\xE2\x80\xA8") != npos || line.find("\xE2\x80\xA9") != npos) {
+                    // U+2028/U+2029 also end a `.*` match.
+                    return false;
+                }
+                i = eol;
+                continue;
+            }
+        }
+        content += source[i++];
+    }
+
+    for (size_t match = content.find("v-bind"); match != npos;
+         match = content.find("v-bind", match + 1)) {
+        size_t paren = match + 6;
+        while (paren < content.size() && is_js_space(content[paren])) {
+            paren++;
+        }
+        if (paren < content.size() && static_cast<unsigned char>(content[paren]) >= 0x80) {
+            // Possibly a non-ASCII `\s`.
+            return false;
+        }
+        if (paren == content.size() || content[paren] != '(') {
+            continue;
+        }
+        size_t close = lex_binding(content, paren + 1);
+        if (close == npos) {
+            continue;
+        }
+
+        std::string_view argument(content.data() + paren + 1, close - paren - 1);
+        while (!argument.empty() && is_js_space(argument.front())) {
+            argument.remove_prefix(1);
+        }
+        while (!argument.empty() && is_js_space(argument.back())) {
+            argument.remove_suffix(1);
+        }
+        if (!argument.empty()
+            && (static_cast<unsigned char>(argument.front()) >= 0x80
+                || static_cast<unsigned char>(argument.back()) >= 0x80)) {
+            // trim() would also strip non-ASCII whitespace.
+            return false;
+        }
+
+        std::string variable(normalize_expression(argument));
+        if (std::find(vars.begin(), vars.end(), variable) == vars.end()) {
+            vars.push_back(std::move(variable));
+        }
+    }
+    return true;
+}
+
+void collect_style_imports(
+    std::string_view source,
+    std::string_view lang,
+    std::vector<std::string_view>& imports
+) {
+    bool line_comments = !lang.empty() && lang != "css" && lang != "postcss";
+    bool sass_modules = lang == "scss" || lang == "sass";
+    bool stylus = lang == "stylus" || lang == "styl";
+
+    for (size_t i = 0; i < source.size(); i++) {
+        char c = source[i];
+        if (c == '"' || c == '\'') {
+            i = string_end(source, i);
+            if (i == npos) {
+                return;
+            }
+            continue;
+        }
+        if (c == '/' && i + 1 < source.size() && source[i + 1] == '*') {
+            size_t close = source.find("*/", i + 2);
+            if (close == npos) {
+                return;
+            }
+            i = close + 1;
+            continue;
+        }
+        if (c == '/' && line_comments && i + 1 < source.size() && source[i + 1] == '/') {
+            i = source.find('\n', i);
+            if (i == npos) {
+                return;
+            }
+            continue;
+        }
+        if (c != '@') {
+            continue;
+        }
+
+        size_t name_end = ident_end(source, i + 1);
+        std::string_view name = source.substr(i + 1, name_end - i - 1);
+        if (sass_modules && (name == "use" || name == "forward")) {
+            // Built-in modules (`sass:math`) are not files.
+            size_t first = imports.size();
+            name_end = read_import_paths(source, name_end, imports);
+            imports.erase(
+                std::remove_if(imports.begin() + first, imports.end(),
+                    [](std::string_view path) { return path.substr(0, 5) == "sass:"; }),
+                imports.end());
+        } else if (equals_ignore_case(name, "import") || (stylus && name == "require")) {
+            name_end = read_import_paths(source, name_end, imports);
+        }
+        i = name_end - 1;
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * @file scoped_css.h
+ * @brief Native rewriter for plain (unpreprocessed) style blocks.
+ *
+ * This header is NOT part of the public API. It is only included by
+ * vue_sfc.cpp, sfc_scanner.cpp and scoped_css.cpp.
+ */
+
+#ifndef VUE_SCOPED_CSS_H
+#define VUE_SCOPED_CSS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Compiles plain CSS the way the bridge's compileStyle() does: trims the
+ * whitespace around rules, rewrites v-bind() to CSS variables and, if
+ * scoped, adds the scope attribute to every selector.
+ *
+ * Only a conservative subset of CSS is handled. Anything else - comments
+ * in selectors, nested rules, :deep()/:slotted()/:global() and the other
+ * scoping pseudo-classes, the universal selector, escapes, keyframes in
+ * scoped styles, v-bind() names hashed in production, and input postcss
+ * would reject - makes the function return false so the caller can fall
+ * back to compileStyle(), which remains the reference.
+ *
+ * @param source The CSS source (UTF-8).
+ * @param id The scope ID, with or without the `data-v-` prefix.
+ * @param scoped Add the scope attribute to selectors.
+ * @param is_prod Production mode (hashes v-bind() variable names).
+ * @param out Receives the compiled CSS on success.
+ * @return true if `out` holds the same CSS compileStyle() would produce.
+ */
+bool rewrite_plain_css(
+    std::string_view source,
+    std::string_view id,
+    bool scoped,
+    bool is_prod,
+    std::string& out
+);
+
+/**
+ * Collects the v-bind() expressions of a style block the way compiler-sfc's
+ * parseCssVars() does: comments are skipped, each argument is trimmed and
+ * unquoted, and names already in `vars` are not added again.
+ *
+ * @param source The style block content.
+ * @param vars Receives the expressions, in order of first appearance.
+ * @return false if the result could depend on non-ASCII whitespace, which
+ *         is not handled; `vars` may then hold some of the expressions.
+ */
+bool collect_css_vars(std::string_view source, std::vector<std::string>& vars);
+
+/**
+ * Collects the stylesheets a style block imports: the quoted or url()
+ * arguments of `@import`, and of `@use` and `@forward` in scss/sass or
+ * `@require` in stylus, leaving out Sass built-in modules. Comments and
+ * strings are skipped. Nothing is resolved or evaluated, so paths are
+ * returned as written and imports built by interpolation are missed.
+ *
+ * @param source The style block content.
+ * @param lang The block's lang attribute, empty for plain CSS.
+ * @param imports Receives views into `source`, in source order.
+ */
+void collect_style_imports(
+    std::string_view source,
+    std::string_view lang,
+    std::vector<std::string_view>& imports
+);
+
+#endif /* VUE_SCOPED_CSS_H */
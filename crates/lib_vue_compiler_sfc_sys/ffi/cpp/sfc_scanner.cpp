@@ -0,0 +1,735 @@
+/**
+ * @file sfc_scanner.cpp
+ * @brief Native SFC block splitter.
+ *
+ * Mirrors what sfcParse() does to find blocks: the compiler-core tokenizer
+ * in SFC mode reads every root element other than an HTML template as raw
+ * text up to its closing tag, and parses HTML templates as markup. The
+ * scanner does the same with a vectorized search for `<` (memchr), then
+ * applies compiler-sfc's block rules: empty blocks are dropped, attributes
+ * become lang/src/scoped/module/setup, pug templates are de-indented, and
+ * cssVars and slotted are derived from the styles.
+ *
+ * Whenever the parser would report an error or the result would depend on
+ * something the scanner does not model, it gives up and the caller falls
+ * back to sfcParse(), which remains the reference.
+ */
+
+#include "sfc_scanner.h"
+#include "scoped_css.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr size_t npos = std::string_view::npos;
+
+/// Whitespace as the tokenizer sees it.
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\f' || c == '\r';
+}
+
+bool is_tag_start(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/// Length of the UTF-8 sequence starting with `lead`.
+size_t utf8_length(unsigned char lead) {
+    return lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+}
+
+/**
+ * Length of the JS whitespace character (`\s`, String.prototype.trim())
+ * at s[i], or 0 if there is none there.
+ */
+size_t js_space_at(std::string_view s, size_t i) {
+    auto byte = [&](size_t k) -> unsigned char {
+        return i + k < s.size() ? static_cast<unsigned char>(s[i + k]) : 0;
+    };
+    unsigned char c = byte(0);
+    if (c == ' ' || (c >= '\t' && c <= '\r')) {
+        return 1;
+    }
+    if (c < 0x80) {
+        return 0;
+    }
+    unsigned char c1 = byte(1);
+    unsigned char c2 = byte(2);
+    bool space = (c == 0xC2 && c1 == 0xA0)                                  // U+00A0
+        || (c == 0xE1 && c1 == 0x9A && c2 == 0x80)                          // U+1680
+        || (c == 0xE2 && c1 == 0x80
+            && (c2 <= 0x8A || c2 == 0xA8 || c2 == 0xA9 || c2 == 0xAF))      // U+2000-U+202F
+        || (c == 0xE2 && c1 == 0x81 && c2 == 0x9F)                          // U+205F
+        || (c == 0xE3 && c1 == 0x80 && c2 == 0x80)                          // U+3000
+        || (c == 0xEF && c1 == 0xBB && c2 == 0xBF);                         // U+FEFF
+    return !space ? 0 : c == 0xC2 ? 2 : 3;
+}
+
+/// Length of the leading JS whitespace of `s`, in bytes and in characters.
+std::pair<size_t, size_t> leading_js_space(std::string_view s) {
+    size_t bytes = 0;
+    size_t chars = 0;
+    while (size_t n = js_space_at(s, bytes)) {
+        bytes += n;
+        chars++;
+    }
+    return {bytes, chars};
+}
+
+/// `s.trim() === ''`
+bool is_js_blank(std::string_view s) {
+    return leading_js_space(s).first == s.size();
+}
+
+/// Finds the next `<` at or after `from`.
+size_t find_lt(std::string_view s, size_t from) {
+    if (from >= s.size()) {
+        return npos;
+    }
+    const void* hit = std::memchr(s.data() + from, '<', s.size() - from);
+    return hit ? static_cast<size_t>(static_cast<const char*>(hit) - s.data()) : npos;
+}
+
+/// Compares a tag name with a lowercase name, ignoring ASCII case.
+bool is_tag(std::string_view name, std::string_view lower) {
+    if (name.size() != lower.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < name.size(); i++) {
+        char c = name[i];
+        if ((c >= 'A' && c <= 'Z' ? c + 32 : c) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Maps byte offsets to positions like the compiler reports them: offsets
+ * and columns in UTF-16 code units, lines and columns from 1. Offsets must
+ * be queried in ascending order.
+ */
+class PositionCursor {
+public:
+    explicit PositionCursor(std::string_view source) : source_(source) {}
+
+    VuePosition at(size_t byte) {
+        while (byte_ < byte && byte_ < source_.size()) {
+            unsigned char lead = static_cast<unsigned char>(source_[byte_]);
+            size_t bytes = utf8_length(lead);
+            if (lead == '\n') {
+                line_++;
+                newline_ = utf16_;
+                seen_newline_ = true;
+            }
+            byte_ += bytes;
+            utf16_ += bytes == 4 ? 2 : 1;
+        }
+        size_t column = seen_newline_ ? utf16_ - newline_ : utf16_ + 1;
+        return VuePosition{utf16_, line_, column};
+    }
+
+private:
+    std::string_view source_;
+    size_t byte_ = 0;
+    size_t utf16_ = 0;
+    size_t line_ = 1;
+    size_t newline_ = 0;
+    bool seen_newline_ = false;
+};
+
+struct Attr {
+    std::string_view name;
+    std::string_view value;
+    /// No value, or an empty one: compiler-sfc stores `true`.
+    bool is_bool = true;
+};
+
+struct Tag {
+    std::string_view name;
+    std::vector<Attr> attrs;
+    bool self_closing = false;
+    /// Index just past the closing `>`.
+    size_t end = 0;
+
+    const Attr* find(std::string_view name) const {
+        for (const auto& attr : attrs) {
+            if (attr.name == name) {
+                return &attr;
+            }
+        }
+        return nullptr;
+    }
+
+    std::string_view value(std::string_view name) const {
+        const Attr* attr = find(name);
+        return attr ? attr->value : std::string_view();
+    }
+};
+
+/// A block found at the root, before it is copied into the snapshot.
+struct Block {
+    Tag tag;
+    std::string_view content;
+    VueSourceLocation loc{};
+    /// Content de-indented from a pug template, if it differs.
+    std::string dedented;
+    bool is_dedented = false;
+};
+
+class Scanner {
+public:
+    explicit Scanner(std::string_view source) : src_(source), positions_(source) {}
+
+    bool run(std::string_view filename, DescriptorSnapshot& out) {
+        std::vector<Block> blocks;
+        int template_index = -1;
+        int script_index = -1;
+        int script_setup_index = -1;
+        std::vector<size_t> styles;
+        std::vector<size_t> custom_blocks;
+
+        size_t i = 0;
+        for (;;) {
+            size_t lt = find_lt(src_, i);
+            std::string_view text = src_.substr(i, (lt == npos ? src_.size() : lt) - i);
+            if (text.find("{{") != npos) {
+                // An interpolation at the root could hide tags.
+                return false;
+            }
+            if (lt == npos) {
+                break;
+            }
+
+            char next = lt + 1 < src_.size() ? src_[lt + 1] : '\0';
+            if (next == '!') {
+                size_t end = skip_comment(lt);
+                if (end == npos) {
+                    return false;
+                }
+                i = end;
+                continue;
+            }
+            if (next == '/' || next == '?') {
+                return false;
+            }
+            if (!is_tag_start(next)) {
+                i = lt + 1;
+                continue;
+            }
+
+            Block block;
+            if (!read_tag(lt, true, block.tag)) {
+                return false;
+            }
+            const Tag& tag = block.tag;
+            size_t start = tag.end;
+            size_t end = start;
+            i = tag.end;
+            if (!tag.self_closing) {
+                std::string_view lang = tag.value("lang");
+                bool markup = tag.name == "template" && (lang.empty() || lang == "html");
+                size_t close = markup ? find_template_close(start) : find_raw_close(tag.name, start);
+                if (close == npos) {
+                    return false;
+                }
+                size_t gt = src_.find('>', close + 2 + tag.name.size());
+                if (gt == npos) {
+                    return false;
+                }
+                end = close;
+                i = gt + 1;
+            }
+            block.content = src_.substr(start, end - start);
+            block.loc.start = positions_.at(start);
+            block.loc.end = positions_.at(end);
+
+            // Blocks with nothing but whitespace are ignored (ignoreEmpty).
+            if (tag.name != "template" && !tag.find("src") && is_js_blank(block.content)) {
+                continue;
+            }
+
+            int index = static_cast<int>(blocks.size());
+            if (tag.name == "template") {
+                if (template_index >= 0 || tag.find("functional")) {
+                    return false;
+                }
+                template_index = index;
+            } else if (tag.name == "script") {
+                int& slot = tag.find("setup") ? script_setup_index : script_index;
+                if (slot >= 0) {
+                    return false;
+                }
+                slot = index;
+            } else if (tag.name == "style") {
+                if (tag.find("vars")) {
+                    return false;
+                }
+                styles.push_back(blocks.size());
+            } else {
+                custom_blocks.push_back(blocks.size());
+            }
+            blocks.push_back(std::move(block));
+        }
+
+        if (template_index < 0 && script_index < 0 && script_setup_index < 0) {
+            return false;
+        }
+        if (script_setup_index >= 0
+            && (blocks[script_setup_index].tag.find("src")
+                || (script_index >= 0 && blocks[script_index].tag.find("src")))) {
+            return false;
+        }
+        if (template_index >= 0) {
+            Block& block = blocks[template_index];
+            std::string_view lang = block.tag.value("lang");
+            if ((lang == "pug" || lang == "jade") && !dedent(block)) {
+                return false;
+            }
+        }
+
+        std::vector<std::string> css_vars;
+        bool slotted = false;
+        for (size_t index : styles) {
+            const Block& style = blocks[index];
+            if (!collect_css_vars(style.content, css_vars)) {
+                return false;
+            }
+            slotted = slotted
+                || (style.tag.find("scoped")
+                    && (style.content.find(":slotted(") != npos
+                        || style.content.find("::v-slotted(") != npos));
+        }
+
+        // Copy into the snapshot in its block order.
+        std::vector<const Block*> ordered;
+        for (int index : {template_index, script_index, script_setup_index}) {
+            if (index >= 0) {
+                ordered.push_back(&blocks[index]);
+            }
+        }
+        for (size_t index : styles) {
+            ordered.push_back(&blocks[index]);
+        }
+        for (size_t index : custom_blocks) {
+            ordered.push_back(&blocks[index]);
+        }
+
+        size_t attr_count = 0;
+        for (const Block* block : ordered) {
+            attr_count += block->tag.attrs.size();
+        }
+        out.blocks.resize(ordered.size());
+        out.attrs.reserve(attr_count);
+        for (size_t b = 0; b < ordered.size(); b++) {
+            const Block& block = *ordered[b];
+            const Tag& tag = block.tag;
+            VueBlockSnapshot& snapshot = out.blocks[b];
+            snapshot.type = str(tag.name);
+            snapshot.content = block.is_dedented ? store(out, block.dedented) : str(block.content);
+            snapshot.lang = str(tag.value("lang"));
+            snapshot.src = str(tag.value("src"));
+            snapshot.loc = block.loc;
+            if (tag.name == "style") {
+                snapshot.scoped = tag.find("scoped") != nullptr;
+                snapshot.has_module = tag.find("module") != nullptr;
+                snapshot.module = str(tag.value("module"));
+            } else if (tag.name == "script") {
+                snapshot.has_setup = tag.find("setup") != nullptr;
+                snapshot.setup = str(tag.value("setup"));
+            }
+
+            snapshot.attrs = tag.attrs.empty() ? nullptr : out.attrs.data() + out.attrs.size();
+            snapshot.attrs_count = tag.attrs.size();
+            for (const auto& attr : tag.attrs) {
+                out.attrs.push_back(VueBlockAttr{str(attr.name), str(attr.value), attr.is_bool});
+            }
+        }
+
+        for (auto& name : css_vars) {
+            out.css_vars.push_back(store(out, std::move(name)));
+        }
+
+        auto& view = out.view;
+        view.filename = str(filename);
+        view.source = str(src_);
+        view.slotted = slotted;
+        const VueBlockSnapshot* next = out.blocks.data();
+        auto take = [&](int index) -> const VueBlockSnapshot* {
+            return index >= 0 ? next++ : nullptr;
+        };
+        view.template_block = take(template_index);
+        view.script = take(script_index);
+        view.script_setup = take(script_setup_index);
+        view.styles = styles.empty() ? nullptr : next;
+        view.styles_count = styles.size();
+        next += styles.size();
+        view.custom_blocks = custom_blocks.empty() ? nullptr : next;
+        view.custom_blocks_count = custom_blocks.size();
+        view.css_vars = out.css_vars.empty() ? nullptr : out.css_vars.data();
+        view.css_vars_count = out.css_vars.size();
+        return true;
+    }
+
+private:
+    static VueStr str(std::string_view s) {
+        return s.empty() ? VueStr{"", 0} : VueStr{s.data(), s.size()};
+    }
+
+    static VueStr store(DescriptorSnapshot& out, std::string s) {
+        out.strings.push_back(std::move(s));
+        const auto& stored = out.strings.back();
+        return VueStr{stored.data(), stored.size()};
+    }
+
+    /**
+     * Skips the comment opening at `lt`. Like the tokenizer, the `--` of
+     * `<!--` may also end it, so `<!-->` is a complete comment.
+     *
+     * @return The index past the comment, or npos for an unclosed comment
+     *         or another `<!` declaration.
+     */
+    size_t skip_comment(size_t lt) const {
+        if (src_.compare(lt, 4, "<!--") != 0) {
+            return npos;
+        }
+        size_t close = src_.find("-->", lt + 2);
+        return close == npos ? npos : close + 3;
+    }
+
+    /**
+     * Reads the start tag at `lt`.
+     *
+     * Root tags are also checked for everything sfcParse() would report or
+     * treat specially: directives, entities, duplicate or malformed
+     * attributes, and names the scanner does not match case-insensitively.
+     */
+    bool read_tag(size_t lt, bool root, Tag& tag) const {
+        size_t n = src_.size();
+        size_t i = lt + 1;
+        while (i < n && !is_space(src_[i]) && src_[i] != '/' && src_[i] != '>') {
+            i++;
+        }
+        if (i == n) {
+            return false;
+        }
+        tag.name = src_.substr(lt + 1, i - lt - 1);
+        if (root) {
+            for (char c : tag.name) {
+                if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-')) {
+                    return false;
+                }
+            }
+        }
+
+        for (;;) {
+            while (i < n && is_space(src_[i])) {
+                i++;
+            }
+            if (i == n) {
+                return false;
+            }
+            if (src_[i] == '>') {
+                tag.end = i + 1;
+                return true;
+            }
+            if (src_[i] == '/') {
+                if (i + 1 < n && src_[i + 1] == '>') {
+                    tag.self_closing = true;
+                    tag.end = i + 2;
+                    return true;
+                }
+                if (root) {
+                    return false;
+                }
+                i++;
+                continue;
+            }
+
+            // The first character always starts the name, even a `=`.
+            size_t name_start = i++;
+            while (i < n && !is_space(src_[i]) && src_[i] != '=' && src_[i] != '/'
+                   && src_[i] != '>') {
+                i++;
+            }
+            Attr attr;
+            attr.name = src_.substr(name_start, i - name_start);
+            while (i < n && is_space(src_[i])) {
+                i++;
+            }
+            bool unquoted = false;
+            if (i < n && src_[i] == '=') {
+                i++;
+                while (i < n && is_space(src_[i])) {
+                    i++;
+                }
+                if (i == n) {
+                    return false;
+                }
+                char quote = src_[i];
+                if (quote == '"' || quote == '\'') {
+                    size_t close = src_.find(quote, i + 1);
+                    if (close == npos) {
+                        return false;
+                    }
+                    attr.value = src_.substr(i + 1, close - i - 1);
+                    i = close + 1;
+                } else {
+                    size_t value_start = i;
+                    while (i < n && !is_space(src_[i]) && src_[i] != '>') {
+                        i++;
+                    }
+                    attr.value = src_.substr(value_start, i - value_start);
+                    unquoted = true;
+                }
+                attr.is_bool = attr.value.empty();
+            }
+
+            if (root && !is_plain_block_attr(tag, attr, unquoted)) {
+                return false;
+            }
+            tag.attrs.push_back(attr);
+        }
+    }
+
+    /// Checks a root tag attribute against what read_tag() documents.
+    static bool is_plain_block_attr(const Tag& tag, const Attr& attr, bool unquoted) {
+        std::string_view name = attr.name;
+        char first = name.front();
+        if (first == ':' || first == '@' || first == '#' || first == '.' || first == '='
+            || name.compare(0, 2, "v-") == 0) {
+            return false;
+        }
+        if (name.find_first_of("\"'<") != npos || name == "__proto__") {
+            return false;
+        }
+        if (name.find_first_not_of("0123456789") == npos) {
+            // Integer keys would come first in the attrs object.
+            return false;
+        }
+        if (attr.value.find('&') != npos
+            || (unquoted && attr.value.find_first_of("\"'<=`") != npos)) {
+            return false;
+        }
+        return tag.find(name) == nullptr;
+    }
+
+    /**
+     * Finds the `</name` that closes a raw-text element, matching like the
+     * tokenizer: each source character is compared with `| 0x20`, and the
+     * name must be followed by `>` or whitespace.
+     *
+     * @param name The lowercase element name.
+     * @return The index of the `<`, or npos if the element is not closed.
+     */
+    size_t find_raw_close(std::string_view name, size_t from) const {
+        for (size_t lt = find_lt(src_, from); lt != npos; lt = find_lt(src_, lt + 1)) {
+            size_t after = lt + 2 + name.size();
+            if (after >= src_.size() || src_[lt + 1] != '/') {
+                continue;
+            }
+            bool match = true;
+            for (size_t k = 0; k < name.size() && match; k++) {
+                match = (src_[lt + 2 + k] | 0x20) == name[k];
+            }
+            if (match && (src_[after] == '>' || is_space(src_[after]))) {
+                return lt;
+            }
+        }
+        return npos;
+    }
+
+    /// Like find_raw_close(), skipping interpolations as <textarea> and <title> do.
+    size_t find_rcdata_close(std::string_view name, size_t from) const {
+        for (;;) {
+            size_t close = find_raw_close(name, from);
+            size_t open = src_.find("{{", from);
+            if (close == npos || open == npos || open > close) {
+                return close;
+            }
+            size_t end = src_.find("}}", open + 2);
+            if (end == npos) {
+                return npos;
+            }
+            from = end + 2;
+        }
+    }
+
+    /**
+     * Finds the `</template` that closes an HTML root template whose
+     * content starts at `from`, tracking nested templates, comments,
+     * interpolations and raw-text elements.
+     *
+     * @return The index of the `<`, or npos if the template is not closed
+     *         or its markup needs the parser.
+     */
+    size_t find_template_close(size_t from) const {
+        size_t depth = 0;
+        bool foreign = false;
+        // A trailing comment is not part of the inner range if the parser
+        // drops comments, so a template ending with one is left to it.
+        bool after_comment = false;
+        size_t interpolation = src_.find("{{", from);
+        for (size_t i = from;;) {
+            if (interpolation != npos && interpolation < i) {
+                interpolation = src_.find("{{", i);
+            }
+            size_t lt = find_lt(src_, i);
+            if (interpolation != npos && (lt == npos || interpolation < lt)) {
+                size_t end = src_.find("}}", interpolation + 2);
+                if (end == npos) {
+                    return npos;
+                }
+                i = end + 2;
+                after_comment = false;
+                continue;
+            }
+            if (lt == npos) {
+                return npos;
+            }
+            if (lt > i) {
+                after_comment = false;
+            }
+
+            char next = lt + 1 < src_.size() ? src_[lt + 1] : '\0';
+            if (next == '!') {
+                i = skip_comment(lt);
+                if (i == npos) {
+                    return npos;
+                }
+                after_comment = true;
+                continue;
+            }
+            if (next == '?') {
+                return npos;
+            }
+            if (next == '/') {
+                size_t name_start = lt + 2;
+                if (name_start == src_.size() || !is_tag_start(src_[name_start])) {
+                    return npos;
+                }
+                size_t name_end = name_start;
+                while (name_end < src_.size() && !is_space(src_[name_end])
+                       && src_[name_end] != '>') {
+                    name_end++;
+                }
+                if (is_tag(src_.substr(name_start, name_end - name_start), "template")) {
+                    if (depth == 0) {
+                        return after_comment ? npos : lt;
+                    }
+                    depth--;
+                }
+                size_t gt = src_.find('>', name_end);
+                if (gt == npos) {
+                    return npos;
+                }
+                i = gt + 1;
+                after_comment = false;
+                continue;
+            }
+            if (!is_tag_start(next)) {
+                i = lt + 1;
+                after_comment = false;
+                continue;
+            }
+
+            Tag tag;
+            if (!read_tag(lt, false, tag) || tag.find("v-pre")) {
+                return npos;
+            }
+            i = tag.end;
+            after_comment = false;
+            if (is_tag(tag.name, "svg") || is_tag(tag.name, "math")) {
+                foreign = true;
+            }
+            if (is_tag(tag.name, "template") && !tag.self_closing) {
+                depth++;
+            }
+
+            bool raw = is_tag(tag.name, "script") || is_tag(tag.name, "style");
+            bool rcdata = is_tag(tag.name, "textarea") || is_tag(tag.name, "title");
+            if ((raw || rcdata) && !tag.self_closing) {
+                if (foreign) {
+                    // Not raw text inside <svg> or <math>.
+                    return npos;
+                }
+                std::string lower(tag.name.size(), '\0');
+                for (size_t k = 0; k < tag.name.size(); k++) {
+                    char c = tag.name[k];
+                    lower[k] = c >= 'A' && c <= 'Z' ? c + 32 : c;
+                }
+                size_t close = raw ? find_raw_close(lower, i) : find_rcdata_close(lower, i);
+                size_t gt = close == npos ? npos : src_.find('>', close + 2 + lower.size());
+                if (gt == npos) {
+                    return npos;
+                }
+                i = gt + 1;
+            }
+        }
+    }
+
+    /**
+     * De-indents a pug template like compiler-sfc's dedent(): the smallest
+     * indentation of the non-blank lines is removed from every line.
+     */
+    static bool dedent(Block& block) {
+        std::string_view content = block.content;
+        std::vector<std::string_view> lines;
+        for (size_t start = 0;;) {
+            size_t eol = content.find('\n', start);
+            lines.push_back(content.substr(start, eol == npos ? npos : eol - start));
+            if (eol == npos) {
+                break;
+            }
+            start = eol + 1;
+        }
+
+        size_t min_indent = npos;
+        for (auto line : lines) {
+            auto indent = leading_js_space(line);
+            if (indent.first != line.size() && indent.second < min_indent) {
+                min_indent = indent.second;
+            }
+        }
+        if (min_indent == 0) {
+            return true;
+        }
+
+        std::string out;
+        out.reserve(content.size());
+        for (size_t l = 0; l < lines.size(); l++) {
+            std::string_view line = lines[l];
+            size_t skip = 0;
+            for (size_t k = 0; k < min_indent && skip < line.size(); k++) {
+                // Removed characters are whitespace, one UTF-16 unit each.
+                skip += utf8_length(static_cast<unsigned char>(line[skip]));
+            }
+            if (l > 0) {
+                out += '\n';
+            }
+            out.append(line.substr(std::min(skip, line.size())));
+        }
+        block.dedented = std::move(out);
+        block.is_dedented = true;
+        return true;
+    }
+
+    std::string_view src_;
+    PositionCursor positions_;
+};
+
+}  // namespace
+
+bool scan_sfc(std::string_view source, std::string_view filename, DescriptorSnapshot& out) {
+    out = DescriptorSnapshot{};
+    Scanner scanner(source);
+    if (!scanner.run(filename, out)) {
+        out = DescriptorSnapshot{};
+        return false;
+    }
+    return true;
+}
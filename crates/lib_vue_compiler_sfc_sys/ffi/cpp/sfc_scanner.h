@@ -0,0 +1,36 @@
+/**
+ * @file sfc_scanner.h
+ * @brief Native SFC block splitter.
+ *
+ * This header is NOT part of the public API. It is only included by
+ * descriptor_buffer.cpp, vue_sfc.cpp and sfc_scanner.cpp.
+ */
+
+#ifndef VUE_SFC_SCANNER_H
+#define VUE_SFC_SCANNER_H
+
+#include "runtime_internal.h"
+
+#include <string_view>
+
+/**
+ * Splits an SFC into its blocks without a runtime and fills `out` with the
+ * snapshot sfcParse() would produce: block contents, locations, attributes,
+ * CSS variables and the slotted flag.
+ *
+ * Template markup is only scanned for the end of the template block, not
+ * validated. Sources sfcParse() would report block-level errors for, and
+ * the rare constructs the scanner does not reproduce (directives or
+ * entities on block tags, v-pre, raw-text elements inside SVG, non-ASCII
+ * whitespace where trimming matters), make the function return false so
+ * the caller can fall back to the parser.
+ *
+ * @param source The SFC source (UTF-8).
+ * @param filename The filename stored in the snapshot.
+ * @param out Receives the snapshot. Its strings may point into `source`
+ *        and `filename`, which must outlive it.
+ * @return true if `out` matches what sfcParse() would produce.
+ */
+bool scan_sfc(std::string_view source, std::string_view filename, DescriptorSnapshot& out);
+
+#endif /* VUE_SFC_SCANNER_H */
@@ -4,7 +4,607 @@
  */
 
 #include "vue_sfc.h"
+#include "marshal.h"
 #include "runtime_internal.h"
+#include "scoped_css.h"
+#include "sfc_scanner.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * Builds the JS options object passed to the bridge from VueCompileOptions.
+ *
+ * @param rt The runtime (valid).
+ * @param options The caller's options, or nullptr for defaults.
+ */
+facebook::jsi::Object make_compile_options(
+    HermesRuntime rt,
+    const VueCompileOptions* options
+) {
+    VueCompileOptions defaults{};
+    const VueCompileOptions& opts = options ? *options : defaults;
+
+    auto& hermes = rt->runtime();
+    const auto& props = rt->props();
+    facebook::jsi::Object obj(hermes);
+    obj.setProperty(hermes, props.is_prod, opts.is_prod);
+    obj.setProperty(hermes, props.ssr, opts.ssr);
+    obj.setProperty(hermes, props.source_map, opts.source_map);
+    obj.setProperty(hermes, props.keep_ast, opts.keep_template_ast);
+    obj.setProperty(hermes, props.keep_preamble, opts.keep_preamble);
+    obj.setProperty(hermes, props.keep_tips, opts.keep_tips);
+    obj.setProperty(hermes, props.inline_template, opts.inline_template);
+    return obj;
+}
+
+/**
+ * Serializes an object-valued property of a result with JSON.stringify.
+ *
+ * @return The JSON cached on the handle, or "" if the property is absent.
+ */
+const char* stringify_property(
+    HermesRuntime rt,
+    HermesHandle handle,
+    facebook::jsi::PropNameID PropNames::*name
+) {
+    if (!rt) {
+        return "";
+    }
+
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return "";
+    }
+
+    // Memoized per property: the interned name's address is the accessor key.
+    const auto& propName = rt->props().*name;
+    if (const char* cached = entry->strings.find(&propName, 0)) {
+        return cached;
+    }
+
+    auto& hermes = rt->runtime();
+    auto prop = entry->value->getObject(hermes).getProperty(hermes, propName);
+    if (!prop.isObject()) {
+        return "";
+    }
+
+    auto json = rt->json_stringify_fn->call(hermes, prop);
+    if (!json.isString()) {
+        return "";
+    }
+
+    return entry->strings.store(&propName, 0, read_js_string(hermes, json));
+}
+
+// ----------------------------------------------------------------------------
+// Bulk accessor helpers
+// ----------------------------------------------------------------------------
+
+/**
+ * Calls the callback for every entry of the array property `name` of a
+ * result. Strings are passed as-is; error objects contribute their
+ * `message`; other entries are skipped.
+ */
+size_t for_each_string(
+    HermesRuntime rt,
+    HermesHandle handle,
+    facebook::jsi::PropNameID PropNames::*name,
+    VueStrCallback callback,
+    void* user_data
+) {
+    if (!rt || !callback) {
+        return 0;
+    }
+
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    const auto& props = rt->props();
+    auto prop = entry->value->getObject(hermes).getProperty(hermes, props.*name);
+    if (!prop.isObject()) {
+        return 0;
+    }
+
+    auto arr = prop.getObject(hermes).getArray(hermes);
+    size_t len = arr.size(hermes);
+    size_t visited = 0;
+    std::string text;
+
+    for (size_t i = 0; i < len; i++) {
+        auto item = arr.getValueAtIndex(hermes, i);
+        if (item.isObject()) {
+            item = item.getObject(hermes).getProperty(hermes, props.message);
+        }
+        if (!item.isString()) {
+            continue;
+        }
+
+        text = read_js_string(hermes, item);
+        VUE_STATS_ADD(rt, bytes_out, text.size());
+        visited++;
+        if (!callback(user_data, VueStr{text.data(), text.size()})) {
+            break;
+        }
+    }
+
+    return visited;
+}
+
+/**
+ * Streams a string-valued property of a result to `sink` straight from the
+ * JS value, bypassing the handle's string cache.
+ *
+ * @return The bytes passed to the sink, or 0 if the property is absent.
+ */
+template <typename Sink>
+size_t write_string_property(
+    HermesRuntime rt,
+    HermesHandle handle,
+    facebook::jsi::PropNameID PropNames::*name,
+    Sink&& sink
+) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto value = entry->value->getObject(hermes).getProperty(hermes, rt->props().*name);
+    if (!value.isString()) {
+        return 0;
+    }
+
+    size_t written = write_js_string(hermes, value.getString(hermes), sink);
+    VUE_STATS_ADD(rt, bytes_out, written);
+    return written;
+}
+
+/// Backs the *_copy accessors: fills the buffer and returns the full length.
+size_t copy_string_property(
+    HermesRuntime rt,
+    HermesHandle handle,
+    facebook::jsi::PropNameID PropNames::*name,
+    char* buffer,
+    size_t capacity
+) {
+    size_t offset = 0;
+    return write_string_property(rt, handle, name, [&](const char* data, size_t len) {
+        if (offset < capacity) {
+            std::memcpy(buffer + offset, data, std::min(len, capacity - offset));
+        }
+        offset += len;
+        return true;
+    });
+}
+
+/// Backs the *_write accessors: forwards each chunk to the callback.
+size_t stream_string_property(
+    HermesRuntime rt,
+    HermesHandle handle,
+    facebook::jsi::PropNameID PropNames::*name,
+    VueStrCallback callback,
+    void* user_data
+) {
+    if (!callback) {
+        return 0;
+    }
+    return write_string_property(rt, handle, name, [&](const char* data, size_t len) {
+        return callback(user_data, VueStr{data, len});
+    });
+}
+
+/// Reads a string property as UTF-8, or "" if it is not a string.
+std::string string_property(
+    facebook::jsi::Runtime& hermes,
+    const facebook::jsi::Object& obj,
+    const facebook::jsi::PropNameID& name
+) {
+    auto value = obj.getProperty(hermes, name);
+    return value.isString() ? read_js_string(hermes, value) : std::string();
+}
+
+/// Reads a boolean property, treating anything but `true` as false.
+bool bool_property(
+    facebook::jsi::Runtime& hermes,
+    const facebook::jsi::Object& obj,
+    const facebook::jsi::PropNameID& name
+) {
+    auto value = obj.getProperty(hermes, name);
+    return value.isBool() && value.getBool();
+}
+
+// ----------------------------------------------------------------------------
+// Descriptor snapshot helpers
+// ----------------------------------------------------------------------------
+
+/// Stores a string in the snapshot and returns a view of it.
+VueStr store_string(DescriptorSnapshot& snap, std::string&& str) {
+    snap.strings.push_back(std::move(str));
+    const auto& stored = snap.strings.back();
+    return VueStr{stored.data(), stored.size()};
+}
+
+/// Reads a string property into the snapshot; non-strings become empty.
+VueStr read_string(
+    facebook::jsi::Runtime& hermes,
+    DescriptorSnapshot& snap,
+    const facebook::jsi::Object& obj,
+    const facebook::jsi::PropNameID& name
+) {
+    auto value = obj.getProperty(hermes, name);
+    if (!value.isString()) {
+        return VueStr{"", 0};
+    }
+    return store_string(snap, read_js_string(hermes, value));
+}
+
+/// Reads a numeric property as size_t; non-numbers become 0.
+size_t read_size(
+    facebook::jsi::Runtime& hermes,
+    const facebook::jsi::Object& obj,
+    const facebook::jsi::PropNameID& name
+) {
+    auto value = obj.getProperty(hermes, name);
+    return value.isNumber() ? static_cast<size_t>(value.getNumber()) : 0;
+}
+
+/// Reads a { offset, line, column } position object.
+VuePosition read_position(
+    facebook::jsi::Runtime& hermes,
+    const PropNames& props,
+    const facebook::jsi::Value& value
+) {
+    VuePosition pos{0, 0, 0};
+    if (!value.isObject()) {
+        return pos;
+    }
+    auto obj = value.getObject(hermes);
+    pos.offset = read_size(hermes, obj, props.offset);
+    pos.line = read_size(hermes, obj, props.line);
+    pos.column = read_size(hermes, obj, props.column);
+    return pos;
+}
+
+/**
+ * Maps UTF-16 code unit offsets (as reported by JS) to UTF-8 byte offsets in
+ * a borrowed source buffer.
+ *
+ * Pure-ASCII sources map 1:1. Otherwise a forward cursor decodes the buffer;
+ * queries in ascending order cost one pass in total.
+ */
+class Utf16ByteMapper {
+public:
+    Utf16ByteMapper(const char* data, size_t len)
+        : data_(reinterpret_cast<const unsigned char*>(data)),
+          len_(len),
+          ascii_(is_ascii(data, len)) {}
+
+    /// Returns the byte offset of a UTF-16 offset, clamped to the buffer.
+    size_t to_byte(size_t utf16) {
+        if (ascii_) {
+            return utf16 < len_ ? utf16 : len_;
+        }
+        if (utf16 < cursor_utf16_) {
+            cursor_byte_ = 0;
+            cursor_utf16_ = 0;
+        }
+        while (cursor_utf16_ < utf16 && cursor_byte_ < len_) {
+            unsigned char lead = data_[cursor_byte_];
+            size_t bytes = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+            cursor_byte_ += bytes;
+            cursor_utf16_ += bytes == 4 ? 2 : 1;
+        }
+        return cursor_byte_ < len_ ? cursor_byte_ : len_;
+    }
+
+private:
+    const unsigned char* data_;
+    size_t len_;
+    bool ascii_;
+    size_t cursor_byte_ = 0;
+    size_t cursor_utf16_ = 0;
+};
+
+/**
+ * Borrowed-mode context for a snapshot build. `source.data` is null when the
+ * descriptor was parsed without vue_parse_borrowed().
+ */
+struct BorrowContext {
+    BorrowedSource source;
+    Utf16ByteMapper mapper;
+};
+
+/// Attribute range of a block inside DescriptorSnapshot::attrs.
+struct AttrRange {
+    size_t begin;
+    size_t count;
+};
+
+/**
+ * Reads one SFC block into the snapshot.
+ *
+ * Attributes are appended to snap.attrs; the returned range is resolved to a
+ * pointer once all blocks have been read.
+ */
+AttrRange read_block(
+    facebook::jsi::Runtime& hermes,
+    const PropNames& props,
+    DescriptorSnapshot& snap,
+    BorrowContext& borrow,
+    const facebook::jsi::Object& block,
+    VueBlockSnapshot& out
+) {
+    out = VueBlockSnapshot{};
+    out.type = read_string(hermes, snap, block, props.type);
+    out.lang = read_string(hermes, snap, block, props.lang);
+    out.src = read_string(hermes, snap, block, props.src);
+
+    auto loc = block.getProperty(hermes, props.loc);
+    if (loc.isObject()) {
+        auto locObj = loc.getObject(hermes);
+        out.loc.start = read_position(hermes, props, locObj.getProperty(hermes, props.start));
+        out.loc.end = read_position(hermes, props, locObj.getProperty(hermes, props.end));
+    }
+
+    // The bridge flags blocks whose content is exactly source[start, end).
+    auto isSlice = borrow.source.data
+        ? block.getProperty(hermes, props.content_is_slice)
+        : facebook::jsi::Value(false);
+    if (isSlice.isBool() && isSlice.getBool()) {
+        size_t begin = borrow.mapper.to_byte(out.loc.start.offset);
+        size_t end = borrow.mapper.to_byte(out.loc.end.offset);
+        out.content = VueStr{borrow.source.data + begin, end - begin};
+        out.content_borrowed = true;
+        out.content_offset = begin;
+    } else {
+        out.content = read_string(hermes, snap, block, props.content);
+    }
+
+    auto scoped = block.getProperty(hermes, props.scoped);
+    out.scoped = scoped.isBool() && scoped.getBool();
+
+    auto module = block.getProperty(hermes, props.module);
+    out.has_module = !module.isNull() && !module.isUndefined();
+    out.module = module.isString()
+        ? store_string(snap, read_js_string(hermes, module))
+        : VueStr{"", 0};
+
+    auto setup = block.getProperty(hermes, props.setup);
+    out.has_setup = !setup.isNull() && !setup.isUndefined();
+    out.setup = setup.isString()
+        ? store_string(snap, read_js_string(hermes, setup))
+        : VueStr{"", 0};
+
+    AttrRange range{snap.attrs.size(), 0};
+    auto attrs = block.getProperty(hermes, props.attrs);
+    if (!attrs.isObject()) {
+        return range;
+    }
+
+    auto attrsObj = attrs.getObject(hermes);
+    auto names = attrsObj.getPropertyNames(hermes);
+    size_t count = names.size(hermes);
+    for (size_t i = 0; i < count; i++) {
+        auto key = names.getValueAtIndex(hermes, i).getString(hermes);
+        auto value = attrsObj.getProperty(hermes, key);
+
+        VueBlockAttr attr{};
+        attr.key = store_string(snap, read_js_string(hermes, key));
+        if (value.isString()) {
+            attr.value = store_string(snap, read_js_string(hermes, value));
+        } else {
+            attr.value = VueStr{"", 0};
+            attr.is_bool = value.isBool() && value.getBool();
+        }
+        snap.attrs.push_back(attr);
+    }
+    range.count = count;
+    return range;
+}
+
+/// Builds the full snapshot of a descriptor object.
+std::unique_ptr<DescriptorSnapshot> build_descriptor_snapshot(
+    facebook::jsi::Runtime& hermes,
+    const PropNames& props,
+    const facebook::jsi::Object& desc,
+    const BorrowedSource& borrowed
+) {
+    auto snap = std::make_unique<DescriptorSnapshot>();
+    auto& view = snap->view;
+    BorrowContext borrow{borrowed, Utf16ByteMapper(borrowed.data, borrowed.len)};
+
+    view.filename = read_string(hermes, *snap, desc, props.filename);
+    view.source = borrowed.data
+        ? VueStr{borrowed.data, borrowed.len}
+        : read_string(hermes, *snap, desc, props.source);
+
+    auto slotted = desc.getProperty(hermes, props.slotted);
+    view.slotted = slotted.isBool() && slotted.getBool();
+
+    // Collect block objects first so the blocks vector is sized exactly once.
+    std::vector<facebook::jsi::Object> blockObjs;
+    int templateIdx = -1;
+    int scriptIdx = -1;
+    int scriptSetupIdx = -1;
+
+    auto takeSingle = [&](const facebook::jsi::PropNameID& name, int& idx) {
+        auto value = desc.getProperty(hermes, name);
+        if (value.isObject()) {
+            idx = static_cast<int>(blockObjs.size());
+            blockObjs.push_back(value.getObject(hermes));
+        }
+    };
+    takeSingle(props.template_block, templateIdx);
+    takeSingle(props.script, scriptIdx);
+    takeSingle(props.script_setup, scriptSetupIdx);
+
+    auto takeList = [&](const facebook::jsi::PropNameID& name) -> std::pair<size_t, size_t> {
+        size_t begin = blockObjs.size();
+        auto value = desc.getProperty(hermes, name);
+        if (!value.isObject()) {
+            return {begin, 0};
+        }
+        auto arr = value.getObject(hermes).getArray(hermes);
+        size_t count = arr.size(hermes);
+        for (size_t i = 0; i < count; i++) {
+            blockObjs.push_back(arr.getValueAtIndex(hermes, i).getObject(hermes));
+        }
+        return {begin, count};
+    };
+    auto styles = takeList(props.styles);
+    auto customBlocks = takeList(props.custom_blocks);
+
+    snap->blocks.resize(blockObjs.size());
+    std::vector<AttrRange> ranges;
+    ranges.reserve(blockObjs.size());
+    for (size_t i = 0; i < blockObjs.size(); i++) {
+        ranges.push_back(read_block(hermes, props, *snap, borrow, blockObjs[i], snap->blocks[i]));
+    }
+
+    // snap->attrs is complete; resolve attribute ranges to pointers.
+    for (size_t i = 0; i < ranges.size(); i++) {
+        snap->blocks[i].attrs = ranges[i].count ? &snap->attrs[ranges[i].begin] : nullptr;
+        snap->blocks[i].attrs_count = ranges[i].count;
+    }
+
+    const VueBlockSnapshot* blocks = snap->blocks.data();
+    view.template_block = templateIdx >= 0 ? &blocks[templateIdx] : nullptr;
+    view.script = scriptIdx >= 0 ? &blocks[scriptIdx] : nullptr;
+    view.script_setup = scriptSetupIdx >= 0 ? &blocks[scriptSetupIdx] : nullptr;
+    view.styles = styles.second ? &blocks[styles.first] : nullptr;
+    view.styles_count = styles.second;
+    view.custom_blocks = customBlocks.second ? &blocks[customBlocks.first] : nullptr;
+    view.custom_blocks_count = customBlocks.second;
+
+    auto cssVars = desc.getProperty(hermes, props.css_vars);
+    if (cssVars.isObject()) {
+        auto arr = cssVars.getObject(hermes).getArray(hermes);
+        size_t count = arr.size(hermes);
+        snap->css_vars.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            auto cssVar = arr.getValueAtIndex(hermes, i);
+            if (cssVar.isString()) {
+                snap->css_vars.push_back(store_string(*snap, read_js_string(hermes, cssVar)));
+            }
+        }
+    }
+    view.css_vars = snap->css_vars.empty() ? nullptr : snap->css_vars.data();
+    view.css_vars_count = snap->css_vars.size();
+
+    return snap;
+}
+
+/**
+ * Compiles a style with the native rewriter if the options ask for it and
+ * the rewriter handles the source.
+ *
+ * @return A handle to a result shaped like the bridge's compileStyle()
+ *         result, or 0 to fall back to the bridge.
+ */
+HermesHandle compile_style_natively(
+    HermesRuntime rt,
+    std::string_view source,
+    std::string_view id,
+    bool scoped,
+    const VueCompileOptions* options
+) {
+    if (!options || !options->native_style) {
+        return 0;
+    }
+
+    std::string code;
+    if (!rewrite_plain_css(source, id, scoped, options->is_prod, code)) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    const auto& props = rt->props();
+    facebook::jsi::Object result(hermes);
+    result.setProperty(hermes, props.code, make_js_string(hermes, code.data(), code.size()));
+    result.setProperty(hermes, props.errors, facebook::jsi::Array(hermes, 0));
+    result.setProperty(hermes, props.dependencies, facebook::jsi::Array(hermes, 0));
+    return rt->allocate_handle(facebook::jsi::Value(hermes, result));
+}
+
+// ----------------------------------------------------------------------------
+// Dependency scan helpers
+// ----------------------------------------------------------------------------
+
+/// Copies a string into `strings` and returns a view of the copy.
+VueStr store_owned(std::deque<std::string>& strings, std::string_view str) {
+    strings.emplace_back(str);
+    const auto& stored = strings.back();
+    return VueStr{stored.data(), stored.size()};
+}
+
+/**
+ * Copies the messages of a JS array of errors into `out`. Strings are taken
+ * as-is and error objects contribute their `message`.
+ */
+void store_messages(
+    facebook::jsi::Runtime& hermes,
+    const PropNames& props,
+    const facebook::jsi::Value& list,
+    std::deque<std::string>& strings,
+    std::vector<VueStr>& out
+) {
+    if (!list.isObject()) {
+        return;
+    }
+
+    auto arr = list.getObject(hermes).getArray(hermes);
+    size_t len = arr.size(hermes);
+    for (size_t i = 0; i < len; i++) {
+        auto item = arr.getValueAtIndex(hermes, i);
+        if (item.isObject()) {
+            item = item.getObject(hermes).getProperty(hermes, props.message);
+        }
+        if (item.isString()) {
+            out.push_back(store_owned(strings, read_js_string(hermes, item)));
+        }
+    }
+}
+
+/// Sets a script block's content and lang at `index`; absent blocks stay
+/// undefined.
+void set_script_input(
+    facebook::jsi::Runtime& hermes,
+    facebook::jsi::Array& contents,
+    facebook::jsi::Array& langs,
+    size_t index,
+    const VueBlockSnapshot* block
+) {
+    if (!block) {
+        return;
+    }
+    contents.setValueAtIndex(
+        hermes, index, make_js_string(hermes, block->content.data, block->content.len));
+    langs.setValueAtIndex(
+        hermes, index, make_js_string(hermes, block->lang.data, block->lang.len));
+}
+
+}  // namespace
 
 // ============================================================================
 // Parsing
@@ -13,27 +613,65 @@
 extern "C" HermesHandle vue_parse(
     HermesRuntime rt,
     const char* source, size_t source_len,
-    const char* filename, size_t filename_len
+    const char* filename, size_t filename_len,
+    const VueCompileOptions* options
 ) {
     if (!rt) {
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+
     auto& hermes = rt->runtime();
-    auto jsSource = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(source), source_len);
-    auto jsFilename = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(filename), filename_len);
-    auto result = rt->parse_fn->call(hermes, jsSource, jsFilename);
+    auto jsSource = make_js_string(hermes, source, source_len);
+    auto jsFilename = make_js_string(hermes, filename, filename_len);
+    auto jsOptions = make_compile_options(rt, options);
+    VUE_STATS_ADD(rt, bytes_in, source_len + filename_len);
+    if (!rt->require_units(VUE_UNIT_PARSE)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, parse,
+        rt->parse_fn->call(hermes, jsSource, jsFilename, jsOptions));
 
     return rt->allocate_handle(std::move(result));
 }
 
+extern "C" HermesHandle vue_parse_borrowed(
+    HermesRuntime rt,
+    const char* source, size_t source_len,
+    const char* filename, size_t filename_len,
+    const VueCompileOptions* options
+) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    auto& hermes = rt->runtime();
+    auto jsSource = make_js_string(hermes, source, source_len);
+    auto jsFilename = make_js_string(hermes, filename, filename_len);
+    auto jsOptions = make_compile_options(rt, options);
+    VUE_STATS_ADD(rt, bytes_in, source_len + filename_len);
+    if (!rt->require_units(VUE_UNIT_PARSE)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, parse,
+        rt->parse_fn->call(hermes, jsSource, jsFilename, jsOptions, true));
+
+    HermesHandle handle = rt->allocate_handle(std::move(result));
+    rt->get_handle(handle)->borrowed = BorrowedSource{source, source_len};
+    return handle;
+}
+
 extern "C" HermesHandle vue_parse_result_descriptor(HermesRuntime rt, HermesHandle handle) {
     if (!rt) {
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -41,13 +679,15 @@ extern "C" HermesHandle vue_parse_result_descriptor(HermesRuntime rt, HermesHand
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto desc = obj.getProperty(hermes, "descriptor");
+    auto desc = obj.getProperty(hermes, rt->props().descriptor);
 
     if (desc.isNull() || desc.isUndefined()) {
         return 0;
     }
 
-    return rt->allocate_handle(std::move(desc));
+    HermesHandle descHandle = rt->allocate_handle(std::move(desc));
+    rt->get_handle(descHandle)->borrowed = entry->borrowed;
+    return descHandle;
 }
 
 extern "C" size_t vue_parse_result_error_count(HermesRuntime rt, HermesHandle handle) {
@@ -55,6 +695,9 @@ extern "C" size_t vue_parse_result_error_count(HermesRuntime rt, HermesHandle ha
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -62,7 +705,7 @@ extern "C" size_t vue_parse_result_error_count(HermesRuntime rt, HermesHandle ha
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto errors = obj.getProperty(hermes, "errors");
+    auto errors = obj.getProperty(hermes, rt->props().errors);
 
     if (!errors.isObject()) {
         return 0;
@@ -76,22 +719,29 @@ extern "C" const char* vue_parse_result_error_message(HermesRuntime rt, HermesHa
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto errors = obj.getProperty(hermes, "errors").getObject(hermes).getArray(hermes);
+    auto errors = obj.getProperty(hermes, rt->props().errors).getObject(hermes).getArray(hermes);
 
     if (index >= errors.size(hermes)) {
         return "";
     }
 
     auto err = errors.getValueAtIndex(hermes, index).getObject(hermes);
-    auto msg = err.getProperty(hermes, "message").getString(hermes).utf8(hermes);
-    return rt->cache_string(handle, msg);
+    auto msg = read_js_string(hermes, err.getProperty(hermes, rt->props().message));
+    return entry->strings.store(__func__, index, msg);
 }
 
 // ============================================================================
@@ -103,6 +753,9 @@ extern "C" bool vue_descriptor_has_template(HermesRuntime rt, HermesHandle handl
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -110,7 +763,7 @@ extern "C" bool vue_descriptor_has_template(HermesRuntime rt, HermesHandle handl
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto tmpl = obj.getProperty(hermes, "template");
+    auto tmpl = obj.getProperty(hermes, rt->props().template_block);
     return !tmpl.isNull() && !tmpl.isUndefined();
 }
 
@@ -119,6 +772,9 @@ extern "C" bool vue_descriptor_has_script(HermesRuntime rt, HermesHandle handle)
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -126,7 +782,7 @@ extern "C" bool vue_descriptor_has_script(HermesRuntime rt, HermesHandle handle)
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto script = obj.getProperty(hermes, "script");
+    auto script = obj.getProperty(hermes, rt->props().script);
     return !script.isNull() && !script.isUndefined();
 }
 
@@ -135,6 +791,9 @@ extern "C" bool vue_descriptor_has_script_setup(HermesRuntime rt, HermesHandle h
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -142,7 +801,7 @@ extern "C" bool vue_descriptor_has_script_setup(HermesRuntime rt, HermesHandle h
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto script = obj.getProperty(hermes, "scriptSetup");
+    auto script = obj.getProperty(hermes, rt->props().script_setup);
     return !script.isNull() && !script.isUndefined();
 }
 
@@ -151,6 +810,9 @@ extern "C" size_t vue_descriptor_style_count(HermesRuntime rt, HermesHandle hand
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -158,7 +820,7 @@ extern "C" size_t vue_descriptor_style_count(HermesRuntime rt, HermesHandle hand
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto styles = obj.getProperty(hermes, "styles");
+    auto styles = obj.getProperty(hermes, rt->props().styles);
 
     if (!styles.isObject()) {
         return 0;
@@ -172,6 +834,9 @@ extern "C" HermesHandle vue_descriptor_template(HermesRuntime rt, HermesHandle h
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -179,7 +844,7 @@ extern "C" HermesHandle vue_descriptor_template(HermesRuntime rt, HermesHandle h
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto tmpl = obj.getProperty(hermes, "template");
+    auto tmpl = obj.getProperty(hermes, rt->props().template_block);
 
     if (tmpl.isNull() || tmpl.isUndefined()) {
         return 0;
@@ -193,6 +858,9 @@ extern "C" HermesHandle vue_descriptor_script(HermesRuntime rt, HermesHandle han
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -200,7 +868,7 @@ extern "C" HermesHandle vue_descriptor_script(HermesRuntime rt, HermesHandle han
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto script = obj.getProperty(hermes, "script");
+    auto script = obj.getProperty(hermes, rt->props().script);
 
     if (script.isNull() || script.isUndefined()) {
         return 0;
@@ -214,6 +882,9 @@ extern "C" HermesHandle vue_descriptor_script_setup(HermesRuntime rt, HermesHand
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -221,7 +892,7 @@ extern "C" HermesHandle vue_descriptor_script_setup(HermesRuntime rt, HermesHand
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto script = obj.getProperty(hermes, "scriptSetup");
+    auto script = obj.getProperty(hermes, rt->props().script_setup);
 
     if (script.isNull() || script.isUndefined()) {
         return 0;
@@ -235,6 +906,9 @@ extern "C" HermesHandle vue_descriptor_style_at(HermesRuntime rt, HermesHandle h
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -242,7 +916,7 @@ extern "C" HermesHandle vue_descriptor_style_at(HermesRuntime rt, HermesHandle h
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto styles = obj.getProperty(hermes, "styles").getObject(hermes).getArray(hermes);
+    auto styles = obj.getProperty(hermes, rt->props().styles).getObject(hermes).getArray(hermes);
 
     if (index >= styles.size(hermes)) {
         return 0;
@@ -257,6 +931,9 @@ extern "C" size_t vue_descriptor_custom_blocks_count(HermesRuntime rt, HermesHan
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -264,7 +941,7 @@ extern "C" size_t vue_descriptor_custom_blocks_count(HermesRuntime rt, HermesHan
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto customBlocks = obj.getProperty(hermes, "customBlocks");
+    auto customBlocks = obj.getProperty(hermes, rt->props().custom_blocks);
 
     if (!customBlocks.isObject()) {
         return 0;
@@ -278,6 +955,9 @@ extern "C" HermesHandle vue_descriptor_custom_block_at(HermesRuntime rt, HermesH
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -285,7 +965,7 @@ extern "C" HermesHandle vue_descriptor_custom_block_at(HermesRuntime rt, HermesH
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto customBlocks = obj.getProperty(hermes, "customBlocks").getObject(hermes).getArray(hermes);
+    auto customBlocks = obj.getProperty(hermes, rt->props().custom_blocks).getObject(hermes).getArray(hermes);
 
     if (index >= customBlocks.size(hermes)) {
         return 0;
@@ -300,6 +980,9 @@ extern "C" size_t vue_descriptor_css_vars_count(HermesRuntime rt, HermesHandle h
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -307,7 +990,7 @@ extern "C" size_t vue_descriptor_css_vars_count(HermesRuntime rt, HermesHandle h
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto cssVars = obj.getProperty(hermes, "cssVars");
+    auto cssVars = obj.getProperty(hermes, rt->props().css_vars);
 
     if (!cssVars.isObject()) {
         return 0;
@@ -321,14 +1004,21 @@ extern "C" const char* vue_descriptor_css_var_at(HermesRuntime rt, HermesHandle
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto cssVars = obj.getProperty(hermes, "cssVars");
+    auto cssVars = obj.getProperty(hermes, rt->props().css_vars);
 
     if (!cssVars.isObject()) {
         return "";
@@ -341,7 +1031,7 @@ extern "C" const char* vue_descriptor_css_var_at(HermesRuntime rt, HermesHandle
 
     auto cssVar = cssVarsArr.getValueAtIndex(hermes, index);
     if (cssVar.isString()) {
-        return rt->cache_string(handle, cssVar.getString(hermes).utf8(hermes));
+        return entry->strings.store(__func__, index, read_js_string(hermes, cssVar));
     }
 
     return "";
@@ -352,6 +1042,9 @@ extern "C" bool vue_descriptor_slotted(HermesRuntime rt, HermesHandle handle) {
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -359,7 +1052,7 @@ extern "C" bool vue_descriptor_slotted(HermesRuntime rt, HermesHandle handle) {
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto slotted = obj.getProperty(hermes, "slotted");
+    auto slotted = obj.getProperty(hermes, rt->props().slotted);
     return slotted.isBool() && slotted.getBool();
 }
 
@@ -368,20 +1061,27 @@ extern "C" const char* vue_descriptor_source(HermesRuntime rt, HermesHandle hand
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto source = obj.getProperty(hermes, "source");
+    auto source = obj.getProperty(hermes, rt->props().source);
 
     if (!source.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, source.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, source));
 }
 
 extern "C" const char* vue_descriptor_filename(HermesRuntime rt, HermesHandle handle) {
@@ -389,20 +1089,58 @@ extern "C" const char* vue_descriptor_filename(HermesRuntime rt, HermesHandle ha
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto filename = obj.getProperty(hermes, "filename");
+    auto filename = obj.getProperty(hermes, rt->props().filename);
 
     if (!filename.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, filename.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, filename));
+}
+
+// ============================================================================
+// Descriptor Snapshot
+// ============================================================================
+
+extern "C" const VueDescriptorSnapshot* vue_descriptor_materialize(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return nullptr;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return nullptr;
+    }
+
+    if (!entry->snapshot) {
+        auto& hermes = rt->runtime();
+        auto obj = entry->value->getObject(hermes);
+        entry->snapshot = build_descriptor_snapshot(hermes, rt->props(), obj, entry->borrowed);
+#ifdef VUE_FFI_STATS
+        for (const auto& str : entry->snapshot->strings) {
+            rt->stats.bytes_out += str.size();
+        }
+#endif
+    }
+
+    return &entry->snapshot->view;
 }
 
 // ============================================================================
@@ -414,20 +1152,27 @@ extern "C" const char* vue_block_content(HermesRuntime rt, HermesHandle handle)
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto content = obj.getProperty(hermes, "content");
+    auto content = obj.getProperty(hermes, rt->props().content);
 
     if (!content.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, content.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, content));
 }
 
 extern "C" const char* vue_block_lang(HermesRuntime rt, HermesHandle handle) {
@@ -435,20 +1180,27 @@ extern "C" const char* vue_block_lang(HermesRuntime rt, HermesHandle handle) {
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto lang = obj.getProperty(hermes, "lang");
+    auto lang = obj.getProperty(hermes, rt->props().lang);
 
     if (!lang.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, lang.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, lang));
 }
 
 extern "C" const char* vue_block_src(HermesRuntime rt, HermesHandle handle) {
@@ -456,20 +1208,27 @@ extern "C" const char* vue_block_src(HermesRuntime rt, HermesHandle handle) {
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto src = obj.getProperty(hermes, "src");
+    auto src = obj.getProperty(hermes, rt->props().src);
 
     if (!src.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, src.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, src));
 }
 
 extern "C" const char* vue_custom_block_type(HermesRuntime rt, HermesHandle handle) {
@@ -477,20 +1236,27 @@ extern "C" const char* vue_custom_block_type(HermesRuntime rt, HermesHandle hand
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto type = obj.getProperty(hermes, "type");
+    auto type = obj.getProperty(hermes, rt->props().type);
 
     if (!type.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, type.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, type));
 }
 
 // ============================================================================
@@ -502,6 +1268,9 @@ extern "C" size_t vue_block_loc_start_offset(HermesRuntime rt, HermesHandle hand
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -509,17 +1278,17 @@ extern "C" size_t vue_block_loc_start_offset(HermesRuntime rt, HermesHandle hand
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto loc = obj.getProperty(hermes, "loc");
+    auto loc = obj.getProperty(hermes, rt->props().loc);
     if (!loc.isObject()) {
         return 0;
     }
 
-    auto start = loc.getObject(hermes).getProperty(hermes, "start");
+    auto start = loc.getObject(hermes).getProperty(hermes, rt->props().start);
     if (!start.isObject()) {
         return 0;
     }
 
-    auto offset = start.getObject(hermes).getProperty(hermes, "offset");
+    auto offset = start.getObject(hermes).getProperty(hermes, rt->props().offset);
     if (!offset.isNumber()) {
         return 0;
     }
@@ -532,6 +1301,9 @@ extern "C" size_t vue_block_loc_start_line(HermesRuntime rt, HermesHandle handle
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -539,17 +1311,17 @@ extern "C" size_t vue_block_loc_start_line(HermesRuntime rt, HermesHandle handle
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto loc = obj.getProperty(hermes, "loc");
+    auto loc = obj.getProperty(hermes, rt->props().loc);
     if (!loc.isObject()) {
         return 0;
     }
 
-    auto start = loc.getObject(hermes).getProperty(hermes, "start");
+    auto start = loc.getObject(hermes).getProperty(hermes, rt->props().start);
     if (!start.isObject()) {
         return 0;
     }
 
-    auto line = start.getObject(hermes).getProperty(hermes, "line");
+    auto line = start.getObject(hermes).getProperty(hermes, rt->props().line);
     if (!line.isNumber()) {
         return 0;
     }
@@ -562,6 +1334,9 @@ extern "C" size_t vue_block_loc_start_column(HermesRuntime rt, HermesHandle hand
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -569,17 +1344,17 @@ extern "C" size_t vue_block_loc_start_column(HermesRuntime rt, HermesHandle hand
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto loc = obj.getProperty(hermes, "loc");
+    auto loc = obj.getProperty(hermes, rt->props().loc);
     if (!loc.isObject()) {
         return 0;
     }
 
-    auto start = loc.getObject(hermes).getProperty(hermes, "start");
+    auto start = loc.getObject(hermes).getProperty(hermes, rt->props().start);
     if (!start.isObject()) {
         return 0;
     }
 
-    auto column = start.getObject(hermes).getProperty(hermes, "column");
+    auto column = start.getObject(hermes).getProperty(hermes, rt->props().column);
     if (!column.isNumber()) {
         return 0;
     }
@@ -592,6 +1367,9 @@ extern "C" size_t vue_block_loc_end_offset(HermesRuntime rt, HermesHandle handle
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -599,17 +1377,17 @@ extern "C" size_t vue_block_loc_end_offset(HermesRuntime rt, HermesHandle handle
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto loc = obj.getProperty(hermes, "loc");
+    auto loc = obj.getProperty(hermes, rt->props().loc);
     if (!loc.isObject()) {
         return 0;
     }
 
-    auto end = loc.getObject(hermes).getProperty(hermes, "end");
+    auto end = loc.getObject(hermes).getProperty(hermes, rt->props().end);
     if (!end.isObject()) {
         return 0;
     }
 
-    auto offset = end.getObject(hermes).getProperty(hermes, "offset");
+    auto offset = end.getObject(hermes).getProperty(hermes, rt->props().offset);
     if (!offset.isNumber()) {
         return 0;
     }
@@ -622,6 +1400,9 @@ extern "C" size_t vue_block_loc_end_line(HermesRuntime rt, HermesHandle handle)
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -629,17 +1410,17 @@ extern "C" size_t vue_block_loc_end_line(HermesRuntime rt, HermesHandle handle)
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto loc = obj.getProperty(hermes, "loc");
+    auto loc = obj.getProperty(hermes, rt->props().loc);
     if (!loc.isObject()) {
         return 0;
     }
 
-    auto end = loc.getObject(hermes).getProperty(hermes, "end");
+    auto end = loc.getObject(hermes).getProperty(hermes, rt->props().end);
     if (!end.isObject()) {
         return 0;
     }
 
-    auto line = end.getObject(hermes).getProperty(hermes, "line");
+    auto line = end.getObject(hermes).getProperty(hermes, rt->props().line);
     if (!line.isNumber()) {
         return 0;
     }
@@ -652,6 +1433,9 @@ extern "C" size_t vue_block_loc_end_column(HermesRuntime rt, HermesHandle handle
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -659,17 +1443,17 @@ extern "C" size_t vue_block_loc_end_column(HermesRuntime rt, HermesHandle handle
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto loc = obj.getProperty(hermes, "loc");
+    auto loc = obj.getProperty(hermes, rt->props().loc);
     if (!loc.isObject()) {
         return 0;
     }
 
-    auto end = loc.getObject(hermes).getProperty(hermes, "end");
+    auto end = loc.getObject(hermes).getProperty(hermes, rt->props().end);
     if (!end.isObject()) {
         return 0;
     }
 
-    auto column = end.getObject(hermes).getProperty(hermes, "column");
+    auto column = end.getObject(hermes).getProperty(hermes, rt->props().column);
     if (!column.isNumber()) {
         return 0;
     }
@@ -686,6 +1470,9 @@ extern "C" size_t vue_block_attrs_count(HermesRuntime rt, HermesHandle handle) {
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -693,7 +1480,7 @@ extern "C" size_t vue_block_attrs_count(HermesRuntime rt, HermesHandle handle) {
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto attrs = obj.getProperty(hermes, "attrs");
+    auto attrs = obj.getProperty(hermes, rt->props().attrs);
 
     if (!attrs.isObject()) {
         return 0;
@@ -709,14 +1496,21 @@ extern "C" const char* vue_block_attrs_key_at(HermesRuntime rt, HermesHandle han
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto attrs = obj.getProperty(hermes, "attrs");
+    auto attrs = obj.getProperty(hermes, rt->props().attrs);
 
     if (!attrs.isObject()) {
         return "";
@@ -728,8 +1522,8 @@ extern "C" const char* vue_block_attrs_key_at(HermesRuntime rt, HermesHandle han
         return "";
     }
 
-    auto key = names.getValueAtIndex(hermes, index).getString(hermes).utf8(hermes);
-    return rt->cache_string(handle, key);
+    auto key = read_js_string(hermes, names.getValueAtIndex(hermes, index));
+    return entry->strings.store(__func__, index, key);
 }
 
 extern "C" const char* vue_block_attrs_value_at(HermesRuntime rt, HermesHandle handle, size_t index) {
@@ -737,14 +1531,21 @@ extern "C" const char* vue_block_attrs_value_at(HermesRuntime rt, HermesHandle h
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto attrs = obj.getProperty(hermes, "attrs");
+    auto attrs = obj.getProperty(hermes, rt->props().attrs);
 
     if (!attrs.isObject()) {
         return "";
@@ -760,7 +1561,7 @@ extern "C" const char* vue_block_attrs_value_at(HermesRuntime rt, HermesHandle h
     auto value = attrsObj.getProperty(hermes, key);
 
     if (value.isString()) {
-        return rt->cache_string(handle, value.getString(hermes).utf8(hermes));
+        return entry->strings.store(__func__, index, read_js_string(hermes, value));
     }
 
     return "";
@@ -771,6 +1572,9 @@ extern "C" bool vue_block_attrs_is_bool_at(HermesRuntime rt, HermesHandle handle
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -778,7 +1582,7 @@ extern "C" bool vue_block_attrs_is_bool_at(HermesRuntime rt, HermesHandle handle
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto attrs = obj.getProperty(hermes, "attrs");
+    auto attrs = obj.getProperty(hermes, rt->props().attrs);
 
     if (!attrs.isObject()) {
         return false;
@@ -805,6 +1609,9 @@ extern "C" bool vue_style_is_scoped(HermesRuntime rt, HermesHandle handle) {
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -812,7 +1619,7 @@ extern "C" bool vue_style_is_scoped(HermesRuntime rt, HermesHandle handle) {
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto scoped = obj.getProperty(hermes, "scoped");
+    auto scoped = obj.getProperty(hermes, rt->props().scoped);
     return scoped.isBool() && scoped.getBool();
 }
 
@@ -821,6 +1628,9 @@ extern "C" bool vue_style_has_module(HermesRuntime rt, HermesHandle handle) {
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -828,7 +1638,7 @@ extern "C" bool vue_style_has_module(HermesRuntime rt, HermesHandle handle) {
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto module = obj.getProperty(hermes, "module");
+    auto module = obj.getProperty(hermes, rt->props().module);
     return !module.isNull() && !module.isUndefined();
 }
 
@@ -837,17 +1647,24 @@ extern "C" const char* vue_style_module_value(HermesRuntime rt, HermesHandle han
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto module = obj.getProperty(hermes, "module");
+    auto module = obj.getProperty(hermes, rt->props().module);
 
     if (module.isString()) {
-        return rt->cache_string(handle, module.getString(hermes).utf8(hermes));
+        return entry->strings.store(__func__, 0, read_js_string(hermes, module));
     }
 
     return "";
@@ -862,6 +1679,9 @@ extern "C" bool vue_script_has_setup(HermesRuntime rt, HermesHandle handle) {
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -869,7 +1689,7 @@ extern "C" bool vue_script_has_setup(HermesRuntime rt, HermesHandle handle) {
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto setup = obj.getProperty(hermes, "setup");
+    auto setup = obj.getProperty(hermes, rt->props().setup);
     return !setup.isNull() && !setup.isUndefined();
 }
 
@@ -878,17 +1698,24 @@ extern "C" const char* vue_script_setup_value(HermesRuntime rt, HermesHandle han
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto setup = obj.getProperty(hermes, "setup");
+    auto setup = obj.getProperty(hermes, rt->props().setup);
 
     if (setup.isString()) {
-        return rt->cache_string(handle, setup.getString(hermes).utf8(hermes));
+        return entry->strings.store(__func__, 0, read_js_string(hermes, setup));
     }
 
     return "";
@@ -899,6 +1726,9 @@ extern "C" size_t vue_script_bindings_count(HermesRuntime rt, HermesHandle handl
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -906,7 +1736,7 @@ extern "C" size_t vue_script_bindings_count(HermesRuntime rt, HermesHandle handl
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto bindings = obj.getProperty(hermes, "bindings");
+    auto bindings = obj.getProperty(hermes, rt->props().bindings);
 
     if (!bindings.isObject()) {
         return 0;
@@ -922,14 +1752,21 @@ extern "C" const char* vue_script_bindings_key_at(HermesRuntime rt, HermesHandle
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto bindings = obj.getProperty(hermes, "bindings");
+    auto bindings = obj.getProperty(hermes, rt->props().bindings);
 
     if (!bindings.isObject()) {
         return "";
@@ -941,8 +1778,8 @@ extern "C" const char* vue_script_bindings_key_at(HermesRuntime rt, HermesHandle
         return "";
     }
 
-    auto key = names.getValueAtIndex(hermes, index).getString(hermes).utf8(hermes);
-    return rt->cache_string(handle, key);
+    auto key = read_js_string(hermes, names.getValueAtIndex(hermes, index));
+    return entry->strings.store(__func__, index, key);
 }
 
 extern "C" const char* vue_script_bindings_value_at(HermesRuntime rt, HermesHandle handle, size_t index) {
@@ -950,14 +1787,21 @@ extern "C" const char* vue_script_bindings_value_at(HermesRuntime rt, HermesHand
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto bindings = obj.getProperty(hermes, "bindings");
+    auto bindings = obj.getProperty(hermes, rt->props().bindings);
 
     if (!bindings.isObject()) {
         return "";
@@ -973,7 +1817,7 @@ extern "C" const char* vue_script_bindings_value_at(HermesRuntime rt, HermesHand
     auto value = bindingsObj.getProperty(hermes, key);
 
     if (value.isString()) {
-        return rt->cache_string(handle, value.getString(hermes).utf8(hermes));
+        return entry->strings.store(__func__, index, read_js_string(hermes, value));
     }
 
     return "";
@@ -984,6 +1828,9 @@ extern "C" size_t vue_script_imports_count(HermesRuntime rt, HermesHandle handle
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -991,7 +1838,7 @@ extern "C" size_t vue_script_imports_count(HermesRuntime rt, HermesHandle handle
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto imports = obj.getProperty(hermes, "imports");
+    auto imports = obj.getProperty(hermes, rt->props().imports);
 
     if (!imports.isObject()) {
         return 0;
@@ -1007,14 +1854,21 @@ extern "C" const char* vue_script_imports_key_at(HermesRuntime rt, HermesHandle
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto imports = obj.getProperty(hermes, "imports");
+    auto imports = obj.getProperty(hermes, rt->props().imports);
 
     if (!imports.isObject()) {
         return "";
@@ -1026,8 +1880,8 @@ extern "C" const char* vue_script_imports_key_at(HermesRuntime rt, HermesHandle
         return "";
     }
 
-    auto key = names.getValueAtIndex(hermes, index).getString(hermes).utf8(hermes);
-    return rt->cache_string(handle, key);
+    auto key = read_js_string(hermes, names.getValueAtIndex(hermes, index));
+    return entry->strings.store(__func__, index, key);
 }
 
 extern "C" HermesHandle vue_script_imports_value_at(HermesRuntime rt, HermesHandle handle, size_t index) {
@@ -1035,6 +1889,9 @@ extern "C" HermesHandle vue_script_imports_value_at(HermesRuntime rt, HermesHand
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -1042,7 +1899,7 @@ extern "C" HermesHandle vue_script_imports_value_at(HermesRuntime rt, HermesHand
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto imports = obj.getProperty(hermes, "imports");
+    auto imports = obj.getProperty(hermes, rt->props().imports);
 
     if (!imports.isObject()) {
         return 0;
@@ -1069,6 +1926,9 @@ extern "C" bool vue_import_binding_is_type(HermesRuntime rt, HermesHandle handle
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -1076,7 +1936,7 @@ extern "C" bool vue_import_binding_is_type(HermesRuntime rt, HermesHandle handle
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto isType = obj.getProperty(hermes, "isType");
+    auto isType = obj.getProperty(hermes, rt->props().is_type);
     return isType.isBool() && isType.getBool();
 }
 
@@ -1085,20 +1945,27 @@ extern "C" const char* vue_import_binding_imported(HermesRuntime rt, HermesHandl
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto imported = obj.getProperty(hermes, "imported");
+    auto imported = obj.getProperty(hermes, rt->props().imported);
 
     if (!imported.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, imported.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, imported));
 }
 
 extern "C" const char* vue_import_binding_source(HermesRuntime rt, HermesHandle handle) {
@@ -1106,20 +1973,27 @@ extern "C" const char* vue_import_binding_source(HermesRuntime rt, HermesHandle
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto source = obj.getProperty(hermes, "source");
+    auto source = obj.getProperty(hermes, rt->props().source);
 
     if (!source.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, source.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, source));
 }
 
 extern "C" bool vue_import_binding_is_from_setup(HermesRuntime rt, HermesHandle handle) {
@@ -1127,6 +2001,9 @@ extern "C" bool vue_import_binding_is_from_setup(HermesRuntime rt, HermesHandle
         return false;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return false;
@@ -1134,7 +2011,7 @@ extern "C" bool vue_import_binding_is_from_setup(HermesRuntime rt, HermesHandle
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto isFromSetup = obj.getProperty(hermes, "isFromSetup");
+    auto isFromSetup = obj.getProperty(hermes, rt->props().is_from_setup);
     return isFromSetup.isBool() && isFromSetup.getBool();
 }
 
@@ -1143,6 +2020,9 @@ extern "C" size_t vue_script_warnings_count(HermesRuntime rt, HermesHandle handl
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -1150,7 +2030,7 @@ extern "C" size_t vue_script_warnings_count(HermesRuntime rt, HermesHandle handl
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto warnings = obj.getProperty(hermes, "warnings");
+    auto warnings = obj.getProperty(hermes, rt->props().warnings);
 
     if (!warnings.isObject()) {
         return 0;
@@ -1164,14 +2044,21 @@ extern "C" const char* vue_script_warning_at(HermesRuntime rt, HermesHandle hand
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto warnings = obj.getProperty(hermes, "warnings");
+    auto warnings = obj.getProperty(hermes, rt->props().warnings);
 
     if (!warnings.isObject()) {
         return "";
@@ -1184,7 +2071,7 @@ extern "C" const char* vue_script_warning_at(HermesRuntime rt, HermesHandle hand
 
     auto warning = warningsArr.getValueAtIndex(hermes, index);
     if (warning.isString()) {
-        return rt->cache_string(handle, warning.getString(hermes).utf8(hermes));
+        return entry->strings.store(__func__, index, read_js_string(hermes, warning));
     }
 
     return "";
@@ -1195,6 +2082,9 @@ extern "C" size_t vue_script_deps_count(HermesRuntime rt, HermesHandle handle) {
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -1202,7 +2092,7 @@ extern "C" size_t vue_script_deps_count(HermesRuntime rt, HermesHandle handle) {
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto deps = obj.getProperty(hermes, "deps");
+    auto deps = obj.getProperty(hermes, rt->props().deps);
 
     if (!deps.isObject()) {
         return 0;
@@ -1216,14 +2106,21 @@ extern "C" const char* vue_script_dep_at(HermesRuntime rt, HermesHandle handle,
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto deps = obj.getProperty(hermes, "deps");
+    auto deps = obj.getProperty(hermes, rt->props().deps);
 
     if (!deps.isObject()) {
         return "";
@@ -1236,7 +2133,7 @@ extern "C" const char* vue_script_dep_at(HermesRuntime rt, HermesHandle handle,
 
     auto dep = depsArr.getValueAtIndex(hermes, index);
     if (dep.isString()) {
-        return rt->cache_string(handle, dep.getString(hermes).utf8(hermes));
+        return entry->strings.store(__func__, index, read_js_string(hermes, dep));
     }
 
     return "";
@@ -1250,21 +2147,28 @@ extern "C" HermesHandle vue_compile_script(
     HermesRuntime rt,
     HermesHandle desc_handle,
     const char* id, size_t id_len,
-    bool is_prod
+    const VueCompileOptions* options
 ) {
     if (!rt) {
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+
     auto* entry = rt->get_handle(desc_handle);
     if (!entry) {
         return 0;
     }
 
     auto& hermes = rt->runtime();
-    auto jsId = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(id), id_len);
-    auto result = rt->compile_script_fn->call(hermes, *entry->value, jsId, is_prod);
+    auto jsId = make_js_string(hermes, id, id_len);
+    auto jsOptions = make_compile_options(rt, options);
+    VUE_STATS_ADD(rt, bytes_in, id_len);
+    if (!rt->require_units(VUE_UNIT_SCRIPT)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, compile_script,
+        rt->compile_script_fn->call(hermes, *entry->value, jsId, jsOptions));
 
     return rt->allocate_handle(std::move(result));
 }
@@ -1274,20 +2178,27 @@ extern "C" const char* vue_script_result_content(HermesRuntime rt, HermesHandle
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto content = obj.getProperty(hermes, "content");
+    auto content = obj.getProperty(hermes, rt->props().content);
 
     if (!content.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, content.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, content));
 }
 
 extern "C" HermesHandle vue_script_result_bindings(HermesRuntime rt, HermesHandle handle) {
@@ -1295,6 +2206,9 @@ extern "C" HermesHandle vue_script_result_bindings(HermesRuntime rt, HermesHandl
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -1302,7 +2216,7 @@ extern "C" HermesHandle vue_script_result_bindings(HermesRuntime rt, HermesHandl
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto bindings = obj.getProperty(hermes, "bindings");
+    auto bindings = obj.getProperty(hermes, rt->props().bindings);
 
     if (bindings.isNull() || bindings.isUndefined()) {
         return 0;
@@ -1311,6 +2225,28 @@ extern "C" HermesHandle vue_script_result_bindings(HermesRuntime rt, HermesHandl
     return rt->allocate_handle(std::move(bindings));
 }
 
+extern "C" const char* vue_script_result_map(HermesRuntime rt, HermesHandle handle) {
+    VUE_TRACE_SPAN(rt);
+    return stringify_property(rt, handle, &PropNames::map);
+}
+
+extern "C" bool vue_script_result_has_inline_template(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return false;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return false;
+    }
+
+    auto& hermes = rt->runtime();
+    return bool_property(hermes, entry->value->getObject(hermes), rt->props().inline_template);
+}
+
 // ============================================================================
 // Template Compilation
 // ============================================================================
@@ -1321,20 +2257,20 @@ extern "C" HermesHandle vue_compile_template(
     const char* filename, size_t filename_len,
     const char* id, size_t id_len,
     bool scoped,
-    HermesHandle bindings_handle
+    HermesHandle bindings_handle,
+    const VueCompileOptions* options
 ) {
     if (!rt) {
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+
     auto& hermes = rt->runtime();
 
-    auto jsSource = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(source), source_len);
-    auto jsFilename = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(filename), filename_len);
-    auto jsId = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(id), id_len);
+    auto jsSource = make_js_string(hermes, source, source_len);
+    auto jsFilename = make_js_string(hermes, filename, filename_len);
+    auto jsId = make_js_string(hermes, id, id_len);
 
     // Handle optional bindings parameter
     facebook::jsi::Value jsBindings = facebook::jsi::Value::null();
@@ -1345,7 +2281,55 @@ extern "C" HermesHandle vue_compile_template(
         }
     }
 
-    auto result = rt->compile_template_fn->call(hermes, jsSource, jsFilename, jsId, scoped, jsBindings);
+    auto jsOptions = make_compile_options(rt, options);
+    VUE_STATS_ADD(rt, bytes_in, source_len + filename_len + id_len);
+    if (!rt->require_units(VUE_UNIT_TEMPLATE)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, compile_template,
+        rt->compile_template_fn->call(
+            hermes, jsSource, jsFilename, jsId, scoped, jsBindings, jsOptions));
+    return rt->allocate_handle(std::move(result));
+}
+
+extern "C" HermesHandle vue_compile_template_from_descriptor(
+    HermesRuntime rt,
+    HermesHandle descriptor,
+    const char* id, size_t id_len,
+    HermesHandle bindings_handle,
+    const VueCompileOptions* options
+) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    auto* entry = rt->get_handle(descriptor);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    facebook::jsi::Value jsDescriptor(hermes, *entry->value);
+    auto jsId = make_js_string(hermes, id, id_len);
+
+    facebook::jsi::Value jsBindings = facebook::jsi::Value::null();
+    if (bindings_handle != 0) {
+        auto* bindings_entry = rt->get_handle(bindings_handle);
+        if (bindings_entry) {
+            jsBindings = facebook::jsi::Value(hermes, *bindings_entry->value);
+        }
+    }
+
+    auto jsOptions = make_compile_options(rt, options);
+    VUE_STATS_ADD(rt, bytes_in, id_len);
+    if (!rt->require_units(VUE_UNIT_TEMPLATE)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, compile_template,
+        rt->compile_template_from_descriptor_fn->call(
+            hermes, jsDescriptor, jsId, jsBindings, jsOptions));
     return rt->allocate_handle(std::move(result));
 }
 
@@ -1354,20 +2338,27 @@ extern "C" const char* vue_template_result_code(HermesRuntime rt, HermesHandle h
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto code = obj.getProperty(hermes, "code");
+    auto code = obj.getProperty(hermes, rt->props().code);
 
     if (!code.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, code.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, code));
 }
 
 extern "C" size_t vue_template_result_error_count(HermesRuntime rt, HermesHandle handle) {
@@ -1375,6 +2366,9 @@ extern "C" size_t vue_template_result_error_count(HermesRuntime rt, HermesHandle
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return 0;
@@ -1382,7 +2376,7 @@ extern "C" size_t vue_template_result_error_count(HermesRuntime rt, HermesHandle
 
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto errors = obj.getProperty(hermes, "errors");
+    auto errors = obj.getProperty(hermes, rt->props().errors);
 
     if (!errors.isObject()) {
         return 0;
@@ -1391,6 +2385,125 @@ extern "C" size_t vue_template_result_error_count(HermesRuntime rt, HermesHandle
     return errors.getObject(hermes).getArray(hermes).size(hermes);
 }
 
+extern "C" const char* vue_template_result_map(HermesRuntime rt, HermesHandle handle) {
+    VUE_TRACE_SPAN(rt);
+    return stringify_property(rt, handle, &PropNames::map);
+}
+
+extern "C" const char* vue_template_result_preamble(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return "";
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return "";
+    }
+
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto preamble = obj.getProperty(hermes, rt->props().preamble);
+
+    if (!preamble.isString()) {
+        return "";
+    }
+
+    return entry->strings.store(__func__, 0, read_js_string(hermes, preamble));
+}
+
+extern "C" HermesHandle vue_template_result_ast(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto ast = obj.getProperty(hermes, rt->props().ast);
+
+    if (!ast.isObject()) {
+        return 0;
+    }
+
+    return rt->allocate_handle(std::move(ast));
+}
+
+extern "C" size_t vue_template_result_tip_count(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto tips = obj.getProperty(hermes, rt->props().tips);
+
+    if (!tips.isObject()) {
+        return 0;
+    }
+
+    return tips.getObject(hermes).getArray(hermes).size(hermes);
+}
+
+extern "C" const char* vue_template_result_tip_at(HermesRuntime rt, HermesHandle handle, size_t index) {
+    if (!rt) {
+        return "";
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return "";
+    }
+
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto tips = obj.getProperty(hermes, rt->props().tips);
+
+    if (!tips.isObject()) {
+        return "";
+    }
+
+    auto tipsArr = tips.getObject(hermes).getArray(hermes);
+    if (index >= tipsArr.size(hermes)) {
+        return "";
+    }
+
+    auto tip = tipsArr.getValueAtIndex(hermes, index);
+    if (tip.isString()) {
+        return entry->strings.store(__func__, index, read_js_string(hermes, tip));
+    }
+
+    return "";
+}
+
 // ============================================================================
 // Style Compilation
 // ============================================================================
@@ -1400,22 +2513,84 @@ extern "C" HermesHandle vue_compile_style(
     const char* source, size_t source_len,
     const char* filename, size_t filename_len,
     const char* id, size_t id_len,
-    bool scoped
+    bool scoped,
+    const VueCompileOptions* options
 ) {
     if (!rt) {
         return 0;
     }
 
+    VUE_TRACE_SPAN(rt);
+
+    VUE_STATS_ADD(rt, bytes_in, source_len + filename_len + id_len);
+    HermesHandle native = compile_style_natively(
+        rt, std::string_view(source, source_len), std::string_view(id, id_len), scoped, options);
+    if (native) {
+        return native;
+    }
+
     auto& hermes = rt->runtime();
 
-    auto jsSource = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(source), source_len);
-    auto jsFilename = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(filename), filename_len);
-    auto jsId = facebook::jsi::String::createFromUtf8(
-        hermes, reinterpret_cast<const uint8_t*>(id), id_len);
+    auto jsSource = make_js_string(hermes, source, source_len);
+    auto jsFilename = make_js_string(hermes, filename, filename_len);
+    auto jsId = make_js_string(hermes, id, id_len);
+    auto jsOptions = make_compile_options(rt, options);
 
-    auto result = rt->compile_style_fn->call(hermes, jsSource, jsFilename, jsId, scoped);
+    if (!rt->require_units(VUE_UNIT_STYLE)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, compile_style,
+        rt->compile_style_fn->call(hermes, jsSource, jsFilename, jsId, scoped, jsOptions));
+    return rt->allocate_handle(std::move(result));
+}
+
+extern "C" HermesHandle vue_compile_style_from_descriptor(
+    HermesRuntime rt,
+    HermesHandle descriptor,
+    size_t index,
+    const char* id, size_t id_len,
+    const VueCompileOptions* options
+) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    auto* entry = rt->get_handle(descriptor);
+    if (!entry) {
+        return 0;
+    }
+
+    VUE_STATS_ADD(rt, bytes_in, id_len);
+    if (options && options->native_style) {
+        // The snapshot holds the block contents, borrowed when possible.
+        const VueDescriptorSnapshot* view = vue_descriptor_materialize(rt, descriptor);
+        if (view && index < view->styles_count) {
+            const VueBlockSnapshot& style = view->styles[index];
+            std::string_view lang(style.lang.data, style.lang.len);
+            if (lang.empty() || lang == "css") {
+                HermesHandle native = compile_style_natively(
+                    rt, std::string_view(style.content.data, style.content.len),
+                    std::string_view(id, id_len), style.scoped, options);
+                if (native) {
+                    return native;
+                }
+            }
+        }
+    }
+
+    auto& hermes = rt->runtime();
+    facebook::jsi::Value jsDescriptor(hermes, *entry->value);
+    auto jsId = make_js_string(hermes, id, id_len);
+    auto jsOptions = make_compile_options(rt, options);
+
+    if (!rt->require_units(VUE_UNIT_STYLE)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, compile_style,
+        rt->compile_style_from_descriptor_fn->call(
+            hermes, jsDescriptor, static_cast<double>(index), jsId, jsOptions));
     return rt->allocate_handle(std::move(result));
 }
 
@@ -1424,18 +2599,802 @@ extern "C" const char* vue_style_result_code(HermesRuntime rt, HermesHandle hand
         return "";
     }
 
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
     auto* entry = rt->get_handle(handle);
     if (!entry) {
         return "";
     }
 
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
     auto& hermes = rt->runtime();
     auto obj = entry->value->getObject(hermes);
-    auto code = obj.getProperty(hermes, "code");
+    auto code = obj.getProperty(hermes, rt->props().code);
 
     if (!code.isString()) {
         return "";
     }
 
-    return rt->cache_string(handle, code.getString(hermes).utf8(hermes));
+    return entry->strings.store(__func__, 0, read_js_string(hermes, code));
+}
+
+// ============================================================================
+// SFC Pipeline
+// ============================================================================
+
+extern "C" HermesHandle vue_compile_sfc(
+    HermesRuntime rt,
+    const char* source, size_t source_len,
+    const char* filename, size_t filename_len,
+    const char* id, size_t id_len,
+    const VueCompileOptions* options
+) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    auto& hermes = rt->runtime();
+
+    auto jsSource = make_js_string(hermes, source, source_len);
+    auto jsFilename = make_js_string(hermes, filename, filename_len);
+    auto jsId = make_js_string(hermes, id, id_len);
+    auto jsOptions = make_compile_options(rt, options);
+
+    VUE_STATS_ADD(rt, bytes_in, source_len + filename_len + id_len);
+    if (!rt->require_units(VUE_UNIT_ALL)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, compile_sfc,
+        rt->compile_sfc_fn->call(hermes, jsSource, jsFilename, jsId, jsOptions));
+    return rt->allocate_handle(std::move(result));
+}
+
+extern "C" const char* vue_sfc_result_js(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return "";
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return "";
+    }
+
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto js = obj.getProperty(hermes, rt->props().js);
+
+    if (!js.isString()) {
+        return "";
+    }
+
+    return entry->strings.store(__func__, 0, read_js_string(hermes, js));
+}
+
+extern "C" const char* vue_sfc_result_css(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return "";
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return "";
+    }
+
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto css = obj.getProperty(hermes, rt->props().css);
+
+    if (!css.isString()) {
+        return "";
+    }
+
+    return entry->strings.store(__func__, 0, read_js_string(hermes, css));
+}
+
+extern "C" size_t vue_sfc_result_error_count(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto errors = obj.getProperty(hermes, rt->props().errors);
+
+    if (!errors.isObject()) {
+        return 0;
+    }
+
+    return errors.getObject(hermes).getArray(hermes).size(hermes);
+}
+
+extern "C" const char* vue_sfc_result_error_at(HermesRuntime rt, HermesHandle handle, size_t index) {
+    if (!rt) {
+        return "";
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return "";
+    }
+
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto errors = obj.getProperty(hermes, rt->props().errors);
+
+    if (!errors.isObject()) {
+        return "";
+    }
+
+    auto errorsArr = errors.getObject(hermes).getArray(hermes);
+    if (index >= errorsArr.size(hermes)) {
+        return "";
+    }
+
+    auto error = errorsArr.getValueAtIndex(hermes, index);
+    if (error.isString()) {
+        return entry->strings.store(__func__, index, read_js_string(hermes, error));
+    }
+
+    return "";
+}
+
+extern "C" size_t vue_sfc_result_warning_count(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto warnings = obj.getProperty(hermes, rt->props().warnings);
+
+    if (!warnings.isObject()) {
+        return 0;
+    }
+
+    return warnings.getObject(hermes).getArray(hermes).size(hermes);
+}
+
+extern "C" const char* vue_sfc_result_warning_at(HermesRuntime rt, HermesHandle handle, size_t index) {
+    if (!rt) {
+        return "";
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return "";
+    }
+
+    if (const char* cached = entry->strings.find(__func__, index)) {
+        return cached;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto warnings = obj.getProperty(hermes, rt->props().warnings);
+
+    if (!warnings.isObject()) {
+        return "";
+    }
+
+    auto warningsArr = warnings.getObject(hermes).getArray(hermes);
+    if (index >= warningsArr.size(hermes)) {
+        return "";
+    }
+
+    auto warning = warningsArr.getValueAtIndex(hermes, index);
+    if (warning.isString()) {
+        return entry->strings.store(__func__, index, read_js_string(hermes, warning));
+    }
+
+    return "";
+}
+
+// ============================================================================
+// Incremental Pipeline
+// ============================================================================
+
+extern "C" HermesHandle vue_compile_sfc_incremental(
+    HermesRuntime rt,
+    HermesHandle previous,
+    const char* source, size_t source_len,
+    const char* filename, size_t filename_len,
+    const char* id, size_t id_len,
+    const VueCompileOptions* options
+) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    auto& hermes = rt->runtime();
+
+    facebook::jsi::Value jsPrevious = facebook::jsi::Value::null();
+    if (auto* entry = rt->get_handle(previous)) {
+        jsPrevious = facebook::jsi::Value(hermes, *entry->value);
+    }
+
+    auto jsSource = make_js_string(hermes, source, source_len);
+    auto jsFilename = make_js_string(hermes, filename, filename_len);
+    auto jsId = make_js_string(hermes, id, id_len);
+    auto jsOptions = make_compile_options(rt, options);
+
+    VUE_STATS_ADD(rt, bytes_in, source_len + filename_len + id_len);
+    if (!rt->require_units(VUE_UNIT_ALL)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, compile_sfc,
+        rt->compile_sfc_incremental_fn->call(
+            hermes, jsPrevious, jsSource, jsFilename, jsId, jsOptions));
+    return rt->allocate_handle(std::move(result));
+}
+
+extern "C" uint32_t vue_sfc_result_dirty(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto dirty = obj.getProperty(hermes, rt->props().dirty);
+
+    if (!dirty.isNumber()) {
+        return VUE_SFC_DIRTY_ALL;
+    }
+
+    return static_cast<uint32_t>(dirty.getNumber());
+}
+
+extern "C" const char* vue_sfc_result_render(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return "";
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return "";
+    }
+
+    if (const char* cached = entry->strings.find(__func__, 0)) {
+        return cached;
+    }
+
+    auto& hermes = rt->runtime();
+    auto obj = entry->value->getObject(hermes);
+    auto render = obj.getProperty(hermes, rt->props().render);
+
+    if (!render.isString()) {
+        return "";
+    }
+
+    return entry->strings.store(__func__, 0, read_js_string(hermes, render));
+}
+
+// ============================================================================
+// Batch Compilation
+// ============================================================================
+
+extern "C" HermesHandle vue_compile_batch(
+    HermesRuntime rt,
+    const VueSfcInput* inputs, size_t count,
+    const VueCompileOptions* options
+) {
+    if (!rt || (count > 0 && !inputs)) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    auto& hermes = rt->runtime();
+
+    facebook::jsi::Array jsSources(hermes, count);
+    facebook::jsi::Array jsFilenames(hermes, count);
+    facebook::jsi::Array jsIds(hermes, count);
+    for (size_t i = 0; i < count; i++) {
+        const VueSfcInput& in = inputs[i];
+        VUE_STATS_ADD(rt, bytes_in, in.source_len + in.filename_len + in.id_len);
+        jsSources.setValueAtIndex(hermes, i, make_js_string(hermes, in.source, in.source_len));
+        jsFilenames.setValueAtIndex(hermes, i, make_js_string(hermes, in.filename, in.filename_len));
+        jsIds.setValueAtIndex(hermes, i, make_js_string(hermes, in.id, in.id_len));
+    }
+    auto jsOptions = make_compile_options(rt, options);
+
+    if (!rt->require_units(VUE_UNIT_ALL)) {
+        return 0;
+    }
+    auto result = VUE_STATS_CALL(rt, compile_sfc,
+        rt->compile_sfc_batch_fn->call(
+            hermes, jsSources, jsFilenames, jsIds, jsOptions));
+    return rt->allocate_handle(std::move(result));
+}
+
+extern "C" size_t vue_batch_result_count(HermesRuntime rt, HermesHandle handle) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    return entry->value->getObject(hermes).getArray(hermes).size(hermes);
+}
+
+extern "C" HermesHandle vue_batch_result_at(HermesRuntime rt, HermesHandle handle, size_t index) {
+    if (!rt) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto results = entry->value->getObject(hermes).getArray(hermes);
+    if (index >= results.size(hermes)) {
+        return 0;
+    }
+
+    auto item = results.getValueAtIndex(hermes, index);
+    return rt->allocate_handle(std::move(item));
+}
+
+// ============================================================================
+// Bulk Accessors
+// ============================================================================
+
+extern "C" size_t vue_parse_result_errors_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return for_each_string(rt, handle, &PropNames::errors, callback, user_data);
+}
+
+extern "C" size_t vue_script_bindings_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrPairCallback callback, void* user_data
+) {
+    if (!rt || !callback) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto bindings = entry->value->getObject(hermes).getProperty(hermes, rt->props().bindings);
+    if (!bindings.isObject()) {
+        return 0;
+    }
+
+    auto bindingsObj = bindings.getObject(hermes);
+    auto names = bindingsObj.getPropertyNames(hermes);
+    size_t len = names.size(hermes);
+    size_t visited = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        auto name = names.getValueAtIndex(hermes, i).getString(hermes);
+        auto value = bindingsObj.getProperty(hermes, name);
+        if (!value.isString()) {
+            continue;
+        }
+
+        std::string key = read_js_string(hermes, name);
+        std::string type = read_js_string(hermes, value);
+        visited++;
+        if (!callback(user_data, VueStr{key.data(), key.size()}, VueStr{type.data(), type.size()})) {
+            break;
+        }
+    }
+
+    return visited;
+}
+
+extern "C" size_t vue_script_imports_for_each(
+    HermesRuntime rt, HermesHandle handle, VueImportCallback callback, void* user_data
+) {
+    if (!rt || !callback) {
+        return 0;
+    }
+
+    VUE_TRACE_SPAN(rt);
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    auto* entry = rt->get_handle(handle);
+    if (!entry) {
+        return 0;
+    }
+
+    auto& hermes = rt->runtime();
+    auto imports = entry->value->getObject(hermes).getProperty(hermes, rt->props().imports);
+    if (!imports.isObject()) {
+        return 0;
+    }
+
+    auto importsObj = imports.getObject(hermes);
+    auto names = importsObj.getPropertyNames(hermes);
+    size_t len = names.size(hermes);
+    size_t visited = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        auto name = names.getValueAtIndex(hermes, i).getString(hermes);
+        auto value = importsObj.getProperty(hermes, name);
+        if (!value.isObject()) {
+            continue;
+        }
+
+        auto binding = value.getObject(hermes);
+        std::string local = read_js_string(hermes, name);
+        std::string imported = string_property(hermes, binding, rt->props().imported);
+        std::string source = string_property(hermes, binding, rt->props().source);
+
+        VueImportEntry item{};
+        item.local = VueStr{local.data(), local.size()};
+        item.imported = VueStr{imported.data(), imported.size()};
+        item.source = VueStr{source.data(), source.size()};
+        item.is_type = bool_property(hermes, binding, rt->props().is_type);
+        item.is_from_setup = bool_property(hermes, binding, rt->props().is_from_setup);
+
+        visited++;
+        if (!callback(user_data, &item)) {
+            break;
+        }
+    }
+
+    return visited;
+}
+
+extern "C" size_t vue_script_warnings_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return for_each_string(rt, handle, &PropNames::warnings, callback, user_data);
+}
+
+extern "C" size_t vue_script_deps_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return for_each_string(rt, handle, &PropNames::deps, callback, user_data);
+}
+
+extern "C" size_t vue_template_result_errors_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return for_each_string(rt, handle, &PropNames::errors, callback, user_data);
+}
+
+extern "C" size_t vue_template_result_tips_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return for_each_string(rt, handle, &PropNames::tips, callback, user_data);
+}
+
+extern "C" size_t vue_sfc_result_errors_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return for_each_string(rt, handle, &PropNames::errors, callback, user_data);
+}
+
+extern "C" size_t vue_sfc_result_warnings_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return for_each_string(rt, handle, &PropNames::warnings, callback, user_data);
+}
+
+// ============================================================================
+// Dependency Scanning
+// ============================================================================
+
+struct VueDependencyScanImpl {
+    /// String storage. A deque keeps element addresses stable on push_back.
+    std::deque<std::string> strings;
+
+    /// Entries of all files, referenced by range from each file.
+    std::vector<VueImportEntry> imports;
+    std::vector<VueSrcEntry> srcs;
+    std::vector<VueStr> style_imports;
+    std::vector<VueStr> errors;
+
+    std::vector<VueFileDependencies> files;
+};
+
+extern "C" VueDependencyScan vue_scan_dependencies(
+    HermesRuntime rt,
+    const VueSfcInput* inputs,
+    size_t count
+) {
+    if (!rt || (count > 0 && !inputs)) {
+        return nullptr;
+    }
+
+    VUE_TRACE_SPAN(rt);
+
+    auto& hermes = rt->runtime();
+    const auto& props = rt->props();
+    auto scan = std::make_unique<VueDependencyScanImpl>();
+
+    // Split the blocks natively where the scanner can, with the parser as
+    // the fallback. Snapshots may point into the inputs; every string kept
+    // in the scan is copied.
+    std::vector<std::unique_ptr<DescriptorSnapshot>> snapshots(count);
+    std::vector<std::vector<VueStr>> parse_errors(count);
+    for (size_t i = 0; i < count; i++) {
+        const VueSfcInput& in = inputs[i];
+        VUE_STATS_ADD(rt, bytes_in, in.source_len + in.filename_len);
+        auto snap = std::make_unique<DescriptorSnapshot>();
+        if (scan_sfc(
+                std::string_view(in.source ? in.source : "", in.source_len),
+                std::string_view(in.filename ? in.filename : "", in.filename_len),
+                *snap)) {
+            snapshots[i] = std::move(snap);
+            continue;
+        }
+
+        auto jsSource = make_js_string(hermes, in.source, in.source_len);
+        auto jsFilename = make_js_string(hermes, in.filename, in.filename_len);
+        auto jsOptions = make_compile_options(rt, nullptr);
+        if (!rt->require_units(VUE_UNIT_PARSE)) {
+            return nullptr;
+        }
+        auto parsed = VUE_STATS_CALL(rt, parse,
+            rt->parse_fn->call(hermes, jsSource, jsFilename, jsOptions, true)).getObject(hermes);
+        store_messages(hermes, props, parsed.getProperty(hermes, props.errors),
+            scan->strings, parse_errors[i]);
+        auto desc = parsed.getProperty(hermes, props.descriptor);
+        if (desc.isObject()) {
+            snapshots[i] = build_descriptor_snapshot(
+                hermes, props, desc.getObject(hermes), BorrowedSource{in.source, in.source_len});
+        }
+    }
+
+    // Parse the script blocks of the whole batch in one bridge call.
+    facebook::jsi::Array jsScripts(hermes, count);
+    facebook::jsi::Array jsScriptLangs(hermes, count);
+    facebook::jsi::Array jsSetups(hermes, count);
+    facebook::jsi::Array jsSetupLangs(hermes, count);
+    for (size_t i = 0; i < count; i++) {
+        if (const auto* snap = snapshots[i].get()) {
+            set_script_input(hermes, jsScripts, jsScriptLangs, i, snap->view.script);
+            set_script_input(hermes, jsSetups, jsSetupLangs, i, snap->view.script_setup);
+        }
+    }
+    if (!rt->require_units(VUE_UNIT_SCRIPT)) {
+        return nullptr;
+    }
+    auto results = VUE_STATS_CALL(rt, scan_dependencies,
+        rt->scan_script_imports_fn->call(
+            hermes, jsScripts, jsScriptLangs, jsSetups, jsSetupLangs))
+        .getObject(hermes).getArray(hermes);
+
+    VUE_STATS_SCOPE(rt, marshal_out);
+
+    struct Starts {
+        size_t imports, srcs, style_imports, errors;
+    };
+    std::vector<Starts> starts(count);
+    scan->files.resize(count);
+    std::vector<std::string_view> paths;
+    for (size_t i = 0; i < count; i++) {
+        starts[i] = Starts{
+            scan->imports.size(), scan->srcs.size(), scan->style_imports.size(), scan->errors.size()};
+        scan->errors.insert(scan->errors.end(), parse_errors[i].begin(), parse_errors[i].end());
+
+        auto result = results.getValueAtIndex(hermes, i).getObject(hermes);
+        auto imports = result.getProperty(hermes, props.imports).getObject(hermes).getArray(hermes);
+        size_t len = imports.size(hermes);
+        for (size_t j = 0; j < len; j++) {
+            auto binding = imports.getValueAtIndex(hermes, j).getObject(hermes);
+            VueImportEntry item{};
+            item.local = store_owned(scan->strings, string_property(hermes, binding, props.local));
+            item.imported = store_owned(scan->strings, string_property(hermes, binding, props.imported));
+            item.source = store_owned(scan->strings, string_property(hermes, binding, props.source));
+            item.is_type = bool_property(hermes, binding, props.is_type);
+            item.is_from_setup = bool_property(hermes, binding, props.is_from_setup);
+            scan->imports.push_back(item);
+        }
+        store_messages(hermes, props, result.getProperty(hermes, props.errors),
+            scan->strings, scan->errors);
+
+        if (const auto* snap = snapshots[i].get()) {
+            for (const auto& block : snap->blocks) {
+                if (block.src.len > 0) {
+                    scan->srcs.push_back(VueSrcEntry{
+                        store_owned(scan->strings, std::string_view(block.type.data, block.type.len)),
+                        store_owned(scan->strings, std::string_view(block.src.data, block.src.len)),
+                    });
+                }
+            }
+            for (size_t j = 0; j < snap->view.styles_count; j++) {
+                const auto& style = snap->view.styles[j];
+                paths.clear();
+                collect_style_imports(
+                    std::string_view(style.content.data, style.content.len),
+                    std::string_view(style.lang.data, style.lang.len),
+                    paths);
+                for (auto path : paths) {
+                    scan->style_imports.push_back(store_owned(scan->strings, path));
+                }
+            }
+        }
+
+        auto& file = scan->files[i];
+        file.imports_count = scan->imports.size() - starts[i].imports;
+        file.srcs_count = scan->srcs.size() - starts[i].srcs;
+        file.style_imports_count = scan->style_imports.size() - starts[i].style_imports;
+        file.errors_count = scan->errors.size() - starts[i].errors;
+    }
+
+    // The arrays are complete; resolve the ranges to pointers.
+    for (size_t i = 0; i < count; i++) {
+        auto& file = scan->files[i];
+        file.imports = scan->imports.data() + starts[i].imports;
+        file.srcs = scan->srcs.data() + starts[i].srcs;
+        file.style_imports = scan->style_imports.data() + starts[i].style_imports;
+        file.errors = scan->errors.data() + starts[i].errors;
+    }
+    return scan.release();
+}
+
+extern "C" const VueFileDependencies* vue_dependency_scan_files(
+    VueDependencyScan scan, size_t* out_count
+) {
+    if (!scan || !out_count) {
+        return nullptr;
+    }
+
+    *out_count = scan->files.size();
+    return scan->files.data();
+}
+
+extern "C" void vue_dependency_scan_free(VueDependencyScan scan) {
+    delete scan;
+}
+
+// ============================================================================
+// Output Sinks
+// ============================================================================
+
+extern "C" size_t vue_script_result_content_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity
+) {
+    VUE_TRACE_SPAN(rt);
+    return copy_string_property(rt, handle, &PropNames::content, buffer, capacity);
+}
+
+extern "C" size_t vue_script_result_content_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return stream_string_property(rt, handle, &PropNames::content, callback, user_data);
+}
+
+extern "C" size_t vue_template_result_code_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity
+) {
+    VUE_TRACE_SPAN(rt);
+    return copy_string_property(rt, handle, &PropNames::code, buffer, capacity);
+}
+
+extern "C" size_t vue_template_result_code_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return stream_string_property(rt, handle, &PropNames::code, callback, user_data);
+}
+
+extern "C" size_t vue_style_result_code_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity
+) {
+    VUE_TRACE_SPAN(rt);
+    return copy_string_property(rt, handle, &PropNames::code, buffer, capacity);
+}
+
+extern "C" size_t vue_style_result_code_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return stream_string_property(rt, handle, &PropNames::code, callback, user_data);
+}
+
+extern "C" size_t vue_sfc_result_js_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity
+) {
+    VUE_TRACE_SPAN(rt);
+    return copy_string_property(rt, handle, &PropNames::js, buffer, capacity);
+}
+
+extern "C" size_t vue_sfc_result_js_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return stream_string_property(rt, handle, &PropNames::js, callback, user_data);
+}
+
+extern "C" size_t vue_sfc_result_css_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity
+) {
+    VUE_TRACE_SPAN(rt);
+    return copy_string_property(rt, handle, &PropNames::css, buffer, capacity);
+}
+
+extern "C" size_t vue_sfc_result_css_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data
+) {
+    VUE_TRACE_SPAN(rt);
+    return stream_string_property(rt, handle, &PropNames::css, callback, user_data);
 }
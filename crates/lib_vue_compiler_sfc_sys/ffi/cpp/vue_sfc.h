@@ -17,6 +17,67 @@
 extern "C" {
 #endif
 
+// ============================================================================
+// Options
+// ============================================================================
+
+/**
+ * Options for the compile entry points.
+ *
+ * Zero-initialize the struct and set the fields you need. Passing NULL
+ * selects the defaults (all fields false), which generate and retain only
+ * the compiled code: no source maps, template AST, preamble or tips.
+ */
+typedef struct VueCompileOptions {
+    /** Compile for production (enables optimizations). */
+    bool is_prod;
+    /**
+     * Generate source maps during parse, script and template compilation.
+     * Read them with vue_script_result_map() / vue_template_result_map().
+     */
+    bool source_map;
+    /** Keep the template AST on template results (vue_template_result_ast()). */
+    bool keep_template_ast;
+    /** Keep the template preamble on template results (vue_template_result_preamble()). */
+    bool keep_preamble;
+    /** Keep compiler tips on template results (vue_template_result_tip_at()). */
+    bool keep_tips;
+    /**
+     * Generate server-rendering code: templates compile to an ssrRender
+     * function and scripts skip client-only CSS variable injection.
+     */
+    bool ssr;
+    /**
+     * Compile plain CSS of style blocks with the native rewriter instead of
+     * the JS compiler. Input it doesn't handle falls back to the JS
+     * compiler, so the output is the same either way. Only read by
+     * vue_compile_style() and vue_compile_style_from_descriptor().
+     */
+    bool native_style;
+    /**
+     * Inline the template's render function into the `<script setup>`
+     * output, compiled once against the script's bindings instead of going
+     * through the setup proxy (compiler-sfc's inlineTemplate). The script
+     * result is then the whole component and vue_compile_template() is not
+     * needed; check vue_script_result_has_inline_template(), as components
+     * without `<script setup>` or with a `src` template are not inlined.
+     * Only read by vue_compile_script().
+     */
+    bool inline_template;
+} VueCompileOptions;
+
+/**
+ * One SFC to compile in a batch. Strings are UTF-8 and not null-terminated.
+ */
+typedef struct VueSfcInput {
+    const char* source;
+    size_t source_len;
+    const char* filename;
+    size_t filename_len;
+    const char* id;
+    size_t id_len;
+} VueSfcInput;
+
 // ============================================================================
 // Parsing
 // ============================================================================
@@ -29,12 +90,37 @@ extern "C" {
  * @param source_len Length of source in bytes.
  * @param filename UTF-8 filename (not null-terminated).
  * @param filename_len Length of filename in bytes.
+ * @param options Compile options (only source_map is read), or NULL.
  * @return Handle to parse result, or 0 on failure.
  */
 HermesHandle vue_parse(
     HermesRuntime rt,
     const char* source, size_t source_len,
-    const char* filename, size_t filename_len
+    const char* filename, size_t filename_len,
+    const VueCompileOptions* options
+);
+
+/**
+ * Parses an SFC source without copying block contents out of the JS heap.
+ *
+ * Descriptor snapshots built from this result point block content (and the
+ * descriptor source) directly into `source` whenever the content is an
+ * unmodified slice of it, and copy only content the parser transformed.
+ *
+ * @param rt The Hermes runtime.
+ * @param source Source code (UTF-8). Must stay alive and unmodified until the
+ *               parse result and every descriptor obtained from it are freed.
+ * @param source_len Length of source in bytes.
+ * @param filename Filename for error messages (UTF-8).
+ * @param filename_len Length of filename in bytes.
+ * @param options Compile options (only source_map is read), or NULL.
+ * @return Handle to parse result, or 0 on failure.
+ */
+HermesHandle vue_parse_borrowed(
+    HermesRuntime rt,
+    const char* source, size_t source_len,
+    const char* filename, size_t filename_len,
+    const VueCompileOptions* options
 );
 
 /**
@@ -131,6 +217,242 @@ const char* vue_descriptor_source(HermesRuntime rt, HermesHandle handle);
  */
 const char* vue_descriptor_filename(HermesRuntime rt, HermesHandle handle);
 
+// ============================================================================
+// Descriptor Snapshot
+// ============================================================================
+
+/**
+ * A UTF-8 string view (not null-terminated).
+ */
+typedef struct VueStr {
+    const char* data;
+    size_t len;
+} VueStr;
+
+/**
+ * A position in the SFC source.
+ */
+typedef struct VuePosition {
+    size_t offset;
+    size_t line;
+    size_t column;
+} VuePosition;
+
+/**
+ * A range in the SFC source.
+ */
+typedef struct VueSourceLocation {
+    VuePosition start;
+    VuePosition end;
+} VueSourceLocation;
+
+/**
+ * A block attribute. Key-only attributes have is_bool set and an empty value.
+ */
+typedef struct VueBlockAttr {
+    VueStr key;
+    VueStr value;
+    bool is_bool;
+} VueBlockAttr;
+
+/**
+ * Flattened view of a template, script, style or custom block.
+ *
+ * Fields that don't apply to a block kind are empty/false.
+ */
+typedef struct VueBlockSnapshot {
+    VueStr type;
+    VueStr content;
+    VueStr lang;
+    VueStr src;
+    VueSourceLocation loc;
+    const VueBlockAttr* attrs;
+    size_t attrs_count;
+    /** Style: has the scoped attribute. */
+    bool scoped;
+    /** Style: has the module attribute (boolean or named). */
+    bool has_module;
+    /** Style: module name, empty if module is boolean. */
+    VueStr module;
+    /** Script: has the setup attribute (boolean or valued). */
+    bool has_setup;
+    /** Script: setup attribute value, empty if setup is boolean. */
+    VueStr setup;
+    /** Content points into the caller's buffer (vue_parse_borrowed only). */
+    bool content_borrowed;
+    /** Byte offset of content in the caller's buffer, if content_borrowed. */
+    size_t content_offset;
+} VueBlockSnapshot;
+
+/**
+ * Flattened view of a whole descriptor.
+ *
+ * Absent blocks are NULL pointers.
+ */
+typedef struct VueDescriptorSnapshot {
+    VueStr filename;
+    VueStr source;
+    const VueBlockSnapshot* template_block;
+    const VueBlockSnapshot* script;
+    const VueBlockSnapshot* script_setup;
+    const VueBlockSnapshot* styles;
+    size_t styles_count;
+    const VueBlockSnapshot* custom_blocks;
+    size_t custom_blocks_count;
+    const VueStr* css_vars;
+    size_t css_vars_count;
+    bool slotted;
+} VueDescriptorSnapshot;
+
+/**
+ * Walks a descriptor once and returns a flat snapshot of all its blocks.
+ *
+ * The snapshot is built on the first call and memoized; it is owned by the
+ * descriptor handle and stays valid until that handle is freed.
+ *
+ * @param rt The Hermes runtime.
+ * @param handle A descriptor handle from vue_parse_result_descriptor().
+ * @return Pointer to the snapshot, or NULL if the handle is invalid.
+ */
+const VueDescriptorSnapshot* vue_descriptor_materialize(HermesRuntime rt, HermesHandle handle);
+
+// ============================================================================
+// Descriptor Serialization
+// ============================================================================
+
+/**
+ * Version of the binary descriptor format written by vue_descriptor_serialize().
+ */
+#define VUE_DESCRIPTOR_FORMAT_VERSION 1
+
+/*
+ * Binary descriptor format ("VSFD")
+ *
+ * A serialized descriptor is one self-contained little-endian buffer that
+ * references no runtime, so it can be moved between threads and processes
+ * and read in place. All integers are u32 unless noted. A str is a
+ * (u32 offset, u32 length) pair locating UTF-8 bytes within the buffer. A
+ * pos is (u32 offset, u32 line, u32 column), with offsets in UTF-16 code
+ * units as reported by the compiler.
+ *
+ *   Header, 40 bytes
+ *     0   magic "VSFD"
+ *     4   u16 version (VUE_DESCRIPTOR_FORMAT_VERSION)
+ *     6   u16 flags: bit 0 slotted
+ *     8   total size in bytes
+ *     12  block count
+ *     16  attribute count
+ *     20  CSS variable count
+ *     24  str filename
+ *     32  str source
+ *   Blocks, 84 bytes each: the template, script and script setup blocks if
+ *   present, then styles and custom blocks in source order
+ *     0   u8 kind: 0 template, 1 script, 2 script setup, 3 style, 4 custom
+ *     1   u8 flags: bit 0 scoped, bit 1 has module, bit 2 has setup
+ *     2   u16 reserved, 0
+ *     4   index of the block's first attribute
+ *     8   attribute count
+ *     12  str type
+ *     20  str content
+ *     28  str lang
+ *     36  str src
+ *     44  str module
+ *     52  str setup
+ *     60  pos start
+ *     72  pos end
+ *   Attributes, 20 bytes each
+ *     0   str key
+ *     8   str value
+ *     16  flags: bit 0 boolean (key-only) attribute
+ *   CSS variables, 8 bytes each: str
+ *   String bytes
+ */
+
+/**
+ * Serializes a descriptor to the binary descriptor format.
+ *
+ * Built on the first call and memoized; the buffer is owned by the
+ * descriptor handle and stays valid until that handle is freed.
+ *
+ * @param rt The Hermes runtime.
+ * @param handle A descriptor handle.
+ * @param out_len Receives the buffer length in bytes.
+ * @return Pointer to the buffer, or NULL if the handle is invalid or the
+ *         descriptor exceeds the format's 4 GiB limit.
+ */
+const uint8_t* vue_descriptor_serialize(HermesRuntime rt, HermesHandle handle, size_t* out_len);
+
+/**
+ * Rebuilds a descriptor from the binary descriptor format, in any runtime.
+ *
+ * The result works with every function taking a descriptor handle. The
+ * template AST is not serialized: template compilation parses the template
+ * content instead, and script compilation reparses the source should it
+ * need the AST.
+ *
+ * @param rt The Hermes runtime.
+ * @param data The buffer; only needs to stay valid during the call.
+ * @param len Length of data in bytes.
+ * @return A descriptor handle, or 0 if the buffer is truncated, malformed
+ *         or of another format version.
+ */
+HermesHandle vue_descriptor_deserialize(HermesRuntime rt, const uint8_t* data, size_t len);
+
+// ============================================================================
+// Block Scanning
+// ============================================================================
+
+/**
+ * Opaque pointer to an owned block scan.
+ *
+ * Like a VueCompiledSfc, a scan holds no JS values and is independent of
+ * any runtime. Free it with vue_sfc_scan_free().
+ */
+typedef struct VueSfcScanImpl* VueSfcScan;
+
+/**
+ * Splits an SFC into its blocks natively, without a runtime.
+ *
+ * For tools that only need the block structure, this replaces vue_parse():
+ * the result is the descriptor vue_parse() would produce, in the binary
+ * descriptor format, so it can be read in place or loaded into a runtime
+ * with vue_descriptor_deserialize(). Template markup is only scanned for
+ * the end of the template block, not parsed or validated.
+ *
+ * Sources vue_parse() would report block-level errors for (duplicate or
+ * unclosed blocks, a missing template and script, ...) and the rare
+ * constructs the scanner does not reproduce (directives or entities on
+ * block tags, v-pre, raw-text elements inside SVG, ...) return NULL; parse
+ * those with vue_parse().
+ *
+ * @param source The SFC source (UTF-8).
+ * @param source_len Length of source in bytes.
+ * @param filename The filename stored in the descriptor (UTF-8).
+ * @param filename_len Length of filename in bytes.
+ * @return An owned scan to free with vue_sfc_scan_free(), or NULL.
+ */
+VueSfcScan vue_sfc_scan(
+    const char* source,
+    size_t source_len,
+    const char* filename,
+    size_t filename_len
+);
+
+/**
+ * Gets the scanned descriptor in the binary descriptor format.
+ *
+ * @param scan The scan.
+ * @param out_len Receives the buffer length in bytes.
+ * @return Pointer to the buffer, owned by the scan, or NULL if scan or
+ *         out_len is NULL.
+ */
+const uint8_t* vue_sfc_scan_data(VueSfcScan scan, size_t* out_len);
+
+/**
+ * Frees a scan. Safe to call with NULL.
+ */
+void vue_sfc_scan_free(VueSfcScan scan);
+
 // ============================================================================
 // Block Accessors
 // ============================================================================
@@ -221,12 +543,16 @@ const char* vue_script_dep_at(HermesRuntime rt, HermesHandle handle, size_t inde
 
 /**
  * Compiles the script blocks of an SFC descriptor.
+ *
+ * Reads is_prod, ssr, source_map and inline_template from options (NULL
+ * selects the defaults). With inline_template, a template that fails to
+ * compile fails the script compilation, leaving the content empty.
  */
 HermesHandle vue_compile_script(
     HermesRuntime rt,
     HermesHandle descriptor,
     const char* id, size_t id_len,
-    bool is_prod
+    const VueCompileOptions* options
 );
 
 /**
@@ -239,12 +565,29 @@ const char* vue_script_result_content(HermesRuntime rt, HermesHandle handle);
  */
 HermesHandle vue_script_result_bindings(HermesRuntime rt, HermesHandle handle);
 
+/**
+ * Gets the script source map as a JSON string.
+ *
+ * Returns "" unless the script was compiled with source_map set. The JSON is
+ * serialized on demand.
+ */
+const char* vue_script_result_map(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Checks if the script result includes the render function, compiled with
+ * the inline_template option.
+ */
+bool vue_script_result_has_inline_template(HermesRuntime rt, HermesHandle handle);
+
 // ============================================================================
 // Template Compilation
 // ============================================================================
 
 /**
  * Compiles a Vue template to a render function.
+ *
+ * Reads is_prod, ssr, source_map, keep_template_ast, keep_preamble and
+ * keep_tips from options (NULL selects the defaults).
  */
 HermesHandle vue_compile_template(
     HermesRuntime rt,
@@ -252,7 +595,32 @@ HermesHandle vue_compile_template(
     const char* filename, size_t filename_len,
     const char* id, size_t id_len,
     bool scoped,
-    HermesHandle bindings
+    HermesHandle bindings,
+    const VueCompileOptions* options
+);
+
+/**
+ * Compiles the template block of a parsed descriptor.
+ *
+ * The template source stays in the JS heap and the AST from parsing is
+ * reused, so the template is neither copied across the FFI boundary nor
+ * parsed a second time. Scoped and slotted are derived from the descriptor.
+ *
+ * @param rt The Hermes runtime.
+ * @param descriptor A descriptor handle.
+ * @param id UTF-8 scope ID (not null-terminated).
+ * @param id_len Length of id in bytes.
+ * @param bindings Bindings handle from vue_script_result_bindings(), or 0.
+ * @param options Compile options as for vue_compile_template(), or NULL.
+ * @return Handle to a template result (read with vue_template_result_*), or 0
+ *         if the descriptor handle is invalid.
+ */
+HermesHandle vue_compile_template_from_descriptor(
+    HermesRuntime rt,
+    HermesHandle descriptor,
+    const char* id, size_t id_len,
+    HermesHandle bindings,
+    const VueCompileOptions* options
 );
 
 /**
@@ -265,19 +633,82 @@ const char* vue_template_result_code(HermesRuntime rt, HermesHandle handle);
  */
 size_t vue_template_result_error_count(HermesRuntime rt, HermesHandle handle);
 
+/**
+ * Gets the template source map as a JSON string.
+ *
+ * Returns "" unless the template was compiled with source_map set. The JSON
+ * is serialized on demand.
+ */
+const char* vue_template_result_map(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets the template preamble (hoisted imports for inline mode).
+ *
+ * Returns "" unless the template was compiled with keep_preamble set.
+ */
+const char* vue_template_result_preamble(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets a handle to the template AST.
+ *
+ * Returns 0 unless the template was compiled with keep_template_ast set.
+ * The returned handle must be freed separately.
+ */
+HermesHandle vue_template_result_ast(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets the number of compiler tips.
+ *
+ * Always 0 unless the template was compiled with keep_tips set.
+ */
+size_t vue_template_result_tip_count(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets a compiler tip at the specified index.
+ */
+const char* vue_template_result_tip_at(HermesRuntime rt, HermesHandle handle, size_t index);
+
 // ============================================================================
 // Style Compilation
 // ============================================================================
 
 /**
  * Compiles a CSS style block.
+ *
+ * Reads is_prod from options (NULL selects the defaults); production mode
+ * hashes the names of v-bind() CSS variables. With native_style, the source
+ * is rewritten natively unless it uses something left to the JS compiler,
+ * such as :deep() or keyframes in a scoped style.
  */
 HermesHandle vue_compile_style(
     HermesRuntime rt,
     const char* source, size_t source_len,
     const char* filename, size_t filename_len,
     const char* id, size_t id_len,
-    bool scoped
+    bool scoped,
+    const VueCompileOptions* options
+);
+
+/**
+ * Compiles one style block of a parsed descriptor without copying its source.
+ *
+ * @param rt The Hermes runtime.
+ * @param descriptor A descriptor handle.
+ * @param index Index of the style block.
+ * @param id UTF-8 scope ID (not null-terminated).
+ * @param id_len Length of id in bytes.
+ * @param options Compile options as for vue_compile_style(), or NULL. With
+ *                native_style, blocks with a lang other than css always go
+ *                to the JS compiler.
+ * @return Handle to a style result (read with vue_style_result_code), or 0
+ *         if the descriptor handle is invalid.
+ */
+HermesHandle vue_compile_style_from_descriptor(
+    HermesRuntime rt,
+    HermesHandle descriptor,
+    size_t index,
+    const char* id, size_t id_len,
+    const VueCompileOptions* options
 );
 
 /**
@@ -285,6 +716,424 @@ HermesHandle vue_compile_style(
  */
 const char* vue_style_result_code(HermesRuntime rt, HermesHandle handle);
 
+// ============================================================================
+// SFC Pipeline
+// ============================================================================
+
+/**
+ * Compiles a complete SFC in a single call.
+ *
+ * Runs parse, compileScript, compileTemplate and compileStyle (for every
+ * style block) inside the JS bridge, so the whole pipeline costs one FFI
+ * crossing instead of one per step and accessor.
+ *
+ * @param rt The Hermes runtime.
+ * @param source UTF-8 SFC source (not null-terminated).
+ * @param source_len Length of source in bytes.
+ * @param filename UTF-8 filename (not null-terminated).
+ * @param filename_len Length of filename in bytes.
+ * @param id UTF-8 scope ID (not null-terminated).
+ * @param id_len Length of id in bytes.
+ * @param options Compile options, or NULL for defaults. Only is_prod and
+ *                ssr apply; the pipeline never generates source maps and
+ *                never retains intermediate artifacts.
+ * @return Handle to the pipeline result, or 0 on failure.
+ */
+HermesHandle vue_compile_sfc(
+    HermesRuntime rt,
+    const char* source, size_t source_len,
+    const char* filename, size_t filename_len,
+    const char* id, size_t id_len,
+    const VueCompileOptions* options
+);
+
+/**
+ * Gets the compiled JavaScript (script content followed by the render function).
+ */
+const char* vue_sfc_result_js(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets the compiled CSS of all style blocks, joined with newlines.
+ */
+const char* vue_sfc_result_css(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets the number of errors reported by any pipeline step.
+ */
+size_t vue_sfc_result_error_count(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets an error message at the specified index.
+ */
+const char* vue_sfc_result_error_at(HermesRuntime rt, HermesHandle handle, size_t index);
+
+/**
+ * Gets the number of warnings reported by any pipeline step.
+ */
+size_t vue_sfc_result_warning_count(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets a warning message at the specified index.
+ */
+const char* vue_sfc_result_warning_at(HermesRuntime rt, HermesHandle handle, size_t index);
+
+// ============================================================================
+// Incremental Pipeline
+// ============================================================================
+
+/*
+ * Bits of vue_sfc_result_dirty(): the parts an incremental compile actually
+ * recompiled. An HMR client can do a style-only update when only
+ * VUE_SFC_DIRTY_STYLE is set, and a template-only (rerender) update when
+ * only VUE_SFC_DIRTY_TEMPLATE is set.
+ */
+#define VUE_SFC_DIRTY_SCRIPT   (1u << 0)
+#define VUE_SFC_DIRTY_TEMPLATE (1u << 1)
+#define VUE_SFC_DIRTY_STYLE    (1u << 2)
+/** Custom blocks changed. They are not compiled; this only reports it. */
+#define VUE_SFC_DIRTY_CUSTOM   (1u << 3)
+#define VUE_SFC_DIRTY_ALL      (0xFu)
+
+/**
+ * Recompiles an SFC, reusing the script, template and style output of a
+ * previous result wherever their inputs did not change.
+ *
+ * The source is always re-parsed. Blocks are compared by content and
+ * attributes, and coupling between blocks is respected: a cssVars change
+ * recompiles the script, a bindings or scoped-ness change recompiles the
+ * template, and a TypeScript script setup is recompiled with its template.
+ *
+ * The result is an SFC pipeline result: js, css, errors and warnings are
+ * read with the vue_sfc_result_* accessors and match a full
+ * vue_compile_sfc() of the same source.
+ *
+ * @param rt The Hermes runtime.
+ * @param previous Handle from an earlier vue_compile_sfc_incremental() of
+ *                 the same component, or 0 for a full compile. It is only
+ *                 reused for the same filename, id, is_prod and ssr, and stays
+ *                 valid; free it when no longer needed.
+ * @param source UTF-8 SFC source (not null-terminated).
+ * @param source_len Length of source in bytes.
+ * @param filename UTF-8 filename (not null-terminated).
+ * @param filename_len Length of filename in bytes.
+ * @param id UTF-8 scope ID (not null-terminated).
+ * @param id_len Length of id in bytes.
+ * @param options Compile options, or NULL for defaults. Only is_prod and ssr apply.
+ * @return Handle to the result, or 0 on failure.
+ */
+HermesHandle vue_compile_sfc_incremental(
+    HermesRuntime rt,
+    HermesHandle previous,
+    const char* source, size_t source_len,
+    const char* filename, size_t filename_len,
+    const char* id, size_t id_len,
+    const VueCompileOptions* options
+);
+
+/**
+ * Gets the VUE_SFC_DIRTY_* mask of parts recompiled by
+ * vue_compile_sfc_incremental(). A full compile, a parse failure and any
+ * result of vue_compile_sfc() report VUE_SFC_DIRTY_ALL.
+ */
+uint32_t vue_sfc_result_dirty(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets the render function code alone (the template part of
+ * vue_sfc_result_js()) of an incremental result, for rerender updates.
+ */
+const char* vue_sfc_result_render(HermesRuntime rt, HermesHandle handle);
+
+// ============================================================================
+// Batch Compilation
+// ============================================================================
+
+/**
+ * Compiles many SFCs with a single FFI call.
+ *
+ * Equivalent to calling vue_compile_sfc() for every input, but the loop runs
+ * inside the JS bridge.
+ *
+ * @param rt The Hermes runtime.
+ * @param inputs Array of `count` inputs.
+ * @param count Number of inputs.
+ * @param options Compile options applied to every input, or NULL for defaults.
+ * @return Handle to the batch result, or 0 on failure.
+ */
+HermesHandle vue_compile_batch(
+    HermesRuntime rt,
+    const VueSfcInput* inputs, size_t count,
+    const VueCompileOptions* options
+);
+
+/**
+ * Gets the number of results in a batch.
+ */
+size_t vue_batch_result_count(HermesRuntime rt, HermesHandle handle);
+
+/**
+ * Gets the result at the specified index as a new handle.
+ *
+ * The returned handle is an SFC pipeline result: read it with the
+ * vue_sfc_result_* accessors and free it independently of the batch.
+ *
+ * @return Handle to the result, or 0 if index is out of range.
+ */
+HermesHandle vue_batch_result_at(HermesRuntime rt, HermesHandle handle, size_t index);
+
+// ============================================================================
+// Bulk Accessors
+// ============================================================================
+
+/*
+ * The *_for_each functions walk a whole list in one call, fetching the JS
+ * array (or the object's property names) once instead of once per index as
+ * the *_at accessors do. Strings passed to a callback are only valid for the
+ * duration of that callback. A callback returns true to continue or false to
+ * stop early; it must not free the handle being iterated.
+ *
+ * Each function returns the number of entries passed to the callback, or 0
+ * if the runtime or handle is invalid.
+ */
+
+/** Receives one string (a message, tip, warning or dependency). */
+typedef bool (*VueStrCallback)(void* user_data, VueStr value);
+
+/** Receives one key/value pair (a binding name and its binding type). */
+typedef bool (*VueStrPairCallback)(void* user_data, VueStr key, VueStr value);
+
+/** One import of a script block. */
+typedef struct VueImportEntry {
+    VueStr local;
+    VueStr imported;
+    VueStr source;
+    bool is_type;
+    bool is_from_setup;
+} VueImportEntry;
+
+/** Receives one import. */
+typedef bool (*VueImportCallback)(void* user_data, const VueImportEntry* entry);
+
+/**
+ * Iterates over parse error messages.
+ */
+size_t vue_parse_result_errors_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Iterates over bindings of a script block or a script compilation result.
+ */
+size_t vue_script_bindings_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrPairCallback callback, void* user_data);
+
+/**
+ * Iterates over the imports of a script block.
+ */
+size_t vue_script_imports_for_each(
+    HermesRuntime rt, HermesHandle handle, VueImportCallback callback, void* user_data);
+
+/**
+ * Iterates over warnings of a script block or a script compilation result.
+ */
+size_t vue_script_warnings_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Iterates over the dependencies of a script block.
+ */
+size_t vue_script_deps_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Iterates over template compilation error messages.
+ */
+size_t vue_template_result_errors_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Iterates over template compiler tips (empty unless keep_tips was set).
+ */
+size_t vue_template_result_tips_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Iterates over SFC pipeline error messages.
+ */
+size_t vue_sfc_result_errors_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Iterates over SFC pipeline warning messages.
+ */
+size_t vue_sfc_result_warnings_for_each(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+// ============================================================================
+// Dependency Scanning
+// ============================================================================
+
+/**
+ * Opaque pointer to an owned dependency scan.
+ *
+ * Like a VueCompiledSfc, a scan holds no JS values and is independent of
+ * the runtime that produced it. Free it with vue_dependency_scan_free().
+ */
+typedef struct VueDependencyScanImpl* VueDependencyScan;
+
+/** One block that loads its content from another file. */
+typedef struct VueSrcEntry {
+    /** The block type ("template", "script", "style" or a custom block's tag). */
+    VueStr block;
+    /** The src attribute, as written. */
+    VueStr src;
+} VueSrcEntry;
+
+/**
+ * The dependencies of one SFC. Arrays are owned by the scan.
+ */
+typedef struct VueFileDependencies {
+    /**
+     * Imports of <script> and <script setup>, in the order and with the
+     * de-duplication compileScript() reports them. Side-effect imports
+     * (`import './a.css'`) have an empty local and imported name.
+     */
+    const VueImportEntry* imports;
+    size_t imports_count;
+    /** Blocks with a src attribute, in block order. */
+    const VueSrcEntry* srcs;
+    size_t srcs_count;
+    /**
+     * Paths style blocks import (@import, and @use/@forward in scss/sass or
+     * @require in stylus), as written. Found lexically: preprocessors are
+     * not run.
+     */
+    const VueStr* style_imports;
+    size_t style_imports_count;
+    /** Parse errors of the SFC and its script blocks. */
+    const VueStr* errors;
+    size_t errors_count;
+} VueFileDependencies;
+
+/**
+ * Collects the dependencies of many SFCs in one call, without compiling
+ * them, so a build tool can start resolving and loading imported files
+ * before compilation.
+ *
+ * Blocks are split with the native scanner (see vue_sfc_scan()), falling
+ * back to vue_parse() for sources it declines, and all script blocks of
+ * the batch are then parsed for their imports with a single JS call.
+ * Unlike vue_script_imports_for_each(), a component with only a <script>
+ * lists that block's imports too.
+ *
+ * @param rt The Hermes runtime.
+ * @param inputs Array of `count` inputs. The id field is not read.
+ * @param count Number of inputs.
+ * @return An owned scan to free with vue_dependency_scan_free(), or NULL on
+ *         failure.
+ */
+VueDependencyScan vue_scan_dependencies(
+    HermesRuntime rt,
+    const VueSfcInput* inputs,
+    size_t count
+);
+
+/**
+ * Gets the per-file dependencies of a scan, parallel to its inputs.
+ *
+ * @param scan The scan.
+ * @param out_count Receives the number of files.
+ * @return Pointer to the array, owned by the scan, or NULL if scan or
+ *         out_count is NULL.
+ */
+const VueFileDependencies* vue_dependency_scan_files(VueDependencyScan scan, size_t* out_count);
+
+/**
+ * Frees a dependency scan. Safe to call with NULL.
+ */
+void vue_dependency_scan_free(VueDependencyScan scan);
+
+// ============================================================================
+// Output Sinks
+// ============================================================================
+
+/*
+ * The *_copy and *_write functions move compiled code out of the JS heap
+ * into caller-owned memory without going through the handle's string cache,
+ * saving the intermediate copy and the memory it holds until the handle is
+ * freed. They read the string afresh on every call.
+ *
+ * A *_copy function writes up to `capacity` bytes of UTF-8 to `buffer`, with
+ * no NUL terminator, and returns the full length in bytes. Call it with a
+ * capacity of 0 (buffer may then be NULL) to query the length; if the
+ * returned length exceeds the capacity, the buffer holds a truncated prefix.
+ *
+ * A *_write function passes the code to `callback` in one or more chunks of
+ * UTF-8, each ending on a character boundary and valid only for the duration
+ * of the call. The callback returns true to continue or false to stop, and
+ * must not call into the same runtime. Returns the number of bytes passed.
+ *
+ * Both return 0 if the runtime or handle is invalid.
+ */
+
+/**
+ * Copies the compiled script content into a caller buffer.
+ */
+size_t vue_script_result_content_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity);
+
+/**
+ * Streams the compiled script content to a callback.
+ */
+size_t vue_script_result_content_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Copies the compiled template code into a caller buffer.
+ */
+size_t vue_template_result_code_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity);
+
+/**
+ * Streams the compiled template code to a callback.
+ */
+size_t vue_template_result_code_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Copies the compiled CSS code into a caller buffer.
+ */
+size_t vue_style_result_code_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity);
+
+/**
+ * Streams the compiled CSS code to a callback.
+ */
+size_t vue_style_result_code_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Copies the compiled JavaScript of an SFC pipeline result into a caller buffer.
+ */
+size_t vue_sfc_result_js_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity);
+
+/**
+ * Streams the compiled JavaScript of an SFC pipeline result to a callback.
+ */
+size_t vue_sfc_result_js_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
+/**
+ * Copies the compiled CSS of an SFC pipeline result into a caller buffer.
+ */
+size_t vue_sfc_result_css_copy(
+    HermesRuntime rt, HermesHandle handle, char* buffer, size_t capacity);
+
+/**
+ * Streams the compiled CSS of an SFC pipeline result to a callback.
+ */
+size_t vue_sfc_result_css_write(
+    HermesRuntime rt, HermesHandle handle, VueStrCallback callback, void* user_data);
+
 #ifdef __cplusplus
 }
 #endif
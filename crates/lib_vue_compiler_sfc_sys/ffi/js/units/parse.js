@@ -0,0 +1,111 @@
+/**
+ * @file units/parse.js
+ * @description Parse unit: parse() and rehydrateDescriptor(), plus the SFC
+ * pipeline entry points (see pipeline.js), which need every unit.
+ */
+
+import { parse as sfcParse } from '@vue/compiler-sfc';
+import { shared } from './shared.js';
+import './pipeline.js';
+
+// ============================================================================
+// Parse
+// ============================================================================
+
+/**
+ * Parses a Vue Single File Component source string.
+ *
+ * @param {string} source - The SFC source code.
+ * @param {string} filename - The filename (used for error messages and source maps).
+ * @param {Object} options - Compile options (`sourceMap`).
+ * @param {boolean} [borrowed] - Flag blocks whose content is an unmodified
+ *   slice of `source` (see markContentSlices), so native code can reference
+ *   the caller's buffer instead of copying.
+ * @returns {Object} Parse result with `descriptor` and `errors` properties.
+ *
+ * @example
+ * const result = parse('<template><div>Hello</div></template>', 'App.vue', {});
+ * if (result.errors.length === 0) {
+ *   console.log(result.descriptor.template.content);
+ * }
+ */
+globalThis.parse = function(source, filename, options, borrowed) {
+    try {
+        const result = sfcParse(source, { filename, sourceMap: !!options.sourceMap });
+        if (borrowed && result.descriptor) {
+            markContentSlices(result.descriptor, source);
+        }
+        return result;
+    } catch (e) {
+        return {
+            descriptor: null,
+            errors: [{ message: e.message }],
+        };
+    }
+};
+
+/**
+ * Sets a non-enumerable `contentIsSlice` flag on every block whose content
+ * equals `source.slice(loc.start.offset, loc.end.offset)`. Blocks the parser
+ * transformed (e.g. de-indented templates) are left unflagged.
+ *
+ * @param {Object} descriptor - The SFC descriptor.
+ * @param {string} source - The source it was parsed from.
+ */
+function markContentSlices(descriptor, source) {
+    const mark = (block) => {
+        if (!block || block.contentIsSlice !== undefined) {
+            return;
+        }
+        const { start, end } = block.loc;
+        Object.defineProperty(block, 'contentIsSlice', {
+            value: block.content === source.slice(start.offset, end.offset),
+        });
+    };
+    mark(descriptor.template);
+    mark(descriptor.script);
+    mark(descriptor.scriptSetup);
+    descriptor.styles.forEach(mark);
+    descriptor.customBlocks.forEach(mark);
+}
+
+/**
+ * Completes a descriptor rebuilt from its binary form (see
+ * vue_descriptor_deserialize()), which carries only what cannot be derived.
+ *
+ * Adds each block's `loc.source` and a memoized `template.ast`, which parses
+ * the source again the first time it is read (compileScript() reads it to
+ * find the identifiers a template uses).
+ *
+ * @param {Object} descriptor - Descriptor with plain block objects.
+ * @returns {Object} The same descriptor.
+ */
+globalThis.rehydrateDescriptor = function(descriptor) {
+    const { source, filename } = descriptor;
+    const complete = (block) => {
+        const { start, end } = block.loc;
+        block.loc.source = source.slice(start.offset, end.offset);
+    };
+    [descriptor.template, descriptor.script, descriptor.scriptSetup]
+        .filter(Boolean)
+        .forEach(complete);
+    descriptor.styles.forEach(complete);
+    descriptor.customBlocks.forEach(complete);
+
+    const template = descriptor.template;
+    if (template) {
+        shared.rehydratedTemplates.add(template);
+        let ast;
+        Object.defineProperty(template, 'ast', {
+            get() {
+                if (ast === undefined) {
+                    const parsed = sfcParse(source, { filename, sourceMap: false });
+                    ast = parsed.descriptor.template ? parsed.descriptor.template.ast : null;
+                }
+                return ast;
+            },
+            configurable: true,
+        });
+    }
+    return descriptor;
+};
@@ -0,0 +1,257 @@
+/**
+ * @file units/pipeline.js
+ * @description SFC pipeline entry points: compileSfc(),
+ * compileSfcIncremental() and compileSfcBatch().
+ *
+ * Bundled with the parse unit. The steps come from the script, template and
+ * style units through `shared`; native code loads every unit before calling
+ * these entry points.
+ */
+
+import { parse as sfcParse } from '@vue/compiler-sfc';
+import { messageOf, shared } from './shared.js';
+
+// ============================================================================
+// SFC Pipeline
+// ============================================================================
+
+/**
+ * Joins compiled parts into a compileSfc() result.
+ *
+ * Script warnings come before template tips, and template errors before
+ * style errors, after whatever `errors` and `warnings` already hold.
+ */
+function assembleSfc(script, template, styles, errors, warnings) {
+    for (const w of script.warnings) {
+        warnings.push(w);
+    }
+
+    let js = script.js;
+    if (template) {
+        for (const e of template.errors) {
+            errors.push(e);
+        }
+        for (const t of template.tips) {
+            warnings.push(t);
+        }
+        js = js ? js + '\n' + template.code : template.code;
+    }
+
+    const css = [];
+    for (const style of styles) {
+        for (const e of style.errors) {
+            errors.push(e);
+        }
+        css.push(style.code);
+    }
+
+    return { js, css: css.join('\n'), errors, warnings };
+}
+
+/**
+ * Compiles a complete SFC: parse, script, template and every style block.
+ *
+ * Runs the same four steps as calling parse(), compileScript(),
+ * compileTemplate() and compileStyle() individually, but keeps every
+ * intermediate object inside the JS heap so the caller only crosses the FFI
+ * boundary once per file.
+ *
+ * @param {string} source - The SFC source code.
+ * @param {string} filename - The filename (used for error messages).
+ * @param {string} id - Scope ID for the component (e.g., "data-v-abc123").
+ * @param {Object} options - Compile options (`isProd`, `ssr`).
+ * @returns {Object} Result with `js`, `css`, `errors` and `warnings` (string arrays).
+ *
+ * @example
+ * const result = compileSfc(source, 'App.vue', 'data-v-abc123', { isProd: false });
+ * console.log(result.js);  // script content + render function
+ * console.log(result.css); // compiled styles
+ */
+globalThis.compileSfc = function(source, filename, id, options) {
+    const errors = [];
+    const warnings = [];
+    const isProd = !!options.isProd;
+    const ssr = !!options.ssr;
+
+    try {
+        const { descriptor, errors: parseErrors } = sfcParse(source, {
+            filename,
+            sourceMap: false,
+        });
+        for (const e of parseErrors) {
+            errors.push(messageOf(e));
+        }
+        if (errors.length > 0) {
+            return { js: '', css: '', errors, warnings };
+        }
+
+        const script = shared.compileScriptPart(descriptor, id, isProd, ssr);
+        const template = shared.compileTemplatePart(descriptor, filename, id, isProd, ssr, script.bindings);
+        const styles = descriptor.styles.map(style => shared.compileStylePart(style, filename, id, isProd));
+        return assembleSfc(script, template, styles, errors, warnings);
+    } catch (e) {
+        errors.push(e.message);
+        return { js: '', css: '', errors, warnings };
+    }
+};
+
+// ============================================================================
+// Incremental Pipeline
+// ============================================================================
+
+/** Bits of the `dirty` mask. Mirrors VUE_SFC_DIRTY_* in vue_sfc.h. */
+const DIRTY_SCRIPT = 1;
+const DIRTY_TEMPLATE = 2;
+const DIRTY_STYLE = 4;
+const DIRTY_CUSTOM = 8;
+const DIRTY_ALL = DIRTY_SCRIPT | DIRTY_TEMPLATE | DIRTY_STYLE | DIRTY_CUSTOM;
+
+/**
+ * Returns a string that changes whenever a block's content or attributes do.
+ */
+function blockKey(block) {
+    return block ? block.content + '\0' + JSON.stringify(block.attrs) : '';
+}
+
+/**
+ * Whether script output depends on the template: a TypeScript
+ * `<script setup>` only keeps imports the template uses.
+ */
+function scriptReadsTemplate(descriptor) {
+    const setup = descriptor.scriptSetup;
+    return !!setup && (setup.lang === 'ts' || setup.lang === 'tsx');
+}
+
+/**
+ * Recompiles an SFC, reusing the parts of a previous result whose inputs
+ * did not change.
+ *
+ * The source is always re-parsed. Then each part is compared with the
+ * previous compilation, and coupled blocks are taken into account:
+ * - script: script and script setup content and attributes, and `cssVars`
+ *   (injected into the script); a TypeScript script setup also depends on
+ *   the template
+ * - template: template content and attributes, script bindings, whether any
+ *   style is scoped and `slotted`, and in SSR mode the CSS variables
+ * - style: each block's content and attributes
+ *
+ * Custom blocks are not compiled; a change is only reported.
+ *
+ * @param {Object|null} previous - A previous compileSfcIncremental() result,
+ *   or null. It is only reused for the same filename, id and options.
+ * @param {string} source - The new SFC source code.
+ * @param {string} filename - The filename (used for error messages).
+ * @param {string} id - Scope ID for the component.
+ * @param {Object} options - Compile options (`isProd`, `ssr`).
+ * @returns {Object} A compileSfc() result plus `dirty` (mask of recompiled
+ *   parts), `render` (the template code) and `state` (for the next call).
+ */
+globalThis.compileSfcIncremental = function(previous, source, filename, id, options) {
+    const errors = [];
+    const warnings = [];
+    const isProd = !!options.isProd;
+    const ssr = !!options.ssr;
+
+    let prev = previous && previous.state;
+    if (prev && (prev.filename !== filename || prev.id !== id
+        || prev.isProd !== isProd || prev.ssr !== ssr)) {
+        prev = null;
+    }
+
+    try {
+        const { descriptor, errors: parseErrors } = sfcParse(source, {
+            filename,
+            sourceMap: false,
+        });
+        for (const e of parseErrors) {
+            errors.push(messageOf(e));
+        }
+        if (errors.length > 0) {
+            return { js: '', css: '', errors, warnings, dirty: DIRTY_ALL, render: '', state: null };
+        }
+
+        let dirty = prev ? 0 : DIRTY_ALL;
+
+        const templateBlockKey = blockKey(descriptor.template);
+        const scriptKey = blockKey(descriptor.script) + '\0'
+            + blockKey(descriptor.scriptSetup) + '\0'
+            + descriptor.cssVars.join('\0');
+        let script;
+        if (prev && scriptKey === prev.scriptKey
+            && !(scriptReadsTemplate(descriptor) && templateBlockKey !== prev.templateBlockKey)) {
+            script = prev.script;
+        } else {
+            script = shared.compileScriptPart(descriptor, id, isProd, ssr);
+            dirty |= DIRTY_SCRIPT;
+        }
+
+        const templateKey = templateBlockKey + '\0'
+            + descriptor.styles.some(s => s.scoped) + '\0'
+            + descriptor.slotted + '\0'
+            + JSON.stringify(script.bindings) + '\0'
+            + (ssr ? descriptor.cssVars.join('\0') : '');
+        let template;
+        if (prev && templateKey === prev.templateKey) {
+            template = prev.template;
+        } else {
+            template = shared.compileTemplatePart(descriptor, filename, id, isProd, ssr, script.bindings);
+            dirty |= DIRTY_TEMPLATE;
+        }
+
+        const styleKeys = descriptor.styles.map(blockKey);
+        const styles = descriptor.styles.map((style, i) => {
+            if (prev && prev.styleKeys[i] === styleKeys[i]) {
+                return prev.styles[i];
+            }
+            dirty |= DIRTY_STYLE;
+            return shared.compileStylePart(style, filename, id, isProd);
+        });
+        if (prev && prev.styleKeys.length !== styleKeys.length) {
+            dirty |= DIRTY_STYLE;
+        }
+
+        const customKey = descriptor.customBlocks.map(block => block.type + '\0' + blockKey(block)).join('\0');
+        if (prev && customKey !== prev.customKey) {
+            dirty |= DIRTY_CUSTOM;
+        }
+
+        const result = assembleSfc(script, template, styles, errors, warnings);
+        result.dirty = dirty;
+        result.render = template ? template.code : '';
+        result.state = {
+            filename, id, isProd, ssr,
+            scriptKey, templateBlockKey, templateKey, styleKeys, customKey,
+            script, template, styles,
+        };
+        return result;
+    } catch (e) {
+        errors.push(e.message);
+        return { js: '', css: '', errors, warnings, dirty: DIRTY_ALL, render: '', state: null };
+    }
+};
+
+// ============================================================================
+// Batch Compilation
+// ============================================================================
+
+/**
+ * Compiles many SFCs in one call.
+ *
+ * The loop runs inside the natively compiled bridge, so the compiler's hot
+ * paths and inline caches stay warm across files and the caller pays the
+ * FFI crossing once per batch instead of once per file.
+ *
+ * @param {string[]} sources - SFC sources.
+ * @param {string[]} filenames - Filenames, parallel to `sources`.
+ * @param {string[]} ids - Scope IDs, parallel to `sources`.
+ * @param {Object} options - Compile options applied to every file.
+ * @returns {Object[]} One compileSfc() result per input, in input order.
+ */
+globalThis.compileSfcBatch = function(sources, filenames, ids, options) {
+    const compileOne = globalThis.compileSfc;
+    const results = new Array(sources.length);
+    for (let i = 0; i < sources.length; i++) {
+        results[i] = compileOne(sources[i], filenames[i], ids[i], options);
+    }
+    return results;
+};
@@ -0,0 +1,219 @@
+/**
+ * @file units/script.js
+ * @description Script unit: compileScript(), the pipeline's script step and
+ * the dependency scan.
+ */
+
+import { compileScript as sfcCompileScript, babelParse } from '@vue/compiler-sfc';
+import { messageOf, shared } from './shared.js';
+
+// ============================================================================
+// Script Compilation
+// ============================================================================
+
+/**
+ * Compiles the script blocks of an SFC descriptor.
+ *
+ * Processes both `<script>` and `<script setup>` blocks, combining them into
+ * a single output with binding metadata for template optimization.
+ *
+ * With `options.inlineTemplate`, the template of a `<script setup>`
+ * component is compiled into the setup function (see inlinesTemplate()), so
+ * `content` is the whole component; a template compile error fails the
+ * script compilation.
+ *
+ * @param {Object} descriptor - The SFC descriptor from parseRaw().
+ * @param {string} id - Scope ID for the component (e.g., "data-v-abc123").
+ * @param {Object} options - Compile options (`isProd`, `ssr`, `sourceMap`,
+ *   `inlineTemplate`).
+ * @returns {Object} Compilation result with `content`, `bindings`, `map`,
+ *   `warnings` and `inlineTemplate` (whether the template was inlined).
+ *   `map` is null unless `options.sourceMap` is set.
+ *
+ * @example
+ * const scriptResult = compileScript(descriptor, 'data-v-abc123', { isProd: false });
+ * console.log(scriptResult.content); // Compiled JavaScript
+ * console.log(scriptResult.bindings); // { msg: 'setup-ref', count: 'setup-ref' }
+ */
+globalThis.compileScript = function(descriptor, id, options) {
+    try {
+        const inlineTemplate = !!options.inlineTemplate && inlinesTemplate(descriptor);
+        const templateOptions = { ssr: !!options.ssr };
+        if (inlineTemplate) {
+            // compileScript() derives scoped and the CSS variables itself
+            templateOptions.slotted = descriptor.slotted;
+            templateOptions.compilerOptions = { sourceMap: !!options.sourceMap };
+        }
+        const result = sfcCompileScript(descriptor, {
+            id,
+            isProd: !!options.isProd,
+            sourceMap: !!options.sourceMap,
+            inlineTemplate,
+            templateOptions,
+        });
+        return {
+            content: result.content,
+            bindings: result.bindings || null,
+            map: result.map || null,
+            warnings: result.warnings || [],
+            inlineTemplate,
+        };
+    } catch (e) {
+        return {
+            content: '',
+            bindings: null,
+            errors: [{ message: e.message }],
+        };
+    }
+};
+
+/**
+ * Whether compileScript() can inline the template of a descriptor: only
+ * `<script setup>` components with an inline (not `src`) template.
+ */
+function inlinesTemplate(descriptor) {
+    return !!descriptor.scriptSetup && !!descriptor.template && !descriptor.template.src;
+}
+
+/**
+ * Compiles the script blocks of a descriptor, if any.
+ *
+ * @returns {Object} `js`, `bindings` (or null) and `warnings`.
+ */
+shared.compileScriptPart = function(descriptor, id, isProd, ssr) {
+    if (!descriptor.script && !descriptor.scriptSetup) {
+        return { js: '', bindings: null, warnings: [] };
+    }
+    const script = sfcCompileScript(descriptor, {
+        id,
+        isProd,
+        sourceMap: false,
+        templateOptions: { ssr },
+    });
+    return {
+        js: script.content,
+        bindings: script.bindings || null,
+        warnings: script.warnings || [],
+    };
+};
+
+// ============================================================================
+// Dependency Scanning
+// ============================================================================
+
+const SETUP_MACROS = new Set([
+    'defineProps',
+    'defineEmits',
+    'defineExpose',
+    'defineOptions',
+    'defineSlots',
+    'defineModel',
+    'withDefaults',
+]);
+
+/**
+ * Returns the Babel plugins compileScript() parses a script of `lang` with.
+ */
+function scriptParserPlugins(lang) {
+    const plugins = ['importAttributes'];
+    if (lang === 'jsx' || lang === 'tsx' || lang === 'mtsx') {
+        plugins.push('jsx');
+    }
+    if (lang === 'ts' || lang === 'mts' || lang === 'tsx' || lang === 'mtsx') {
+        plugins.push(['typescript', { dts: false }], 'explicitResourceManagement', 'decorators-legacy');
+    }
+    return plugins;
+}
+
+/**
+ * Adds the imports of one script block to `imports`, the way compileScript()
+ * registers them: keyed by local name, type-only if the declaration or the
+ * specifier is, and without the compiler macros imported from 'vue' in
+ * <script setup>. Side-effect imports have an empty local and imported name.
+ */
+function collectScriptImports(content, lang, isFromSetup, imports, locals, errors) {
+    let program;
+    try {
+        program = babelParse(content, { plugins: scriptParserPlugins(lang), sourceType: 'module' }).program;
+    } catch (e) {
+        errors.push(messageOf(e));
+        return;
+    }
+
+    for (const node of program.body) {
+        if (node.type !== 'ImportDeclaration') {
+            continue;
+        }
+        const source = node.source.value;
+        const declIsType = node.importKind === 'type';
+        if (node.specifiers.length === 0) {
+            imports.push({ local: '', imported: '', source, isType: declIsType, isFromSetup });
+            continue;
+        }
+        for (const specifier of node.specifiers) {
+            const local = specifier.local.name;
+            const imported = specifier.type === 'ImportDefaultSpecifier'
+                ? 'default'
+                : specifier.type === 'ImportNamespaceSpecifier'
+                    ? '*'
+                    : specifier.imported.type === 'Identifier'
+                        ? specifier.imported.name
+                        : specifier.imported.value;
+            if (isFromSetup && source === 'vue' && SETUP_MACROS.has(imported)) {
+                continue;
+            }
+            const entry = {
+                local,
+                imported,
+                source,
+                isType: declIsType || specifier.importKind === 'type',
+                isFromSetup,
+            };
+            const index = locals.get(local);
+            if (index === undefined) {
+                locals.set(local, imports.length);
+                imports.push(entry);
+            } else if (!isFromSetup) {
+                imports[index] = entry;
+            } else if (imports[index].source !== source || imports[index].imported !== imported) {
+                errors.push(`different imports aliased to same local name: ${local}`);
+            }
+        }
+    }
+}
+
+/**
+ * Collects the imports of the script blocks of many SFCs in one call,
+ * parsing each block with Babel instead of running compileScript().
+ *
+ * Unlike compileScript(), which only reports imports for <script setup>
+ * components, the imports of a lone <script> are listed too.
+ *
+ * @param {Array<string|null>} scripts - <script> contents, null if absent.
+ * @param {Array<string|null>} scriptLangs - Their lang attributes, parallel to `scripts`.
+ * @param {Array<string|null>} setups - <script setup> contents, null if absent.
+ * @param {Array<string|null>} setupLangs - Their lang attributes, parallel to `setups`.
+ * @returns {Object[]} Per file, in input order: `imports` (local, imported,
+ *          source, isType, isFromSetup, in compileScript() order) and
+ *          `errors` (parse error messages).
+ */
+globalThis.scanScriptImports = function(scripts, scriptLangs, setups, setupLangs) {
+    const results = new Array(scripts.length);
+    for (let i = 0; i < scripts.length; i++) {
+        const imports = [];
+        const locals = new Map();
+        const errors = [];
+        try {
+            if (scripts[i] != null) {
+                collectScriptImports(scripts[i], scriptLangs[i], false, imports, locals, errors);
+            }
+            if (setups[i] != null) {
+                collectScriptImports(setups[i], setupLangs[i], true, imports, locals, errors);
+            }
+        } catch (e) {
+            errors.push(messageOf(e));
+        }
+        results[i] = { imports, errors };
+    }
+    return results;
+};
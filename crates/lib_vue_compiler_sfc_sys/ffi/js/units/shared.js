@@ -0,0 +1,30 @@
+/**
+ * @file units/shared.js
+ * @description State and helpers the compiler units share.
+ *
+ * Each unit is bundled on its own, so it gets its own copy of this module.
+ * Cross-unit state therefore lives on globalThis: every unit loaded into a
+ * runtime sees the same `shared` object, whichever was initialized first.
+ */
+
+/**
+ * Cross-unit registry.
+ *
+ * - `rehydratedTemplates`: template blocks rebuilt by rehydrateDescriptor()
+ *   (parse unit). Their `ast` is derived on demand, so
+ *   compileTemplateFromDescriptor() (template unit) parses the content instead.
+ * - `compileScriptPart`, `compileTemplatePart`, `compileStylePart`: the
+ *   pipeline steps, registered by the script, template and style units.
+ */
+export const shared = globalThis.__vueBridgeShared
+    || (globalThis.__vueBridgeShared = { rehydratedTemplates: new WeakSet() });
+
+/**
+ * Returns the message of a compiler error, which may be a string or an Error.
+ *
+ * @param {string|Error} e - The error value.
+ * @returns {string} The error message.
+ */
+export function messageOf(e) {
+    return typeof e === 'string' ? e : e.message;
+}
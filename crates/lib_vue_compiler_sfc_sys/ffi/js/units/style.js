@@ -0,0 +1,98 @@
+/**
+ * @file units/style.js
+ * @description Style unit: compileStyle(), compileStyleFromDescriptor() and
+ * the pipeline's style step.
+ */
+
+import { compileStyle as sfcCompileStyle } from '@vue/compiler-sfc';
+import { messageOf, shared } from './shared.js';
+
+// ============================================================================
+// Style Compilation
+// ============================================================================
+
+/**
+ * Compiles a CSS style block, optionally adding scoped attribute selectors.
+ *
+ * @param {string} source - The CSS source code.
+ * @param {string} filename - The filename (used for error messages).
+ * @param {string} id - Scope ID for scoped styles (e.g., "data-v-abc123").
+ * @param {boolean} scoped - Whether to add scoped attribute selectors.
+ * @param {Object} options - Compile options (`isProd`).
+ * @returns {Object} Compilation result with `code`, `errors`, and `dependencies`.
+ *
+ * @example
+ * const styleResult = compileStyle(
+ *   '.container { color: red; }',
+ *   'App.vue',
+ *   'data-v-abc123',
+ *   true,
+ *   {}
+ * );
+ * // Output: .container[data-v-abc123] { color: red; }
+ * console.log(styleResult.code);
+ */
+globalThis.compileStyle = function(source, filename, id, scoped, options) {
+    try {
+        const result = sfcCompileStyle({
+            source,
+            filename,
+            id,
+            scoped,
+            isProd: !!options.isProd,
+        });
+        return {
+            code: result.code,
+            errors: result.errors || [],
+            dependencies: result.dependencies || [],
+        };
+    } catch (e) {
+        return {
+            code: '',
+            errors: [{ message: e.message }],
+            dependencies: [],
+        };
+    }
+};
+
+/**
+ * Compiles one style block of a parsed descriptor.
+ *
+ * The block content stays in the JS heap; scoped is taken from the block.
+ *
+ * @param {Object} descriptor - The SFC descriptor from parse().
+ * @param {number} index - Index into `descriptor.styles`.
+ * @param {string} id - Scope ID for scoped styles (e.g., "data-v-abc123").
+ * @param {Object} options - Compile options as for compileStyle().
+ * @returns {Object} Same shape as compileStyle().
+ */
+globalThis.compileStyleFromDescriptor = function(descriptor, index, id, options) {
+    const style = descriptor.styles[index];
+    if (!style) {
+        return {
+            code: '',
+            errors: [{ message: `descriptor has no style block at index ${index}` }],
+            dependencies: [],
+        };
+    }
+    return globalThis.compileStyle(style.content, descriptor.filename, id, !!style.scoped, options);
+};
+
+/**
+ * Compiles one style block.
+ *
+ * @returns {Object} `code` and `errors`.
+ */
+shared.compileStylePart = function(style, filename, id, isProd) {
+    const result = sfcCompileStyle({
+        source: style.content,
+        filename,
+        id,
+        scoped: style.scoped,
+        isProd,
+    });
+    return {
+        code: result.code,
+        errors: (result.errors || []).map(messageOf),
+    };
+};
@@ -0,0 +1,174 @@
+/**
+ * @file units/template.js
+ * @description Template unit: compileTemplate(),
+ * compileTemplateFromDescriptor() and the pipeline's template step.
+ */
+
+import { compileTemplate as sfcCompileTemplate } from '@vue/compiler-sfc';
+import { messageOf, shared } from './shared.js';
+
+// ============================================================================
+// Template Compilation
+// ============================================================================
+
+/**
+ * Compiles a Vue template to a render function.
+ *
+ * @param {string} source - The template source code.
+ * @param {string} filename - The filename (used for error messages).
+ * @param {string} id - Scope ID for scoped styles (e.g., "data-v-abc123").
+ * @param {boolean} scoped - Whether the component has scoped styles.
+ * @param {Object|null} bindings - Binding metadata from compileScript() for optimization.
+ * @param {Object} options - Compile options (`isProd`, `ssr`, and see toTemplateResult()).
+ * @returns {Object} Compilation result with `code`, `ast`, `preamble`, `map`, `errors`, and `tips`.
+ *
+ * @example
+ * const templateResult = compileTemplate(
+ *   '<div>{{ msg }}</div>',
+ *   'App.vue',
+ *   'data-v-abc123',
+ *   true,
+ *   { msg: 'setup-ref' },
+ *   {}
+ * );
+ * console.log(templateResult.code); // render function code
+ */
+globalThis.compileTemplate = function(source, filename, id, scoped, bindings, options) {
+    try {
+        const result = sfcCompileTemplate({
+            source,
+            filename,
+            id,
+            scoped,
+            slotted: false,
+            isProd: !!options.isProd,
+            ssr: !!options.ssr,
+            ssrCssVars: [],
+            compilerOptions: templateCompilerOptions(bindings, options),
+        });
+        return toTemplateResult(result, options);
+    } catch (e) {
+        return {
+            code: '',
+            errors: [{ message: e.message }],
+            tips: [],
+        };
+    }
+};
+
+/**
+ * Compiles the template block of a parsed descriptor.
+ *
+ * Unlike compileTemplate(), the source never leaves the JS heap and the AST
+ * produced by parse() is reused instead of parsing the template again
+ * (except for descriptors from rehydrateDescriptor(), which have none).
+ * Scoped and slotted are derived from the descriptor's style blocks.
+ *
+ * @param {Object} descriptor - The SFC descriptor from parse().
+ * @param {string} id - Scope ID for the component (e.g., "data-v-abc123").
+ * @param {Object|null} bindings - Binding metadata from compileScript().
+ * @param {Object} options - Compile options (`isProd`, `ssr`, and see toTemplateResult()).
+ * @returns {Object} Same shape as compileTemplate().
+ */
+globalThis.compileTemplateFromDescriptor = function(descriptor, id, bindings, options) {
+    const template = descriptor.template;
+    if (!template) {
+        return {
+            code: '',
+            errors: [{ message: 'descriptor has no template block' }],
+            tips: [],
+        };
+    }
+
+    try {
+        const result = sfcCompileTemplate({
+            source: template.content,
+            // A rehydrated template has no AST yet; parsing only its content
+            // is cheaper than deriving one from the whole source.
+            ast: shared.rehydratedTemplates.has(template) ? undefined : template.ast,
+            filename: descriptor.filename,
+            id,
+            scoped: descriptor.styles.some(s => s.scoped),
+            slotted: descriptor.slotted,
+            isProd: !!options.isProd,
+            ssr: !!options.ssr,
+            ssrCssVars: descriptor.cssVars,
+            compilerOptions: templateCompilerOptions(bindings, options),
+        });
+        return toTemplateResult(result, options);
+    } catch (e) {
+        return {
+            code: '',
+            errors: [{ message: e.message }],
+            tips: [],
+        };
+    }
+};
+
+/**
+ * Builds the compiler options for a template compilation.
+ *
+ * compiler-sfc turns source maps on for templates unless told otherwise, so
+ * `sourceMap` is always passed explicitly.
+ *
+ * @param {Object|null} bindings - Binding metadata from compileScript().
+ * @param {Object} options - Compile options (`sourceMap`).
+ * @returns {Object} Options for `compilerOptions`.
+ */
+function templateCompilerOptions(bindings, options) {
+    const compilerOptions = { sourceMap: !!options.sourceMap };
+    if (bindings) {
+        compilerOptions.bindingMetadata = bindings;
+    }
+    return compilerOptions;
+}
+
+/**
+ * Shapes a compiler-sfc template result for the FFI accessors.
+ *
+ * Artifacts the caller did not ask for are dropped so the result handle
+ * does not keep them alive.
+ *
+ * @param {Object} result - Result of sfcCompileTemplate().
+ * @param {Object} options - Compile options (`sourceMap`, `keepAst`,
+ *   `keepPreamble`, `keepTips`).
+ * @returns {Object} Result with `code`, `ast`, `preamble`, `map`, `errors` and `tips`.
+ */
+function toTemplateResult(result, options) {
+    return {
+        code: result.code,
+        ast: (options.keepAst && result.ast) || null,
+        preamble: (options.keepPreamble && result.preamble) || null,
+        map: (options.sourceMap && result.map) || null,
+        errors: result.errors || [],
+        tips: (options.keepTips && result.tips) || [],
+    };
+}
+
+/**
+ * Compiles the template block of a descriptor against the script bindings.
+ *
+ * @returns {Object|null} `code`, `errors` and `tips`, or null without a template.
+ */
+shared.compileTemplatePart = function(descriptor, filename, id, isProd, ssr, bindings) {
+    if (!descriptor.template) {
+        return null;
+    }
+    const template = sfcCompileTemplate({
+        source: descriptor.template.content,
+        ast: descriptor.template.ast,
+        filename,
+        id,
+        scoped: descriptor.styles.some(s => s.scoped),
+        slotted: descriptor.slotted,
+        isProd,
+        ssr,
+        ssrCssVars: descriptor.cssVars,
+        compilerOptions: templateCompilerOptions(bindings, {}),
+    });
+    return {
+        code: template.code,
+        errors: (template.errors || []).map(messageOf),
+        tips: template.tips || [],
+    };
+};
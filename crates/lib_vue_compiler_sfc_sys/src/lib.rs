@@ -31,8 +31,10 @@
 //!
 //! All JS objects are represented as opaque handles ([`HermesHandle`]). Handles are:
 //! - 64-bit integers (0 = invalid/null)
-//! - 1-indexed into an internal handle table
-//! - Must be freed with [`hermes_handle_free`] when no longer needed
+//! - A 1-indexed slot in an internal handle table plus the slot's generation,
+//!   so freed handles are detected as stale rather than reused
+//! - Must be freed with [`hermes_handle_free`] when no longer needed, or in
+//!   bulk by closing the handle scope they were allocated in
 //!
 //! # Safety
 //!
@@ -58,8 +60,11 @@
 //!
 //! - Each runtime instance must only be used from one thread at a time
 //! - Multiple runtime instances can be used in parallel from different threads
+//! - A [`VuePool`] owns several runtimes pinned to worker threads and may be
+//!   called from any thread
 
-use std::os::raw::c_char;
+use std::ffi::c_void;
+use std::os::raw::{c_char, c_int};
 
 // ============================================================================
 // Types
@@ -98,7 +103,8 @@ impl HermesRuntime {
 /// # Representation
 ///
 /// - `0` represents an invalid/null handle
-/// - Non-zero values are 1-indexed into the handle table
+/// - The low 32 bits are a 1-indexed slot in the handle table
+/// - The high 32 bits are the slot's generation
 ///
 /// # Lifetime
 ///
@@ -140,6 +146,430 @@ impl From<HermesHandle> for u64 {
     }
 }
 
+/// Token for an open handle scope (see [`hermes_handle_scope_open`]).
+///
+/// `0` represents an invalid/null scope.
+#[repr(transparent)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+pub struct HermesHandleScope(pub u64);
+
+impl HermesHandleScope {
+    /// The invalid/null scope value.
+    pub const INVALID: Self = HermesHandleScope(0);
+
+    /// Returns `true` if this scope token is valid (non-null).
+    #[inline]
+    #[must_use]
+    pub fn is_valid(self) -> bool {
+        self.0 != 0
+    }
+}
+
+/// [`HermesRuntimeOptions::units`] bit: `vue_parse()` and descriptor rehydration.
+pub const VUE_UNIT_PARSE: u32 = 1 << 0;
+/// [`HermesRuntimeOptions::units`] bit: script compilation and dependency scans.
+pub const VUE_UNIT_SCRIPT: u32 = 1 << 1;
+/// [`HermesRuntimeOptions::units`] bit: template compilation.
+pub const VUE_UNIT_TEMPLATE: u32 = 1 << 2;
+/// [`HermesRuntimeOptions::units`] bit: style compilation through compiler-sfc.
+pub const VUE_UNIT_STYLE: u32 = 1 << 3;
+/// Every compiler unit.
+pub const VUE_UNIT_ALL: u32 = 0xF;
+
+/// Heap and GC configuration of every runtime, for
+/// [`hermes_runtime_configure_process`]. Mirrors `HermesProcessOptions` in
+/// `runtime.h`; zero fields keep defaults.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct HermesProcessOptions {
+    /// Initial GC heap size of each runtime in bytes (0 = default).
+    pub init_heap_bytes: usize,
+    /// Maximum GC heap size of each runtime in bytes (0 = default).
+    pub max_heap_bytes: usize,
+    /// Further Static Hermes VM flags in command line form, or null.
+    pub vm_flags: *const *const c_char,
+    pub vm_flag_count: usize,
+}
+
+impl Default for HermesProcessOptions {
+    fn default() -> Self {
+        HermesProcessOptions {
+            init_heap_bytes: 0,
+            max_heap_bytes: 0,
+            vm_flags: std::ptr::null(),
+            vm_flag_count: 0,
+        }
+    }
+}
+
+/// Per-runtime configuration for [`hermes_runtime_create_with_options`].
+/// Mirrors `HermesRuntimeOptions` in `runtime.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct HermesRuntimeOptions {
+    /// Compiler units to initialize at creation (`VUE_UNIT_*` bits, 0 = all).
+    /// Missing units load on first use; only honored with `split-units`.
+    pub units: u32,
+}
+
+/// Heap statistics of a runtime. Mirrors `HermesHeapStats` in `runtime.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
+pub struct HermesHeapStats {
+    /// Bytes currently allocated in the JS heap.
+    pub allocated_bytes: usize,
+    /// Current size of the JS heap, including free space.
+    pub heap_size: usize,
+    /// Native memory retained by JS objects outside the heap.
+    pub external_bytes: usize,
+    /// Bytes allocated over the runtime's lifetime.
+    pub total_allocated_bytes: u64,
+    /// Collections run by the GC, including explicit ones.
+    pub gc_count: u64,
+    /// Collections requested with [`hermes_runtime_collect_garbage`].
+    pub explicit_gc_count: u64,
+    /// Pause of the last explicit collection, in milliseconds.
+    pub last_gc_pause_ms: f64,
+    /// Total pause of all explicit collections, in milliseconds.
+    pub total_gc_pause_ms: f64,
+}
+
+/// Calls and time spent in one instrumented phase. Mirrors `VuePhaseStats`
+/// in `runtime.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct VuePhaseStats {
+    pub calls: u64,
+    pub nanos: u64,
+}
+
+/// Instrumentation counters of a runtime. Mirrors `HermesRuntimeStats` in
+/// `runtime.h`. All zero unless built with the `stats` feature.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct HermesRuntimeStats {
+    /// `vue_parse` and `vue_parse_borrowed`.
+    pub parse: VuePhaseStats,
+    /// `vue_compile_script`.
+    pub compile_script: VuePhaseStats,
+    /// `vue_compile_template` and `vue_compile_template_from_descriptor`.
+    pub compile_template: VuePhaseStats,
+    /// `vue_compile_style` and `vue_compile_style_from_descriptor`, through
+    /// the JS compiler.
+    pub compile_style: VuePhaseStats,
+    /// `vue_compile_sfc`, `vue_compile_sfc_incremental` and `vue_compile_batch`.
+    pub compile_sfc: VuePhaseStats,
+    /// The batch script import scan of `vue_scan_dependencies`.
+    pub scan_dependencies: VuePhaseStats,
+    /// Accessor calls (property reads, string conversion and copies).
+    pub marshal_out: VuePhaseStats,
+    /// UTF-8 bytes of sources, filenames and ids passed into JS.
+    pub bytes_in: u64,
+    /// UTF-8 bytes converted out of the JS heap.
+    pub bytes_out: u64,
+    /// Handles allocated, including ones since freed.
+    pub handles_allocated: u64,
+    /// Bytes copied into handle string storage, including terminators.
+    pub string_bytes: u64,
+}
+
+/// Options for the compile entry points (mirrors `VueCompileOptions` in `vue_sfc.h`).
+///
+/// Passing a null pointer instead of this struct selects the defaults, which
+/// generate and retain only the compiled code.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct VueCompileOptions {
+    /// Compile for production (enables optimizations).
+    pub is_prod: bool,
+    /// Generate source maps during parse, script and template compilation.
+    pub source_map: bool,
+    /// Keep the template AST on template results.
+    pub keep_template_ast: bool,
+    /// Keep the template preamble on template results.
+    pub keep_preamble: bool,
+    /// Keep compiler tips on template results.
+    pub keep_tips: bool,
+    /// Generate server-rendering code (templates compile to `ssrRender`).
+    pub ssr: bool,
+    /// Compile plain CSS of style blocks with the native rewriter, falling
+    /// back to the JS compiler for input it doesn't handle.
+    pub native_style: bool,
+    /// Inline the render function into `<script setup>` output (only read
+    /// by `vue_compile_script`).
+    pub inline_template: bool,
+}
+
+/// One SFC to compile in a batch. Mirrors `VueSfcInput` in `vue_sfc.h`.
+///
+/// All strings are UTF-8 byte slices (not null-terminated).
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueSfcInput {
+    pub source: *const c_char,
+    pub source_len: usize,
+    pub filename: *const c_char,
+    pub filename_len: usize,
+    pub id: *const c_char,
+    pub id_len: usize,
+}
+
+/// Opaque pointer to a compiler pool (`pool.h`).
+///
+/// The pool owns worker threads, each pinned to its own runtime. Unlike
+/// [`HermesRuntime`], a pool may be used from any thread. Must be destroyed
+/// with [`vue_pool_destroy`].
+#[repr(transparent)]
+#[derive(Debug, Clone, Copy)]
+pub struct VuePool(*mut std::ffi::c_void);
+
+impl VuePool {
+    /// Returns `true` if this pool pointer is null.
+    #[inline]
+    pub fn is_null(self) -> bool {
+        self.0.is_null()
+    }
+}
+
+/// Opaque pointer to an owned, runtime-independent compile result (`pool.h`).
+///
+/// Must be freed with [`vue_compiled_sfc_free`]. Strings returned by its
+/// accessors are owned by the result.
+#[repr(transparent)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueCompiledSfc(*mut std::ffi::c_void);
+
+impl VueCompiledSfc {
+    /// The null result.
+    pub const NULL: Self = VueCompiledSfc(std::ptr::null_mut());
+
+    /// Returns `true` if this result pointer is null.
+    #[inline]
+    pub fn is_null(self) -> bool {
+        self.0.is_null()
+    }
+}
+
+/// Opaque pointer to an open persistent compile cache (`disk_cache.h`).
+///
+/// May be used from any thread. Must be closed with [`vue_disk_cache_close`].
+#[repr(transparent)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueDiskCache(*mut std::ffi::c_void);
+
+impl VueDiskCache {
+    /// Returns `true` if this cache pointer is null.
+    #[inline]
+    pub fn is_null(self) -> bool {
+        self.0.is_null()
+    }
+}
+
+/// Identifies a job submitted with [`vue_pool_submit`]. Never 0.
+pub type VueJobTicket = u64;
+
+/// Receives the result of a submitted job on the worker thread that compiled
+/// it. The callback owns the result and must free it with
+/// [`vue_compiled_sfc_free`].
+pub type VueJobCallback =
+    unsafe extern "C" fn(user_data: *mut c_void, ticket: VueJobTicket, result: VueCompiledSfc);
+
+/// Counters of a pool's compile cache. Mirrors `VuePoolCacheStats` in `pool.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct VuePoolCacheStats {
+    /// Results currently cached.
+    pub entries: usize,
+    /// Approximate bytes held by cached results.
+    pub bytes: usize,
+    /// Inputs answered from the cache without entering JS.
+    pub hits: u64,
+    /// Inputs that were compiled while the cache was enabled.
+    pub misses: u64,
+    /// Results dropped to stay within the limits.
+    pub evictions: u64,
+}
+
+/// A UTF-8 string view (not null-terminated). Mirrors `VueStr` in `vue_sfc.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueStr {
+    pub data: *const c_char,
+    pub len: usize,
+}
+
+/// Receives one string from a `*_for_each` accessor. Return false to stop.
+///
+/// The string is only valid for the duration of the call.
+pub type VueStrCallback = unsafe extern "C" fn(user_data: *mut c_void, value: VueStr) -> bool;
+
+/// Receives one key/value pair from a `*_for_each` accessor. Return false to stop.
+///
+/// The strings are only valid for the duration of the call.
+pub type VueStrPairCallback =
+    unsafe extern "C" fn(user_data: *mut c_void, key: VueStr, value: VueStr) -> bool;
+
+/// One import of a script block. Mirrors `VueImportEntry` in `vue_sfc.h`.
+///
+/// The strings are only valid for the duration of the callback.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueImportEntry {
+    pub local: VueStr,
+    pub imported: VueStr,
+    pub source: VueStr,
+    pub is_type: bool,
+    pub is_from_setup: bool,
+}
+
+/// Receives one import from [`vue_script_imports_for_each`]. Return false to stop.
+pub type VueImportCallback =
+    unsafe extern "C" fn(user_data: *mut c_void, entry: *const VueImportEntry) -> bool;
+
+/// A position in the SFC source. Mirrors `VuePosition` in `vue_sfc.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct VuePosition {
+    pub offset: usize,
+    pub line: usize,
+    pub column: usize,
+}
+
+/// A range in the SFC source. Mirrors `VueSourceLocation` in `vue_sfc.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct VueSourceLocation {
+    pub start: VuePosition,
+    pub end: VuePosition,
+}
+
+/// A block attribute. Mirrors `VueBlockAttr` in `vue_sfc.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueBlockAttr {
+    pub key: VueStr,
+    pub value: VueStr,
+    pub is_bool: bool,
+}
+
+/// Flattened view of an SFC block. Mirrors `VueBlockSnapshot` in `vue_sfc.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueBlockSnapshot {
+    pub type_: VueStr,
+    pub content: VueStr,
+    pub lang: VueStr,
+    pub src: VueStr,
+    pub loc: VueSourceLocation,
+    pub attrs: *const VueBlockAttr,
+    pub attrs_count: usize,
+    pub scoped: bool,
+    pub has_module: bool,
+    pub module: VueStr,
+    pub has_setup: bool,
+    pub setup: VueStr,
+    pub content_borrowed: bool,
+    pub content_offset: usize,
+}
+
+/// Flattened view of a descriptor. Mirrors `VueDescriptorSnapshot` in `vue_sfc.h`.
+///
+/// Returned by [`vue_descriptor_materialize`]; owned by the descriptor handle.
+/// Absent blocks are null pointers.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueDescriptorSnapshot {
+    pub filename: VueStr,
+    pub source: VueStr,
+    pub template_block: *const VueBlockSnapshot,
+    pub script: *const VueBlockSnapshot,
+    pub script_setup: *const VueBlockSnapshot,
+    pub styles: *const VueBlockSnapshot,
+    pub styles_count: usize,
+    pub custom_blocks: *const VueBlockSnapshot,
+    pub custom_blocks_count: usize,
+    pub css_vars: *const VueStr,
+    pub css_vars_count: usize,
+    pub slotted: bool,
+}
+
+/// [`vue_sfc_result_dirty`] bit: the script was recompiled.
+pub const VUE_SFC_DIRTY_SCRIPT: u32 = 1 << 0;
+/// [`vue_sfc_result_dirty`] bit: the template was recompiled.
+pub const VUE_SFC_DIRTY_TEMPLATE: u32 = 1 << 1;
+/// [`vue_sfc_result_dirty`] bit: at least one style block was recompiled.
+pub const VUE_SFC_DIRTY_STYLE: u32 = 1 << 2;
+/// [`vue_sfc_result_dirty`] bit: custom blocks changed (reported, not compiled).
+pub const VUE_SFC_DIRTY_CUSTOM: u32 = 1 << 3;
+/// Every [`vue_sfc_result_dirty`] bit.
+pub const VUE_SFC_DIRTY_ALL: u32 = 0xF;
+
+/// Opaque pointer to an owned block scan from [`vue_sfc_scan`].
+///
+/// Like [`VueCompiledSfc`], it holds no JS values and is independent of any
+/// runtime.
+#[repr(transparent)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueSfcScan(*mut std::ffi::c_void);
+
+impl VueSfcScan {
+    /// The null scan.
+    pub const NULL: Self = VueSfcScan(std::ptr::null_mut());
+
+    /// Returns `true` if this scan pointer is null.
+    #[inline]
+    pub fn is_null(self) -> bool {
+        self.0.is_null()
+    }
+}
+
+/// Opaque pointer to an owned dependency scan from [`vue_scan_dependencies`].
+///
+/// Like [`VueCompiledSfc`], it holds no JS values and is independent of the
+/// runtime that produced it.
+#[repr(transparent)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueDependencyScan(*mut std::ffi::c_void);
+
+impl VueDependencyScan {
+    /// The null scan.
+    pub const NULL: Self = VueDependencyScan(std::ptr::null_mut());
+
+    /// Returns `true` if this scan pointer is null.
+    #[inline]
+    pub fn is_null(self) -> bool {
+        self.0.is_null()
+    }
+}
+
+/// A block loaded from another file. Mirrors `VueSrcEntry` in `vue_sfc.h`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueSrcEntry {
+    pub block: VueStr,
+    pub src: VueStr,
+}
+
+/// The dependencies of one SFC. Mirrors `VueFileDependencies` in `vue_sfc.h`.
+///
+/// Returned by [`vue_dependency_scan_files`]; owned by the scan.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct VueFileDependencies {
+    pub imports: *const VueImportEntry,
+    pub imports_count: usize,
+    pub srcs: *const VueSrcEntry,
+    pub srcs_count: usize,
+    pub style_imports: *const VueStr,
+    pub style_imports_count: usize,
+    pub errors: *const VueStr,
+    pub errors_count: usize,
+}
+
+/// Version of the binary descriptor format written by [`vue_descriptor_serialize`].
+/// The layout is documented in `vue_sfc.h`.
+pub const VUE_DESCRIPTOR_FORMAT_VERSION: u16 = 1;
+
 // ============================================================================
 // FFI Function Declarations
 // ============================================================================
@@ -151,7 +581,8 @@ extern "C" {
 
     /// Creates a new Hermes runtime instance.
     ///
-    /// This function:
+    /// Takes a spare runtime if one is available (see [`hermes_runtime_prewarm`]).
+    /// Otherwise this function:
     /// 1. Initializes a fresh Static Hermes runtime
     /// 2. Loads the Vue compiler unit
     /// 3. Caches references to Vue compiler functions
@@ -178,6 +609,135 @@ extern "C" {
     /// - All handles created by this runtime become invalid.
     pub fn hermes_runtime_destroy(rt: HermesRuntime);
 
+    /// Tears a runtime down for good, releasing its heap, even if it could
+    /// be parked as a spare.
+    ///
+    /// # Safety
+    ///
+    /// Same as [`hermes_runtime_destroy`]. May be called from any thread
+    /// that is not using the runtime.
+    pub fn hermes_runtime_retire(rt: HermesRuntime);
+
+    /// Returns the number of runtimes torn down so far in this process (by
+    /// destroy or retire); parked spares are not counted.
+    #[must_use]
+    pub fn hermes_runtime_teardown_count() -> u64;
+
+    /// Creates a fresh runtime that initializes only `options.units` up front.
+    ///
+    /// Never takes a spare; the runtime may be parked on destroy.
+    ///
+    /// # Safety
+    ///
+    /// - `options` must be null or point to valid options.
+    /// - The returned runtime must be destroyed with [`hermes_runtime_destroy`].
+    #[must_use]
+    pub fn hermes_runtime_create_with_options(
+        options: *const HermesRuntimeOptions,
+    ) -> HermesRuntime;
+
+    /// Sets the heap and GC configuration of every runtime of the process.
+    ///
+    /// Returns false if `options` is null or a runtime was already
+    /// initialized: Static Hermes applies VM options once.
+    ///
+    /// # Safety
+    ///
+    /// `options` must be null or point to valid options whose `vm_flags`
+    /// array (if any) holds `vm_flag_count` C strings, valid during the call.
+    #[must_use]
+    pub fn hermes_runtime_configure_process(options: *const HermesProcessOptions) -> bool;
+
+    // ------------------------------------------------------------------------
+    // Memory
+    // ------------------------------------------------------------------------
+
+    /// Runs a full garbage collection. Values held by live handles survive.
+    pub fn hermes_runtime_collect_garbage(rt: HermesRuntime);
+
+    /// Reads heap statistics into `out`.
+    ///
+    /// # Safety
+    ///
+    /// `out` must be null or point to a writable [`HermesHeapStats`].
+    pub fn hermes_runtime_heap_stats(rt: HermesRuntime, out: *mut HermesHeapStats) -> bool;
+
+    // ------------------------------------------------------------------------
+    // Compiler Units
+    // ------------------------------------------------------------------------
+
+    /// Returns `true` if the library was built with the `split-units` feature.
+    #[must_use]
+    pub fn hermes_runtime_split_units_enabled() -> bool;
+
+    /// Returns the compiler units `rt` has initialized (`VUE_UNIT_*` bits),
+    /// or 0 for a null runtime. Always [`VUE_UNIT_ALL`] without `split-units`.
+    #[must_use]
+    pub fn hermes_runtime_loaded_units(rt: HermesRuntime) -> u32;
+
+    // ------------------------------------------------------------------------
+    // Instrumentation
+    // ------------------------------------------------------------------------
+
+    /// Returns `true` if the library was built with the `stats` feature.
+    #[must_use]
+    pub fn hermes_runtime_stats_enabled() -> bool;
+
+    /// Reads the instrumentation counters into `out`.
+    ///
+    /// # Safety
+    ///
+    /// `out` must be null or point to a writable [`HermesRuntimeStats`].
+    pub fn hermes_runtime_stats(rt: HermesRuntime, out: *mut HermesRuntimeStats) -> bool;
+
+    /// Zeroes the instrumentation counters.
+    pub fn hermes_runtime_stats_reset(rt: HermesRuntime);
+
+    // ------------------------------------------------------------------------
+    // Profiling
+    // ------------------------------------------------------------------------
+
+    /// Starts recording FFI spans and, with `sample_hz > 0`, Hermes samples.
+    ///
+    /// Returns `false` if a profile is already recording or sampling is not
+    /// available in this Hermes build.
+    #[must_use]
+    pub fn hermes_runtime_profile_start(rt: HermesRuntime, sample_hz: f64) -> bool;
+
+    /// Stops profiling and returns the Chrome trace JSON.
+    ///
+    /// # Safety
+    ///
+    /// `out_len` must be valid for writes.
+    ///
+    /// # Returns
+    ///
+    /// The trace, with its length in `*out_len`, owned by the runtime until
+    /// the next [`hermes_runtime_profile_start`] or [`hermes_runtime_destroy`];
+    /// null if no profile is recording.
+    #[must_use]
+    pub fn hermes_runtime_profile_stop(rt: HermesRuntime, out_len: *mut usize) -> *const c_char;
+
+    // ------------------------------------------------------------------------
+    // Warm Start
+    // ------------------------------------------------------------------------
+
+    /// Initializes spare runtimes in parallel until `count` are available,
+    /// raising the spare capacity to at least `count`. Thread-safe.
+    ///
+    /// # Returns
+    ///
+    /// The number of spare runtimes available afterwards.
+    pub fn hermes_runtime_prewarm(count: usize) -> usize;
+
+    /// Sets how many destroyed runtimes are parked for reuse (default 0).
+    /// Spares beyond the capacity are destroyed. Thread-safe.
+    pub fn hermes_runtime_set_spare_capacity(capacity: usize);
+
+    /// Gets the number of spare runtimes currently available. Thread-safe.
+    #[must_use]
+    pub fn hermes_runtime_spare_count() -> usize;
+
     // ------------------------------------------------------------------------
     // Handle Management
     // ------------------------------------------------------------------------
@@ -196,6 +756,33 @@ extern "C" {
     /// - The handle must not be used after this call.
     pub fn hermes_handle_free(rt: HermesRuntime, handle: HermesHandle);
 
+    /// Checks if a handle refers to a live value (not freed, not stale).
+    ///
+    /// # Safety
+    ///
+    /// `rt` must be a valid runtime.
+    #[must_use]
+    pub fn hermes_handle_is_live(rt: HermesRuntime, handle: HermesHandle) -> bool;
+
+    /// Opens a handle scope. Every handle allocated until the scope is closed
+    /// belongs to it.
+    ///
+    /// # Safety
+    ///
+    /// `rt` must be a valid runtime.
+    #[must_use]
+    pub fn hermes_handle_scope_open(rt: HermesRuntime) -> HermesHandleScope;
+
+    /// Closes a handle scope (and any scope nested in it), freeing every
+    /// handle allocated in it that is still live.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be the runtime that opened `scope`.
+    /// - No handle allocated in the scope, nor any string or snapshot
+    ///   obtained from one, may be used after this call.
+    pub fn hermes_handle_scope_close(rt: HermesRuntime, scope: HermesHandleScope);
+
     // ------------------------------------------------------------------------
     // Parsing
     // ------------------------------------------------------------------------
@@ -210,7 +797,8 @@ extern "C" {
     /// - `rt` must be a valid runtime.
     /// - `source` must be a valid UTF-8 byte slice of length `source_len`.
     /// - `filename` must be a valid UTF-8 byte slice of length `filename_len`.
-    /// - Both pointers must remain valid for the duration of the call.
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    /// - All pointers must remain valid for the duration of the call.
     ///
     /// # Returns
     ///
@@ -224,6 +812,27 @@ extern "C" {
         source_len: usize,
         filename: *const c_char,
         filename_len: usize,
+        options: *const VueCompileOptions,
+    ) -> HermesHandle;
+
+    /// Parses an SFC source in borrowed mode.
+    ///
+    /// Descriptor snapshots built from this result point unmodified block
+    /// content (and the descriptor source) into `source` instead of copying.
+    ///
+    /// # Safety
+    ///
+    /// Same as [`vue_parse`], and additionally `source` must remain valid and
+    /// unmodified until the parse result and every descriptor obtained from it
+    /// are freed.
+    #[must_use]
+    pub fn vue_parse_borrowed(
+        rt: HermesRuntime,
+        source: *const c_char,
+        source_len: usize,
+        filename: *const c_char,
+        filename_len: usize,
+        options: *const VueCompileOptions,
     ) -> HermesHandle;
 
     /// Gets the descriptor handle from a parse result.
@@ -304,26 +913,128 @@ extern "C" {
     pub fn vue_descriptor_filename(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
 
     // ------------------------------------------------------------------------
-    // Block Accessors
+    // Descriptor Snapshot
     // ------------------------------------------------------------------------
 
+    /// Walks a descriptor once and returns a flat snapshot of all its blocks.
+    ///
+    /// The snapshot is memoized on the handle and stays valid until the
+    /// descriptor handle is freed.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime.
+    /// - `handle` must be a descriptor handle.
+    ///
+    /// # Returns
+    ///
+    /// A pointer to the snapshot, or null if the handle is invalid.
     #[must_use]
-    pub fn vue_block_content(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+    pub fn vue_descriptor_materialize(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+    ) -> *const VueDescriptorSnapshot;
 
-    #[must_use]
-    pub fn vue_block_lang(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+    // ------------------------------------------------------------------------
+    // Descriptor Serialization
+    // ------------------------------------------------------------------------
 
+    /// Serialize a descriptor to the binary descriptor format.
+    ///
+    /// The buffer is memoized on the handle and stays valid until the
+    /// descriptor handle is freed.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime.
+    /// - `handle` must be a descriptor handle.
+    /// - `out_len` must be valid for writes.
+    ///
+    /// # Returns
+    ///
+    /// A pointer to the buffer, with its length in `*out_len`, or null if the
+    /// handle is invalid or the descriptor exceeds the format's 4 GiB limit.
     #[must_use]
-    pub fn vue_style_is_scoped(rt: HermesRuntime, handle: HermesHandle) -> bool;
+    pub fn vue_descriptor_serialize(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        out_len: *mut usize,
+    ) -> *const u8;
 
+    /// Rebuild a descriptor from the binary descriptor format.
+    ///
+    /// The buffer may come from any runtime, thread or process.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime.
+    /// - `data` must point to `len` readable bytes.
+    ///
+    /// # Returns
+    ///
+    /// A descriptor handle, or an invalid handle if the buffer is truncated,
+    /// malformed or of another format version.
     #[must_use]
-    pub fn vue_custom_block_type(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+    pub fn vue_descriptor_deserialize(
+        rt: HermesRuntime,
+        data: *const u8,
+        len: usize,
+    ) -> HermesHandle;
 
     // ------------------------------------------------------------------------
-    // Block Location Accessors
+    // Block Scanning
     // ------------------------------------------------------------------------
 
-    #[must_use]
+    /// Split an SFC into its blocks natively, without a runtime.
+    ///
+    /// The result holds the descriptor [`vue_parse`] would produce, in the
+    /// binary descriptor format. Template markup is only scanned for the end
+    /// of the template block, not validated.
+    ///
+    /// # Returns
+    /// An owned scan to free with [`vue_sfc_scan_free`], or null if the source
+    /// has block-level parse errors or uses a construct the scanner does not
+    /// reproduce; parse those with [`vue_parse`].
+    #[must_use]
+    pub fn vue_sfc_scan(
+        source: *const c_char,
+        source_len: usize,
+        filename: *const c_char,
+        filename_len: usize,
+    ) -> VueSfcScan;
+
+    /// Get the scanned descriptor in the binary descriptor format.
+    ///
+    /// # Returns
+    /// A pointer to the buffer, owned by the scan, with its length in
+    /// `*out_len`, or null if `scan` or `out_len` is null.
+    #[must_use]
+    pub fn vue_sfc_scan_data(scan: VueSfcScan, out_len: *mut usize) -> *const u8;
+
+    /// Frees a scan. Safe to call with null.
+    pub fn vue_sfc_scan_free(scan: VueSfcScan);
+
+    // ------------------------------------------------------------------------
+    // Block Accessors
+    // ------------------------------------------------------------------------
+
+    #[must_use]
+    pub fn vue_block_content(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    #[must_use]
+    pub fn vue_block_lang(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    #[must_use]
+    pub fn vue_style_is_scoped(rt: HermesRuntime, handle: HermesHandle) -> bool;
+
+    #[must_use]
+    pub fn vue_custom_block_type(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    // ------------------------------------------------------------------------
+    // Block Location Accessors
+    // ------------------------------------------------------------------------
+
+    #[must_use]
     pub fn vue_block_loc_start_offset(rt: HermesRuntime, handle: HermesHandle) -> usize;
 
     #[must_use]
@@ -468,7 +1179,7 @@ extern "C" {
         descriptor: HermesHandle,
         id: *const c_char,
         id_len: usize,
-        is_prod: bool,
+        options: *const VueCompileOptions,
     ) -> HermesHandle;
 
     #[must_use]
@@ -477,6 +1188,14 @@ extern "C" {
     #[must_use]
     pub fn vue_script_result_bindings(rt: HermesRuntime, handle: HermesHandle) -> HermesHandle;
 
+    /// Gets the script source map as JSON, or "" if none was generated.
+    #[must_use]
+    pub fn vue_script_result_map(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    /// Checks if the script result includes the inlined render function.
+    #[must_use]
+    pub fn vue_script_result_has_inline_template(rt: HermesRuntime, handle: HermesHandle) -> bool;
+
     // ------------------------------------------------------------------------
     // Template Compilation
     // ------------------------------------------------------------------------
@@ -492,6 +1211,25 @@ extern "C" {
         id_len: usize,
         scoped: bool,
         bindings: HermesHandle,
+        options: *const VueCompileOptions,
+    ) -> HermesHandle;
+
+    /// Compiles the template block of a descriptor, reusing its parsed AST.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime and `descriptor` a descriptor handle.
+    /// - `id` must be a valid UTF-8 byte slice of length `id_len`.
+    /// - `bindings` must be 0 or a handle from [`vue_script_result_bindings`].
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    #[must_use]
+    pub fn vue_compile_template_from_descriptor(
+        rt: HermesRuntime,
+        descriptor: HermesHandle,
+        id: *const c_char,
+        id_len: usize,
+        bindings: HermesHandle,
+        options: *const VueCompileOptions,
     ) -> HermesHandle;
 
     #[must_use]
@@ -500,6 +1238,32 @@ extern "C" {
     #[must_use]
     pub fn vue_template_result_error_count(rt: HermesRuntime, handle: HermesHandle) -> usize;
 
+    /// Gets the template source map as JSON, or "" if none was generated.
+    #[must_use]
+    pub fn vue_template_result_map(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    /// Gets the template preamble, or "" unless `keep_preamble` was set.
+    #[must_use]
+    pub fn vue_template_result_preamble(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    /// Gets a handle to the template AST, or 0 unless `keep_template_ast` was set.
+    ///
+    /// The returned handle must be freed with [`hermes_handle_free`].
+    #[must_use]
+    pub fn vue_template_result_ast(rt: HermesRuntime, handle: HermesHandle) -> HermesHandle;
+
+    /// Gets the number of compiler tips (0 unless `keep_tips` was set).
+    #[must_use]
+    pub fn vue_template_result_tip_count(rt: HermesRuntime, handle: HermesHandle) -> usize;
+
+    /// Gets a compiler tip at the specified index.
+    #[must_use]
+    pub fn vue_template_result_tip_at(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        index: usize,
+    ) -> *const c_char;
+
     // ------------------------------------------------------------------------
     // Style Compilation
     // ------------------------------------------------------------------------
@@ -514,8 +1278,552 @@ extern "C" {
         id: *const c_char,
         id_len: usize,
         scoped: bool,
+        options: *const VueCompileOptions,
+    ) -> HermesHandle;
+
+    /// Compiles the style block at `index` of a descriptor.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime and `descriptor` a descriptor handle.
+    /// - `id` must be a valid UTF-8 byte slice of length `id_len`.
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    #[must_use]
+    pub fn vue_compile_style_from_descriptor(
+        rt: HermesRuntime,
+        descriptor: HermesHandle,
+        index: usize,
+        id: *const c_char,
+        id_len: usize,
+        options: *const VueCompileOptions,
     ) -> HermesHandle;
 
     #[must_use]
     pub fn vue_style_result_code(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    // ------------------------------------------------------------------------
+    // SFC Pipeline
+    // ------------------------------------------------------------------------
+
+    /// Compiles a complete SFC (parse, script, template, styles) in one call.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime.
+    /// - `source`, `filename` and `id` must be valid UTF-8 byte slices of the
+    ///   given lengths.
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    ///
+    /// # Returns
+    ///
+    /// A handle to the pipeline result. Compilation errors are reported via
+    /// [`vue_sfc_result_error_count`] rather than an invalid handle.
+    #[must_use]
+    pub fn vue_compile_sfc(
+        rt: HermesRuntime,
+        source: *const c_char,
+        source_len: usize,
+        filename: *const c_char,
+        filename_len: usize,
+        id: *const c_char,
+        id_len: usize,
+        options: *const VueCompileOptions,
+    ) -> HermesHandle;
+
+    #[must_use]
+    pub fn vue_sfc_result_js(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    #[must_use]
+    pub fn vue_sfc_result_css(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    #[must_use]
+    pub fn vue_sfc_result_error_count(rt: HermesRuntime, handle: HermesHandle) -> usize;
+
+    #[must_use]
+    pub fn vue_sfc_result_error_at(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        index: usize,
+    ) -> *const c_char;
+
+    #[must_use]
+    pub fn vue_sfc_result_warning_count(rt: HermesRuntime, handle: HermesHandle) -> usize;
+
+    #[must_use]
+    pub fn vue_sfc_result_warning_at(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        index: usize,
+    ) -> *const c_char;
+
+    // ------------------------------------------------------------------------
+    // Incremental Pipeline
+    // ------------------------------------------------------------------------
+
+    /// Recompiles an SFC, reusing unchanged parts of `previous`.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime.
+    /// - `previous` must be 0 or a handle from an earlier call on `rt`; it
+    ///   stays valid and must still be freed.
+    /// - String pointers must be valid UTF-8 with the given lengths.
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    ///
+    /// # Returns
+    ///
+    /// A handle to a pipeline result whose [`vue_sfc_result_dirty`] mask
+    /// tells which parts were recompiled.
+    #[must_use]
+    pub fn vue_compile_sfc_incremental(
+        rt: HermesRuntime,
+        previous: HermesHandle,
+        source: *const c_char,
+        source_len: usize,
+        filename: *const c_char,
+        filename_len: usize,
+        id: *const c_char,
+        id_len: usize,
+        options: *const VueCompileOptions,
+    ) -> HermesHandle;
+
+    /// Returns the `VUE_SFC_DIRTY_*` mask of an incremental result.
+    #[must_use]
+    pub fn vue_sfc_result_dirty(rt: HermesRuntime, handle: HermesHandle) -> u32;
+
+    #[must_use]
+    pub fn vue_sfc_result_render(rt: HermesRuntime, handle: HermesHandle) -> *const c_char;
+
+    // ------------------------------------------------------------------------
+    // Batch Compilation
+    // ------------------------------------------------------------------------
+
+    /// Compiles many SFCs with a single FFI call (the loop runs in the JS bridge).
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime.
+    /// - `inputs` must point to `count` inputs whose strings are valid UTF-8.
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    ///
+    /// # Returns
+    ///
+    /// A handle to the batch result, or 0 on failure.
+    #[must_use]
+    pub fn vue_compile_batch(
+        rt: HermesRuntime,
+        inputs: *const VueSfcInput,
+        count: usize,
+        options: *const VueCompileOptions,
+    ) -> HermesHandle;
+
+    #[must_use]
+    pub fn vue_batch_result_count(rt: HermesRuntime, handle: HermesHandle) -> usize;
+
+    /// Gets a batch item as a new SFC result handle, or 0 if out of range.
+    ///
+    /// The item handle is read with the `vue_sfc_result_*` accessors and is
+    /// freed independently of the batch handle.
+    #[must_use]
+    pub fn vue_batch_result_at(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        index: usize,
+    ) -> HermesHandle;
+
+    // ------------------------------------------------------------------------
+    // Bulk Accessors
+    // ------------------------------------------------------------------------
+    //
+    // Each walks a whole list in one call and returns the number of entries
+    // passed to the callback.
+    //
+    // # Safety
+    //
+    // - `rt` must be a valid runtime and `handle` a handle of the kind named
+    //   by the function (or 0).
+    // - `user_data` is passed through to `callback` unchanged; the callback
+    //   must not free `handle`.
+
+    pub fn vue_parse_result_errors_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    /// Works on a script block or a script compilation result.
+    pub fn vue_script_bindings_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrPairCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_script_imports_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueImportCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    /// Works on a script block or a script compilation result.
+    pub fn vue_script_warnings_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_script_deps_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_template_result_errors_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_template_result_tips_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_sfc_result_errors_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_sfc_result_warnings_for_each(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    // ------------------------------------------------------------------------
+    // Dependency Scanning
+    // ------------------------------------------------------------------------
+
+    /// Collects the imports, src attributes and style imports of many SFCs
+    /// in one call, without compiling them.
+    ///
+    /// # Safety
+    ///
+    /// - `rt` must be a valid runtime.
+    /// - `inputs` must point to `count` inputs whose strings are valid UTF-8.
+    ///   Their `id` is not read.
+    ///
+    /// # Returns
+    ///
+    /// An owned scan to free with [`vue_dependency_scan_free`], or null on
+    /// failure.
+    #[must_use]
+    pub fn vue_scan_dependencies(
+        rt: HermesRuntime,
+        inputs: *const VueSfcInput,
+        count: usize,
+    ) -> VueDependencyScan;
+
+    /// Get the per-file dependencies of a scan, parallel to its inputs.
+    ///
+    /// # Returns
+    /// A pointer to the array, owned by the scan, with its length in
+    /// `*out_count`, or null if `scan` or `out_count` is null.
+    #[must_use]
+    pub fn vue_dependency_scan_files(
+        scan: VueDependencyScan,
+        out_count: *mut usize,
+    ) -> *const VueFileDependencies;
+
+    /// Frees a dependency scan. Safe to call with null.
+    pub fn vue_dependency_scan_free(scan: VueDependencyScan);
+
+    // ------------------------------------------------------------------------
+    // Output Sinks
+    // ------------------------------------------------------------------------
+    //
+    // Move compiled code into caller-owned memory without caching it on the
+    // handle. A `*_copy` function writes up to `capacity` bytes (no NUL) and
+    // returns the full length; a capacity of 0 queries the length. A
+    // `*_write` function passes UTF-8 chunks that end on character boundaries
+    // and returns the number of bytes passed.
+    //
+    // # Safety
+    //
+    // - `rt` must be a valid runtime and `handle` a handle of the kind named
+    //   by the function (or 0).
+    // - `buffer` must point to `capacity` writable bytes (or be null with a
+    //   capacity of 0).
+    // - `callback` must not call into `rt`; chunks are only valid during the
+    //   call.
+
+    pub fn vue_script_result_content_copy(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        buffer: *mut c_char,
+        capacity: usize,
+    ) -> usize;
+
+    pub fn vue_script_result_content_write(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_template_result_code_copy(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        buffer: *mut c_char,
+        capacity: usize,
+    ) -> usize;
+
+    pub fn vue_template_result_code_write(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_style_result_code_copy(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        buffer: *mut c_char,
+        capacity: usize,
+    ) -> usize;
+
+    pub fn vue_style_result_code_write(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_sfc_result_js_copy(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        buffer: *mut c_char,
+        capacity: usize,
+    ) -> usize;
+
+    pub fn vue_sfc_result_js_write(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    pub fn vue_sfc_result_css_copy(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        buffer: *mut c_char,
+        capacity: usize,
+    ) -> usize;
+
+    pub fn vue_sfc_result_css_write(
+        rt: HermesRuntime,
+        handle: HermesHandle,
+        callback: VueStrCallback,
+        user_data: *mut c_void,
+    ) -> usize;
+
+    // ------------------------------------------------------------------------
+    // Compiler Pool
+    // ------------------------------------------------------------------------
+
+    /// Creates a pool with `num_workers` runtimes (0 = one per hardware thread).
+    ///
+    /// # Returns
+    ///
+    /// A pool pointer, or null if any runtime failed to initialize.
+    #[must_use]
+    pub fn vue_pool_create(num_workers: usize) -> VuePool;
+
+    /// Stops the workers and destroys their runtimes.
+    ///
+    /// # Safety
+    ///
+    /// `pool` must be null or a pool from [`vue_pool_create`] with no batch
+    /// in flight; it must not be used afterwards.
+    pub fn vue_pool_destroy(pool: VuePool);
+
+    #[must_use]
+    pub fn vue_pool_worker_count(pool: VuePool) -> usize;
+
+    /// Creates a pool whose worker runtimes use `runtime_options`.
+    ///
+    /// # Safety
+    ///
+    /// `runtime_options` must be null or point to valid options, which only
+    /// need to stay valid during the call.
+    #[must_use]
+    pub fn vue_pool_create_with_options(
+        num_workers: usize,
+        runtime_options: *const HermesRuntimeOptions,
+    ) -> VuePool;
+
+    /// Makes workers collect garbage whenever they run out of jobs.
+    pub fn vue_pool_set_collect_when_idle(pool: VuePool, enabled: bool);
+
+    /// Compiles a batch of SFCs on the pool, blocking until all are done.
+    ///
+    /// # Safety
+    ///
+    /// - `pool` must be a valid pool.
+    /// - `inputs` must point to `count` inputs whose strings stay valid until
+    ///   the call returns.
+    /// - `out_results` must point to `count` writable slots. Every slot
+    ///   receives a result that must be freed with [`vue_compiled_sfc_free`].
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    pub fn vue_pool_compile_batch(
+        pool: VuePool,
+        inputs: *const VueSfcInput,
+        count: usize,
+        options: *const VueCompileOptions,
+        out_results: *mut VueCompiledSfc,
+    ) -> bool;
+
+    /// Queues one SFC for compilation and returns its ticket without waiting,
+    /// or 0 if `pool` or `input` is null.
+    ///
+    /// The result goes to `callback` on a worker thread, or, if `callback` is
+    /// `None`, waits for [`vue_pool_take_completed`].
+    ///
+    /// # Safety
+    ///
+    /// - `pool` must be a valid pool.
+    /// - `input` must point to a valid input; its strings are copied.
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    /// - `callback` must be safe to call from any thread with `user_data`.
+    pub fn vue_pool_submit(
+        pool: VuePool,
+        input: *const VueSfcInput,
+        options: *const VueCompileOptions,
+        callback: Option<VueJobCallback>,
+        user_data: *mut c_void,
+    ) -> VueJobTicket;
+
+    /// Returns a descriptor that is readable while results of jobs submitted
+    /// without a callback are waiting, or -1 on failure. Owned by the pool.
+    #[must_use]
+    pub fn vue_pool_completion_fd(pool: VuePool) -> c_int;
+
+    /// Takes the oldest waiting result of a job submitted without a callback,
+    /// or returns null if none is waiting.
+    ///
+    /// # Safety
+    ///
+    /// `out_ticket` must be null or point to a writable [`VueJobTicket`].
+    #[must_use]
+    pub fn vue_pool_take_completed(pool: VuePool, out_ticket: *mut VueJobTicket) -> VueCompiledSfc;
+
+    /// Enables (`max_entries > 0`), resizes or disables the pool's compile
+    /// cache. `max_bytes` of 0 means no byte limit.
+    pub fn vue_pool_set_cache_limits(pool: VuePool, max_entries: usize, max_bytes: usize);
+
+    /// Drops all cached results, keeping the counters.
+    pub fn vue_pool_cache_clear(pool: VuePool);
+
+    /// Reads the cache counters into `out`.
+    ///
+    /// # Safety
+    ///
+    /// `out` must be null or point to a writable [`VuePoolCacheStats`].
+    pub fn vue_pool_cache_stats(pool: VuePool, out: *mut VuePoolCacheStats) -> bool;
+
+    /// Sets the runtime recycling limits: a worker's runtime is replaced in
+    /// the background after `max_compiles` compilations or once its heap is
+    /// larger than `max_heap_bytes`. 0 disables a limit.
+    pub fn vue_pool_set_recycle_limits(pool: VuePool, max_compiles: u64, max_heap_bytes: usize);
+
+    /// Gets the number of worker runtimes replaced by recycling.
+    #[must_use]
+    pub fn vue_pool_recycle_count(pool: VuePool) -> u64;
+
+    #[must_use]
+    pub fn vue_compiled_sfc_js(result: VueCompiledSfc) -> *const c_char;
+
+    #[must_use]
+    pub fn vue_compiled_sfc_css(result: VueCompiledSfc) -> *const c_char;
+
+    #[must_use]
+    pub fn vue_compiled_sfc_error_count(result: VueCompiledSfc) -> usize;
+
+    #[must_use]
+    pub fn vue_compiled_sfc_error_at(result: VueCompiledSfc, index: usize) -> *const c_char;
+
+    #[must_use]
+    pub fn vue_compiled_sfc_warning_count(result: VueCompiledSfc) -> usize;
+
+    #[must_use]
+    pub fn vue_compiled_sfc_warning_at(result: VueCompiledSfc, index: usize) -> *const c_char;
+
+    /// Frees a compile result. Safe to call with null.
+    pub fn vue_compiled_sfc_free(result: VueCompiledSfc);
+
+    // ------------------------------------------------------------------------
+    // Disk Cache
+    // ------------------------------------------------------------------------
+
+    /// Opens (creating if needed) the cache file in `dir` and maps it.
+    ///
+    /// # Safety
+    ///
+    /// `dir` must point to `dir_len` bytes of a UTF-8 path.
+    ///
+    /// # Returns
+    ///
+    /// A cache pointer, or null if the file cannot be opened.
+    #[must_use]
+    pub fn vue_disk_cache_open(dir: *const c_char, dir_len: usize) -> VueDiskCache;
+
+    /// Unmaps and closes the cache. Safe to call with null.
+    pub fn vue_disk_cache_close(cache: VueDiskCache);
+
+    /// Returns the version key of this build (static, null-terminated).
+    #[must_use]
+    pub fn vue_disk_cache_version() -> *const c_char;
+
+    #[must_use]
+    pub fn vue_disk_cache_entry_count(cache: VueDiskCache) -> usize;
+
+    /// Looks up a cached result.
+    ///
+    /// # Safety
+    ///
+    /// - `input` must point to a valid [`VueSfcInput`].
+    /// - `options` must be null or point to a valid [`VueCompileOptions`].
+    ///
+    /// # Returns
+    ///
+    /// An owned result to free with [`vue_compiled_sfc_free`], or null on a
+    /// miss or a record that failed its integrity check.
+    #[must_use]
+    pub fn vue_disk_cache_get(
+        cache: VueDiskCache,
+        input: *const VueSfcInput,
+        options: *const VueCompileOptions,
+    ) -> VueCompiledSfc;
+
+    /// Appends a copy of `result` to the cache.
+    ///
+    /// # Safety
+    ///
+    /// Same as [`vue_disk_cache_get`]; `result` must be a live result.
+    pub fn vue_disk_cache_put(
+        cache: VueDiskCache,
+        input: *const VueSfcInput,
+        options: *const VueCompileOptions,
+        result: VueCompiledSfc,
+    ) -> bool;
 }
@@ -0,0 +1,244 @@
+//! Benchmark suite over the FFI: runtime creation, each compile step,
+//! descriptor reads, full-pipeline throughput and multi-core scaling.
+//!
+//! Run with `cargo bench --bench sfc`, optionally followed by `-- <filter>`
+//! to run only benchmarks whose name contains the filter.
+//!
+//! `tools/bench-corpus-node.ts` runs the same workloads over the same corpus
+//! with `@vue/compiler-sfc` on Node and prints the same benchmark names, so
+//! the two outputs can be compared line by line. Runtime creation has no
+//! Node counterpart.
+
+use libvue_compiler_sfc::{CompileOptions, Compiler, CompilerPool, Descriptor, SfcInput};
+use std::hint::black_box;
+use std::thread;
+use std::time::{Duration, Instant};
+
+/// The corpus: (name, source), also read by the Node benchmark.
+const CORPUS: &[(&str, &str)] = &[
+    ("small", include_str!("corpus/small.vue")),
+    ("medium", include_str!("corpus/medium.vue")),
+    ("huge", include_str!("corpus/huge.vue")),
+];
+
+const ID: &str = "data-v-bench";
+
+/// Copies of the corpus per scaling batch.
+const SCALING_COPIES: usize = 32;
+
+/// Time spent warming up and measuring each benchmark.
+const WARMUP_TIME: Duration = Duration::from_millis(300);
+const MEASURE_TIME: Duration = Duration::from_secs(1);
+const SAMPLES: u32 = 10;
+
+/// Runs benchmarks and prints one line per benchmark.
+struct Bench {
+    filter: Option<String>,
+}
+
+impl Bench {
+    fn from_args() -> Self {
+        // cargo bench passes `--bench`; anything else is a name filter
+        let filter = std::env::args().skip(1).find(|arg| !arg.starts_with('-'));
+        Bench { filter }
+    }
+
+    fn enabled(&self, name: &str) -> bool {
+        self.filter.as_deref().is_none_or(|f| name.contains(f))
+    }
+
+    /// Times `f` and prints the median time per call across samples.
+    fn run(&self, name: &str, mut f: impl FnMut()) {
+        if !self.enabled(name) {
+            return;
+        }
+
+        // Warm up, estimating the time per call on the way.
+        let start = Instant::now();
+        let mut calls = 0u32;
+        while calls < 3 || start.elapsed() < WARMUP_TIME {
+            f();
+            calls += 1;
+        }
+        let estimate = start.elapsed() / calls;
+        let per_sample = MEASURE_TIME / SAMPLES;
+        let iterations = (per_sample.as_nanos() / estimate.as_nanos().max(1)).max(1) as u32;
+
+        let mut samples: Vec<Duration> = (0..SAMPLES)
+            .map(|_| {
+                let start = Instant::now();
+                for _ in 0..iterations {
+                    f();
+                }
+                start.elapsed() / iterations
+            })
+            .collect();
+        samples.sort();
+        report(name, samples[samples.len() / 2], 1);
+    }
+}
+
+/// Prints a result line: time per call and items per second.
+fn report(name: &str, per_call: Duration, items_per_call: usize) {
+    let secs = per_call.as_secs_f64();
+    println!(
+        "{name:<32} {:>12.3} us/op {:>12.0} items/s",
+        secs * 1e6,
+        items_per_call as f64 / secs
+    );
+}
+
+fn descriptor_of<'c>(compiler: &'c Compiler, source: &str, filename: &str) -> Descriptor<'c> {
+    let parsed = compiler.parse(source, filename).expect("parse");
+    parsed.descriptor().expect("descriptor")
+}
+
+/// Reads every block of a descriptor the way a bundler plugin does.
+fn read_descriptor(desc: &Descriptor<'_>) -> usize {
+    let mut total = desc.source().len() + desc.filename().len();
+    if let Some(template) = desc.template() {
+        total += template.content().len() + template.lang().len() + template.attrs().len();
+        total += template.loc().start.offset;
+    }
+    for script in desc.script().into_iter().chain(desc.script_setup()) {
+        total += script.content().len() + script.lang().len() + script.attrs().len();
+        total += script.loc().end.offset;
+    }
+    for style in desc.styles() {
+        total += style.content().len() + style.lang().len() + style.attrs().len();
+        total += usize::from(style.is_scoped()) + style.loc().end.line;
+    }
+    total + desc.css_vars().len()
+}
+
+fn bench_runtime(bench: &Bench) {
+    Compiler::set_spare_capacity(0);
+    bench.run("runtime/create_cold", || {
+        black_box(Compiler::new().expect("create"));
+    });
+
+    // A dropped compiler parks its runtime, so each create reuses it.
+    Compiler::set_spare_capacity(1);
+    Compiler::prewarm(1);
+    bench.run("runtime/create_warm", || {
+        black_box(Compiler::new().expect("create"));
+    });
+    Compiler::set_spare_capacity(0);
+}
+
+fn bench_steps(bench: &Bench, compiler: &Compiler) {
+    for &(name, source) in CORPUS {
+        let filename = format!("{name}.vue");
+
+        bench.run(&format!("parse/{name}"), || {
+            black_box(compiler.parse(source, &filename).expect("parse"));
+        });
+
+        let desc = descriptor_of(compiler, source, &filename);
+        bench.run(&format!("compile_script/{name}"), || {
+            let script = desc.compile_script(ID, false).expect("script");
+            black_box(script.content().len());
+        });
+
+        let script = desc.compile_script(ID, false).expect("script");
+        bench.run(&format!("compile_template/{name}"), || {
+            let template = desc.compile_template(ID, Some(&script)).expect("template");
+            black_box(template.code().len());
+        });
+
+        bench.run(&format!("compile_style/{name}"), || {
+            for index in 0..desc.style_count() {
+                black_box(desc.compile_style(index, ID).expect("style").code().len());
+            }
+        });
+
+        // A fresh descriptor handle each time, so no read is memoized.
+        let parsed = compiler.parse(source, &filename).expect("parse");
+        bench.run(&format!("descriptor_reads/{name}"), || {
+            let desc = parsed.descriptor().expect("descriptor");
+            black_box(read_descriptor(&desc));
+        });
+    }
+}
+
+fn bench_pipeline(bench: &Bench, compiler: &Compiler) {
+    let options = CompileOptions::default();
+    for &(name, source) in CORPUS {
+        let filename = format!("{name}.vue");
+        bench.run(&format!("pipeline/{name}"), || {
+            let output = compiler
+                .compile_sfc(source, &filename, ID, &options)
+                .expect("compile");
+            black_box((output.js().len(), output.css().len()));
+        });
+    }
+
+    let inputs: Vec<SfcInput<'_>> = CORPUS
+        .iter()
+        .map(|&(_, source)| SfcInput::new(source, "Corpus.vue", ID))
+        .collect();
+    bench.run("pipeline/corpus_batch", || {
+        for output in compiler.compile_batch(&inputs, &options).expect("batch") {
+            black_box((output.js().len(), output.css().len()));
+        }
+    });
+}
+
+fn bench_scaling(bench: &Bench) {
+    let max = thread::available_parallelism().map_or(1, |n| n.get());
+    let mut counts: Vec<usize> = std::iter::successors(Some(1), |n| Some(n * 2))
+        .take_while(|&n| n < max)
+        .collect();
+    counts.push(max);
+
+    // Distinct ids keep every input a separate compilation.
+    let ids: Vec<String> = (0..SCALING_COPIES * CORPUS.len())
+        .map(|i| format!("data-v-{i:04x}"))
+        .collect();
+    let inputs: Vec<SfcInput<'_>> = ids
+        .iter()
+        .zip(CORPUS.iter().cycle())
+        .map(|(id, &(_, source))| SfcInput::new(source, "Corpus.vue", id))
+        .collect();
+    let options = CompileOptions::default();
+
+    let mut baseline = None;
+    for workers in counts {
+        let name = format!("scaling/threads_{workers}");
+        if !bench.enabled(&name) {
+            continue;
+        }
+
+        let pool = CompilerPool::new(workers).expect("pool");
+        pool.compile_batch(&inputs, &options).expect("warmup");
+
+        let start = Instant::now();
+        let mut rounds = 0u32;
+        while rounds < 2 || start.elapsed() < MEASURE_TIME {
+            black_box(pool.compile_batch(&inputs, &options).expect("batch"));
+            rounds += 1;
+        }
+        let per_batch = start.elapsed() / rounds;
+        report(&name, per_batch, inputs.len());
+
+        let base = *baseline.get_or_insert(per_batch);
+        println!(
+            "{:<32} {:>12.2}x speedup",
+            "",
+            base.as_secs_f64() / per_batch.as_secs_f64()
+        );
+    }
+}
+
+fn main() {
+    let bench = Bench::from_args();
+
+    bench_runtime(&bench);
+
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    bench_steps(&bench, &compiler);
+    bench_pipeline(&bench, &compiler);
+    drop(compiler);
+
+    bench_scaling(&bench);
+}
@@ -1,4 +1,4 @@
-use libvue_compiler_sfc::Compiler;
+use libvue_compiler_sfc::{CompileOptions, Compiler, SfcInput};
 use std::fs;
 use std::time::Instant;
 
@@ -37,6 +37,53 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
         ITERATIONS as f64 / duration.as_secs_f64()
     );
 
+    // Same work through the single-call pipeline
+    println!("\n=== Single-call pipeline (compile_sfc) ===\n");
+    let options = CompileOptions::default();
+    for _ in 0..WARMUP {
+        let _ = compiler.compile_sfc(&source, filename, scope_id, &options);
+    }
+
+    let start = Instant::now();
+    for _ in 0..ITERATIONS {
+        let output = compiler.compile_sfc(&source, filename, scope_id, &options)?;
+        let _ = (output.js().to_string(), output.css().to_string());
+    }
+    let duration = start.elapsed();
+    let per_op = duration / ITERATIONS as u32;
+
+    println!("Total: {:?}", duration);
+    println!("Per operation: {:?}", per_op);
+    println!(
+        "Throughput: {:.0} ops/sec",
+        ITERATIONS as f64 / duration.as_secs_f64()
+    );
+
+    // Same work in batches, one FFI call per batch
+    const BATCH: usize = 100;
+    println!(
+        "\n=== Batch pipeline (compile_batch, {} files/call) ===\n",
+        BATCH
+    );
+    let inputs = vec![SfcInput::new(&source, filename, scope_id); BATCH];
+    let _ = compiler.compile_batch(&inputs, &options)?;
+
+    let start = Instant::now();
+    for _ in 0..ITERATIONS / BATCH {
+        for output in compiler.compile_batch(&inputs, &options)? {
+            let _ = (output.js().to_string(), output.css().to_string());
+        }
+    }
+    let duration = start.elapsed();
+    let per_op = duration / ITERATIONS as u32;
+
+    println!("Total: {:?}", duration);
+    println!("Per operation: {:?}", per_op);
+    println!(
+        "Throughput: {:.0} ops/sec",
+        ITERATIONS as f64 / duration.as_secs_f64()
+    );
+
     Ok(())
 }
 
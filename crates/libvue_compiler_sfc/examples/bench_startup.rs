@@ -0,0 +1,86 @@
+//! Native counterpart of `tools/benchmark-startup-node.ts`.
+//!
+//! Measures runtime creation plus a first template compile, cold and warm.
+//!
+//! Warm start is opt-in: `Compiler::new` only takes a spare runtime after
+//! `Compiler::prewarm` or `Compiler::set_spare_capacity`, as done below.
+
+use libvue_compiler_sfc::{Compiler, CompilerUnits, RuntimeOptions};
+use std::time::{Duration, Instant};
+
+const TEMPLATE: &str = r#"<div class="container"><span>{{ msg }}</span><button @click="handleClick">Click me</button></div>"#;
+const SPARES: usize = 4;
+
+/// Creates a compiler and compiles once, returning (create, first compile) times.
+fn start_once() -> Result<(Compiler, Duration, Duration), Box<dyn std::error::Error>> {
+    start_with(Compiler::new)
+}
+
+/// Like [`start_once`], creating the compiler with `create`.
+fn start_with(
+    create: impl FnOnce() -> libvue_compiler_sfc::Result<Compiler>,
+) -> Result<(Compiler, Duration, Duration), Box<dyn std::error::Error>> {
+    let start = Instant::now();
+    let compiler = create()?;
+    let created = start.elapsed();
+
+    let start = Instant::now();
+    compiler.compile_template(TEMPLATE, "test.vue", "test", false, None)?;
+    let compiled = start.elapsed();
+
+    Ok((compiler, created, compiled))
+}
+
+fn report(label: &str, created: Duration, compiled: Duration) {
+    println!(
+        "{label:<28} create: {:>8.2}ms  first compile: {:>8.2}ms  total: {:>8.2}ms",
+        created.as_secs_f64() * 1000.0,
+        compiled.as_secs_f64() * 1000.0,
+        (created + compiled).as_secs_f64() * 1000.0,
+    );
+}
+
+fn main() -> Result<(), Box<dyn std::error::Error>> {
+    println!("=== Runtime Startup Benchmark ===\n");
+
+    // First runtime in the process: pays for everything.
+    let (first, created, compiled) = start_once()?;
+    report("First runtime (cold)", created, compiled);
+    drop(first);
+
+    // Second cold runtime: the spare capacity defaults to 0, so the first
+    // runtime was torn down rather than parked.
+    let (second, created, compiled) = start_once()?;
+    report("Second runtime (cold)", created, compiled);
+    drop(second);
+
+    // Template-only worker: with `split-units`, only the template unit loads.
+    let options = RuntimeOptions {
+        units: CompilerUnits::TEMPLATE,
+    };
+    let (template_only, created, compiled) = start_with(|| Compiler::with_options(&options))?;
+    report("Template-only runtime (cold)", created, compiled);
+    drop(template_only);
+
+    // Prewarm spares, then take them.
+    let start = Instant::now();
+    let spares = Compiler::prewarm(SPARES);
+    println!(
+        "\nPrewarmed {spares} runtimes in {:.2}ms (parallel)\n",
+        start.elapsed().as_secs_f64() * 1000.0
+    );
+
+    let mut warm = Vec::with_capacity(SPARES);
+    for i in 0..SPARES {
+        let (compiler, created, compiled) = start_once()?;
+        report(&format!("Warm runtime #{}", i + 1), created, compiled);
+        warm.push(compiler);
+    }
+
+    // Dropped compilers park their runtime; the next one reuses it.
+    warm.clear();
+    let (_reused, created, compiled) = start_once()?;
+    report("Parked runtime reuse", created, compiled);
+
+    Ok(())
+}
@@ -3,8 +3,12 @@
 //! Each `Compiler` owns its own Hermes runtime and can be used independently.
 //! This enables thread-safe parallel compilation by creating one Compiler per thread.
 
-use crate::ffi::{self, HermesHandle, HermesRuntime};
-use crate::types::{Error, ParseOutput, Result, ScriptOutput, StyleOutput, TemplateOutput};
+use crate::ffi::{self, HermesHandle, HermesHandleScope, HermesRuntime};
+use crate::types::{
+    CompileOptions, CompilerUnits, DependencyScan, Descriptor, DescriptorBuffer, Error, HeapStats,
+    ParseOutput, ProcessOptions, Result, RuntimeOptions, RuntimeStats, ScriptOutput, SfcInput,
+    SfcOutput, StyleOutput, TemplateOutput,
+};
 
 /// Vue SFC compiler instance.
 ///
@@ -36,6 +40,13 @@ impl Compiler {
     /// This initializes a fresh Hermes runtime. The operation is relatively
     /// expensive (~100ms), so reuse compiler instances when possible.
     ///
+    /// Warm start is opt-in: by default no spare runtimes are kept, so every
+    /// call pays the full cost. Prepare runtimes ahead of time with
+    /// [`Compiler::prewarm`], or let dropped compilers park theirs for the
+    /// next call with [`Compiler::set_spare_capacity`]; then this takes a
+    /// spare instead. `examples/bench_startup.rs` compares both with cold
+    /// starts.
+    ///
     /// # Errors
     ///
     /// Returns an error if the Hermes runtime fails to initialize.
@@ -47,6 +58,181 @@ impl Compiler {
         Ok(Self { runtime })
     }
 
+    /// Creates a compiler whose runtime initializes only some compiler units
+    /// up front (see [`RuntimeOptions::units`]).
+    ///
+    /// Always initializes a fresh runtime rather than taking a spare. When
+    /// the compiler is dropped, its runtime may be parked like any other.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the Hermes runtime fails to initialize.
+    pub fn with_options(options: &RuntimeOptions) -> Result<Self> {
+        let ffi_options = options.to_ffi();
+        let runtime = unsafe { ffi::hermes_runtime_create_with_options(&ffi_options) };
+        if runtime.is_null() {
+            return Err(Error::new("Failed to create compiler instance"));
+        }
+        Ok(Self { runtime })
+    }
+
+    /// Sets the heap and GC configuration of every runtime in the process,
+    /// including pool workers and spares.
+    ///
+    /// Static Hermes applies these settings once, so this must be called
+    /// before the process creates its first compiler, pool or spare. It may
+    /// be called several times until then; the last call wins.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if a VM flag contains a NUL byte or a runtime was
+    /// already initialized.
+    pub fn configure_process(options: &ProcessOptions) -> Result<()> {
+        let configured = options.with_ffi(|ffi_options| unsafe {
+            ffi::hermes_runtime_configure_process(ffi_options)
+        })?;
+        if !configured {
+            return Err(Error::new(
+                "configure_process must be called before the first runtime is created",
+            ));
+        }
+        Ok(())
+    }
+
+    /// Runs a full garbage collection now, e.g. between batches.
+    ///
+    /// JS values of outputs that are still alive are kept.
+    pub fn collect_garbage(&self) {
+        unsafe { ffi::hermes_runtime_collect_garbage(self.runtime) }
+    }
+
+    /// Returns heap statistics of this compiler's runtime.
+    pub fn heap_stats(&self) -> HeapStats {
+        let mut stats = ffi::HermesHeapStats::default();
+        unsafe {
+            ffi::hermes_runtime_heap_stats(self.runtime, &mut stats);
+        }
+        HeapStats::from_ffi(stats)
+    }
+
+    /// Returns the compiler units this compiler's runtime has loaded so far.
+    ///
+    /// Always [`CompilerUnits::ALL`] unless built with the `split-units`
+    /// feature and created with a subset in [`RuntimeOptions::units`].
+    pub fn loaded_units(&self) -> CompilerUnits {
+        CompilerUnits::from_bits(unsafe { ffi::hermes_runtime_loaded_units(self.runtime) })
+    }
+
+    /// Returns the instrumentation counters of this compiler's runtime.
+    ///
+    /// All zero unless built with the `stats` feature.
+    pub fn stats(&self) -> RuntimeStats {
+        let mut stats = ffi::HermesRuntimeStats::default();
+        unsafe {
+            ffi::hermes_runtime_stats(self.runtime, &mut stats);
+        }
+        RuntimeStats::from_ffi(stats)
+    }
+
+    /// Zeroes the instrumentation counters, e.g. before measuring a batch.
+    pub fn reset_stats(&self) {
+        unsafe { ffi::hermes_runtime_stats_reset(self.runtime) }
+    }
+
+    /// Starts profiling this compiler's runtime.
+    ///
+    /// Every FFI call is recorded as a span until [`stop_profiling`](Self::stop_profiling).
+    /// With `sample_hz > 0`, the Hermes sampling profiler also records the
+    /// compiler's JS stacks at about that rate. Profiling works in every
+    /// build, not only with the `stats` feature.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if a profile is already recording, or if sampling was
+    /// requested and this Hermes build has no sampling profiler.
+    pub fn start_profiling(&self, sample_hz: f64) -> Result<()> {
+        if unsafe { ffi::hermes_runtime_profile_start(self.runtime, sample_hz) } {
+            Ok(())
+        } else {
+            Err(Error::new("Failed to start profiling"))
+        }
+    }
+
+    /// Stops profiling and returns the profile as Chrome trace event JSON,
+    /// to be opened in Perfetto or the Chrome DevTools performance panel.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if no profile is recording.
+    pub fn stop_profiling(&self) -> Result<String> {
+        let mut len = 0;
+        let trace = unsafe { ffi::hermes_runtime_profile_stop(self.runtime, &mut len) };
+        if trace.is_null() {
+            return Err(Error::new("No profile is recording"));
+        }
+        let bytes = unsafe { std::slice::from_raw_parts(trace as *const u8, len) };
+        Ok(String::from_utf8_lossy(bytes).into_owned())
+    }
+
+    /// Initializes `count` spare runtimes in parallel for later [`Compiler::new`] calls.
+    ///
+    /// Also raises the spare capacity to at least `count`, so dropped
+    /// compilers park their runtime for reuse instead of discarding it.
+    /// Returns the number of spares available afterwards.
+    pub fn prewarm(count: usize) -> usize {
+        unsafe { ffi::hermes_runtime_prewarm(count) }
+    }
+
+    /// Sets how many dropped compilers keep their runtime parked for reuse.
+    ///
+    /// The default is 0 (runtimes are discarded on drop). Spares beyond the
+    /// new capacity are destroyed.
+    pub fn set_spare_capacity(capacity: usize) {
+        unsafe { ffi::hermes_runtime_set_spare_capacity(capacity) }
+    }
+
+    /// Returns the number of spare runtimes ready for [`Compiler::new`].
+    pub fn spare_count() -> usize {
+        unsafe { ffi::hermes_runtime_spare_count() }
+    }
+
+    /// Runs `f` inside a handle scope and frees every handle it allocated
+    /// in one call when it returns (or unwinds).
+    ///
+    /// Outputs dropped inside `f` are still freed individually; the scope
+    /// also releases handles the caller never wraps, such as intermediate
+    /// binding handles. Taking `&mut self` guarantees that no output borrowed
+    /// from the compiler outlives the scope.
+    ///
+    /// # Example
+    ///
+    /// ```ignore
+    /// let mut compiler = Compiler::new()?;
+    /// let js = compiler.with_handle_scope(|c| {
+    ///     let parsed = c.parse(source, "App.vue")?;
+    ///     let desc = parsed.descriptor().unwrap();
+    ///     Ok::<_, Error>(desc.compile_script("abc123", false)?.content().to_string())
+    /// })?;
+    /// ```
+    pub fn with_handle_scope<R>(&mut self, f: impl FnOnce(&Compiler) -> R) -> R {
+        struct ScopeGuard {
+            runtime: HermesRuntime,
+            scope: HermesHandleScope,
+        }
+
+        impl Drop for ScopeGuard {
+            fn drop(&mut self) {
+                unsafe { ffi::hermes_handle_scope_close(self.runtime, self.scope) }
+            }
+        }
+
+        let _guard = ScopeGuard {
+            runtime: self.runtime,
+            scope: unsafe { ffi::hermes_handle_scope_open(self.runtime) },
+        };
+        f(self)
+    }
+
     /// Parses a Vue Single File Component source string.
     ///
     /// # Arguments
@@ -66,8 +252,22 @@ impl Compiler {
     /// assert!(!result.has_errors());
     /// ```
     pub fn parse<'c>(&'c self, source: &str, filename: &str) -> Result<ParseOutput<'c>> {
+        self.parse_with_options(source, filename, &CompileOptions::default())
+    }
+
+    /// Parses an SFC source with explicit options.
+    ///
+    /// Only `source_map` is read: block source maps are generated only when
+    /// it is set.
+    pub fn parse_with_options<'c>(
+        &'c self,
+        source: &str,
+        filename: &str,
+        options: &CompileOptions,
+    ) -> Result<ParseOutput<'c>> {
         use std::os::raw::c_char;
 
+        let options = options.to_ffi();
         let handle = unsafe {
             ffi::vue_parse(
                 self.runtime,
@@ -75,6 +275,49 @@ impl Compiler {
                 source.len(),
                 filename.as_ptr() as *const c_char,
                 filename.len(),
+                &options,
+            )
+        };
+
+        if !handle.is_valid() {
+            return Err(Error::new("Parse returned invalid handle"));
+        }
+
+        Ok(ParseOutput::from_raw(handle, &self.runtime))
+    }
+
+    /// Parses an SFC source without copying block contents.
+    ///
+    /// Block `content()` and `Descriptor::source()` borrow from `source`
+    /// whenever the block text is an unmodified slice of it (see
+    /// `content_range()` on the block types); only content the parser
+    /// transformed is copied.
+    ///
+    /// # Example
+    ///
+    /// ```ignore
+    /// let compiler = Compiler::new()?;
+    /// let source = std::fs::read_to_string("App.vue")?;
+    /// let result = compiler.parse_borrowed(&source, "App.vue")?;
+    /// let desc = result.descriptor().unwrap();
+    /// let template = desc.template().unwrap();
+    /// assert_eq!(template.content_range().map(|r| &source[r]), Some(template.content()));
+    /// ```
+    pub fn parse_borrowed<'c>(
+        &'c self,
+        source: &'c str,
+        filename: &str,
+    ) -> Result<ParseOutput<'c>> {
+        use std::os::raw::c_char;
+
+        let handle = unsafe {
+            ffi::vue_parse_borrowed(
+                self.runtime,
+                source.as_ptr() as *const c_char,
+                source.len(),
+                filename.as_ptr() as *const c_char,
+                filename.len(),
+                std::ptr::null(),
             )
         };
 
@@ -85,6 +328,25 @@ impl Compiler {
         Ok(ParseOutput::from_raw(handle, &self.runtime))
     }
 
+    /// Loads a descriptor serialized with [`Descriptor::serialize`], possibly
+    /// by another compiler, thread or process.
+    ///
+    /// The result compiles like a parsed descriptor. It has no template AST:
+    /// the template content is parsed when the template is compiled, and the
+    /// source is parsed again only if script compilation needs the AST.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the buffer is not a valid serialized descriptor
+    /// of this format version.
+    pub fn load_descriptor<'c>(&'c self, buffer: &DescriptorBuffer<'_>) -> Result<Descriptor<'c>> {
+        let bytes = buffer.as_bytes();
+        let handle =
+            unsafe { ffi::vue_descriptor_deserialize(self.runtime, bytes.as_ptr(), bytes.len()) };
+        Descriptor::from_raw(handle, &self.runtime)
+            .ok_or_else(|| Error::new("load_descriptor returned invalid handle"))
+    }
+
     /// Compiles a Vue template to a render function.
     ///
     /// # Arguments
@@ -101,12 +363,36 @@ impl Compiler {
         id: &str,
         scoped: bool,
         bindings: Option<&ScriptOutput<'c>>,
+    ) -> Result<TemplateOutput<'c>> {
+        self.compile_template_with_options(
+            source,
+            filename,
+            id,
+            scoped,
+            bindings,
+            &CompileOptions::default(),
+        )
+    }
+
+    /// Compiles a Vue template with explicit options.
+    ///
+    /// Reads `is_prod`, `ssr`, `source_map`, `keep_template_ast`,
+    /// `keep_preamble` and `keep_tips`.
+    pub fn compile_template_with_options<'c>(
+        &'c self,
+        source: &str,
+        filename: &str,
+        id: &str,
+        scoped: bool,
+        bindings: Option<&ScriptOutput<'c>>,
+        options: &CompileOptions,
     ) -> Result<TemplateOutput<'c>> {
         use std::os::raw::c_char;
 
         let bindings_handle = bindings
             .map(|b| b.bindings_handle())
             .unwrap_or(HermesHandle::INVALID);
+        let options = options.to_ffi();
 
         let handle = unsafe {
             ffi::vue_compile_template(
@@ -119,6 +405,7 @@ impl Compiler {
                 id.len(),
                 scoped,
                 bindings_handle,
+                &options,
             )
         };
 
@@ -143,9 +430,25 @@ impl Compiler {
         filename: &str,
         id: &str,
         scoped: bool,
+    ) -> Result<StyleOutput<'c>> {
+        self.compile_style_with_options(source, filename, id, scoped, &CompileOptions::default())
+    }
+
+    /// Compiles a CSS style block with explicit options.
+    ///
+    /// Reads `is_prod`, which hashes the names of `v-bind()` CSS variables,
+    /// and `native_style`.
+    pub fn compile_style_with_options<'c>(
+        &'c self,
+        source: &str,
+        filename: &str,
+        id: &str,
+        scoped: bool,
+        options: &CompileOptions,
     ) -> Result<StyleOutput<'c>> {
         use std::os::raw::c_char;
 
+        let options = options.to_ffi();
         let handle = unsafe {
             ffi::vue_compile_style(
                 self.runtime,
@@ -156,6 +459,7 @@ impl Compiler {
                 id.as_ptr() as *const c_char,
                 id.len(),
                 scoped,
+                &options,
             )
         };
 
@@ -165,6 +469,213 @@ impl Compiler {
 
         Ok(StyleOutput::from_raw(handle, &self.runtime))
     }
+
+    /// Compiles a complete SFC in a single call.
+    ///
+    /// Runs parse, script, template and style compilation inside the JS
+    /// runtime and returns the combined output. This is equivalent to calling
+    /// [`parse`](Self::parse), [`Descriptor::compile_script`](crate::Descriptor::compile_script),
+    /// [`compile_template`](Self::compile_template) and
+    /// [`compile_style`](Self::compile_style) in sequence, but crosses the FFI
+    /// boundary once instead of once per step.
+    ///
+    /// # Arguments
+    ///
+    /// * `source` - The SFC source code.
+    /// * `filename` - The filename (for error messages).
+    /// * `id` - A unique scope ID for scoped CSS.
+    /// * `options` - Compile options.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error only if the FFI call fails. Compilation errors are
+    /// reported through [`SfcOutput::errors`].
+    pub fn compile_sfc<'c>(
+        &'c self,
+        source: &str,
+        filename: &str,
+        id: &str,
+        options: &CompileOptions,
+    ) -> Result<SfcOutput<'c>> {
+        use std::os::raw::c_char;
+
+        let ffi_options = options.to_ffi();
+        let handle = unsafe {
+            ffi::vue_compile_sfc(
+                self.runtime,
+                source.as_ptr() as *const c_char,
+                source.len(),
+                filename.as_ptr() as *const c_char,
+                filename.len(),
+                id.as_ptr() as *const c_char,
+                id.len(),
+                &ffi_options,
+            )
+        };
+
+        if !handle.is_valid() {
+            return Err(Error::new("compile_sfc returned invalid handle"));
+        }
+
+        Ok(SfcOutput::from_raw(handle, &self.runtime))
+    }
+
+    /// Recompiles an SFC after an edit, reusing the unchanged parts of a
+    /// previous incremental result.
+    ///
+    /// The source is re-parsed and only the script, template or style blocks
+    /// whose inputs changed are recompiled, taking coupling between blocks
+    /// into account (`cssVars`, bindings, scoped styles). The output has the
+    /// same `js`, `css`, errors and warnings as [`compile_sfc`](Self::compile_sfc),
+    /// and [`SfcOutput::dirty`] tells which parts changed so an HMR client
+    /// can pick a style-only or rerender update.
+    ///
+    /// # Arguments
+    ///
+    /// * `previous` - The last result for this component, or `None` for a
+    ///   full compile. Only reused for the same filename, id, `is_prod` and `ssr`.
+    /// * `source` - The new SFC source code.
+    /// * `filename` - The filename (for error messages).
+    /// * `id` - A unique scope ID for scoped CSS.
+    /// * `options` - Compile options.
+    ///
+    /// # Example
+    ///
+    /// ```ignore
+    /// let mut last = compiler.compile_sfc_incremental(None, &source, "App.vue", "abc", &opts)?;
+    /// // ... after an edit:
+    /// let next = compiler.compile_sfc_incremental(Some(&last), &edited, "App.vue", "abc", &opts)?;
+    /// if next.dirty().is_style_only() {
+    ///     send_css_update(next.css());
+    /// }
+    /// last = next;
+    /// ```
+    ///
+    /// # Errors
+    ///
+    /// Returns an error only if the FFI call fails.
+    pub fn compile_sfc_incremental<'c>(
+        &'c self,
+        previous: Option<&SfcOutput<'c>>,
+        source: &str,
+        filename: &str,
+        id: &str,
+        options: &CompileOptions,
+    ) -> Result<SfcOutput<'c>> {
+        use std::os::raw::c_char;
+
+        let ffi_options = options.to_ffi();
+        let previous = previous.map_or(HermesHandle::INVALID, SfcOutput::raw);
+        let handle = unsafe {
+            ffi::vue_compile_sfc_incremental(
+                self.runtime,
+                previous,
+                source.as_ptr() as *const c_char,
+                source.len(),
+                filename.as_ptr() as *const c_char,
+                filename.len(),
+                id.as_ptr() as *const c_char,
+                id.len(),
+                &ffi_options,
+            )
+        };
+
+        if !handle.is_valid() {
+            return Err(Error::new(
+                "compile_sfc_incremental returned invalid handle",
+            ));
+        }
+
+        Ok(SfcOutput::from_raw(handle, &self.runtime))
+    }
+
+    /// Compiles many SFCs with a single FFI call.
+    ///
+    /// Equivalent to calling [`Compiler::compile_sfc`] for every input, but the
+    /// loop runs inside the JS bridge, keeping the compiler's hot paths warm
+    /// and paying the FFI crossing once per batch. Results are in input order,
+    /// one per input; per-file errors are reported on each [`SfcOutput`].
+    ///
+    /// Returns an error, and no results, if the runtime fails to produce a
+    /// result for every input.
+    ///
+    /// # Example
+    ///
+    /// ```ignore
+    /// let inputs: Vec<SfcInput> = files
+    ///     .iter()
+    ///     .map(|f| SfcInput::new(&f.source, &f.name, &f.id))
+    ///     .collect();
+    /// for output in compiler.compile_batch(&inputs, &CompileOptions::default())? {
+    ///     println!("{}", output.js());
+    /// }
+    /// ```
+    pub fn compile_batch<'c>(
+        &'c self,
+        inputs: &[SfcInput<'_>],
+        options: &CompileOptions,
+    ) -> Result<Vec<SfcOutput<'c>>> {
+        let ffi_inputs: Vec<ffi::VueSfcInput> = inputs.iter().map(|i| i.to_ffi()).collect();
+        let ffi_options = options.to_ffi();
+        let batch = unsafe {
+            ffi::vue_compile_batch(
+                self.runtime,
+                ffi_inputs.as_ptr(),
+                ffi_inputs.len(),
+                &ffi_options,
+            )
+        };
+
+        if !batch.is_valid() {
+            return Err(Error::new("compile_batch returned invalid handle"));
+        }
+
+        let count = unsafe { ffi::vue_batch_result_count(self.runtime, batch) };
+        let outputs = if count == inputs.len() {
+            (0..count)
+                .map(|index| {
+                    let handle = unsafe { ffi::vue_batch_result_at(self.runtime, batch, index) };
+                    if handle.is_valid() {
+                        Ok(SfcOutput::from_raw(handle, &self.runtime))
+                    } else {
+                        Err(Error::new(format!(
+                            "compile_batch returned invalid handle for input {index}"
+                        )))
+                    }
+                })
+                .collect()
+        } else {
+            Err(Error::new(format!(
+                "compile_batch returned {count} results for {} inputs",
+                inputs.len()
+            )))
+        };
+
+        unsafe { ffi::hermes_handle_free(self.runtime, batch) };
+        outputs
+    }
+
+    /// Collects the dependencies of many SFCs without compiling them.
+    ///
+    /// For each input, the scan lists the imports of its script blocks, the
+    /// blocks loaded through `src` and the stylesheets its style blocks
+    /// import, so a build tool can start resolving and loading them before
+    /// compilation. Blocks are split natively where possible, and all script
+    /// blocks are parsed with a single FFI call. The inputs' `id` is not
+    /// used. Files are in input order; per-file parse errors are reported on
+    /// each [`FileDependencies`](crate::FileDependencies).
+    pub fn scan_dependencies(&self, inputs: &[SfcInput<'_>]) -> Result<DependencyScan> {
+        let ffi_inputs: Vec<ffi::VueSfcInput> = inputs.iter().map(|i| i.to_ffi()).collect();
+        let raw = unsafe {
+            ffi::vue_scan_dependencies(self.runtime, ffi_inputs.as_ptr(), ffi_inputs.len())
+        };
+
+        if raw.is_null() {
+            return Err(Error::new("scan_dependencies returned null"));
+        }
+
+        Ok(DependencyScan::from_raw(raw))
+    }
 }
 
 impl Drop for Compiler {
@@ -0,0 +1,157 @@
+//! Persistent compile cache shared across processes.
+//!
+//! A `DiskCache` stores [`CompiledSfc`] results in a memory-mapped,
+//! append-only file, so short-lived processes compiling the same components
+//! can reuse each other's work without creating a Hermes runtime.
+
+use std::ffi::CStr;
+use std::os::unix::ffi::OsStrExt;
+use std::path::Path;
+
+use crate::ffi::{self, VueDiskCache};
+use crate::pool::CompilerPool;
+use crate::types::{CompileOptions, CompiledSfc, Error, Result, SfcInput};
+
+/// Persistent, content-addressed cache of compile results.
+///
+/// Entries are keyed by source, filename, id and options, and the cache file
+/// is versioned by the bundled `@vue/compiler-sfc` and bridge, so results of
+/// another compiler build are never served. Each record also stores the
+/// source length, filename, id and options it was compiled with, which a
+/// lookup checks when its hash matches. Records that fail their checksum
+/// are treated as misses.
+///
+/// The file is append-only and never compacted: storing a new result for an
+/// input leaves the old record in place, so a cache whose components change
+/// often grows without bound. Delete the directory to reclaim the space; the
+/// file is also replaced when [`DiskCache::version`] changes.
+///
+/// # Example
+///
+/// ```ignore
+/// use libvue_compiler_sfc::{CompileOptions, DiskCache, SfcInput};
+///
+/// let cache = DiskCache::open("node_modules/.cache/vue-sfc")?;
+/// let inputs = vec![SfcInput::new(source, "App.vue", "abc123")];
+/// // Only creates a pool if some input is not cached yet.
+/// let outputs = cache.compile_batch(&inputs, &CompileOptions::default(), 0)?;
+/// ```
+pub struct DiskCache {
+    cache: VueDiskCache,
+}
+
+// SAFETY: the C cache synchronizes all access internally.
+unsafe impl Send for DiskCache {}
+unsafe impl Sync for DiskCache {}
+
+impl DiskCache {
+    /// Opens the cache in `dir`, creating the directory (but not its parents)
+    /// and the cache file if needed.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the cache file cannot be opened or mapped.
+    pub fn open(dir: impl AsRef<Path>) -> Result<Self> {
+        let bytes = dir.as_ref().as_os_str().as_bytes();
+        let cache = unsafe { ffi::vue_disk_cache_open(bytes.as_ptr().cast(), bytes.len()) };
+        if cache.is_null() {
+            return Err(Error::new(format!(
+                "Failed to open disk cache in {}",
+                dir.as_ref().display()
+            )));
+        }
+        Ok(Self { cache })
+    }
+
+    /// Returns the version key of this build, which names the cache file.
+    pub fn version() -> &'static str {
+        unsafe { CStr::from_ptr(ffi::vue_disk_cache_version()) }
+            .to_str()
+            .unwrap_or("")
+    }
+
+    /// Returns the number of distinct entries readable through this cache.
+    pub fn len(&self) -> usize {
+        unsafe { ffi::vue_disk_cache_entry_count(self.cache) }
+    }
+
+    /// Returns `true` if the cache has no entries.
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Looks up the result of compiling `input` with `options`.
+    pub fn get(&self, input: &SfcInput<'_>, options: &CompileOptions) -> Option<CompiledSfc> {
+        let ffi_input = input.to_ffi();
+        let ffi_options = options.to_ffi();
+        let raw = unsafe { ffi::vue_disk_cache_get(self.cache, &ffi_input, &ffi_options) };
+        if raw.is_null() {
+            return None;
+        }
+        Some(CompiledSfc::from_raw(raw))
+    }
+
+    /// Stores the result of compiling `input` with `options`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the record could not be written.
+    pub fn put(
+        &self,
+        input: &SfcInput<'_>,
+        options: &CompileOptions,
+        output: &CompiledSfc,
+    ) -> Result<()> {
+        let ffi_input = input.to_ffi();
+        let ffi_options = options.to_ffi();
+        let ok = unsafe {
+            ffi::vue_disk_cache_put(self.cache, &ffi_input, &ffi_options, output.as_raw())
+        };
+        if !ok {
+            return Err(Error::new("vue_disk_cache_put failed"));
+        }
+        Ok(())
+    }
+
+    /// Compiles a batch, answering cached inputs from disk.
+    ///
+    /// A [`CompilerPool`] with `workers` runtimes is created only if some
+    /// input misses. Results without errors are stored for later runs.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the pool cannot be created or the batch fails.
+    pub fn compile_batch(
+        &self,
+        inputs: &[SfcInput<'_>],
+        options: &CompileOptions,
+        workers: usize,
+    ) -> Result<Vec<CompiledSfc>> {
+        let mut outputs: Vec<Option<CompiledSfc>> = inputs
+            .iter()
+            .map(|input| self.get(input, options))
+            .collect();
+
+        let missing: Vec<usize> = (0..inputs.len())
+            .filter(|&i| outputs[i].is_none())
+            .collect();
+        if !missing.is_empty() {
+            let pool = CompilerPool::new(workers)?;
+            let batch: Vec<SfcInput<'_>> = missing.iter().map(|&i| inputs[i]).collect();
+            for (&i, output) in missing.iter().zip(pool.compile_batch(&batch, options)?) {
+                if !output.has_errors() {
+                    self.put(&inputs[i], options, &output)?;
+                }
+                outputs[i] = Some(output);
+            }
+        }
+
+        Ok(outputs.into_iter().flatten().collect())
+    }
+}
+
+impl Drop for DiskCache {
+    fn drop(&mut self) {
+        unsafe { ffi::vue_disk_cache_close(self.cache) }
+    }
+}
@@ -7,7 +7,10 @@
 //!
 //! Each `Compiler` instance must only be used from one thread at a time.
 //! To compile in parallel, create multiple `Compiler` instances - each
-//! owns its own Hermes runtime.
+//! owns its own Hermes runtime - or use a [`CompilerPool`], which owns one
+//! runtime per worker thread and balances jobs with work stealing. A pool
+//! compiles blocking batches or, with [`CompilerPool::submit`], single jobs
+//! awaited as futures on any executor.
 //!
 //! # API Layers
 //!
@@ -29,18 +32,12 @@
 //!     // Compile script
 //!     let script = desc.compile_script("scope-id", false)?;
 //!
-//!     // Compile template with bindings from script
-//!     let template = compiler.compile_template(
-//!         desc.template().unwrap().content(),
-//!         "App.vue",
-//!         "scope-id",
-//!         desc.has_scoped_style(),
-//!         Some(&script),
-//!     )?;
+//!     // Compile template with bindings from script (reuses the parsed AST)
+//!     let template = desc.compile_template("scope-id", Some(&script))?;
 //!
 //!     // Compile styles
-//!     let css: Vec<String> = desc.styles()
-//!         .map(|s| compiler.compile_style(s.content(), "App.vue", "scope-id", s.is_scoped()))
+//!     let css: Vec<String> = (0..desc.style_count())
+//!         .map(|i| desc.compile_style(i, "scope-id"))
 //!         .collect::<Result<Vec<_>, _>>()?
 //!         .into_iter()
 //!         .map(|r| r.code().to_string())
@@ -52,12 +49,33 @@
 //!     ))
 //! }
 //! ```
+//!
+//! When only the final JavaScript and CSS are needed, [`Compiler::compile_sfc`]
+//! runs the whole pipeline in a single FFI call:
+//!
+//! ```no_run
+//! use libvue_compiler_sfc::{CompileOptions, Compiler};
+//!
+//! # fn main() -> Result<(), Box<dyn std::error::Error>> {
+//! let compiler = Compiler::new()?;
+//! let output = compiler.compile_sfc(
+//!     "<template><div>{{ msg }}</div></template>",
+//!     "App.vue",
+//!     "scope-id",
+//!     &CompileOptions::default(),
+//! )?;
+//! println!("{}\n{}", output.js(), output.css());
+//! # Ok(())
+//! # }
+//! ```
 
 // Layer 1: Raw FFI (unsafe, extern "C") - re-exported from sys crate
 pub use lib_vue_compiler_sfc_sys as ffi;
 
 // Layer 2: Safe Rust types and compiler
 mod compiler;
+mod disk_cache;
+mod pool;
 pub(crate) mod types;
 mod util;
 
@@ -67,8 +85,12 @@ mod tests;
 
 // Re-export public API
 pub use compiler::Compiler;
+pub use disk_cache::DiskCache;
+pub use pool::{CompileJob, CompilerPool};
 pub use types::{
-    AttrValue, CustomBlock, Descriptor, Error, ImportBinding, ParseOutput, Position, Result,
-    ScriptBlock, ScriptOutput, SourceLocation, StyleBlock, StyleOutput, TemplateBlock,
-    TemplateOutput,
+    AttrValue, BlockKind, BufferBlock, CacheStats, CompileOptions, CompiledSfc, CompilerUnits,
+    CustomBlock, DependencyImport, DependencyScan, Descriptor, DescriptorBuffer, DirtyParts, Error,
+    FileDependencies, HeapStats, ImportBinding, ParseOutput, PhaseStats, Position, ProcessOptions,
+    Result, RuntimeOptions, RuntimeStats, ScriptBlock, ScriptOutput, SfcInput, SfcOutput, SfcScan,
+    SourceLocation, StyleBlock, StyleOutput, TemplateBlock, TemplateOutput,
 };
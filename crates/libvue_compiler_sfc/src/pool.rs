@@ -0,0 +1,291 @@
+//! Thread-safe compiler pool.
+//!
+//! A `CompilerPool` owns several Hermes runtimes, each pinned to a worker
+//! thread, and balances compile jobs across them with work stealing.
+//! Jobs are either compiled in blocking batches or submitted one at a time
+//! as a [`CompileJob`] future.
+
+use std::ffi::c_void;
+use std::future::Future;
+use std::pin::Pin;
+use std::sync::{Arc, Mutex, PoisonError};
+use std::task::{Context, Poll, Waker};
+
+use crate::ffi::{self, VueJobTicket, VuePool};
+use crate::types::{
+    CacheStats, CompileOptions, CompiledSfc, Error, Result, RuntimeOptions, SfcInput,
+};
+
+/// Pool of compiler runtimes on dedicated worker threads.
+///
+/// Unlike [`Compiler`](crate::Compiler), a pool is `Send` and `Sync`: any
+/// thread may submit work, and runtimes never leave their worker threads.
+///
+/// # Example
+///
+/// ```ignore
+/// use libvue_compiler_sfc::{CompileOptions, CompilerPool, SfcInput};
+///
+/// let pool = CompilerPool::new(0)?;
+/// let inputs = vec![SfcInput::new(source, "App.vue", "abc123")];
+/// for output in pool.compile_batch(&inputs, &CompileOptions::default())? {
+///     println!("{}", output.js());
+/// }
+/// ```
+pub struct CompilerPool {
+    pool: VuePool,
+}
+
+// SAFETY: the C pool synchronizes all access internally.
+unsafe impl Send for CompilerPool {}
+unsafe impl Sync for CompilerPool {}
+
+impl CompilerPool {
+    /// Creates a pool with `workers` runtimes (0 = one per hardware thread).
+    ///
+    /// Runtimes are initialized in parallel, one per worker thread.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if any runtime fails to initialize.
+    pub fn new(workers: usize) -> Result<Self> {
+        let pool = unsafe { ffi::vue_pool_create(workers) };
+        if pool.is_null() {
+            return Err(Error::new("Failed to create compiler pool"));
+        }
+        Ok(Self { pool })
+    }
+
+    /// Creates a pool whose worker runtimes initialize only some compiler
+    /// units up front (see [`Compiler::with_options`](crate::Compiler::with_options)).
+    ///
+    /// Heap limits apply to every runtime of the process; see
+    /// [`Compiler::configure_process`](crate::Compiler::configure_process).
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if any runtime fails to initialize.
+    pub fn with_options(workers: usize, options: &RuntimeOptions) -> Result<Self> {
+        let ffi_options = options.to_ffi();
+        let pool = unsafe { ffi::vue_pool_create_with_options(workers, &ffi_options) };
+        if pool.is_null() {
+            return Err(Error::new("Failed to create compiler pool"));
+        }
+        Ok(Self { pool })
+    }
+
+    /// Makes every worker run a full collection when it runs out of jobs,
+    /// i.e. at the end of each batch (default off).
+    ///
+    /// Keeps each runtime's heap near its live size between batches, at the
+    /// cost of one GC pause per worker per batch.
+    pub fn set_collect_when_idle(&self, enabled: bool) {
+        unsafe { ffi::vue_pool_set_collect_when_idle(self.pool, enabled) }
+    }
+
+    #[cfg(test)]
+    pub(crate) fn as_raw(&self) -> VuePool {
+        self.pool
+    }
+
+    /// Returns the number of worker runtimes.
+    pub fn worker_count(&self) -> usize {
+        unsafe { ffi::vue_pool_worker_count(self.pool) }
+    }
+
+    /// Compiles a batch of SFCs in parallel, blocking until all are done.
+    ///
+    /// Results are returned in input order. Compilation errors of individual
+    /// inputs are reported on their [`CompiledSfc`], not as an `Err`.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the batch could not be submitted.
+    pub fn compile_batch(
+        &self,
+        inputs: &[SfcInput<'_>],
+        options: &CompileOptions,
+    ) -> Result<Vec<CompiledSfc>> {
+        let ffi_inputs: Vec<ffi::VueSfcInput> = inputs.iter().map(|i| i.to_ffi()).collect();
+        let ffi_options = options.to_ffi();
+        let mut raw = vec![ffi::VueCompiledSfc::NULL; inputs.len()];
+
+        let ok = unsafe {
+            ffi::vue_pool_compile_batch(
+                self.pool,
+                ffi_inputs.as_ptr(),
+                ffi_inputs.len(),
+                &ffi_options,
+                raw.as_mut_ptr(),
+            )
+        };
+        if !ok {
+            return Err(Error::new("vue_pool_compile_batch failed"));
+        }
+
+        Ok(raw.into_iter().map(CompiledSfc::from_raw).collect())
+    }
+
+    /// Queues one SFC for compilation and returns a future of its result
+    /// without waiting.
+    ///
+    /// The input is copied, and the job shares the workers and compile cache
+    /// with batches. The future is woken from the worker thread that compiled
+    /// the job, so it works with any executor and lets an async caller overlap
+    /// compilation with its own I/O. Dropping the future does not cancel the
+    /// job; its result is then freed on completion. Jobs still queued when
+    /// the pool is dropped are compiled first.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the job could not be submitted.
+    pub fn submit(&self, input: &SfcInput<'_>, options: &CompileOptions) -> Result<CompileJob> {
+        let ffi_input = input.to_ffi();
+        let ffi_options = options.to_ffi();
+        let state = Arc::new(Mutex::new(JobState::default()));
+        let user_data = Arc::into_raw(Arc::clone(&state)) as *mut c_void;
+
+        let ticket = unsafe {
+            ffi::vue_pool_submit(
+                self.pool,
+                &ffi_input,
+                &ffi_options,
+                Some(complete_job),
+                user_data,
+            )
+        };
+        if ticket == 0 {
+            // The callback will never run, so release its reference here.
+            drop(unsafe { Arc::from_raw(user_data as *const Mutex<JobState>) });
+            return Err(Error::new("vue_pool_submit failed"));
+        }
+
+        Ok(CompileJob {
+            ticket,
+            state,
+            done: false,
+        })
+    }
+
+    /// Enables, resizes or disables the compile cache.
+    ///
+    /// With the cache enabled, an input whose source, filename, id and
+    /// options match an earlier compilation is answered with a copy of that
+    /// result without entering JS. Least recently used results are evicted
+    /// to stay within `max_entries` and `max_bytes` (0 = no byte limit).
+    /// `max_entries` of 0 disables the cache and drops its entries.
+    pub fn set_cache_limits(&self, max_entries: usize, max_bytes: usize) {
+        unsafe { ffi::vue_pool_set_cache_limits(self.pool, max_entries, max_bytes) }
+    }
+
+    /// Drops all cached results. Counters are kept.
+    pub fn clear_cache(&self) {
+        unsafe { ffi::vue_pool_cache_clear(self.pool) }
+    }
+
+    /// Returns the compile cache counters.
+    pub fn cache_stats(&self) -> CacheStats {
+        let mut stats = ffi::VuePoolCacheStats::default();
+        unsafe {
+            ffi::vue_pool_cache_stats(self.pool, &mut stats);
+        }
+        CacheStats::from_ffi(stats)
+    }
+
+    /// Enables, changes or disables runtime recycling, which bounds the
+    /// memory of long-running pools.
+    ///
+    /// A worker whose runtime ran `max_compiles` compilations (cache hits
+    /// do not count), or whose heap grew past `max_heap_bytes`, gets a fresh
+    /// runtime created in the background while it keeps compiling; the old
+    /// runtime is torn down once swapped out, releasing its heap. 0 disables
+    /// a limit.
+    pub fn set_recycle_limits(&self, max_compiles: u64, max_heap_bytes: usize) {
+        unsafe { ffi::vue_pool_set_recycle_limits(self.pool, max_compiles, max_heap_bytes) }
+    }
+
+    /// Returns the number of worker runtimes replaced by recycling so far.
+    pub fn recycle_count(&self) -> u64 {
+        unsafe { ffi::vue_pool_recycle_count(self.pool) }
+    }
+}
+
+impl Drop for CompilerPool {
+    fn drop(&mut self) {
+        unsafe { ffi::vue_pool_destroy(self.pool) }
+    }
+}
+
+/// Completion state shared by a [`CompileJob`] and its C callback.
+#[derive(Default)]
+struct JobState {
+    result: Option<CompiledSfc>,
+    waker: Option<Waker>,
+}
+
+/// `VueJobCallback` for [`CompilerPool::submit`]: stores the result and wakes
+/// the task awaiting it.
+unsafe extern "C" fn complete_job(
+    user_data: *mut c_void,
+    _ticket: VueJobTicket,
+    result: ffi::VueCompiledSfc,
+) {
+    // SAFETY: `submit` passed one reference of the `Arc` for this callback.
+    let state = unsafe { Arc::from_raw(user_data as *const Mutex<JobState>) };
+    let waker = {
+        let mut state = state.lock().unwrap_or_else(PoisonError::into_inner);
+        state.result = Some(CompiledSfc::from_raw(result));
+        state.waker.take()
+    };
+    if let Some(waker) = waker {
+        waker.wake();
+    }
+}
+
+/// A job submitted with [`CompilerPool::submit`], resolving to its result.
+///
+/// Compilation errors are reported on the [`CompiledSfc`], as for batches.
+#[must_use = "dropping a CompileJob discards its result"]
+pub struct CompileJob {
+    ticket: VueJobTicket,
+    state: Arc<Mutex<JobState>>,
+    done: bool,
+}
+
+impl CompileJob {
+    /// Returns the job's ticket, unique within its pool.
+    pub fn ticket(&self) -> u64 {
+        self.ticket
+    }
+
+    /// Returns `true` once the result is ready, i.e. when the next poll
+    /// resolves without waiting.
+    pub fn is_finished(&self) -> bool {
+        self.done
+            || self
+                .state
+                .lock()
+                .unwrap_or_else(PoisonError::into_inner)
+                .result
+                .is_some()
+    }
+}
+
+impl Future for CompileJob {
+    type Output = CompiledSfc;
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<CompiledSfc> {
+        assert!(!self.done, "CompileJob polled after completion");
+        let mut state = self.state.lock().unwrap_or_else(PoisonError::into_inner);
+        if let Some(result) = state.result.take() {
+            drop(state);
+            self.done = true;
+            return Poll::Ready(result);
+        }
+        match &state.waker {
+            Some(waker) if waker.will_wake(cx.waker()) => {}
+            _ => state.waker = Some(cx.waker().clone()),
+        }
+        Poll::Pending
+    }
+}
@@ -0,0 +1,92 @@
+//! Tests for borrowed (zero-copy) parsing.
+
+use crate::Compiler;
+
+const SOURCE: &str = r#"<template>
+  <p>héllo 😀 {{ msg }}</p>
+</template>
+
+<script setup>
+const msg = 'ünïcode'
+</script>
+
+<style scoped>
+.a::before { content: "→"; }
+</style>
+
+<docs>
+# Ünïcode docs
+</docs>
+"#;
+
+#[test]
+fn test_parse_borrowed_matches_parse() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let owned = compiler.parse(SOURCE, "App.vue").unwrap();
+    let borrowed = compiler.parse_borrowed(SOURCE, "App.vue").unwrap();
+    let owned = owned.descriptor().unwrap();
+    let borrowed = borrowed.descriptor().unwrap();
+
+    assert_eq!(borrowed.source(), owned.source());
+    assert_eq!(
+        borrowed.template().unwrap().content(),
+        owned.template().unwrap().content()
+    );
+    assert_eq!(
+        borrowed.script_setup().unwrap().content(),
+        owned.script_setup().unwrap().content()
+    );
+    assert_eq!(
+        borrowed.styles().next().unwrap().content(),
+        owned.styles().next().unwrap().content()
+    );
+    assert_eq!(
+        borrowed.custom_blocks().next().unwrap().content(),
+        owned.custom_blocks().next().unwrap().content()
+    );
+}
+
+#[test]
+fn test_parse_borrowed_points_into_source() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let result = compiler.parse_borrowed(SOURCE, "App.vue").unwrap();
+    let desc = result.descriptor().unwrap();
+
+    assert_eq!(desc.source().as_ptr(), SOURCE.as_ptr());
+
+    let template = desc.template().unwrap();
+    let range = template
+        .content_range()
+        .expect("template content is a slice");
+    assert_eq!(&SOURCE[range.clone()], template.content());
+    assert_eq!(template.content().as_ptr(), SOURCE[range.start..].as_ptr());
+
+    let style = desc.styles().next().unwrap();
+    let range = style.content_range().expect("style content is a slice");
+    assert_eq!(&SOURCE[range], style.content());
+}
+
+#[test]
+fn test_parse_copies_content() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let result = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = result.descriptor().unwrap();
+
+    assert!(desc.template().unwrap().content_range().is_none());
+}
+
+#[test]
+fn test_parse_borrowed_transformed_content() {
+    let source = "<template lang=\"pug\">\n    div\n      p hello\n</template>\n";
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let owned = compiler.parse(source, "App.vue").unwrap();
+    let borrowed = compiler.parse_borrowed(source, "App.vue").unwrap();
+    let owned = owned.descriptor().unwrap();
+    let borrowed = borrowed.descriptor().unwrap();
+
+    let template = borrowed.template().unwrap();
+    assert_eq!(template.content(), owned.template().unwrap().content());
+    if let Some(range) = template.content_range() {
+        assert_eq!(&source[range], template.content());
+    }
+}
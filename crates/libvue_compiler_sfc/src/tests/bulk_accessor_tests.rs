@@ -0,0 +1,67 @@
+//! Tests for the callback-based bulk accessors.
+
+use crate::Compiler;
+
+/// Builds a `<script setup>` component with `n` ref bindings.
+fn many_bindings_source(n: usize) -> String {
+    let mut source = String::from("<script setup>\nimport { ref } from 'vue'\n");
+    for i in 0..n {
+        source.push_str(&format!("const field{i} = ref({i})\n"));
+    }
+    source.push_str("</script>\n<template><div>{{ field0 }}</div></template>\n");
+    source
+}
+
+#[test]
+fn test_bulk_bindings_cover_every_binding() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let source = many_bindings_source(300);
+    let parsed = compiler.parse(&source, "Form.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    let script = desc.compile_script("abc123", false).unwrap();
+    let bindings = script.bindings();
+
+    // 300 refs plus the `ref` import.
+    assert_eq!(bindings.len(), 301);
+    assert_eq!(
+        bindings.get("field0").map(String::as_str),
+        Some("setup-ref")
+    );
+    assert_eq!(
+        bindings.get("field299").map(String::as_str),
+        Some("setup-ref")
+    );
+    assert_eq!(bindings.get("ref").map(String::as_str), Some("setup-const"));
+}
+
+#[test]
+fn test_bulk_imports_of_script_output() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let source = many_bindings_source(3);
+    let parsed = compiler.parse(&source, "Form.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    let script = desc.compile_script("abc123", false).unwrap();
+    let imports = script.imports();
+
+    assert_eq!(imports.len(), 1);
+    let import = &imports["ref"];
+    assert_eq!(import.imported, "ref");
+    assert_eq!(import.source, "vue");
+    assert!(!import.is_type);
+    assert!(import.is_from_setup);
+}
+
+#[test]
+fn test_bulk_template_errors() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let template = compiler
+        .compile_template("<div v-if>", "App.vue", "abc123", false, None)
+        .unwrap();
+
+    let errors = template.errors();
+    assert_eq!(errors.len(), template.error_count());
+    assert!(!errors.is_empty());
+    assert!(errors.iter().all(|e| !e.is_empty()));
+}
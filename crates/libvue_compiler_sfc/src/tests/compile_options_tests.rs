@@ -0,0 +1,170 @@
+//! Tests for opt-in compile artifacts (source maps, preamble, tips).
+
+use crate::{CompileOptions, Compiler};
+
+const SOURCE: &str = r#"<template>
+  <div class="app">{{ msg }}</div>
+</template>
+
+<script setup>
+const msg = 'hello'
+</script>
+"#;
+
+#[test]
+fn test_default_options_omit_artifacts() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    let script = desc.compile_script("abc123", false).unwrap();
+    assert!(script.map().is_none());
+
+    let template = desc.compile_template("abc123", Some(&script)).unwrap();
+    assert!(!template.code().is_empty());
+    assert!(template.map().is_none());
+    assert!(template.preamble().is_none());
+    assert!(template.tips().is_empty());
+}
+
+#[test]
+fn test_source_map_option_produces_maps() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let options = CompileOptions {
+        source_map: true,
+        ..CompileOptions::default()
+    };
+    let parsed = compiler
+        .parse_with_options(SOURCE, "App.vue", &options)
+        .unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    let script = desc
+        .compile_script_with_options("abc123", &options)
+        .unwrap();
+    let script_map = script.map().expect("script map should be generated");
+    assert!(script_map.contains("\"mappings\""));
+
+    let template = desc
+        .compile_template_with_options("abc123", Some(&script), &options)
+        .unwrap();
+    let template_map = template.map().expect("template map should be generated");
+    assert!(template_map.contains("\"mappings\""));
+}
+
+#[test]
+fn test_options_do_not_change_code() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let everything = CompileOptions {
+        source_map: true,
+        keep_template_ast: true,
+        keep_preamble: true,
+        keep_tips: true,
+        ..CompileOptions::default()
+    };
+
+    let lean = compiler
+        .compile_template("<div>{{ a }}</div>", "App.vue", "abc123", false, None)
+        .unwrap();
+    let full = compiler
+        .compile_template_with_options(
+            "<div>{{ a }}</div>",
+            "App.vue",
+            "abc123",
+            false,
+            None,
+            &everything,
+        )
+        .unwrap();
+
+    assert_eq!(lean.code(), full.code());
+    assert!(full.map().is_some());
+}
+
+#[test]
+fn test_ssr_option_generates_ssr_render() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let ssr = CompileOptions {
+        ssr: true,
+        ..CompileOptions::default()
+    };
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    let script = desc.compile_script_with_options("abc123", &ssr).unwrap();
+    let client = desc.compile_template("abc123", Some(&script)).unwrap();
+    assert!(!client.code().contains("ssrRender"));
+
+    let server = desc
+        .compile_template_with_options("abc123", Some(&script), &ssr)
+        .unwrap();
+    assert!(server.code().contains("ssrRender"));
+    assert!(server.code().contains("_push("));
+
+    let raw = compiler
+        .compile_template_with_options("<div>{{ a }}</div>", "App.vue", "abc123", false, None, &ssr)
+        .unwrap();
+    assert!(raw.code().contains("ssrRender"));
+
+    let output = compiler
+        .compile_sfc(SOURCE, "App.vue", "abc123", &ssr)
+        .unwrap();
+    assert!(!output.has_errors());
+    assert!(output.js().contains("ssrRender"));
+}
+
+#[test]
+fn test_prod_option_hashes_style_vars() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let css = ".a { color: v-bind(color); }";
+    let prod = CompileOptions {
+        is_prod: true,
+        ..CompileOptions::default()
+    };
+
+    let dev = compiler
+        .compile_style(css, "App.vue", "abc123", true)
+        .unwrap();
+    assert!(dev.code().contains("var(--abc123-color)"));
+
+    let prod = compiler
+        .compile_style_with_options(css, "App.vue", "abc123", true, &prod)
+        .unwrap();
+    assert!(prod.code().contains("var(--"));
+    assert!(!prod.code().contains("-color)"));
+}
+
+#[test]
+fn test_inline_template_option_inlines_render() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let inline = CompileOptions {
+        inline_template: true,
+        ..CompileOptions::default()
+    };
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    let separate = desc.compile_script("abc123", false).unwrap();
+    assert!(!separate.has_inline_template());
+    assert!(!separate.content().contains("_toDisplayString"));
+
+    let script = desc.compile_script_with_options("abc123", &inline).unwrap();
+    assert!(script.has_inline_template());
+    assert!(script.content().contains("return (_ctx, _cache)"));
+    assert!(script.content().contains("_toDisplayString(msg)"));
+
+    // Without <script setup> there is no setup function to inline into.
+    let parsed = compiler
+        .parse(
+            "<template><p>{{ a }}</p></template>\n<script>export default {}</script>",
+            "App.vue",
+        )
+        .unwrap();
+    let script = parsed
+        .descriptor()
+        .unwrap()
+        .compile_script_with_options("abc123", &inline)
+        .unwrap();
+    assert!(!script.has_inline_template());
+    assert!(!script.content().contains("_toDisplayString"));
+}
@@ -0,0 +1,85 @@
+//! Tests for lazily loaded compiler units.
+
+use super::STYLED_SOURCE;
+use crate::{CompileOptions, Compiler, CompilerPool, CompilerUnits, RuntimeOptions, SfcInput};
+
+fn only(units: CompilerUnits) -> RuntimeOptions {
+    RuntimeOptions { units }
+}
+
+#[test]
+fn test_missing_units_load_on_first_use() {
+    let compiler =
+        Compiler::with_options(&only(CompilerUnits::TEMPLATE)).expect("Compiler should initialize");
+    let split = CompilerUnits::split_enabled();
+    let expect = |units: CompilerUnits| {
+        let loaded = compiler.loaded_units();
+        if split {
+            assert_eq!(loaded, units);
+        } else {
+            assert_eq!(loaded, CompilerUnits::ALL);
+        }
+    };
+    expect(CompilerUnits::TEMPLATE);
+
+    let template = compiler
+        .compile_template("<p>{{ a }}</p>", "App.vue", "abc", false, None)
+        .unwrap();
+    assert!(template.code().contains("_toDisplayString"));
+    expect(CompilerUnits::TEMPLATE);
+
+    let parsed = compiler.parse(STYLED_SOURCE, "App.vue").unwrap();
+    expect(CompilerUnits::TEMPLATE | CompilerUnits::PARSE);
+
+    let script = parsed
+        .descriptor()
+        .unwrap()
+        .compile_script("abc", false)
+        .unwrap();
+    assert!(script.content().contains("msg"));
+    let loaded = compiler.loaded_units();
+    assert!(loaded.contains(CompilerUnits::SCRIPT | CompilerUnits::PARSE));
+    assert!(!split || !loaded.contains(CompilerUnits::STYLE));
+
+    let output = compiler
+        .compile_sfc(STYLED_SOURCE, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+    assert!(!output.has_errors());
+    assert!(output.css().contains("[data-v-abc]"));
+    expect(CompilerUnits::ALL);
+}
+
+#[test]
+fn test_unit_subsets_match_full_compiler() {
+    let full = Compiler::new().expect("Compiler should initialize");
+    let expected = full
+        .compile_sfc(STYLED_SOURCE, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+
+    for units in [
+        CompilerUnits::PARSE,
+        CompilerUnits::SCRIPT | CompilerUnits::STYLE,
+        CompilerUnits::ALL,
+    ] {
+        let compiler = Compiler::with_options(&only(units)).expect("Compiler should initialize");
+        assert!(compiler.loaded_units().contains(units));
+        let output = compiler
+            .compile_sfc(STYLED_SOURCE, "App.vue", "abc", &CompileOptions::default())
+            .unwrap();
+        assert_eq!(output.js(), expected.js());
+        assert_eq!(output.css(), expected.css());
+    }
+}
+
+#[test]
+fn test_pool_workers_load_configured_units() {
+    let pool =
+        CompilerPool::with_options(2, &only(CompilerUnits::PARSE)).expect("Pool should initialize");
+    let outputs = pool
+        .compile_batch(
+            &[SfcInput::new(STYLED_SOURCE, "App.vue", "abc")],
+            &CompileOptions::default(),
+        )
+        .unwrap();
+    assert!(!outputs[0].has_errors());
+}
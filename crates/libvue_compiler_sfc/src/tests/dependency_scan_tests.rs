@@ -0,0 +1,175 @@
+//! Tests for the batch dependency scan.
+
+use std::collections::BTreeMap;
+use std::thread;
+
+use crate::{Compiler, DependencyImport, SfcInput};
+
+/// Components whose imports compileScript() reports.
+const SETUP_SOURCES: &[&str] = &[
+    r#"<script setup>
+import { ref, computed as c } from 'vue'
+import Foo from './Foo.vue'
+import * as utils from '../utils'
+const a = ref(c(() => Foo(utils)))
+</script>
+<template><Foo :a="a" /></template>"#,
+    r#"<script lang="ts">
+import { defineComponent } from 'vue'
+import type { Item } from './types'
+export default defineComponent({ name: 'List' })
+</script>
+<script setup lang="ts">
+import { defineProps, ref } from 'vue'
+import { type Props, format } from './props'
+import { ref as ref2 } from 'vue'
+const props = defineProps<{ item: Item; p: Props }>()
+const label = ref(format(props.item))
+const other = ref2(0)
+</script>"#,
+    r#"<script setup lang="tsx">
+import { h } from 'vue'
+import Icon from '~/icons/Icon'
+const render = () => <Icon />
+void render
+void h
+</script>"#,
+];
+
+fn import_map<'a>(
+    imports: impl Iterator<Item = DependencyImport<'a>>,
+) -> BTreeMap<String, (String, String, bool, bool)> {
+    imports
+        .filter(|import| !import.local.is_empty())
+        .map(|import| {
+            (
+                import.local.to_string(),
+                (
+                    import.imported.to_string(),
+                    import.source.to_string(),
+                    import.is_type,
+                    import.is_from_setup,
+                ),
+            )
+        })
+        .collect()
+}
+
+#[test]
+fn test_scan_imports_match_compile_script() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let inputs: Vec<SfcInput> = SETUP_SOURCES
+        .iter()
+        .map(|source| SfcInput::new(source, "App.vue", ""))
+        .collect();
+    let scan = compiler.scan_dependencies(&inputs).unwrap();
+    assert_eq!(scan.len(), SETUP_SOURCES.len());
+
+    for (source, file) in SETUP_SOURCES.iter().zip(scan.files()) {
+        assert_eq!(file.errors().count(), 0, "{source}");
+
+        let parsed = compiler.parse(source, "App.vue").unwrap();
+        let script = parsed
+            .descriptor()
+            .unwrap()
+            .compile_script("abc123", false)
+            .unwrap();
+        let expected: BTreeMap<_, _> = script
+            .imports()
+            .into_iter()
+            .map(|(local, binding)| {
+                (
+                    local,
+                    (
+                        binding.imported,
+                        binding.source,
+                        binding.is_type,
+                        binding.is_from_setup,
+                    ),
+                )
+            })
+            .collect();
+        assert_eq!(import_map(file.imports()), expected, "{source}");
+    }
+}
+
+#[test]
+fn test_scan_collects_file_dependencies() {
+    let sources = [
+        r#"<template src="./App.html"></template>
+<script>
+import './polyfill'
+import Base from './Base.vue'
+export default { extends: Base }
+</script>
+<style src="./reset.css"></style>
+<style lang="scss">
+// @import 'commented';
+@use 'sass:math';
+@use "./tokens" as t;
+@import 'mixins', 'theme';
+</style>
+<style>
+@import url("./fonts.css") screen;
+.a { content: "@import 'no'" }
+</style>
+<i18n src="./locales.json"></i18n>"#,
+        // Not handled by the native scanner: falls back to the parser.
+        "<template v-if=\"ok\"><div/></template>\n<script setup>import x from 'x'</script>",
+        "<template><div/></template>\n<script setup>import { from 'x'</script>",
+        "<template></template><template></template>",
+    ];
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let inputs: Vec<SfcInput> = sources
+        .iter()
+        .map(|source| SfcInput::new(source, "App.vue", ""))
+        .collect();
+    let scan = compiler.scan_dependencies(&inputs).unwrap();
+    drop(compiler);
+    let scan = thread::spawn(move || scan).join().unwrap();
+
+    let file = scan.file(0).unwrap();
+    let imports: Vec<_> = file.imports().collect();
+    assert_eq!(imports.len(), 2);
+    assert_eq!(
+        imports[0],
+        DependencyImport {
+            local: "",
+            imported: "",
+            source: "./polyfill",
+            is_type: false,
+            is_from_setup: false,
+        }
+    );
+    assert_eq!(imports[1].imported, "default");
+    assert_eq!(imports[1].source, "./Base.vue");
+    assert_eq!(
+        file.srcs().collect::<Vec<_>>(),
+        [
+            ("template", "./App.html"),
+            ("style", "./reset.css"),
+            ("i18n", "./locales.json"),
+        ]
+    );
+    assert_eq!(
+        file.style_imports().collect::<Vec<_>>(),
+        ["./tokens", "mixins", "theme", "./fonts.css"]
+    );
+    assert_eq!(file.errors().count(), 0);
+
+    let file = scan.file(1).unwrap();
+    assert_eq!(file.imports().map(|i| i.source).collect::<Vec<_>>(), ["x"]);
+
+    assert_eq!(scan.file(2).unwrap().imports().count(), 0);
+    assert_eq!(scan.file(2).unwrap().errors().count(), 1);
+    assert!(scan.file(3).unwrap().errors().count() > 0);
+    assert!(scan.file(4).is_none());
+}
+
+#[test]
+fn test_scan_empty_batch() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let scan = compiler.scan_dependencies(&[]).unwrap();
+    assert!(scan.is_empty());
+    assert!(scan.file(0).is_none());
+}
@@ -0,0 +1,176 @@
+//! Tests for the binary descriptor format.
+
+use std::thread;
+
+use crate::{BlockKind, Compiler, DescriptorBuffer};
+
+const SOURCE: &str = r#"<template>
+  <div class="app" @click="count++">{{ count }} {{ label }}</div>
+</template>
+
+<script>
+export default { name: 'App' }
+</script>
+
+<script setup lang="ts">
+import { ref } from 'vue'
+import { label } from './label'
+const count = ref(0)
+const color = 'red'
+</script>
+
+<style scoped>
+.app { color: v-bind(color); }
+</style>
+
+<style module="classes" lang="css">
+.title { margin: 0; }
+</style>
+
+<i18n locale="en" global>
+{ "hello": "Hello" }
+</i18n>
+"#;
+
+#[test]
+fn test_serialized_descriptor_reads_in_place() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+    let buffer = desc.serialize().unwrap();
+
+    assert_eq!(buffer.source(), SOURCE);
+    assert_eq!(buffer.filename(), "App.vue");
+    assert_eq!(buffer.slotted(), desc.slotted());
+    assert_eq!(buffer.css_vars().collect::<Vec<_>>(), desc.css_vars());
+
+    let kinds: Vec<BlockKind> = buffer.blocks().map(|b| b.kind()).collect();
+    assert_eq!(
+        kinds,
+        [
+            BlockKind::Template,
+            BlockKind::Script,
+            BlockKind::ScriptSetup,
+            BlockKind::Style,
+            BlockKind::Style,
+            BlockKind::Custom,
+        ]
+    );
+
+    let template = buffer.template().unwrap();
+    assert_eq!(template.content(), desc.template().unwrap().content());
+    assert_eq!(template.loc(), desc.template().unwrap().loc());
+
+    let setup = buffer.script_setup().unwrap();
+    assert_eq!(setup.lang(), "ts");
+    assert!(setup.has_setup());
+    assert_eq!(setup.setup(), None);
+
+    let styles: Vec<_> = buffer.styles().collect();
+    assert!(styles[0].is_scoped());
+    assert!(!styles[0].has_module());
+    assert_eq!(styles[1].module_name(), Some("classes"));
+    for (style, original) in styles.iter().zip(desc.styles()) {
+        assert_eq!(style.content(), original.content());
+        assert_eq!(style.loc(), original.loc());
+    }
+
+    let i18n = buffer.custom_blocks().next().unwrap();
+    assert_eq!(i18n.block_type(), "i18n");
+    let attrs: Vec<_> = i18n.attrs().collect();
+    assert_eq!(attrs, [("locale", Some("en")), ("global", None)]);
+
+    // Memoized on the descriptor.
+    let again = desc.serialize().unwrap();
+    assert_eq!(again.as_bytes().as_ptr(), buffer.as_bytes().as_ptr());
+}
+
+#[test]
+fn test_loaded_descriptor_compiles_like_the_original() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+    let bytes = desc.serialize().unwrap().as_bytes().to_vec();
+
+    let script = desc.compile_script("abc123", false).unwrap();
+    let template = desc.compile_template("abc123", Some(&script)).unwrap();
+    let styles: Vec<String> = (0..desc.style_count())
+        .map(|i| desc.compile_style(i, "abc123").unwrap().code().to_string())
+        .collect();
+
+    // Loaded into a runtime on another thread.
+    let (js, css) = thread::spawn(move || {
+        let other = Compiler::new().expect("Compiler should initialize");
+        let buffer = DescriptorBuffer::new(&bytes).unwrap();
+        let loaded = other.load_descriptor(&buffer).unwrap();
+        assert_eq!(loaded.source(), SOURCE);
+        assert_eq!(loaded.style_count(), 2);
+        assert_eq!(loaded.custom_blocks_count(), 1);
+
+        let script = loaded.compile_script("abc123", false).unwrap();
+        let template = loaded.compile_template("abc123", Some(&script)).unwrap();
+        assert_eq!(template.error_count(), 0);
+        let css: Vec<String> = (0..loaded.style_count())
+            .map(|i| {
+                loaded
+                    .compile_style(i, "abc123")
+                    .unwrap()
+                    .code()
+                    .to_string()
+            })
+            .collect();
+        (format!("{}\n{}", script.content(), template.code()), css)
+    })
+    .join()
+    .unwrap();
+
+    assert_eq!(js, format!("{}\n{}", script.content(), template.code()));
+    assert_eq!(css, styles);
+}
+
+#[test]
+fn test_loaded_descriptor_serializes_to_the_same_bytes() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+    let buffer = desc.serialize().unwrap();
+
+    let loaded = compiler.load_descriptor(&buffer).unwrap();
+    assert_eq!(loaded.serialize().unwrap().as_bytes(), buffer.as_bytes());
+}
+
+#[test]
+fn test_malformed_descriptor_buffers_are_rejected() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+    let bytes = desc.serialize().unwrap().as_bytes().to_vec();
+
+    assert!(DescriptorBuffer::new(&[]).is_err());
+    assert!(DescriptorBuffer::new(&bytes[..bytes.len() - 1]).is_err());
+
+    let mut bad_magic = bytes.clone();
+    bad_magic[0] = b'X';
+    assert!(DescriptorBuffer::new(&bad_magic).is_err());
+
+    let mut bad_version = bytes.clone();
+    bad_version[4] = 0xFF;
+    assert!(DescriptorBuffer::new(&bad_version).is_err());
+
+    // The filename's str record points past the end.
+    let mut bad_offset = bytes.clone();
+    bad_offset[24..28].copy_from_slice(&u32::MAX.to_le_bytes());
+    assert!(DescriptorBuffer::new(&bad_offset).is_err());
+
+    // The native reader checks independently of the Rust one.
+    for malformed in [&bad_magic, &bad_version, &bad_offset] {
+        let handle = unsafe {
+            crate::ffi::vue_descriptor_deserialize(
+                compiler.runtime,
+                malformed.as_ptr(),
+                malformed.len(),
+            )
+        };
+        assert!(!handle.is_valid());
+    }
+}
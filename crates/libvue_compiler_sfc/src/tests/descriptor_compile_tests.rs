@@ -0,0 +1,75 @@
+//! Tests for compiling template and styles directly from a descriptor.
+
+use crate::Compiler;
+
+const SOURCE: &str = r#"<template>
+  <div class="app" @click="count++">{{ count }}</div>
+</template>
+
+<script setup>
+import { ref } from 'vue'
+const count = ref(0)
+</script>
+
+<style scoped>
+.app { color: red; }
+</style>
+
+<style>
+body { margin: 0; }
+</style>
+"#;
+
+#[test]
+fn test_descriptor_compile_template_matches_source_compile() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+    let script = desc.compile_script("abc123", false).unwrap();
+
+    let from_descriptor = desc.compile_template("abc123", Some(&script)).unwrap();
+    let from_source = compiler
+        .compile_template(
+            desc.template().unwrap().content(),
+            "App.vue",
+            "abc123",
+            desc.has_scoped_style(),
+            Some(&script),
+        )
+        .unwrap();
+
+    assert_eq!(from_descriptor.error_count(), 0);
+    assert_eq!(from_descriptor.code(), from_source.code());
+}
+
+#[test]
+fn test_descriptor_compile_style_matches_source_compile() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    for (index, style) in desc.styles().enumerate() {
+        let from_descriptor = desc.compile_style(index, "abc123").unwrap();
+        let from_source = compiler
+            .compile_style(style.content(), "App.vue", "abc123", style.is_scoped())
+            .unwrap();
+        assert_eq!(from_descriptor.code(), from_source.code());
+    }
+    assert!(desc
+        .compile_style(0, "abc123")
+        .unwrap()
+        .code()
+        .contains(".app[data-v-abc123]"));
+}
+
+#[test]
+fn test_descriptor_compile_missing_blocks() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler
+        .parse("<script>export default {}</script>", "App.vue")
+        .unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    assert!(desc.compile_template("abc123", None).is_err());
+    assert!(desc.compile_style(0, "abc123").is_err());
+}
@@ -0,0 +1,80 @@
+//! Tests for the persistent compile cache.
+
+use std::path::PathBuf;
+
+use crate::{CompileOptions, DiskCache, SfcInput};
+
+const SOURCE: &str = r#"<template><div class="a">{{ n }}</div></template>
+<script setup>
+const n = 1
+</script>
+<style scoped>
+.a { color: red; }
+</style>
+"#;
+
+/// A fresh cache directory under the system temp dir.
+fn cache_dir(name: &str) -> PathBuf {
+    let dir = std::env::temp_dir().join(format!("vue-sfc-{}-{}", name, std::process::id()));
+    let _ = std::fs::remove_dir_all(&dir);
+    dir
+}
+
+#[test]
+fn test_disk_cache_survives_reopen() {
+    let dir = cache_dir("reopen");
+    let inputs = [SfcInput::new(SOURCE, "App.vue", "abc")];
+    let options = CompileOptions::default();
+
+    let compiled = {
+        let cache = DiskCache::open(&dir).expect("Cache should open");
+        assert!(cache.get(&inputs[0], &options).is_none());
+        let outputs = cache.compile_batch(&inputs, &options, 1).unwrap();
+        assert_eq!(cache.len(), 1);
+        outputs[0].js().to_string()
+    };
+
+    // A new process would see the same file; reopening maps it again.
+    let cache = DiskCache::open(&dir).expect("Cache should reopen");
+    assert_eq!(cache.len(), 1);
+    let hit = cache
+        .get(&inputs[0], &options)
+        .expect("Entry should persist");
+    assert_eq!(hit.js(), compiled);
+    assert!(hit.css().contains(".a[data-v-abc]"));
+
+    // Options and id are part of the key.
+    let prod = CompileOptions {
+        is_prod: true,
+        ..CompileOptions::default()
+    };
+    assert!(cache.get(&inputs[0], &prod).is_none());
+    assert!(cache
+        .get(&SfcInput::new(SOURCE, "App.vue", "def"), &options)
+        .is_none());
+
+    let _ = std::fs::remove_dir_all(&dir);
+}
+
+#[test]
+fn test_disk_cache_rejects_corrupt_record() {
+    let dir = cache_dir("corrupt");
+    let input = SfcInput::new(SOURCE, "App.vue", "abc");
+    let options = CompileOptions::default();
+
+    {
+        let cache = DiskCache::open(&dir).expect("Cache should open");
+        cache.compile_batch(&[input], &options, 1).unwrap();
+    }
+
+    let file = dir.join(format!("vue-sfc-{}.cache", DiskCache::version()));
+    let mut bytes = std::fs::read(&file).expect("Cache file should exist");
+    let last = bytes.len() - 1;
+    bytes[last] ^= 0xff;
+    std::fs::write(&file, bytes).unwrap();
+
+    let cache = DiskCache::open(&dir).expect("Cache should reopen");
+    assert!(cache.get(&input, &options).is_none());
+
+    let _ = std::fs::remove_dir_all(&dir);
+}
@@ -0,0 +1,96 @@
+//! Tests for handle generations and handle scopes.
+
+use std::os::raw::c_char;
+
+use super::SOURCE;
+use crate::ffi;
+use crate::Compiler;
+
+/// Parses SOURCE through the raw FFI and returns the parse result handle.
+fn raw_parse(compiler: &Compiler) -> ffi::HermesHandle {
+    unsafe {
+        ffi::vue_parse(
+            compiler.runtime,
+            SOURCE.as_ptr() as *const c_char,
+            SOURCE.len(),
+            "App.vue".as_ptr() as *const c_char,
+            "App.vue".len(),
+            std::ptr::null(),
+        )
+    }
+}
+
+#[test]
+fn test_freed_handle_is_stale() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let rt = compiler.runtime;
+
+    let first = raw_parse(&compiler);
+    assert!(unsafe { ffi::hermes_handle_is_live(rt, first) });
+    unsafe { ffi::hermes_handle_free(rt, first) };
+    assert!(!unsafe { ffi::hermes_handle_is_live(rt, first) });
+
+    // The slot is reused under a new generation; the old handle stays dead.
+    let second = raw_parse(&compiler);
+    assert_ne!(first, second);
+    assert!(!unsafe { ffi::hermes_handle_is_live(rt, first) });
+    assert_eq!(unsafe { ffi::vue_parse_result_error_count(rt, first) }, 0);
+
+    // Double free of a stale handle is a no-op.
+    unsafe { ffi::hermes_handle_free(rt, first) };
+    assert!(unsafe { ffi::hermes_handle_is_live(rt, second) });
+    unsafe { ffi::hermes_handle_free(rt, second) };
+}
+
+#[test]
+fn test_scope_close_frees_nested_handles() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let rt = compiler.runtime;
+
+    let outside = raw_parse(&compiler);
+    let outer = unsafe { ffi::hermes_handle_scope_open(rt) };
+    let a = raw_parse(&compiler);
+    let inner = unsafe { ffi::hermes_handle_scope_open(rt) };
+    let b = raw_parse(&compiler);
+    let descriptor = unsafe { ffi::vue_parse_result_descriptor(rt, b) };
+    assert!(outer.is_valid() && inner.is_valid());
+
+    // Closing the outer scope closes the inner one too.
+    unsafe { ffi::hermes_handle_scope_close(rt, outer) };
+    for handle in [a, b, descriptor] {
+        assert!(!unsafe { ffi::hermes_handle_is_live(rt, handle) });
+    }
+    assert!(unsafe { ffi::hermes_handle_is_live(rt, outside) });
+
+    // Closing an already closed scope is a no-op.
+    unsafe { ffi::hermes_handle_scope_close(rt, inner) };
+    assert!(unsafe { ffi::hermes_handle_is_live(rt, outside) });
+    unsafe { ffi::hermes_handle_free(rt, outside) };
+}
+
+#[test]
+fn test_with_handle_scope() {
+    let mut compiler = Compiler::new().expect("Compiler should initialize");
+
+    let content = compiler.with_handle_scope(|c| {
+        let parsed = c.parse(SOURCE, "App.vue").unwrap();
+        let desc = parsed.descriptor().unwrap();
+        let script = desc.compile_script("abc123", false).unwrap();
+        let template = c
+            .compile_template(
+                "<div>{{ msg }}</div>",
+                "App.vue",
+                "abc123",
+                false,
+                Some(&script),
+            )
+            .unwrap();
+        assert!(!template.code().is_empty());
+        script.content().to_string()
+    });
+    assert!(content.contains("msg"));
+
+    // The compiler stays usable after the scope.
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    assert!(!parsed.has_errors());
+}
@@ -0,0 +1,104 @@
+//! Tests for incremental SFC recompilation.
+
+use crate::{CompileOptions, Compiler, DirtyParts};
+
+fn component(template: &str, script: &str, style: &str) -> String {
+    format!(
+        "<template>{template}</template>\n\
+         <script setup>{script}</script>\n\
+         <style scoped>{style}</style>\n"
+    )
+}
+
+#[test]
+fn test_incremental_reports_changed_parts() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let options = CompileOptions::default();
+    let v1 = component(
+        "<div class=\"a\">{{ n }}</div>",
+        "const n = 1",
+        ".a { color: red; }",
+    );
+
+    let first = compiler
+        .compile_sfc_incremental(None, &v1, "App.vue", "abc", &options)
+        .unwrap();
+    assert_eq!(first.dirty(), DirtyParts::ALL);
+
+    let same = compiler
+        .compile_sfc_incremental(Some(&first), &v1, "App.vue", "abc", &options)
+        .unwrap();
+    assert!(same.dirty().is_clean());
+    assert_eq!(same.js(), first.js());
+
+    let v2 = component(
+        "<div class=\"a\">{{ n }}</div>",
+        "const n = 1",
+        ".a { color: blue; }",
+    );
+    let style_edit = compiler
+        .compile_sfc_incremental(Some(&same), &v2, "App.vue", "abc", &options)
+        .unwrap();
+    assert!(style_edit.dirty().is_style_only());
+    assert!(style_edit.css().contains("blue"));
+
+    let v3 = component(
+        "<p class=\"a\">{{ n }}</p>",
+        "const n = 1",
+        ".a { color: blue; }",
+    );
+    let template_edit = compiler
+        .compile_sfc_incremental(Some(&style_edit), &v3, "App.vue", "abc", &options)
+        .unwrap();
+    assert!(template_edit.dirty().is_template_only());
+    assert!(template_edit.js().contains(template_edit.render()));
+
+    let v4 = component(
+        "<p class=\"a\">{{ n }}</p>",
+        "const n = 2",
+        ".a { color: blue; }",
+    );
+    let script_edit = compiler
+        .compile_sfc_incremental(Some(&template_edit), &v4, "App.vue", "abc", &options)
+        .unwrap();
+    assert!(script_edit.dirty().script());
+    assert!(!script_edit.dirty().style());
+}
+
+#[test]
+fn test_incremental_matches_full_compile() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let options = CompileOptions::default();
+    let v1 = component("<div>{{ n }}</div>", "const n = 1", "div { color: red; }");
+    let v2 = component("<span>{{ n }}</span>", "const n = 1", "div { color: red; }");
+
+    let first = compiler
+        .compile_sfc_incremental(None, &v1, "App.vue", "abc", &options)
+        .unwrap();
+    let next = compiler
+        .compile_sfc_incremental(Some(&first), &v2, "App.vue", "abc", &options)
+        .unwrap();
+    let full = compiler
+        .compile_sfc(&v2, "App.vue", "abc", &options)
+        .unwrap();
+
+    assert_eq!(next.js(), full.js());
+    assert_eq!(next.css(), full.css());
+    assert_eq!(full.dirty(), DirtyParts::ALL);
+}
+
+#[test]
+fn test_incremental_ignores_previous_of_other_component() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let options = CompileOptions::default();
+    let source = component("<div>{{ n }}</div>", "const n = 1", "div { color: red; }");
+
+    let first = compiler
+        .compile_sfc_incremental(None, &source, "App.vue", "abc", &options)
+        .unwrap();
+    let other = compiler
+        .compile_sfc_incremental(Some(&first), &source, "App.vue", "def", &options)
+        .unwrap();
+    assert_eq!(other.dirty(), DirtyParts::ALL);
+    assert!(other.css().contains("[data-v-def]"));
+}
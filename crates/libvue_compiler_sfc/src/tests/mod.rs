@@ -1,4 +1,41 @@
 //! Test modules for Vue SFC compiler.
 
+mod borrowed_parse_tests;
+mod bulk_accessor_tests;
+mod compile_options_tests;
+mod compiler_units_tests;
+mod dependency_scan_tests;
+mod descriptor_buffer_tests;
+mod descriptor_compile_tests;
+mod disk_cache_tests;
 mod generated;
+mod handle_scope_tests;
+mod incremental_tests;
+mod native_style_tests;
+mod output_sink_tests;
+mod pipeline_tests;
+mod pool_tests;
+mod profiling_tests;
+mod runtime_memory_tests;
+mod runtime_stats_tests;
+mod scan_tests;
 mod snapshot_tests;
+mod string_cache_tests;
+
+/// A minimal `<script setup>` component, for tests of the runtime and FFI
+/// layers rather than of compiler output.
+const SOURCE: &str = r#"<template><div>{{ msg }}</div></template>
+<script setup>
+const msg = 'hi'
+</script>
+"#;
+
+/// [`SOURCE`] with a scoped style block.
+const STYLED_SOURCE: &str = r#"<template><div>{{ msg }}</div></template>
+<script setup>
+const msg = 'hi'
+</script>
+<style scoped>
+div { color: red; }
+</style>
+"#;
@@ -0,0 +1,138 @@
+//! Differential tests for the native style rewriter against the JS compiler.
+
+use crate::{CompileOptions, Compiler};
+
+/// Plain CSS the native rewriter handles.
+const HANDLED: &[&str] = &[
+    "",
+    "\n",
+    ".a { color: red; }",
+    ".a{color:red}",
+    "\n\n.a {\n  color: red;\n  margin: 0 auto !important\n}\n\n\n.b { }\n",
+    ".a, .b,\n.c > p + span ~ em { top: 0 }",
+    "div.a#main[data-x=\"y]\"] .b:hover::before { content: 'a;b' }",
+    "ul li:nth-child(2n + 1):not(.skip) a:focus-visible { outline: none; }",
+    ":root { --gap: 4px; }\n::selection { color: blue }",
+    ".a { background: url(data:image/png;base64,AAAA) no-repeat; }",
+    "/* header */\n.a { /* inside */ color: red; /* last */ }\n/* footer */\n",
+    "@charset \"utf-8\";\n@import url(\"base.css\") screen;\n.a { color: red }",
+    "@media (max-width: 600px) {\n  .a { color: red; }\n  .b .c { color: blue }\n}\n",
+    "@supports (display: grid) { @media print { .a { display: grid } } }",
+    "@layer base, theme;\n@layer base {\n  h1 { margin: 0 }\n}",
+    "@font-face {\n  font-family: Foo;\n  src: url(foo.woff2) format('woff2');\n}\n.a { font-family: Foo }",
+    ".a { color: v-bind(color); }",
+    ".a { width: v-bind('size.width'); height: calc(v-bind(\"h\") * 2) }",
+    ".a { margin: v-bind( gap ) v-bind(theme.spacing[0]); }",
+    ".a { --x: v-bind(color); }",
+];
+
+/// Plain CSS the native rewriter leaves to the JS compiler.
+const FALLBACK: &[&str] = &[
+    ".a :deep(.b) { color: red }",
+    ":slotted(.b) { color: red }",
+    ":global(.b) { color: red }",
+    ".a ::v-deep(.b) { color: red }",
+    ".a >>> .b { color: red }",
+    "* { box-sizing: border-box }",
+    ".a :is(.b, .c) { color: red }",
+    "@keyframes spin { from { opacity: 0 } to { opacity: 1 } }\n.a { animation: spin 1s }",
+    ".a { .b { color: red } }",
+    ".a /* note */ { color: red }",
+    ".a\\:hover { color: red }",
+    ".a { color: v-bind(color) ; }",
+    ".a { --x: v-bind(color) }",
+];
+
+fn options(native_style: bool, is_prod: bool) -> CompileOptions {
+    CompileOptions {
+        native_style,
+        is_prod,
+        ..CompileOptions::default()
+    }
+}
+
+fn assert_same_as_js(compiler: &Compiler, css: &str, id: &str, scoped: bool, is_prod: bool) {
+    let js = compiler
+        .compile_style_with_options(css, "App.vue", id, scoped, &options(false, is_prod))
+        .unwrap();
+    let native = compiler
+        .compile_style_with_options(css, "App.vue", id, scoped, &options(true, is_prod))
+        .unwrap();
+    assert_eq!(
+        native.code(),
+        js.code(),
+        "scoped={scoped} is_prod={is_prod} id={id:?} css={css:?}"
+    );
+}
+
+#[test]
+fn test_native_style_matches_js() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    for css in HANDLED.iter().chain(FALLBACK) {
+        for scoped in [true, false] {
+            assert_same_as_js(&compiler, css, "abc123", scoped, false);
+        }
+        assert_same_as_js(&compiler, css, "data-v-abc123", true, false);
+    }
+}
+
+#[test]
+fn test_native_style_falls_back_in_production() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    for css in HANDLED {
+        assert_same_as_js(&compiler, css, "abc123", true, true);
+    }
+
+    // Production hashes v-bind() names, which only the JS compiler does.
+    let output = compiler
+        .compile_style_with_options(
+            ".a { color: v-bind(color); }",
+            "App.vue",
+            "abc123",
+            true,
+            &options(true, true),
+        )
+        .unwrap();
+    assert!(!output.code().contains("--abc123-color"));
+}
+
+#[test]
+fn test_native_style_rewrites_scoped_css() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let output = compiler
+        .compile_style_with_options(
+            ".a, .b:hover { color: v-bind(color); }",
+            "App.vue",
+            "abc123",
+            true,
+            &options(true, false),
+        )
+        .unwrap();
+    assert_eq!(
+        output.code(),
+        ".a[data-v-abc123], .b[data-v-abc123]:hover { color: var(--abc123-color);\n}"
+    );
+}
+
+#[test]
+fn test_native_style_from_descriptor_matches_js() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let mut source = String::from("<template><div class=\"a\"></div></template>\n");
+    for css in HANDLED.iter().chain(FALLBACK) {
+        source.push_str(&format!("<style scoped>\n{css}\n</style>\n"));
+        source.push_str(&format!("<style>\n{css}\n</style>\n"));
+    }
+    source.push_str("<style scoped lang=\"scss\">\n.a { .b { color: red } }\n</style>\n");
+
+    let parsed = compiler.parse(&source, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+    for index in 0..desc.style_count() {
+        let js = desc
+            .compile_style_with_options(index, "abc123", &options(false, false))
+            .unwrap();
+        let native = desc
+            .compile_style_with_options(index, "abc123", &options(true, false))
+            .unwrap();
+        assert_eq!(native.code(), js.code(), "style block {index}");
+    }
+}
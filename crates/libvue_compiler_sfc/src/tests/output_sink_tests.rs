@@ -0,0 +1,170 @@
+//! Tests for the copy and write variants of the compiled code accessors.
+
+use std::ffi::CStr;
+use std::io::{self, Write};
+
+use crate::ffi;
+use crate::{CompileOptions, Compiler};
+
+const SOURCE: &str = r#"<template>
+  <p class="note">日本語 😀 {{ msg }}</p>
+</template>
+
+<script setup>
+const msg = 'naïve'
+</script>
+
+<style scoped>
+.note::before { content: "→"; }
+</style>
+"#;
+
+/// Accepts `limit` bytes, then fails.
+struct FailingWriter {
+    limit: usize,
+    written: Vec<u8>,
+}
+
+impl Write for FailingWriter {
+    fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+        if self.written.len() + buf.len() > self.limit {
+            return Err(io::Error::other("full"));
+        }
+        self.written.extend_from_slice(buf);
+        Ok(buf.len())
+    }
+
+    fn flush(&mut self) -> io::Result<()> {
+        Ok(())
+    }
+}
+
+#[test]
+fn test_write_variants_match_getters() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    let script = desc.compile_script("abc", false).unwrap();
+    let mut out = Vec::new();
+    assert_eq!(script.write_content(&mut out).unwrap(), out.len());
+    assert_eq!(out, script.content().as_bytes());
+
+    let template = desc.compile_template("abc", Some(&script)).unwrap();
+    let mut out = Vec::new();
+    template.write_code(&mut out).unwrap();
+    assert_eq!(out, template.code().as_bytes());
+
+    let style = desc.compile_style(0, "abc").unwrap();
+    let mut out = Vec::new();
+    style.write_code(&mut out).unwrap();
+    assert_eq!(out, style.code().as_bytes());
+
+    let output = compiler
+        .compile_sfc(SOURCE, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+    let (mut js, mut css) = (Vec::new(), Vec::new());
+    output.write_js(&mut js).unwrap();
+    output.write_css(&mut css).unwrap();
+    assert_eq!(js, output.js().as_bytes());
+    assert_eq!(css, output.css().as_bytes());
+    assert!(output.js().contains("日本語 😀"));
+}
+
+#[test]
+fn test_write_stops_at_first_error() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let output = compiler
+        .compile_sfc(SOURCE, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+
+    let mut writer = FailingWriter {
+        limit: 0,
+        written: Vec::new(),
+    };
+    let err = output.write_js(&mut writer).unwrap_err();
+    assert_eq!(err.to_string(), "full");
+    assert!(writer.written.is_empty());
+}
+
+#[test]
+fn test_copy_queries_length_and_truncates() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let output = compiler
+        .compile_sfc(SOURCE, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+    let (rt, handle) = (compiler.runtime, output.raw());
+    let expected = output.css().as_bytes();
+
+    let len = unsafe { ffi::vue_sfc_result_css_copy(rt, handle, std::ptr::null_mut(), 0) };
+    assert_eq!(len, expected.len());
+
+    let mut short = vec![0u8; 4];
+    let len = unsafe { ffi::vue_sfc_result_css_copy(rt, handle, short.as_mut_ptr().cast(), 4) };
+    assert_eq!(len, expected.len());
+    assert_eq!(short, &expected[..4]);
+
+    let mut full = vec![0u8; len];
+    let copied = unsafe { ffi::vue_sfc_result_css_copy(rt, handle, full.as_mut_ptr().cast(), len) };
+    assert_eq!(copied, len);
+    assert_eq!(full, expected);
+
+    assert_eq!(
+        unsafe {
+            ffi::vue_sfc_result_css_copy(
+                rt,
+                ffi::HermesHandle::INVALID,
+                full.as_mut_ptr().cast(),
+                len,
+            )
+        },
+        0
+    );
+}
+
+#[test]
+fn test_copy_encodes_lone_surrogate_at_block_boundary() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let rt = compiler.runtime;
+
+    // Hermes decodes CESU-8 U+D800 (not UTF-8, hence the raw FFI) to a lone
+    // high surrogate in the JS heap; the U+4E00 after it is the widest character that can follow one. Sliding
+    // the pair across the 4096-byte encode block covers every alignment.
+    for pad in 4080..4100 {
+        let mut css = b"a { content: \"".to_vec();
+        css.resize(css.len() + pad, b'x');
+        css.extend_from_slice(b"\xED\xA0\x80\xE4\xB8\x80\"; }");
+
+        let handle = unsafe {
+            ffi::vue_compile_style(
+                rt,
+                css.as_ptr().cast(),
+                css.len(),
+                "App.vue".as_ptr().cast(),
+                "App.vue".len(),
+                "abc".as_ptr().cast(),
+                "abc".len(),
+                false,
+                std::ptr::null(),
+            )
+        };
+        assert!(handle.is_valid(), "{pad}");
+
+        let expected = unsafe { CStr::from_ptr(ffi::vue_style_result_code(rt, handle)) }
+            .to_bytes()
+            .to_vec();
+        assert!(
+            std::str::from_utf8(&expected)
+                .unwrap()
+                .contains("\u{FFFD}\u{4E00}"),
+            "{pad}"
+        );
+
+        let len = unsafe { ffi::vue_style_result_code_copy(rt, handle, std::ptr::null_mut(), 0) };
+        let mut copied = vec![0u8; len];
+        unsafe { ffi::vue_style_result_code_copy(rt, handle, copied.as_mut_ptr().cast(), len) };
+        assert_eq!(copied, expected, "{pad}");
+
+        unsafe { ffi::hermes_handle_free(rt, handle) };
+    }
+}
@@ -0,0 +1,157 @@
+//! Tests for the single-call SFC pipeline.
+
+use crate::{CompileOptions, Compiler, SfcInput};
+
+const SOURCE: &str = r#"<template>
+  <div class="app">{{ count }}</div>
+</template>
+
+<script setup>
+import { ref } from 'vue'
+const count = ref(0)
+</script>
+
+<style scoped>
+.app { color: red; }
+</style>
+"#;
+
+#[test]
+fn test_compile_sfc_produces_js_and_css() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let output = compiler
+        .compile_sfc(SOURCE, "App.vue", "abc123", &CompileOptions::default())
+        .expect("compile_sfc should succeed");
+
+    assert!(
+        !output.has_errors(),
+        "Errors: {:?}",
+        output.errors().collect::<Vec<_>>()
+    );
+    assert!(output.js().contains("setup"));
+    assert!(output.js().contains("function render"));
+    assert!(output.css().contains(".app[data-v-abc123]"));
+}
+
+#[test]
+fn test_compile_sfc_matches_step_by_step() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let output = compiler
+        .compile_sfc(SOURCE, "App.vue", "abc123", &CompileOptions::default())
+        .expect("compile_sfc should succeed");
+
+    let parsed = compiler.parse(SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+    let script = desc.compile_script("abc123", false).unwrap();
+    let template = compiler
+        .compile_template(
+            desc.template().unwrap().content(),
+            "App.vue",
+            "abc123",
+            desc.has_scoped_style(),
+            Some(&script),
+        )
+        .unwrap();
+    let style = compiler
+        .compile_style(
+            desc.styles().next().unwrap().content(),
+            "App.vue",
+            "abc123",
+            true,
+        )
+        .unwrap();
+
+    assert_eq!(
+        output.js(),
+        format!("{}\n{}", script.content(), template.code())
+    );
+    assert_eq!(output.css(), style.code());
+}
+
+#[test]
+fn test_compile_sfc_reports_parse_errors() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let output = compiler
+        .compile_sfc(
+            "import { ref } from 'vue'",
+            "Broken.vue",
+            "abc123",
+            &CompileOptions::default(),
+        )
+        .expect("compile_sfc should return a result");
+
+    assert!(output.has_errors());
+    assert!(output.js().is_empty());
+}
+
+#[test]
+fn test_compile_batch_matches_compile_sfc() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let broken = "<template><div></template>";
+    let inputs = [
+        SfcInput::new(SOURCE, "App.vue", "abc123"),
+        SfcInput::new(broken, "Broken.vue", "def456"),
+        SfcInput::new(SOURCE, "Other.vue", "ghi789"),
+    ];
+
+    let outputs = compiler
+        .compile_batch(&inputs, &CompileOptions::default())
+        .expect("compile_batch should succeed");
+    assert_eq!(outputs.len(), inputs.len());
+
+    for (input, output) in inputs.iter().zip(&outputs) {
+        let single = compiler
+            .compile_sfc(
+                input.source,
+                input.filename,
+                input.id,
+                &CompileOptions::default(),
+            )
+            .unwrap();
+        assert_eq!(output.js(), single.js());
+        assert_eq!(output.css(), single.css());
+        assert_eq!(output.has_errors(), single.has_errors());
+    }
+    assert!(outputs[1].has_errors());
+    assert!(outputs[2].css().contains("[data-v-ghi789]"));
+}
+
+#[test]
+fn test_compile_batch_empty() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let outputs = compiler
+        .compile_batch(&[], &CompileOptions::default())
+        .unwrap();
+    assert!(outputs.is_empty());
+}
+
+#[test]
+fn test_compile_sfc_round_trips_non_ascii() {
+    // Latin-1, BMP and astral characters, after a long ASCII prefix so the
+    // first non-ASCII byte falls past the vectorized part of the scan.
+    let padding = "<!-- padding -->\n".repeat(16);
+    let source = format!(
+        "{padding}<template>\n  <p title=\"café\">日本語 😀 {{{{ msg }}}}</p>\n</template>\n\n\
+         <script setup>\nconst msg = 'naïve 🚀'\n</script>\n\n\
+         <style>\n.note::before {{ content: \"→\"; }}\n</style>\n"
+    );
+    let compiler = Compiler::new().expect("Compiler should initialize");
+
+    let parsed = compiler.parse(&source, "Ünicode.vue").expect("parse");
+    let desc = parsed.descriptor().expect("descriptor");
+    assert_eq!(desc.source(), source);
+    assert_eq!(desc.filename(), "Ünicode.vue");
+
+    let output = compiler
+        .compile_sfc(&source, "Ünicode.vue", "abc123", &CompileOptions::default())
+        .expect("compile_sfc should succeed");
+    assert!(
+        !output.has_errors(),
+        "Errors: {:?}",
+        output.errors().collect::<Vec<_>>()
+    );
+    assert!(output.js().contains("naïve 🚀"));
+    assert!(output.js().contains("日本語 😀"));
+    assert!(output.js().contains("café"));
+    assert!(output.css().contains("content: \"→\""));
+}
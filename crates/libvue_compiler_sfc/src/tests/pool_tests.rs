@@ -0,0 +1,291 @@
+//! Tests for the compiler pool.
+
+use crate::ffi;
+use crate::{CompileOptions, Compiler, CompilerPool, SfcInput};
+use std::future::Future;
+use std::pin::pin;
+use std::sync::Arc;
+use std::task::{Context, Poll, Wake};
+use std::thread::{self, Thread};
+use std::time::{Duration, Instant};
+
+fn component(i: usize) -> String {
+    format!(
+        "<template>\n  <div class=\"c{i}\">{{{{ n }}}}</div>\n</template>\n\n\
+         <script setup>\nconst n = {i}\n</script>\n\n\
+         <style scoped>\n.c{i} {{ order: {i}; }}\n</style>\n"
+    )
+}
+
+/// Wakes a thread parked in `block_on`.
+struct ThreadWaker(Thread);
+
+impl Wake for ThreadWaker {
+    fn wake(self: Arc<Self>) {
+        self.0.unpark();
+    }
+}
+
+/// Minimal executor: polls `future` on the current thread until it is ready.
+fn block_on<F: Future>(future: F) -> F::Output {
+    let waker = Arc::new(ThreadWaker(thread::current())).into();
+    let mut cx = Context::from_waker(&waker);
+    let mut future = pin!(future);
+    loop {
+        if let Poll::Ready(output) = future.as_mut().poll(&mut cx) {
+            return output;
+        }
+        thread::park();
+    }
+}
+
+#[test]
+fn test_pool_batch_preserves_input_order() {
+    let pool = CompilerPool::new(3).expect("Pool should initialize");
+    assert_eq!(pool.worker_count(), 3);
+
+    let sources: Vec<String> = (0..32).map(component).collect();
+    let ids: Vec<String> = (0..32).map(|i| format!("id{i}")).collect();
+    let inputs: Vec<SfcInput> = sources
+        .iter()
+        .zip(&ids)
+        .map(|(source, id)| SfcInput::new(source, "App.vue", id))
+        .collect();
+
+    let outputs = pool
+        .compile_batch(&inputs, &CompileOptions::default())
+        .expect("compile_batch should succeed");
+
+    assert_eq!(outputs.len(), inputs.len());
+    for (i, output) in outputs.iter().enumerate() {
+        assert!(
+            !output.has_errors(),
+            "Errors: {:?}",
+            output.errors().collect::<Vec<_>>()
+        );
+        assert!(output.css().contains(&format!(".c{i}[data-v-id{i}]")));
+    }
+}
+
+#[test]
+fn test_pool_matches_compiler() {
+    let source = component(7);
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let expected = compiler
+        .compile_sfc(&source, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+
+    let pool = CompilerPool::new(2).expect("Pool should initialize");
+    let outputs = pool
+        .compile_batch(
+            &[SfcInput::new(&source, "App.vue", "abc")],
+            &CompileOptions::default(),
+        )
+        .unwrap();
+
+    assert_eq!(outputs[0].js(), expected.js());
+    assert_eq!(outputs[0].css(), expected.css());
+}
+
+#[test]
+fn test_pool_shared_across_threads() {
+    let pool = CompilerPool::new(2).expect("Pool should initialize");
+    let source = component(1);
+
+    std::thread::scope(|scope| {
+        for _ in 0..4 {
+            scope.spawn(|| {
+                let outputs = pool
+                    .compile_batch(
+                        &[SfcInput::new(&source, "App.vue", "abc")],
+                        &CompileOptions::default(),
+                    )
+                    .unwrap();
+                assert!(!outputs[0].has_errors());
+            });
+        }
+    });
+}
+
+#[test]
+fn test_pool_empty_batch() {
+    let pool = CompilerPool::new(1).expect("Pool should initialize");
+    let outputs = pool.compile_batch(&[], &CompileOptions::default()).unwrap();
+    assert!(outputs.is_empty());
+}
+
+#[test]
+fn test_pool_cache_hits_unchanged_inputs() {
+    let pool = CompilerPool::new(2).expect("Pool should initialize");
+    pool.set_cache_limits(16, 0);
+
+    let source = component(3);
+    let inputs = [SfcInput::new(&source, "App.vue", "abc")];
+    let first = pool
+        .compile_batch(&inputs, &CompileOptions::default())
+        .unwrap();
+    let second = pool
+        .compile_batch(&inputs, &CompileOptions::default())
+        .unwrap();
+
+    assert_eq!(first[0].js(), second[0].js());
+    assert_eq!(first[0].css(), second[0].css());
+    let stats = pool.cache_stats();
+    assert_eq!((stats.hits, stats.misses, stats.entries), (1, 1, 1));
+
+    // A different id or options is a different key.
+    pool.compile_batch(
+        &[SfcInput::new(&source, "App.vue", "def")],
+        &CompileOptions::default(),
+    )
+    .unwrap();
+    let prod = CompileOptions {
+        is_prod: true,
+        ..CompileOptions::default()
+    };
+    pool.compile_batch(&inputs, &prod).unwrap();
+    assert_eq!(pool.cache_stats().misses, 3);
+}
+
+#[test]
+fn test_pool_cache_evicts_least_recently_used() {
+    let pool = CompilerPool::new(1).expect("Pool should initialize");
+    pool.set_cache_limits(2, 0);
+
+    let sources: Vec<String> = (0..3).map(component).collect();
+    for source in &sources {
+        pool.compile_batch(
+            &[SfcInput::new(source, "App.vue", "abc")],
+            &CompileOptions::default(),
+        )
+        .unwrap();
+    }
+    let stats = pool.cache_stats();
+    assert_eq!((stats.entries, stats.evictions), (2, 1));
+
+    // The oldest input was evicted; the newest is still cached.
+    pool.compile_batch(
+        &[SfcInput::new(&sources[2], "App.vue", "abc")],
+        &CompileOptions::default(),
+    )
+    .unwrap();
+    pool.compile_batch(
+        &[SfcInput::new(&sources[0], "App.vue", "abc")],
+        &CompileOptions::default(),
+    )
+    .unwrap();
+    let stats = pool.cache_stats();
+    assert_eq!((stats.hits, stats.misses), (1, 4));
+
+    pool.set_cache_limits(0, 0);
+    assert_eq!(pool.cache_stats().entries, 0);
+}
+
+#[test]
+fn test_pool_submit_resolves_futures() {
+    let pool = CompilerPool::new(2).expect("Pool should initialize");
+    let sources: Vec<String> = (0..8).map(component).collect();
+    let ids: Vec<String> = (0..8).map(|i| format!("id{i}")).collect();
+
+    let jobs: Vec<_> = sources
+        .iter()
+        .zip(&ids)
+        .map(|(source, id)| {
+            pool.submit(
+                &SfcInput::new(source, "App.vue", id),
+                &CompileOptions::default(),
+            )
+            .expect("submit should succeed")
+        })
+        .collect();
+    // The inputs are copied on submission.
+    drop(sources);
+
+    let mut tickets: Vec<u64> = jobs.iter().map(|job| job.ticket()).collect();
+    tickets.dedup();
+    assert_eq!(tickets.len(), jobs.len());
+    assert!(tickets.iter().all(|&ticket| ticket != 0));
+
+    for (i, job) in jobs.into_iter().enumerate() {
+        let output = block_on(job);
+        assert!(
+            !output.has_errors(),
+            "Errors: {:?}",
+            output.errors().collect::<Vec<_>>()
+        );
+        assert!(output.css().contains(&format!(".c{i}[data-v-id{i}]")));
+    }
+}
+
+#[test]
+fn test_pool_submit_matches_batch() {
+    let source = component(3);
+    let input = SfcInput::new(&source, "App.vue", "abc");
+    let pool = CompilerPool::new(1).expect("Pool should initialize");
+
+    let expected = pool
+        .compile_batch(&[input], &CompileOptions::default())
+        .unwrap();
+    let job = pool.submit(&input, &CompileOptions::default()).unwrap();
+    let output = block_on(job);
+
+    assert_eq!(output.js(), expected[0].js());
+    assert_eq!(output.css(), expected[0].css());
+}
+
+#[test]
+fn test_pool_drop_completes_pending_jobs() {
+    let source = component(5);
+    let pool = CompilerPool::new(1).expect("Pool should initialize");
+    let kept = pool
+        .submit(
+            &SfcInput::new(&source, "App.vue", "abc"),
+            &CompileOptions::default(),
+        )
+        .unwrap();
+    // A dropped job must not leak or crash when it completes.
+    drop(
+        pool.submit(
+            &SfcInput::new(&source, "App.vue", "def"),
+            &CompileOptions::default(),
+        )
+        .unwrap(),
+    );
+    drop(pool);
+
+    assert!(kept.is_finished());
+    assert!(!block_on(kept).has_errors());
+}
+
+#[test]
+fn test_pool_completion_queue_without_callback() {
+    let pool = CompilerPool::new(2).expect("Pool should initialize");
+    let fd = unsafe { ffi::vue_pool_completion_fd(pool.as_raw()) };
+    assert!(fd >= 0);
+
+    let source = component(2);
+    let input = SfcInput::new(&source, "App.vue", "abc").to_ffi();
+    let options = CompileOptions::default().to_ffi();
+    let mut pending: Vec<u64> = (0..4)
+        .map(|_| unsafe {
+            ffi::vue_pool_submit(pool.as_raw(), &input, &options, None, std::ptr::null_mut())
+        })
+        .collect();
+
+    let deadline = Instant::now() + Duration::from_secs(30);
+    while !pending.is_empty() {
+        let mut ticket = 0;
+        let raw = unsafe { ffi::vue_pool_take_completed(pool.as_raw(), &mut ticket) };
+        if raw.is_null() {
+            assert!(Instant::now() < deadline, "jobs did not complete");
+            thread::sleep(Duration::from_millis(1));
+            continue;
+        }
+        let output = crate::CompiledSfc::from_raw(raw);
+        assert!(!output.has_errors());
+        pending.retain(|&t| t != ticket);
+    }
+
+    let mut ticket = 0;
+    assert!(unsafe { ffi::vue_pool_take_completed(pool.as_raw(), &mut ticket) }.is_null());
+}
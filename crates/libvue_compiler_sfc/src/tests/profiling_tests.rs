@@ -0,0 +1,91 @@
+//! Tests for runtime profiling and Chrome trace export.
+
+use serde_json::Value;
+
+use super::STYLED_SOURCE;
+use crate::{CompileOptions, Compiler};
+
+fn span_names(trace: &Value) -> Vec<&str> {
+    trace["traceEvents"]
+        .as_array()
+        .unwrap()
+        .iter()
+        .filter(|event| event["ph"] == "X")
+        .map(|event| event["name"].as_str().unwrap())
+        .collect()
+}
+
+#[test]
+fn test_profile_records_ffi_spans() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    compiler.start_profiling(0.0).unwrap();
+
+    let output = compiler
+        .compile_sfc(STYLED_SOURCE, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+    assert!(!output.js().is_empty());
+
+    let trace: Value = serde_json::from_str(&compiler.stop_profiling().unwrap()).unwrap();
+    let names = span_names(&trace);
+    assert!(names.contains(&"vue_compile_sfc"));
+    assert!(names.contains(&"vue_sfc_result_js"));
+    assert_eq!(trace["otherData"]["droppedSpans"], 0);
+
+    // Spans are complete events with a start and a duration.
+    let span = trace["traceEvents"]
+        .as_array()
+        .unwrap()
+        .iter()
+        .find(|event| event["name"] == "vue_compile_sfc")
+        .unwrap();
+    assert!(span["ts"].as_f64().unwrap() > 0.0);
+    assert!(span["dur"].as_f64().unwrap() > 0.0);
+}
+
+#[test]
+fn test_profile_only_records_while_started() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    assert!(compiler.stop_profiling().is_err());
+
+    compiler.parse(STYLED_SOURCE, "Before.vue").unwrap();
+    compiler.start_profiling(0.0).unwrap();
+    assert!(compiler.start_profiling(0.0).is_err());
+    compiler.parse(STYLED_SOURCE, "During.vue").unwrap();
+    let trace: Value = serde_json::from_str(&compiler.stop_profiling().unwrap()).unwrap();
+    compiler.parse(STYLED_SOURCE, "After.vue").unwrap();
+
+    let parses = span_names(&trace)
+        .into_iter()
+        .filter(|name| *name == "vue_parse")
+        .count();
+    assert_eq!(parses, 1);
+    assert!(compiler.stop_profiling().is_err());
+}
+
+#[test]
+fn test_profile_embeds_js_samples() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    if compiler.start_profiling(1000.0).is_err() {
+        // Hermes built without the sampling profiler
+        return;
+    }
+    for i in 0..20 {
+        let filename = format!("App{i}.vue");
+        compiler
+            .compile_sfc(STYLED_SOURCE, &filename, "abc", &CompileOptions::default())
+            .unwrap();
+    }
+
+    let trace: Value = serde_json::from_str(&compiler.stop_profiling().unwrap()).unwrap();
+    let profile = trace["traceEvents"]
+        .as_array()
+        .unwrap()
+        .iter()
+        .find(|event| event["name"] == "CpuProfile")
+        .expect("trace should embed the sampled profile");
+    assert!(profile["args"]["data"]["cpuProfile"]["nodes"].is_array());
+
+    // Sampling can start again once the previous profile stopped.
+    compiler.start_profiling(1000.0).unwrap();
+    compiler.stop_profiling().unwrap();
+}
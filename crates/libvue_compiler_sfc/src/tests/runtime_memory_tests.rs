@@ -0,0 +1,181 @@
+//! Tests for runtime configuration, GC control and recycling.
+
+use super::SOURCE;
+use crate::ffi;
+use crate::{CompileOptions, Compiler, CompilerPool, ProcessOptions, RuntimeOptions, SfcInput};
+
+#[test]
+fn test_collect_garbage_updates_heap_stats() {
+    let compiler =
+        Compiler::with_options(&RuntimeOptions::default()).expect("Compiler should initialize");
+    for _ in 0..8 {
+        let output = compiler
+            .compile_sfc(SOURCE, "App.vue", "abc", &CompileOptions::default())
+            .unwrap();
+        assert!(!output.has_errors());
+    }
+
+    let before = compiler.heap_stats();
+    assert!(before.heap_size > 0);
+    assert!(before.total_allocated_bytes > 0);
+    assert_eq!(before.explicit_gc_count, 0);
+
+    compiler.collect_garbage();
+    let after = compiler.heap_stats();
+    assert_eq!(after.explicit_gc_count, 1);
+    assert!(after.gc_count > before.gc_count);
+    assert!(after.total_gc_pause_ms >= after.last_gc_pause_ms);
+}
+
+/// Heap cap of the [`test_max_heap_child`] process.
+const HEAP_CAP: usize = 64 * 1024 * 1024;
+
+/// Set in the environment of the process [`test_max_heap_applies_to_every_runtime`]
+/// spawns.
+const HEAP_CAP_CHILD: &str = "VUERS_HEAP_CAP_CHILD";
+
+#[test]
+fn test_max_heap_applies_to_every_runtime() {
+    // The heap cap must be configured before the first runtime, which other
+    // tests of this process may already have created, so it runs in a fresh
+    // test process.
+    let status = std::process::Command::new(std::env::current_exe().unwrap())
+        .args([
+            "--exact",
+            "tests::runtime_memory_tests::test_max_heap_child",
+            "--ignored",
+            "--test-threads=1",
+        ])
+        .env(HEAP_CAP_CHILD, "1")
+        .status()
+        .expect("test binary should start");
+    assert!(status.success());
+}
+
+#[test]
+#[ignore = "run by test_max_heap_applies_to_every_runtime in its own process"]
+fn test_max_heap_child() {
+    if std::env::var_os(HEAP_CAP_CHILD).is_none() {
+        return;
+    }
+    let options = ProcessOptions {
+        max_heap_bytes: HEAP_CAP,
+        ..ProcessOptions::default()
+    };
+    Compiler::configure_process(&options).expect("no runtime exists yet");
+
+    // Far more live AST than fits under the cap.
+    let huge = format!(
+        "<template>{}</template>",
+        "<p :a=\"b\">{{ c }}</p>".repeat(500_000)
+    );
+    // The first pool holds the first runtime of the process, the second
+    // only later ones.
+    for workers in [1, 2] {
+        let pool = CompilerPool::new(workers).expect("Pool should initialize");
+        let outputs = pool
+            .compile_batch(
+                &[SfcInput::new(SOURCE, "App.vue", "abc")],
+                &CompileOptions::default(),
+            )
+            .unwrap();
+        assert!(!outputs[0].has_errors());
+
+        let ids: Vec<String> = (0..workers).map(|i| format!("huge{i}")).collect();
+        let inputs: Vec<SfcInput> = ids
+            .iter()
+            .map(|id| SfcInput::new(&huge, "Huge.vue", id))
+            .collect();
+        let outputs = pool
+            .compile_batch(&inputs, &CompileOptions::default())
+            .unwrap();
+        for output in &outputs {
+            assert!(output.has_errors());
+        }
+    }
+
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    compiler
+        .compile_sfc(SOURCE, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+    assert!(compiler.heap_stats().heap_size <= HEAP_CAP);
+
+    assert!(Compiler::configure_process(&options).is_err());
+}
+
+#[test]
+fn test_vm_flag_with_nul_is_rejected() {
+    let options = ProcessOptions {
+        vm_flags: vec!["-gc\0".to_string()],
+        ..ProcessOptions::default()
+    };
+    assert!(Compiler::configure_process(&options).is_err());
+}
+
+#[test]
+fn test_pool_collects_when_idle() {
+    let pool =
+        CompilerPool::with_options(2, &RuntimeOptions::default()).expect("Pool should initialize");
+    pool.set_collect_when_idle(true);
+    let outputs = pool
+        .compile_batch(
+            &[SfcInput::new(SOURCE, "App.vue", "abc")],
+            &CompileOptions::default(),
+        )
+        .unwrap();
+    assert!(!outputs[0].has_errors());
+}
+
+#[test]
+fn test_destroyed_runtimes_are_torn_down() {
+    // Other tests only add to the count, so it must grow by at least one
+    // per runtime dropped here.
+    let before = unsafe { ffi::hermes_runtime_teardown_count() };
+    for _ in 0..3 {
+        let compiler =
+            Compiler::with_options(&RuntimeOptions::default()).expect("Compiler should initialize");
+        let output = compiler
+            .compile_sfc(SOURCE, "App.vue", "abc", &CompileOptions::default())
+            .unwrap();
+        assert!(!output.has_errors());
+        drop(output);
+        drop(compiler);
+    }
+    assert!(unsafe { ffi::hermes_runtime_teardown_count() } >= before + 3);
+
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    assert!(compiler.parse(SOURCE, "App.vue").is_ok());
+}
+
+#[test]
+fn test_pool_recycles_runtimes() {
+    let inputs: Vec<SfcInput> = (0..12)
+        .map(|_| SfcInput::new(SOURCE, "App.vue", "abc"))
+        .collect();
+    for (max_compiles, max_heap_bytes) in [(4, 0), (0, 1)] {
+        let pool = CompilerPool::new(1).expect("Pool should initialize");
+        pool.set_recycle_limits(max_compiles, max_heap_bytes);
+        // The worker swaps in the runtime requested during the first batch
+        // before it runs the second.
+        for _ in 0..2 {
+            let outputs = pool
+                .compile_batch(&inputs, &CompileOptions::default())
+                .unwrap();
+            for output in &outputs {
+                assert!(!output.has_errors());
+                assert!(output.js().contains("msg"));
+            }
+        }
+        assert!(pool.recycle_count() >= 1);
+
+        // Disabled: a replacement still pending is swapped in before the
+        // next batch runs, then no more are requested.
+        pool.set_recycle_limits(0, 0);
+        pool.compile_batch(&inputs, &CompileOptions::default())
+            .unwrap();
+        let recycled = pool.recycle_count();
+        pool.compile_batch(&inputs, &CompileOptions::default())
+            .unwrap();
+        assert_eq!(pool.recycle_count(), recycled);
+    }
+}
@@ -0,0 +1,74 @@
+//! Tests for runtime instrumentation counters.
+
+use super::STYLED_SOURCE;
+use crate::{CompileOptions, Compiler, RuntimeStats, SfcInput};
+
+#[test]
+fn test_stats_count_phases_when_enabled() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    compiler.reset_stats();
+
+    let parsed = compiler.parse(STYLED_SOURCE, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+    let script = desc.compile_script("abc", false).unwrap();
+    let template = desc.compile_template("abc", Some(&script)).unwrap();
+    let style = desc.compile_style(0, "abc").unwrap();
+    let js = format!("{}{}", script.content(), template.code());
+    assert!(!js.is_empty());
+    assert!(!style.code().is_empty());
+
+    let stats = compiler.stats();
+    if !RuntimeStats::enabled() {
+        assert_eq!(stats, RuntimeStats::default());
+        return;
+    }
+
+    assert_eq!(stats.parse.calls, 1);
+    assert_eq!(stats.compile_script.calls, 1);
+    assert_eq!(stats.compile_template.calls, 1);
+    assert_eq!(stats.compile_style.calls, 1);
+    assert_eq!(stats.compile_sfc.calls, 0);
+    assert_eq!(stats.scan_dependencies.calls, 0);
+    assert!(stats.parse.time > std::time::Duration::ZERO);
+    assert!(stats.bytes_in >= STYLED_SOURCE.len() as u64);
+    assert!(stats.bytes_out >= js.len() as u64);
+    assert!(stats.string_bytes > js.len() as u64);
+    assert!(stats.handles_allocated >= 5);
+    assert!(stats.marshal_out.calls > 0);
+    assert!(stats.js_time() >= stats.parse.time);
+}
+
+#[test]
+fn test_stats_reset() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let output = compiler
+        .compile_sfc(STYLED_SOURCE, "App.vue", "abc", &CompileOptions::default())
+        .unwrap();
+    assert!(!output.js().is_empty());
+
+    if RuntimeStats::enabled() {
+        let stats = compiler.stats();
+        assert!(stats.compile_sfc.calls >= 1);
+        assert!(stats.bytes_out > 0);
+    }
+
+    compiler.reset_stats();
+    assert_eq!(compiler.stats(), RuntimeStats::default());
+}
+
+#[test]
+fn test_stats_time_dependency_scan_separately() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    compiler.reset_stats();
+
+    let scan = compiler
+        .scan_dependencies(&[SfcInput::new(STYLED_SOURCE, "App.vue", "")])
+        .unwrap();
+    assert_eq!(scan.len(), 1);
+
+    let stats = compiler.stats();
+    if RuntimeStats::enabled() {
+        assert_eq!(stats.scan_dependencies.calls, 1);
+        assert_eq!(stats.compile_script.calls, 0);
+    }
+}
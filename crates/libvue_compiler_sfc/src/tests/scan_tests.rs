@@ -0,0 +1,102 @@
+//! Differential tests for the native block scanner against the parser.
+
+use std::thread;
+
+use crate::{Compiler, SfcScan};
+
+/// Sources the scanner handles.
+const HANDLED: &[&str] = &[
+    "<template><div/></template>",
+    "<script>export default {}</script>",
+    "<template>\r\n  <p>{{ a }}</p>\r\n</template>\r\n<script setup>\r\nconst a = 1\r\n</script>\r\n",
+    "<!-- header -->\n<template>\n  <template v-if=\"ok\"><b>{{ a < b ? '</template>' : c }}</b></template>\n  <Template v-else>x</Template>\n</template>\n",
+    "<template>\n  <textarea>{{ '</textarea>' }}</textarea>\n  <div title=\"a > b\" :x='\"<\"'>é 😀</div>\n  <!-- note -->\n</template>",
+    "<template lang=\"pug\">\n    div\n      p(title=\"x\") 日本\n\n    span\n</template>",
+    "<template lang=\"pug\">\ndiv\n  p\n</template>",
+    "<template lang=\"md\"># <i>{{</i></template>",
+    "<script setup lang=\"ts\">\nconst a = '</scripts>'\n</SCRIPT >\n<style module=\"css\" scoped>\n:slotted(a) { color: v-bind( 'theme.color' ) }\n</style>\n",
+    "<script setup=\"name\">a</script>\n<style>\n/* v-bind(no) */ a { b: v-bind(x) } // v-bind(y)\n</style>\n<style scoped></style>\n<style>\n\n</style>",
+    "<template><p/></template>\n<i18n lang=\"yaml\" global>\n😀: x\n</i18n>\n<docs/>\n<story name=default>\n<x></story>",
+    "<template src=\"./t.html\"/>\n<style src=\"./s.css\"></style>\n<custom-block data-x='1'>&amp;</custom-block>",
+    // Shapes from the parse snapshot fixtures.
+    "<template src=\"./template.html\"></template>\n<script src=\"./script.ts\" lang=\"ts\"></script>\n<style src=\"./style.css\" scoped></style>\n",
+    "<template></template>\n<script></script>\n<style></style>\n",
+    "<script lang=\"ts\">\nexport default { name: 'Dual' }\n</script>\n\n<script setup lang=\"ts\">\nimport type { Ref } from 'vue'\nconst count: Ref<number> = ref(0)\n</script>\n",
+    "<script lang=\"ts\" generic=\"T extends string\">\nexport default {}\n</script>\n<style scoped lang=\"scss\" media=\"screen\">\n$primary: #42b883;\n.btn { color: $primary; }\n</style>\n",
+    "<template><div>{{ $t('greeting') }}</div></template>\n<style module>\n.box { border: 1px solid; }\n</style>\n<style module=\"custom\">\n.item { display: block; }\n</style>\n<docs>\n# Usage\n\n```vue\n<MyComponent />\n```\n</docs>\n",
+];
+
+/// Sources the parser reports errors for.
+const ERRORS: &[&str] = &[
+    "import { ref } from 'vue'",
+    "<template></template><template></template>",
+    "<script>a</script><script>b</script>",
+    "<script setup src=\"./a.ts\"></script>",
+    "<template functional></template>",
+    "<template><div></template",
+    "<script>never closed",
+    "<template></template></div>",
+    "<template></template><style vars=\"{ a }\">a {}</style>",
+];
+
+#[test]
+fn test_scan_matches_parse() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    for source in HANDLED {
+        let parsed = compiler.parse(source, "App.vue").unwrap();
+        assert!(!parsed.has_errors(), "{source:?}");
+        let scan = SfcScan::new(source, "App.vue").unwrap_or_else(|| panic!("{source:?}"));
+        let desc = parsed.descriptor().unwrap();
+        assert_eq!(
+            scan.descriptor().as_bytes(),
+            desc.serialize().unwrap().as_bytes(),
+            "{source:?}"
+        );
+    }
+}
+
+#[test]
+fn test_scan_declines_parse_errors() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    for source in ERRORS {
+        assert!(
+            compiler.parse(source, "App.vue").unwrap().has_errors(),
+            "{source:?}"
+        );
+        assert!(SfcScan::new(source, "App.vue").is_none(), "{source:?}");
+    }
+
+    // Constructs the scanner leaves to the parser.
+    for source in [
+        "<style>a {}</style>",
+        "<template v-if=\"a\"></template>",
+        "<template><div v-pre>{{</div></template>",
+        "<script lang=\"&#116;s\">a</script>",
+    ] {
+        assert!(SfcScan::new(source, "App.vue").is_none(), "{source:?}");
+    }
+}
+
+#[test]
+fn test_scanned_descriptor_compiles() {
+    let source = HANDLED[2];
+    let scan = thread::spawn(move || SfcScan::new(source, "App.vue").unwrap())
+        .join()
+        .unwrap();
+    let buffer = scan.descriptor();
+    assert_eq!(buffer.source(), source);
+    assert_eq!(buffer.filename(), "App.vue");
+
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let loaded = compiler.load_descriptor(&buffer).unwrap();
+    let parsed = compiler.parse(source, "App.vue").unwrap();
+    let desc = parsed.descriptor().unwrap();
+
+    let script = loaded.compile_script("abc", false).unwrap();
+    assert_eq!(
+        script.content(),
+        desc.compile_script("abc", false).unwrap().content()
+    );
+    let template = loaded.compile_template("abc", Some(&script)).unwrap();
+    assert!(template.code().contains("_toDisplayString"));
+}
@@ -0,0 +1,48 @@
+//! Tests for memoized accessor strings.
+
+use std::ffi::CStr;
+use std::os::raw::c_char;
+
+use super::SOURCE;
+use crate::ffi;
+use crate::Compiler;
+
+#[test]
+fn test_repeated_accessor_returns_same_pointer() {
+    let compiler = Compiler::new().expect("Compiler should initialize");
+    let rt = compiler.runtime;
+
+    unsafe {
+        let parsed = ffi::vue_parse(
+            rt,
+            SOURCE.as_ptr() as *const c_char,
+            SOURCE.len(),
+            "App.vue".as_ptr() as *const c_char,
+            "App.vue".len(),
+            std::ptr::null(),
+        );
+        let desc = ffi::vue_parse_result_descriptor(rt, parsed);
+        let template = ffi::vue_descriptor_template(rt, desc);
+
+        let first = ffi::vue_block_content(rt, template);
+        // Interleave other accessors so a growing cache would have to move.
+        let filename = ffi::vue_descriptor_filename(rt, desc);
+        for _ in 0..64 {
+            let _ = ffi::vue_block_lang(rt, template);
+            let _ = ffi::vue_descriptor_source(rt, desc);
+        }
+        let second = ffi::vue_block_content(rt, template);
+
+        assert_eq!(first, second);
+        assert_eq!(filename, ffi::vue_descriptor_filename(rt, desc));
+        assert_eq!(
+            CStr::from_ptr(first).to_str().unwrap(),
+            "<div>{{ msg }}</div>"
+        );
+        assert_eq!(CStr::from_ptr(filename).to_str().unwrap(), "App.vue");
+
+        ffi::hermes_handle_free(rt, template);
+        ffi::hermes_handle_free(rt, desc);
+        ffi::hermes_handle_free(rt, parsed);
+    }
+}
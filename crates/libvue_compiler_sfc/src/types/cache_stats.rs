@@ -0,0 +1,30 @@
+//! Compile cache counters.
+
+use crate::ffi;
+
+/// Counters of a [`CompilerPool`](crate::CompilerPool) compile cache.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct CacheStats {
+    /// Results currently cached.
+    pub entries: usize,
+    /// Approximate bytes held by cached results.
+    pub bytes: usize,
+    /// Inputs answered from the cache without entering JS.
+    pub hits: u64,
+    /// Inputs that were compiled while the cache was enabled.
+    pub misses: u64,
+    /// Results dropped to stay within the limits.
+    pub evictions: u64,
+}
+
+impl CacheStats {
+    pub(crate) fn from_ffi(stats: ffi::VuePoolCacheStats) -> Self {
+        CacheStats {
+            entries: stats.entries,
+            bytes: stats.bytes,
+            hits: stats.hits,
+            misses: stats.misses,
+            evictions: stats.evictions,
+        }
+    }
+}
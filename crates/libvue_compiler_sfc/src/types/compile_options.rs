@@ -0,0 +1,58 @@
+//! Compile options type.
+
+use crate::ffi;
+
+/// Options for the compile entry points.
+///
+/// Construct with `Default::default()` and override the fields you need.
+/// The defaults generate and retain only the compiled code: no source maps,
+/// template AST, preamble or tips.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct CompileOptions {
+    /// Compile for production (enables optimizations).
+    pub is_prod: bool,
+    /// Generate source maps during parse, script and template compilation.
+    pub source_map: bool,
+    /// Keep the template AST on template results.
+    pub keep_template_ast: bool,
+    /// Keep the template preamble on template results.
+    pub keep_preamble: bool,
+    /// Keep compiler tips on template results.
+    pub keep_tips: bool,
+    /// Generate server-rendering code: templates compile to an `ssrRender`
+    /// function and scripts skip client-only CSS variable injection.
+    pub ssr: bool,
+    /// Compile plain CSS with a native rewriter instead of the JS compiler.
+    ///
+    /// Only read by the style compile entry points. The output is the same
+    /// either way: styles with a `lang` other than `css`, and CSS using
+    /// something the rewriter leaves to the JS compiler (such as `:deep()`,
+    /// keyframes in a scoped style or `v-bind()` in production), are still
+    /// compiled in the JS runtime.
+    pub native_style: bool,
+    /// Inline the template's render function into the `<script setup>`
+    /// output, compiled against the script's bindings.
+    ///
+    /// Only read by script compilation. The script output is then the whole
+    /// component and no template compile is needed; check
+    /// [`ScriptOutput::has_inline_template`](crate::ScriptOutput::has_inline_template),
+    /// as components without `<script setup>` or with a `src` template are
+    /// not inlined.
+    pub inline_template: bool,
+}
+
+impl CompileOptions {
+    /// Convert to the FFI representation.
+    pub(crate) fn to_ffi(self) -> ffi::VueCompileOptions {
+        ffi::VueCompileOptions {
+            is_prod: self.is_prod,
+            source_map: self.source_map,
+            keep_template_ast: self.keep_template_ast,
+            keep_preamble: self.keep_preamble,
+            keep_tips: self.keep_tips,
+            ssr: self.ssr,
+            native_style: self.native_style,
+            inline_template: self.inline_template,
+        }
+    }
+}
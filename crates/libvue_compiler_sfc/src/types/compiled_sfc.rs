@@ -0,0 +1,75 @@
+//! Owned, runtime-independent SFC compile result.
+
+use crate::ffi;
+use crate::util::ptr_to_str;
+
+/// Output of compiling an SFC on a [`CompilerPool`](crate::CompilerPool).
+///
+/// Unlike [`SfcOutput`](crate::SfcOutput), this holds plain native data rather
+/// than a JS handle, so it is `Send` and `Sync` and outlives the pool.
+pub struct CompiledSfc(ffi::VueCompiledSfc);
+
+// SAFETY: the result is immutable heap data that does not reference any runtime.
+unsafe impl Send for CompiledSfc {}
+unsafe impl Sync for CompiledSfc {}
+
+impl CompiledSfc {
+    pub(crate) fn from_raw(raw: ffi::VueCompiledSfc) -> Self {
+        CompiledSfc(raw)
+    }
+
+    pub(crate) fn as_raw(&self) -> ffi::VueCompiledSfc {
+        self.0
+    }
+
+    /// Get the compiled JavaScript (script content followed by the render function).
+    pub fn js(&self) -> &str {
+        unsafe { ptr_to_str(ffi::vue_compiled_sfc_js(self.0)) }
+    }
+
+    /// Get the compiled CSS of all style blocks.
+    pub fn css(&self) -> &str {
+        unsafe { ptr_to_str(ffi::vue_compiled_sfc_css(self.0)) }
+    }
+
+    /// Get the number of errors.
+    pub fn error_count(&self) -> usize {
+        unsafe { ffi::vue_compiled_sfc_error_count(self.0) }
+    }
+
+    /// Get an error message by index.
+    pub fn error_message(&self, index: usize) -> &str {
+        unsafe { ptr_to_str(ffi::vue_compiled_sfc_error_at(self.0, index)) }
+    }
+
+    /// Check if compilation produced errors.
+    pub fn has_errors(&self) -> bool {
+        self.error_count() > 0
+    }
+
+    /// Iterate over all error messages.
+    pub fn errors(&self) -> impl Iterator<Item = &str> {
+        (0..self.error_count()).map(move |i| self.error_message(i))
+    }
+
+    /// Get the number of warnings.
+    pub fn warning_count(&self) -> usize {
+        unsafe { ffi::vue_compiled_sfc_warning_count(self.0) }
+    }
+
+    /// Get a warning message by index.
+    pub fn warning_message(&self, index: usize) -> &str {
+        unsafe { ptr_to_str(ffi::vue_compiled_sfc_warning_at(self.0, index)) }
+    }
+
+    /// Iterate over all warning messages.
+    pub fn warnings(&self) -> impl Iterator<Item = &str> {
+        (0..self.warning_count()).map(move |i| self.warning_message(i))
+    }
+}
+
+impl Drop for CompiledSfc {
+    fn drop(&mut self) {
+        unsafe { ffi::vue_compiled_sfc_free(self.0) }
+    }
+}
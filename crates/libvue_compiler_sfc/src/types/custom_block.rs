@@ -1,97 +1,109 @@
 //! Custom block type for SFC parsing.
 
 use std::collections::HashMap;
+use std::ops::Range;
 
 use super::attr_value::AttrValue;
-use super::handle::Handle;
 use super::source_location::{Position, SourceLocation};
-use crate::ffi::{self, HermesHandle, HermesRuntime};
-use crate::util::ptr_to_str;
+use crate::ffi::{self, VueBlockSnapshot};
+use crate::util::{ffi_slice, vue_str};
 
 /// Custom block from an SFC (e.g., `<i18n>`, `<docs>`).
-pub struct CustomBlock<'c>(pub(crate) Handle<'c>);
+///
+/// A view into the descriptor snapshot; borrows the parent [`Descriptor`](super::Descriptor).
+pub struct CustomBlock<'d>(pub(crate) &'d VueBlockSnapshot);
 
-impl<'c> CustomBlock<'c> {
-    pub(crate) fn from_handle(handle: Handle<'c>) -> Self {
-        CustomBlock(handle)
+impl<'d> CustomBlock<'d> {
+    pub(crate) fn from_snapshot(block: &'d VueBlockSnapshot) -> Self {
+        CustomBlock(block)
     }
-}
 
-impl CustomBlock<'_> {
     /// Get the block type (e.g., "i18n", "docs").
-    pub fn block_type(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_custom_block_type(*self.0.runtime(), self.0.raw())) }
+    pub fn block_type(&self) -> &'d str {
+        unsafe { vue_str(self.0.type_) }
     }
 
     /// Get the block content.
-    pub fn content(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_block_content(*self.0.runtime(), self.0.raw())) }
+    pub fn content(&self) -> &'d str {
+        unsafe { vue_str(self.0.content) }
     }
 
     /// Get the block language.
-    pub fn lang(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_block_lang(*self.0.runtime(), self.0.raw())) }
+    pub fn lang(&self) -> &'d str {
+        unsafe { vue_str(self.0.lang) }
     }
 
     /// Get the src attribute if present.
-    pub fn src(&self) -> Option<&str> {
-        let s = unsafe { ptr_to_str(ffi::vue_block_src(*self.0.runtime(), self.0.raw())) };
-        if s.is_empty() {
-            None
-        } else {
-            Some(s)
-        }
+    pub fn src(&self) -> Option<&'d str> {
+        block_src(self.0)
+    }
+
+    /// Get the byte range of the content within the source passed to
+    /// [`Compiler::parse_borrowed`](crate::Compiler::parse_borrowed).
+    ///
+    /// Returns None if the content was copied (regular `parse`, or content
+    /// the parser transformed).
+    pub fn content_range(&self) -> Option<Range<usize>> {
+        block_content_range(self.0)
     }
 
     /// Get the source location of the block.
     pub fn loc(&self) -> SourceLocation {
-        get_block_loc(*self.0.runtime(), self.0.raw())
+        block_loc(self.0)
     }
 
     /// Get all attributes on the block.
     pub fn attrs(&self) -> HashMap<String, AttrValue> {
-        get_block_attrs(*self.0.runtime(), self.0.raw())
+        block_attrs(self.0)
     }
 }
 
-/// Helper function to get source location from a block handle.
-pub(crate) fn get_block_loc(rt: HermesRuntime, handle: HermesHandle) -> SourceLocation {
-    SourceLocation {
-        start: Position {
-            offset: unsafe { ffi::vue_block_loc_start_offset(rt, handle) },
-            line: unsafe { ffi::vue_block_loc_start_line(rt, handle) },
-            column: unsafe { ffi::vue_block_loc_start_column(rt, handle) },
-        },
-        end: Position {
-            offset: unsafe { ffi::vue_block_loc_end_offset(rt, handle) },
-            line: unsafe { ffi::vue_block_loc_end_line(rt, handle) },
-            column: unsafe { ffi::vue_block_loc_end_column(rt, handle) },
-        },
+/// Helper function to get the src attribute from a block snapshot.
+pub(crate) fn block_src(block: &VueBlockSnapshot) -> Option<&str> {
+    let s = unsafe { vue_str(block.src) };
+    if s.is_empty() {
+        None
+    } else {
+        Some(s)
+    }
+}
+
+/// Helper function to get the borrowed content byte range from a block snapshot.
+pub(crate) fn block_content_range(block: &VueBlockSnapshot) -> Option<Range<usize>> {
+    if block.content_borrowed {
+        Some(block.content_offset..block.content_offset + block.content.len)
+    } else {
+        None
     }
 }
 
-/// Helper function to get attributes from a block handle.
-pub(crate) fn get_block_attrs(
-    rt: HermesRuntime,
-    handle: HermesHandle,
-) -> HashMap<String, AttrValue> {
-    let count = unsafe { ffi::vue_block_attrs_count(rt, handle) };
-    let mut attrs = HashMap::with_capacity(count);
-
-    for i in 0..count {
-        let key = unsafe { ptr_to_str(ffi::vue_block_attrs_key_at(rt, handle, i)).to_string() };
-        let is_bool = unsafe { ffi::vue_block_attrs_is_bool_at(rt, handle, i) };
-
-        let value = if is_bool {
-            AttrValue::Bool(true)
-        } else {
-            let val =
-                unsafe { ptr_to_str(ffi::vue_block_attrs_value_at(rt, handle, i)).to_string() };
-            AttrValue::String(val)
-        };
-
-        attrs.insert(key, value);
+/// Helper function to get source location from a block snapshot.
+pub(crate) fn block_loc(block: &VueBlockSnapshot) -> SourceLocation {
+    let position = |p: ffi::VuePosition| Position {
+        offset: p.offset,
+        line: p.line,
+        column: p.column,
+    };
+    SourceLocation {
+        start: position(block.loc.start),
+        end: position(block.loc.end),
     }
+}
+
+/// Helper function to get attributes from a block snapshot.
+pub(crate) fn block_attrs(block: &VueBlockSnapshot) -> HashMap<String, AttrValue> {
+    let attrs = unsafe { ffi_slice(block.attrs, block.attrs_count) };
 
     attrs
+        .iter()
+        .map(|attr| {
+            let key = unsafe { vue_str(attr.key) }.to_string();
+            let value = if attr.is_bool {
+                AttrValue::Bool(true)
+            } else {
+                AttrValue::String(unsafe { vue_str(attr.value) }.to_string())
+            };
+            (key, value)
+        })
+        .collect()
 }
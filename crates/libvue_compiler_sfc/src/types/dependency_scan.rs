@@ -0,0 +1,120 @@
+//! Owned dependency scan of a batch of SFCs.
+
+use crate::ffi;
+use crate::util::{ffi_slice, vue_str};
+
+/// The dependencies of a batch of SFCs, from
+/// [`Compiler::scan_dependencies`](crate::Compiler::scan_dependencies).
+///
+/// The scan holds plain heap data, so it is `Send` and `Sync` and outlives
+/// the compiler that produced it.
+pub struct DependencyScan(ffi::VueDependencyScan);
+
+// SAFETY: the scan is immutable heap data that does not reference any runtime.
+unsafe impl Send for DependencyScan {}
+unsafe impl Sync for DependencyScan {}
+
+impl DependencyScan {
+    /// Wrap a raw scan pointer. Takes ownership.
+    pub(crate) fn from_raw(raw: ffi::VueDependencyScan) -> Self {
+        DependencyScan(raw)
+    }
+
+    fn raw_files(&self) -> &[ffi::VueFileDependencies] {
+        let mut count = 0;
+        let files = unsafe { ffi::vue_dependency_scan_files(self.0, &mut count) };
+        unsafe { ffi_slice(files, count) }
+    }
+
+    /// Get the number of scanned files.
+    pub fn len(&self) -> usize {
+        self.raw_files().len()
+    }
+
+    /// Returns `true` if the scan has no files.
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Get the dependencies of the file at `index`, in input order.
+    pub fn file(&self, index: usize) -> Option<FileDependencies<'_>> {
+        self.raw_files()
+            .get(index)
+            .map(|raw| FileDependencies { raw })
+    }
+
+    /// Iterate over the dependencies of every file, in input order.
+    pub fn files(&self) -> impl ExactSizeIterator<Item = FileDependencies<'_>> {
+        self.raw_files().iter().map(|raw| FileDependencies { raw })
+    }
+}
+
+impl Drop for DependencyScan {
+    fn drop(&mut self) {
+        unsafe { ffi::vue_dependency_scan_free(self.0) }
+    }
+}
+
+/// The dependencies of one file of a [`DependencyScan`].
+#[derive(Debug, Clone, Copy)]
+pub struct FileDependencies<'a> {
+    raw: &'a ffi::VueFileDependencies,
+}
+
+impl<'a> FileDependencies<'a> {
+    /// Get the imports of `<script>` and `<script setup>`, in the order and
+    /// with the de-duplication [`ScriptOutput::imports`](crate::ScriptOutput::imports)
+    /// reports them, plus side-effect imports, which have an empty `local`
+    /// and `imported` name.
+    pub fn imports(&self) -> impl ExactSizeIterator<Item = DependencyImport<'a>> {
+        let entries = unsafe { ffi_slice(self.raw.imports, self.raw.imports_count) };
+        entries.iter().map(|entry| unsafe {
+            DependencyImport {
+                local: vue_str(entry.local),
+                imported: vue_str(entry.imported),
+                source: vue_str(entry.source),
+                is_type: entry.is_type,
+                is_from_setup: entry.is_from_setup,
+            }
+        })
+    }
+
+    /// Get the blocks loaded from other files as `(block type, src)` pairs,
+    /// in block order.
+    pub fn srcs(&self) -> impl ExactSizeIterator<Item = (&'a str, &'a str)> {
+        let entries = unsafe { ffi_slice(self.raw.srcs, self.raw.srcs_count) };
+        entries
+            .iter()
+            .map(|entry| unsafe { (vue_str(entry.block), vue_str(entry.src)) })
+    }
+
+    /// Get the paths style blocks import (`@import`, and `@use`/`@forward`
+    /// in scss/sass or `@require` in stylus), as written. They are found
+    /// lexically: preprocessors are not run.
+    pub fn style_imports(&self) -> impl ExactSizeIterator<Item = &'a str> {
+        let paths = unsafe { ffi_slice(self.raw.style_imports, self.raw.style_imports_count) };
+        paths.iter().map(|path| unsafe { vue_str(*path) })
+    }
+
+    /// Get the parse errors of the SFC and its script blocks.
+    pub fn errors(&self) -> impl ExactSizeIterator<Item = &'a str> {
+        let errors = unsafe { ffi_slice(self.raw.errors, self.raw.errors_count) };
+        errors.iter().map(|error| unsafe { vue_str(*error) })
+    }
+}
+
+/// One import found by a [`DependencyScan`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct DependencyImport<'a> {
+    /// The local name, empty for side-effect imports.
+    pub local: &'a str,
+    /// The imported name: `default`, `*` or the specifier's name; empty for
+    /// side-effect imports.
+    pub imported: &'a str,
+    /// The source module.
+    pub source: &'a str,
+    /// Whether this is a type-only import.
+    pub is_type: bool,
+    /// Whether the import is in `<script setup>`.
+    pub is_from_setup: bool,
+}
@@ -1,80 +1,92 @@
 //! SFC Descriptor type.
 
 use std::os::raw::c_char;
+use std::ptr::NonNull;
 
+use super::compile_options::CompileOptions;
 use super::custom_block::CustomBlock;
+use super::descriptor_buffer::DescriptorBuffer;
 use super::error::{Error, Result};
 use super::handle::Handle;
 use super::script_block::ScriptBlock;
 use super::script_output::ScriptOutput;
 use super::style_block::StyleBlock;
+use super::style_output::StyleOutput;
 use super::template_block::TemplateBlock;
-use crate::ffi;
-use crate::util::ptr_to_str;
+use super::template_output::TemplateOutput;
+use crate::ffi::{self, HermesHandle, HermesRuntime};
+use crate::util::{ffi_slice, vue_str};
 
 /// SFC Descriptor containing all parsed blocks.
-pub struct Descriptor<'c>(Handle<'c>);
+///
+/// The descriptor is materialized into a flat snapshot when it is created, so
+/// block accessors read native memory instead of walking JS properties.
+pub struct Descriptor<'c> {
+    handle: Handle<'c>,
+    snapshot: NonNull<ffi::VueDescriptorSnapshot>,
+}
 
 impl<'c> Descriptor<'c> {
-    pub(crate) fn from_handle(handle: Handle<'c>) -> Self {
-        Descriptor(handle)
+    /// Materialize a descriptor handle. Returns None if the snapshot can't be built.
+    pub(crate) fn from_handle(handle: Handle<'c>) -> Option<Self> {
+        let snapshot = unsafe { ffi::vue_descriptor_materialize(*handle.runtime(), handle.raw()) };
+        NonNull::new(snapshot as *mut ffi::VueDescriptorSnapshot)
+            .map(|snapshot| Descriptor { handle, snapshot })
+    }
+
+    /// Materialize a raw descriptor handle, freeing it if that fails.
+    pub(crate) fn from_raw(handle: HermesHandle, runtime: &'c HermesRuntime) -> Option<Self> {
+        Handle::new(handle, runtime).and_then(Descriptor::from_handle)
+    }
+
+    /// The snapshot is owned by the handle and lives as long as `self`.
+    fn snapshot(&self) -> &ffi::VueDescriptorSnapshot {
+        unsafe { self.snapshot.as_ref() }
     }
 
     /// Check if the SFC has a template block.
     pub fn has_template(&self) -> bool {
-        unsafe { ffi::vue_descriptor_has_template(*self.0.runtime(), self.0.raw()) }
+        !self.snapshot().template_block.is_null()
     }
 
     /// Check if the SFC has a regular script block.
     pub fn has_script(&self) -> bool {
-        unsafe { ffi::vue_descriptor_has_script(*self.0.runtime(), self.0.raw()) }
+        !self.snapshot().script.is_null()
     }
 
     /// Check if the SFC has a script setup block.
     pub fn has_script_setup(&self) -> bool {
-        unsafe { ffi::vue_descriptor_has_script_setup(*self.0.runtime(), self.0.raw()) }
+        !self.snapshot().script_setup.is_null()
     }
 
     /// Get the number of style blocks.
     pub fn style_count(&self) -> usize {
-        unsafe { ffi::vue_descriptor_style_count(*self.0.runtime(), self.0.raw()) }
+        self.snapshot().styles_count
     }
 
     /// Get the template block.
-    pub fn template(&self) -> Option<TemplateBlock<'c>> {
-        if !self.has_template() {
-            return None;
-        }
-        let handle = unsafe { ffi::vue_descriptor_template(*self.0.runtime(), self.0.raw()) };
-        Handle::new(handle, self.0.runtime()).map(TemplateBlock::from_handle)
+    pub fn template(&self) -> Option<TemplateBlock<'_>> {
+        unsafe { self.snapshot().template_block.as_ref() }.map(TemplateBlock::from_snapshot)
     }
 
     /// Get the regular script block (not setup).
-    pub fn script(&self) -> Option<ScriptBlock<'c>> {
-        if !self.has_script() {
-            return None;
-        }
-        let handle = unsafe { ffi::vue_descriptor_script(*self.0.runtime(), self.0.raw()) };
-        Handle::new(handle, self.0.runtime()).map(ScriptBlock::from_handle)
+    pub fn script(&self) -> Option<ScriptBlock<'_>> {
+        unsafe { self.snapshot().script.as_ref() }
+            .map(|block| ScriptBlock::from_snapshot(block, &self.handle))
     }
 
     /// Get the script setup block.
-    pub fn script_setup(&self) -> Option<ScriptBlock<'c>> {
-        if !self.has_script_setup() {
-            return None;
-        }
-        let handle = unsafe { ffi::vue_descriptor_script_setup(*self.0.runtime(), self.0.raw()) };
-        Handle::new(handle, self.0.runtime()).map(ScriptBlock::from_handle)
+    pub fn script_setup(&self) -> Option<ScriptBlock<'_>> {
+        unsafe { self.snapshot().script_setup.as_ref() }
+            .map(|block| ScriptBlock::from_snapshot(block, &self.handle))
     }
 
     /// Iterate over all style blocks.
-    pub fn styles(&self) -> impl Iterator<Item = StyleBlock<'c>> + '_ {
-        let count = self.style_count();
-        (0..count).filter_map(move |index| {
-            let handle =
-                unsafe { ffi::vue_descriptor_style_at(*self.0.runtime(), self.0.raw(), index) };
-            Handle::new(handle, self.0.runtime()).map(StyleBlock::from_handle)
-        })
+    pub fn styles(&self) -> impl Iterator<Item = StyleBlock<'_>> + '_ {
+        let snapshot = self.snapshot();
+        unsafe { ffi_slice(snapshot.styles, snapshot.styles_count) }
+            .iter()
+            .map(StyleBlock::from_snapshot)
     }
 
     /// Check if any style block is scoped.
@@ -84,80 +96,185 @@ impl<'c> Descriptor<'c> {
 
     /// Get the original source code of the SFC.
     pub fn source(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_descriptor_source(*self.0.runtime(), self.0.raw())) }
+        unsafe { vue_str(self.snapshot().source) }
     }
 
     /// Get the filename of the SFC.
     pub fn filename(&self) -> &str {
-        unsafe {
-            ptr_to_str(ffi::vue_descriptor_filename(
-                *self.0.runtime(),
-                self.0.raw(),
-            ))
-        }
+        unsafe { vue_str(self.snapshot().filename) }
     }
 
     /// Get the number of CSS variables extracted from scoped styles.
     pub fn css_vars_count(&self) -> usize {
-        unsafe { ffi::vue_descriptor_css_vars_count(*self.0.runtime(), self.0.raw()) }
+        self.snapshot().css_vars_count
     }
 
     /// Get the CSS variable names extracted from scoped styles.
     ///
     /// These are v-bind() expressions found in `<style>` blocks.
     pub fn css_vars(&self) -> Vec<String> {
-        let count = self.css_vars_count();
-        let mut vars = Vec::with_capacity(count);
-
-        for i in 0..count {
-            let var = unsafe {
-                ptr_to_str(ffi::vue_descriptor_css_var_at(
-                    *self.0.runtime(),
-                    self.0.raw(),
-                    i,
-                ))
-                .to_string()
-            };
-            vars.push(var);
-        }
-
-        vars
+        let snapshot = self.snapshot();
+        unsafe { ffi_slice(snapshot.css_vars, snapshot.css_vars_count) }
+            .iter()
+            .map(|var| unsafe { vue_str(*var) }.to_string())
+            .collect()
     }
 
     /// Check if the SFC uses :slotted() in scoped styles.
     pub fn slotted(&self) -> bool {
-        unsafe { ffi::vue_descriptor_slotted(*self.0.runtime(), self.0.raw()) }
+        self.snapshot().slotted
     }
 
     /// Get the number of custom blocks (e.g., `<i18n>`, `<docs>`).
     pub fn custom_blocks_count(&self) -> usize {
-        unsafe { ffi::vue_descriptor_custom_blocks_count(*self.0.runtime(), self.0.raw()) }
+        self.snapshot().custom_blocks_count
     }
 
     /// Iterate over all custom blocks.
-    pub fn custom_blocks(&self) -> impl Iterator<Item = CustomBlock<'c>> + '_ {
-        let count = self.custom_blocks_count();
-        (0..count).filter_map(move |index| {
-            let handle = unsafe {
-                ffi::vue_descriptor_custom_block_at(*self.0.runtime(), self.0.raw(), index)
-            };
-            Handle::new(handle, self.0.runtime()).map(CustomBlock::from_handle)
-        })
+    pub fn custom_blocks(&self) -> impl Iterator<Item = CustomBlock<'_>> + '_ {
+        let snapshot = self.snapshot();
+        unsafe { ffi_slice(snapshot.custom_blocks, snapshot.custom_blocks_count) }
+            .iter()
+            .map(CustomBlock::from_snapshot)
+    }
+
+    /// Serialize this descriptor to a runtime-independent binary buffer.
+    ///
+    /// The buffer is built once and owned by this descriptor. Read it in place
+    /// with [`DescriptorBuffer`], or load it into any compiler, on any thread
+    /// or process, with [`Compiler::load_descriptor`](crate::Compiler::load_descriptor).
+    /// The template AST is not part of the buffer.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the descriptor exceeds the format's 4 GiB limit.
+    pub fn serialize(&self) -> Result<DescriptorBuffer<'_>> {
+        let mut len = 0;
+        let data = unsafe {
+            ffi::vue_descriptor_serialize(*self.handle.runtime(), self.handle.raw(), &mut len)
+        };
+        if data.is_null() {
+            return Err(Error::new("descriptor is too large to serialize"));
+        }
+        DescriptorBuffer::new(unsafe { ffi_slice(data, len) })
     }
 
     /// Compile the script blocks from this descriptor.
     pub fn compile_script(&self, id: &str, is_prod: bool) -> Result<ScriptOutput<'c>> {
+        let options = CompileOptions {
+            is_prod,
+            ..CompileOptions::default()
+        };
+        self.compile_script_with_options(id, &options)
+    }
+
+    /// Compile the script blocks with explicit options.
+    ///
+    /// Reads `is_prod`, `ssr`, `source_map` and `inline_template`.
+    pub fn compile_script_with_options(
+        &self,
+        id: &str,
+        options: &CompileOptions,
+    ) -> Result<ScriptOutput<'c>> {
+        let options = options.to_ffi();
         let handle = unsafe {
             ffi::vue_compile_script(
-                *self.0.runtime(),
-                self.0.raw(),
+                *self.handle.runtime(),
+                self.handle.raw(),
                 id.as_ptr() as *const c_char,
                 id.len(),
-                is_prod,
+                &options,
             )
         };
-        Handle::new(handle, self.0.runtime())
+        Handle::new(handle, self.handle.runtime())
             .map(ScriptOutput::from_handle)
             .ok_or_else(|| Error::new("compile_script returned invalid handle"))
     }
+
+    /// Compile the template block from this descriptor.
+    ///
+    /// The template source stays in the JS heap and the AST produced by
+    /// parsing is reused, avoiding a second template parse. Scoped and
+    /// slotted are taken from the descriptor.
+    pub fn compile_template(
+        &self,
+        id: &str,
+        bindings: Option<&ScriptOutput<'c>>,
+    ) -> Result<TemplateOutput<'c>> {
+        self.compile_template_with_options(id, bindings, &CompileOptions::default())
+    }
+
+    /// Compile the template block with explicit options.
+    ///
+    /// Reads `is_prod`, `ssr`, `source_map`, `keep_template_ast`,
+    /// `keep_preamble` and `keep_tips`. With `ssr`, the descriptor's CSS
+    /// variables are passed to the SSR compiler.
+    pub fn compile_template_with_options(
+        &self,
+        id: &str,
+        bindings: Option<&ScriptOutput<'c>>,
+        options: &CompileOptions,
+    ) -> Result<TemplateOutput<'c>> {
+        if !self.has_template() {
+            return Err(Error::new("descriptor has no template block"));
+        }
+
+        let rt = *self.handle.runtime();
+        let bindings_handle = bindings
+            .map(|b| b.bindings_handle())
+            .unwrap_or(HermesHandle::INVALID);
+        let options = options.to_ffi();
+        let handle = unsafe {
+            ffi::vue_compile_template_from_descriptor(
+                rt,
+                self.handle.raw(),
+                id.as_ptr() as *const c_char,
+                id.len(),
+                bindings_handle,
+                &options,
+            )
+        };
+        unsafe { ffi::hermes_handle_free(rt, bindings_handle) };
+
+        if !handle.is_valid() {
+            return Err(Error::new("compile_template returned invalid handle"));
+        }
+        Ok(TemplateOutput::from_raw(handle, self.handle.runtime()))
+    }
+
+    /// Compile the style block at `index` from this descriptor.
+    pub fn compile_style(&self, index: usize, id: &str) -> Result<StyleOutput<'c>> {
+        self.compile_style_with_options(index, id, &CompileOptions::default())
+    }
+
+    /// Compile the style block at `index` with explicit options.
+    ///
+    /// Reads `is_prod` and `native_style`.
+    pub fn compile_style_with_options(
+        &self,
+        index: usize,
+        id: &str,
+        options: &CompileOptions,
+    ) -> Result<StyleOutput<'c>> {
+        if index >= self.style_count() {
+            return Err(Error::new("style index out of range"));
+        }
+
+        let options = options.to_ffi();
+        let handle = unsafe {
+            ffi::vue_compile_style_from_descriptor(
+                *self.handle.runtime(),
+                self.handle.raw(),
+                index,
+                id.as_ptr() as *const c_char,
+                id.len(),
+                &options,
+            )
+        };
+
+        if !handle.is_valid() {
+            return Err(Error::new("compile_style returned invalid handle"));
+        }
+        Ok(StyleOutput::from_raw(handle, self.handle.runtime()))
+    }
 }
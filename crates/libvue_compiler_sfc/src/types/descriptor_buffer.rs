@@ -0,0 +1,353 @@
+//! Zero-copy reader for the binary descriptor format.
+
+use super::error::{Error, Result};
+use super::source_location::{Position, SourceLocation};
+use crate::ffi;
+
+const MAGIC: &[u8; 4] = b"VSFD";
+const HEADER_SIZE: usize = 40;
+const BLOCK_SIZE: usize = 84;
+const ATTR_SIZE: usize = 20;
+const STR_SIZE: usize = 8;
+
+const SLOTTED: u16 = 1 << 0;
+const SCOPED: u8 = 1 << 0;
+const HAS_MODULE: u8 = 1 << 1;
+const HAS_SETUP: u8 = 1 << 2;
+const BOOL_ATTR: u32 = 1 << 0;
+
+/// Kind of a block in a [`DescriptorBuffer`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum BlockKind {
+    /// The `<template>` block.
+    Template,
+    /// The regular `<script>` block.
+    Script,
+    /// The `<script setup>` block.
+    ScriptSetup,
+    /// A `<style>` block.
+    Style,
+    /// A custom block (e.g., `<i18n>`, `<docs>`).
+    Custom,
+}
+
+impl BlockKind {
+    fn from_u8(kind: u8) -> Option<Self> {
+        match kind {
+            0 => Some(BlockKind::Template),
+            1 => Some(BlockKind::Script),
+            2 => Some(BlockKind::ScriptSetup),
+            3 => Some(BlockKind::Style),
+            4 => Some(BlockKind::Custom),
+            _ => None,
+        }
+    }
+}
+
+fn u16_at(bytes: &[u8], at: usize) -> u16 {
+    u16::from_le_bytes([bytes[at], bytes[at + 1]])
+}
+
+fn u32_at(bytes: &[u8], at: usize) -> u32 {
+    u32::from_le_bytes([bytes[at], bytes[at + 1], bytes[at + 2], bytes[at + 3]])
+}
+
+/// A descriptor serialized with [`Descriptor::serialize`](super::Descriptor::serialize),
+/// read in place.
+///
+/// The buffer references no runtime, so it can be sent to another thread or
+/// process and loaded there with
+/// [`Compiler::load_descriptor`](crate::Compiler::load_descriptor). It is
+/// validated once on construction; accessors then return slices of it
+/// without copying or checking again.
+#[derive(Debug, Clone, Copy)]
+pub struct DescriptorBuffer<'a> {
+    bytes: &'a [u8],
+    block_count: usize,
+    attr_count: usize,
+    css_var_count: usize,
+}
+
+impl<'a> DescriptorBuffer<'a> {
+    /// Validate a serialized descriptor.
+    ///
+    /// Bytes past the size recorded in the header are ignored.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if the buffer is truncated, malformed, holds invalid
+    /// UTF-8 or was written in another format version.
+    pub fn new(bytes: &'a [u8]) -> Result<Self> {
+        if bytes.len() < HEADER_SIZE || &bytes[..4] != MAGIC {
+            return Err(Error::new("not a serialized descriptor"));
+        }
+        if u16_at(bytes, 4) != ffi::VUE_DESCRIPTOR_FORMAT_VERSION {
+            return Err(Error::new("unsupported descriptor format version"));
+        }
+        let total = u32_at(bytes, 8) as usize;
+        if total < HEADER_SIZE || total > bytes.len() {
+            return Err(Error::new("truncated descriptor buffer"));
+        }
+
+        let buffer = DescriptorBuffer {
+            bytes: &bytes[..total],
+            block_count: u32_at(bytes, 12) as usize,
+            attr_count: u32_at(bytes, 16) as usize,
+            css_var_count: u32_at(bytes, 20) as usize,
+        };
+        buffer.validate()?;
+        Ok(buffer)
+    }
+
+    /// Check every record and string once, so accessors can't fail.
+    fn validate(&self) -> Result<()> {
+        let end = (self.block_count as u64) * BLOCK_SIZE as u64
+            + (self.attr_count as u64) * ATTR_SIZE as u64
+            + (self.css_var_count as u64) * STR_SIZE as u64
+            + HEADER_SIZE as u64;
+        if end > self.bytes.len() as u64 {
+            return Err(Error::new("truncated descriptor buffer"));
+        }
+
+        let check_str = |at: usize| -> Result<()> {
+            let offset = u32_at(self.bytes, at) as usize;
+            let len = u32_at(self.bytes, at + 4) as usize;
+            let bytes = offset
+                .checked_add(len)
+                .and_then(|end| self.bytes.get(offset..end))
+                .ok_or_else(|| Error::new("descriptor string out of bounds"))?;
+            std::str::from_utf8(bytes)
+                .map(|_| ())
+                .map_err(|_| Error::new("descriptor string is not UTF-8"))
+        };
+
+        check_str(24)?;
+        check_str(32)?;
+
+        let mut singles = 0u8;
+        for index in 0..self.block_count {
+            let at = self.blocks_at() + index * BLOCK_SIZE;
+            let kind = self.bytes[at];
+            match BlockKind::from_u8(kind) {
+                Some(BlockKind::Style | BlockKind::Custom) => {}
+                Some(_) if singles & (1 << kind) == 0 => singles |= 1 << kind,
+                Some(_) => return Err(Error::new("duplicate descriptor block")),
+                None => return Err(Error::new("unknown descriptor block kind")),
+            }
+            let first = u32_at(self.bytes, at + 4) as usize;
+            let count = u32_at(self.bytes, at + 8) as usize;
+            if first > self.attr_count || count > self.attr_count - first {
+                return Err(Error::new("descriptor attributes out of bounds"));
+            }
+            for field in 0..6 {
+                check_str(at + 12 + field * STR_SIZE)?;
+            }
+        }
+        for index in 0..self.attr_count {
+            let at = self.attrs_at() + index * ATTR_SIZE;
+            check_str(at)?;
+            check_str(at + 8)?;
+        }
+        for index in 0..self.css_var_count {
+            check_str(self.css_vars_at() + index * STR_SIZE)?;
+        }
+        Ok(())
+    }
+
+    fn blocks_at(&self) -> usize {
+        HEADER_SIZE
+    }
+
+    fn attrs_at(&self) -> usize {
+        self.blocks_at() + self.block_count * BLOCK_SIZE
+    }
+
+    fn css_vars_at(&self) -> usize {
+        self.attrs_at() + self.attr_count * ATTR_SIZE
+    }
+
+    /// Read the str record at `at`.
+    fn str_at(&self, at: usize) -> &'a str {
+        let offset = u32_at(self.bytes, at) as usize;
+        let len = u32_at(self.bytes, at + 4) as usize;
+        // validate() checked every str record for bounds and UTF-8.
+        unsafe { std::str::from_utf8_unchecked(&self.bytes[offset..offset + len]) }
+    }
+
+    /// Get the serialized bytes.
+    pub fn as_bytes(&self) -> &'a [u8] {
+        self.bytes
+    }
+
+    /// Get the original source code of the SFC.
+    pub fn source(&self) -> &'a str {
+        self.str_at(32)
+    }
+
+    /// Get the filename of the SFC.
+    pub fn filename(&self) -> &'a str {
+        self.str_at(24)
+    }
+
+    /// Check if the SFC uses :slotted() in scoped styles.
+    pub fn slotted(&self) -> bool {
+        u16_at(self.bytes, 6) & SLOTTED != 0
+    }
+
+    /// Iterate over all blocks: the template, script and script setup blocks
+    /// if present, then styles and custom blocks in source order.
+    pub fn blocks(&self) -> impl Iterator<Item = BufferBlock<'a>> + 'a {
+        let buffer = *self;
+        (0..self.block_count).map(move |index| BufferBlock {
+            buffer,
+            at: buffer.blocks_at() + index * BLOCK_SIZE,
+        })
+    }
+
+    fn block_of(&self, kind: BlockKind) -> Option<BufferBlock<'a>> {
+        self.blocks().find(|block| block.kind() == kind)
+    }
+
+    /// Get the template block.
+    pub fn template(&self) -> Option<BufferBlock<'a>> {
+        self.block_of(BlockKind::Template)
+    }
+
+    /// Get the regular script block (not setup).
+    pub fn script(&self) -> Option<BufferBlock<'a>> {
+        self.block_of(BlockKind::Script)
+    }
+
+    /// Get the script setup block.
+    pub fn script_setup(&self) -> Option<BufferBlock<'a>> {
+        self.block_of(BlockKind::ScriptSetup)
+    }
+
+    /// Iterate over all style blocks.
+    pub fn styles(&self) -> impl Iterator<Item = BufferBlock<'a>> + 'a {
+        self.blocks()
+            .filter(|block| block.kind() == BlockKind::Style)
+    }
+
+    /// Iterate over all custom blocks.
+    pub fn custom_blocks(&self) -> impl Iterator<Item = BufferBlock<'a>> + 'a {
+        self.blocks()
+            .filter(|block| block.kind() == BlockKind::Custom)
+    }
+
+    /// Iterate over the CSS variable names extracted from scoped styles.
+    pub fn css_vars(&self) -> impl Iterator<Item = &'a str> + 'a {
+        let buffer = *self;
+        (0..self.css_var_count)
+            .map(move |index| buffer.str_at(buffer.css_vars_at() + index * STR_SIZE))
+    }
+}
+
+/// A block of a [`DescriptorBuffer`]. Fields that don't apply to the block
+/// kind are empty/false.
+#[derive(Debug, Clone, Copy)]
+pub struct BufferBlock<'a> {
+    buffer: DescriptorBuffer<'a>,
+    at: usize,
+}
+
+impl<'a> BufferBlock<'a> {
+    fn flags(&self) -> u8 {
+        self.buffer.bytes[self.at + 1]
+    }
+
+    fn optional(&self, field: usize) -> Option<&'a str> {
+        let s = self.buffer.str_at(self.at + field);
+        if s.is_empty() {
+            None
+        } else {
+            Some(s)
+        }
+    }
+
+    fn position(&self, field: usize) -> Position {
+        let bytes = self.buffer.bytes;
+        Position {
+            offset: u32_at(bytes, self.at + field) as usize,
+            line: u32_at(bytes, self.at + field + 4) as usize,
+            column: u32_at(bytes, self.at + field + 8) as usize,
+        }
+    }
+
+    /// Get the block kind.
+    pub fn kind(&self) -> BlockKind {
+        BlockKind::from_u8(self.buffer.bytes[self.at]).expect("validated block kind")
+    }
+
+    /// Get the block's tag name (e.g., "template", "i18n").
+    pub fn block_type(&self) -> &'a str {
+        self.buffer.str_at(self.at + 12)
+    }
+
+    /// Get the block content.
+    pub fn content(&self) -> &'a str {
+        self.buffer.str_at(self.at + 20)
+    }
+
+    /// Get the block language (e.g., "ts"), empty if not specified.
+    pub fn lang(&self) -> &'a str {
+        self.buffer.str_at(self.at + 28)
+    }
+
+    /// Get the src attribute if present (external file reference).
+    pub fn src(&self) -> Option<&'a str> {
+        self.optional(36)
+    }
+
+    /// Get the source location of the block.
+    pub fn loc(&self) -> SourceLocation {
+        SourceLocation {
+            start: self.position(60),
+            end: self.position(72),
+        }
+    }
+
+    /// Iterate over the block's attributes as (key, value) pairs. The value
+    /// is None for key-only attributes (e.g., `scoped`).
+    pub fn attrs(&self) -> impl Iterator<Item = (&'a str, Option<&'a str>)> + 'a {
+        let buffer = self.buffer;
+        let first = u32_at(buffer.bytes, self.at + 4) as usize;
+        let count = u32_at(buffer.bytes, self.at + 8) as usize;
+        (first..first + count).map(move |index| {
+            let at = buffer.attrs_at() + index * ATTR_SIZE;
+            let value = if u32_at(buffer.bytes, at + 16) & BOOL_ATTR != 0 {
+                None
+            } else {
+                Some(buffer.str_at(at + 8))
+            };
+            (buffer.str_at(at), value)
+        })
+    }
+
+    /// Style: check if the style is scoped.
+    pub fn is_scoped(&self) -> bool {
+        self.flags() & SCOPED != 0
+    }
+
+    /// Style: check if the style uses CSS modules.
+    pub fn has_module(&self) -> bool {
+        self.flags() & HAS_MODULE != 0
+    }
+
+    /// Style: get the custom module name. Returns None if module is boolean
+    /// or not present.
+    pub fn module_name(&self) -> Option<&'a str> {
+        self.optional(44)
+    }
+
+    /// Script: check if the block has the setup attribute.
+    pub fn has_setup(&self) -> bool {
+        self.flags() & HAS_SETUP != 0
+    }
+
+    /// Script: get the setup attribute value. Returns None if setup is
+    /// boolean or not present.
+    pub fn setup(&self) -> Option<&'a str> {
+        self.optional(52)
+    }
+}
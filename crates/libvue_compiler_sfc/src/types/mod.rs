@@ -4,14 +4,24 @@
 //! to JavaScript objects. Handles are automatically freed on drop.
 
 mod attr_value;
+mod cache_stats;
+mod compile_options;
+mod compiled_sfc;
 mod custom_block;
+mod dependency_scan;
 mod descriptor;
+mod descriptor_buffer;
 mod error;
 mod handle;
 mod import_binding;
 mod parse_output;
+mod runtime_options;
+mod runtime_stats;
 mod script_block;
 mod script_output;
+mod sfc_input;
+mod sfc_output;
+mod sfc_scan;
 mod source_location;
 mod style_block;
 mod style_output;
@@ -19,13 +29,23 @@ mod template_block;
 mod template_output;
 
 pub use attr_value::AttrValue;
+pub use cache_stats::CacheStats;
+pub use compile_options::CompileOptions;
+pub use compiled_sfc::CompiledSfc;
 pub use custom_block::CustomBlock;
+pub use dependency_scan::{DependencyImport, DependencyScan, FileDependencies};
 pub use descriptor::Descriptor;
+pub use descriptor_buffer::{BlockKind, BufferBlock, DescriptorBuffer};
 pub use error::{Error, Result};
 pub use import_binding::ImportBinding;
 pub use parse_output::ParseOutput;
+pub use runtime_options::{CompilerUnits, HeapStats, ProcessOptions, RuntimeOptions};
+pub use runtime_stats::{PhaseStats, RuntimeStats};
 pub use script_block::ScriptBlock;
 pub use script_output::ScriptOutput;
+pub use sfc_input::SfcInput;
+pub use sfc_output::{DirtyParts, SfcOutput};
+pub use sfc_scan::SfcScan;
 pub use source_location::{Position, SourceLocation};
 pub use style_block::StyleBlock;
 pub use style_output::StyleOutput;
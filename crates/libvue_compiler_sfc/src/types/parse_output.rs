@@ -17,7 +17,7 @@ impl<'c> ParseOutput<'c> {
     /// Get the SFC descriptor containing all parsed blocks.
     pub fn descriptor(&self) -> Option<Descriptor<'c>> {
         let handle = unsafe { ffi::vue_parse_result_descriptor(*self.0.runtime(), self.0.raw()) };
-        Handle::new(handle, self.0.runtime()).map(Descriptor::from_handle)
+        Handle::new(handle, self.0.runtime()).and_then(Descriptor::from_handle)
     }
 
     /// Get the number of parse errors.
@@ -38,7 +38,13 @@ impl<'c> ParseOutput<'c> {
 
     /// Check if parsing produced errors.
     pub fn has_errors(&self) -> bool {
-        self.error_count() > 0 || self.descriptor().is_none()
+        self.error_count() > 0 || !self.has_descriptor()
+    }
+
+    /// Check for a descriptor without materializing it.
+    fn has_descriptor(&self) -> bool {
+        let handle = unsafe { ffi::vue_parse_result_descriptor(*self.0.runtime(), self.0.raw()) };
+        Handle::new(handle, self.0.runtime()).is_some()
     }
 
     /// Iterate over all error messages.
@@ -0,0 +1,162 @@
+//! Runtime configuration types.
+
+use std::ffi::CString;
+use std::os::raw::c_char;
+
+use super::error::{Error, Result};
+use crate::ffi;
+
+/// Heap and GC configuration of every runtime in the process, for
+/// [`Compiler::configure_process`](crate::Compiler::configure_process).
+///
+/// Static Hermes reads these settings once, when the process initializes its
+/// first runtime, and applies them to every runtime, so they cannot differ
+/// between compilers or pools. Zero sizes keep the Static Hermes defaults.
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct ProcessOptions {
+    /// Initial GC heap size of each runtime in bytes.
+    pub init_heap_bytes: usize,
+    /// Maximum GC heap size of each runtime in bytes. A compile that needs
+    /// more fails with an out-of-memory error instead of growing the process.
+    pub max_heap_bytes: usize,
+    /// Further Static Hermes VM flags for GC tuning, in command line form
+    /// (e.g. `"-gc-alloc-young=false"`). Flags are passed to Static Hermes
+    /// as given: an unknown flag is reported by its option parser, which may
+    /// exit the process.
+    pub vm_flags: Vec<String>,
+}
+
+impl ProcessOptions {
+    /// Calls `f` with the FFI representation, which borrows temporary C strings.
+    ///
+    /// # Errors
+    ///
+    /// Returns an error if a VM flag contains a NUL byte.
+    pub(crate) fn with_ffi<R>(&self, f: impl FnOnce(&ffi::HermesProcessOptions) -> R) -> Result<R> {
+        let flags = self
+            .vm_flags
+            .iter()
+            .map(|flag| CString::new(flag.as_str()))
+            .collect::<std::result::Result<Vec<_>, _>>()
+            .map_err(|_| Error::new("VM flag contains a NUL byte"))?;
+        let pointers: Vec<*const c_char> = flags.iter().map(|flag| flag.as_ptr()).collect();
+
+        let options = ffi::HermesProcessOptions {
+            init_heap_bytes: self.init_heap_bytes,
+            max_heap_bytes: self.max_heap_bytes,
+            vm_flags: pointers.as_ptr(),
+            vm_flag_count: pointers.len(),
+        };
+        Ok(f(&options))
+    }
+}
+
+/// Per-runtime configuration for [`Compiler::with_options`](crate::Compiler::with_options)
+/// and [`CompilerPool::with_options`](crate::CompilerPool::with_options).
+///
+/// Heap limits are process-wide; see [`ProcessOptions`].
+#[derive(Debug, Clone, Default, PartialEq, Eq)]
+pub struct RuntimeOptions {
+    /// Compiler units to initialize at creation. Units left out load the
+    /// first time an entry point needs them, so a worker that only compiles
+    /// templates never pays for the script compiler. Only honored with the
+    /// `split-units` feature; other builds always load the whole compiler.
+    pub units: CompilerUnits,
+}
+
+impl RuntimeOptions {
+    /// Convert to the FFI representation.
+    pub(crate) fn to_ffi(&self) -> ffi::HermesRuntimeOptions {
+        ffi::HermesRuntimeOptions {
+            units: self.units.bits(),
+        }
+    }
+}
+
+/// Parts of the bundled compiler a runtime initializes, for
+/// [`RuntimeOptions::units`] and [`Compiler::loaded_units`](crate::Compiler::loaded_units).
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct CompilerUnits(u32);
+
+impl CompilerUnits {
+    /// Parsing and descriptor loading.
+    pub const PARSE: CompilerUnits = CompilerUnits(ffi::VUE_UNIT_PARSE);
+    /// Script compilation and dependency scans.
+    pub const SCRIPT: CompilerUnits = CompilerUnits(ffi::VUE_UNIT_SCRIPT);
+    /// Template compilation.
+    pub const TEMPLATE: CompilerUnits = CompilerUnits(ffi::VUE_UNIT_TEMPLATE);
+    /// Style compilation through compiler-sfc.
+    pub const STYLE: CompilerUnits = CompilerUnits(ffi::VUE_UNIT_STYLE);
+    /// The whole compiler, which the full SFC pipeline needs.
+    pub const ALL: CompilerUnits = CompilerUnits(ffi::VUE_UNIT_ALL);
+
+    /// Returns `true` if the library was built with separately loadable
+    /// units (the `split-units` feature).
+    pub fn split_enabled() -> bool {
+        unsafe { ffi::hermes_runtime_split_units_enabled() }
+    }
+
+    /// Returns `true` if every unit of `other` is in `self`.
+    pub fn contains(self, other: CompilerUnits) -> bool {
+        self.0 & other.0 == other.0
+    }
+
+    /// The raw `VUE_UNIT_*` mask.
+    pub fn bits(self) -> u32 {
+        self.0
+    }
+
+    pub(crate) fn from_bits(bits: u32) -> Self {
+        CompilerUnits(bits & ffi::VUE_UNIT_ALL)
+    }
+}
+
+impl Default for CompilerUnits {
+    fn default() -> Self {
+        CompilerUnits::ALL
+    }
+}
+
+impl std::ops::BitOr for CompilerUnits {
+    type Output = CompilerUnits;
+
+    fn bitor(self, other: CompilerUnits) -> CompilerUnits {
+        CompilerUnits(self.0 | other.0)
+    }
+}
+
+/// Heap statistics of a compiler's runtime, from [`Compiler::heap_stats`](crate::Compiler::heap_stats).
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
+pub struct HeapStats {
+    /// Bytes currently allocated in the JS heap.
+    pub allocated_bytes: usize,
+    /// Current size of the JS heap, including free space.
+    pub heap_size: usize,
+    /// Native memory retained by JS objects outside the heap.
+    pub external_bytes: usize,
+    /// Bytes allocated over the runtime's lifetime.
+    pub total_allocated_bytes: u64,
+    /// Collections run by the GC, including explicit ones.
+    pub gc_count: u64,
+    /// Collections requested with [`Compiler::collect_garbage`](crate::Compiler::collect_garbage).
+    pub explicit_gc_count: u64,
+    /// Pause of the last explicit collection, in milliseconds.
+    pub last_gc_pause_ms: f64,
+    /// Total pause of all explicit collections, in milliseconds.
+    pub total_gc_pause_ms: f64,
+}
+
+impl HeapStats {
+    pub(crate) fn from_ffi(stats: ffi::HermesHeapStats) -> Self {
+        HeapStats {
+            allocated_bytes: stats.allocated_bytes,
+            heap_size: stats.heap_size,
+            external_bytes: stats.external_bytes,
+            total_allocated_bytes: stats.total_allocated_bytes,
+            gc_count: stats.gc_count,
+            explicit_gc_count: stats.explicit_gc_count,
+            last_gc_pause_ms: stats.last_gc_pause_ms,
+            total_gc_pause_ms: stats.total_gc_pause_ms,
+        }
+    }
+}
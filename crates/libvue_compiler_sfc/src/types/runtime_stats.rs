@@ -0,0 +1,91 @@
+//! Runtime instrumentation counters.
+
+use std::time::Duration;
+
+use crate::ffi;
+
+/// Calls and time spent in one instrumented phase.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct PhaseStats {
+    /// Number of calls.
+    pub calls: u64,
+    /// Total time spent in those calls.
+    pub time: Duration,
+}
+
+impl PhaseStats {
+    fn from_ffi(phase: ffi::VuePhaseStats) -> Self {
+        PhaseStats {
+            calls: phase.calls,
+            time: Duration::from_nanos(phase.nanos),
+        }
+    }
+}
+
+/// Instrumentation counters of a [`Compiler`](crate::Compiler)'s runtime.
+///
+/// Counters are only maintained when the crate is built with the `stats`
+/// feature (see [`RuntimeStats::enabled`]); otherwise they are all zero.
+/// Compile phases time the JS call alone; converting inputs and reading
+/// results show up in `bytes_in` and `marshal_out`.
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct RuntimeStats {
+    /// Parsing.
+    pub parse: PhaseStats,
+    /// Script compilation.
+    pub compile_script: PhaseStats,
+    /// Template compilation.
+    pub compile_template: PhaseStats,
+    /// Style compilation through the JS compiler; the native rewriter of
+    /// [`CompileOptions::native_style`](crate::CompileOptions::native_style)
+    /// is not timed.
+    pub compile_style: PhaseStats,
+    /// Whole-pipeline compilation: single, incremental and batch.
+    pub compile_sfc: PhaseStats,
+    /// The script import scan of
+    /// [`Compiler::scan_dependencies`](crate::Compiler::scan_dependencies).
+    pub scan_dependencies: PhaseStats,
+    /// Accessor calls reading results out of JS.
+    pub marshal_out: PhaseStats,
+    /// UTF-8 bytes of sources, filenames and ids passed into JS.
+    pub bytes_in: u64,
+    /// UTF-8 bytes converted out of the JS heap.
+    pub bytes_out: u64,
+    /// Handles allocated, including ones since freed.
+    pub handles_allocated: u64,
+    /// Bytes copied into per-handle string storage.
+    pub string_bytes: u64,
+}
+
+impl RuntimeStats {
+    /// Returns `true` if the library was built with instrumentation.
+    pub fn enabled() -> bool {
+        unsafe { ffi::hermes_runtime_stats_enabled() }
+    }
+
+    /// Returns the total time spent in compile phases, excluding marshalling.
+    pub fn js_time(&self) -> Duration {
+        self.parse.time
+            + self.compile_script.time
+            + self.compile_template.time
+            + self.compile_style.time
+            + self.compile_sfc.time
+            + self.scan_dependencies.time
+    }
+
+    pub(crate) fn from_ffi(stats: ffi::HermesRuntimeStats) -> Self {
+        RuntimeStats {
+            parse: PhaseStats::from_ffi(stats.parse),
+            compile_script: PhaseStats::from_ffi(stats.compile_script),
+            compile_template: PhaseStats::from_ffi(stats.compile_template),
+            compile_style: PhaseStats::from_ffi(stats.compile_style),
+            compile_sfc: PhaseStats::from_ffi(stats.compile_sfc),
+            scan_dependencies: PhaseStats::from_ffi(stats.scan_dependencies),
+            marshal_out: PhaseStats::from_ffi(stats.marshal_out),
+            bytes_in: stats.bytes_in,
+            bytes_out: stats.bytes_out,
+            handles_allocated: stats.handles_allocated,
+            string_bytes: stats.string_bytes,
+        }
+    }
+}
@@ -1,67 +1,128 @@
 //! Script block type for SFC parsing.
 
+use std::cell::OnceCell;
 use std::collections::HashMap;
+use std::ffi::c_void;
+use std::ops::Range;
 
 use super::attr_value::AttrValue;
-use super::custom_block::{get_block_attrs, get_block_loc};
+use super::custom_block::{block_attrs, block_content_range, block_loc, block_src};
 use super::handle::Handle;
 use super::import_binding::ImportBinding;
 use super::source_location::SourceLocation;
-use crate::ffi;
-use crate::util::ptr_to_str;
+use crate::ffi::{self, VueBlockSnapshot, VueImportEntry};
+use crate::util::{collect_pairs, collect_strings, vue_str};
+
+/// Collect the imports of a script block or script compilation result.
+pub(crate) fn collect_imports(handle: &Handle<'_>) -> HashMap<String, ImportBinding> {
+    unsafe extern "C" fn insert(user_data: *mut c_void, entry: *const VueImportEntry) -> bool {
+        let imports = &mut *(user_data as *mut HashMap<String, ImportBinding>);
+        let entry = &*entry;
+        let binding = ImportBinding {
+            is_type: entry.is_type,
+            imported: vue_str(entry.imported).to_owned(),
+            source: vue_str(entry.source).to_owned(),
+            is_from_setup: entry.is_from_setup,
+        };
+        imports.insert(vue_str(entry.local).to_owned(), binding);
+        true
+    }
+
+    let mut imports = HashMap::new();
+    unsafe {
+        ffi::vue_script_imports_for_each(
+            *handle.runtime(),
+            handle.raw(),
+            insert,
+            &mut imports as *mut HashMap<String, ImportBinding> as *mut c_void,
+        );
+    }
+    imports
+}
 
 /// Script block from an SFC.
-pub struct ScriptBlock<'c>(pub(crate) Handle<'c>);
+///
+/// Block fields are read from the descriptor snapshot. Analysis results
+/// (bindings, imports, warnings, deps) still live on the JS block object,
+/// whose handle is acquired on first use.
+pub struct ScriptBlock<'d> {
+    block: &'d VueBlockSnapshot,
+    descriptor: &'d Handle<'d>,
+    handle: OnceCell<Option<Handle<'d>>>,
+}
 
-impl<'c> ScriptBlock<'c> {
-    pub(crate) fn from_handle(handle: Handle<'c>) -> Self {
-        ScriptBlock(handle)
+impl<'d> ScriptBlock<'d> {
+    pub(crate) fn from_snapshot(block: &'d VueBlockSnapshot, descriptor: &'d Handle<'d>) -> Self {
+        ScriptBlock {
+            block,
+            descriptor,
+            handle: OnceCell::new(),
+        }
+    }
+
+    /// Handle to the JS block object (`script` or `scriptSetup`).
+    fn handle(&self) -> Option<&Handle<'d>> {
+        self.handle
+            .get_or_init(|| {
+                let rt = *self.descriptor.runtime();
+                let raw = unsafe {
+                    if self.block.has_setup {
+                        ffi::vue_descriptor_script_setup(rt, self.descriptor.raw())
+                    } else {
+                        ffi::vue_descriptor_script(rt, self.descriptor.raw())
+                    }
+                };
+                Handle::new(raw, self.descriptor.runtime())
+            })
+            .as_ref()
     }
-}
 
-impl ScriptBlock<'_> {
     /// Get the script content.
-    pub fn content(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_block_content(*self.0.runtime(), self.0.raw())) }
+    pub fn content(&self) -> &'d str {
+        unsafe { vue_str(self.block.content) }
     }
 
     /// Get the script language (e.g., "ts").
-    pub fn lang(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_block_lang(*self.0.runtime(), self.0.raw())) }
+    pub fn lang(&self) -> &'d str {
+        unsafe { vue_str(self.block.lang) }
     }
 
     /// Get the src attribute if present (external file reference).
-    pub fn src(&self) -> Option<&str> {
-        let s = unsafe { ptr_to_str(ffi::vue_block_src(*self.0.runtime(), self.0.raw())) };
-        if s.is_empty() {
-            None
-        } else {
-            Some(s)
-        }
+    pub fn src(&self) -> Option<&'d str> {
+        block_src(self.block)
+    }
+
+    /// Get the byte range of the content within the source passed to
+    /// [`Compiler::parse_borrowed`](crate::Compiler::parse_borrowed).
+    ///
+    /// Returns None if the content was copied (regular `parse`, or content
+    /// the parser transformed).
+    pub fn content_range(&self) -> Option<Range<usize>> {
+        block_content_range(self.block)
     }
 
     /// Get the source location of the block.
     pub fn loc(&self) -> SourceLocation {
-        get_block_loc(*self.0.runtime(), self.0.raw())
+        block_loc(self.block)
     }
 
     /// Get all attributes on the block.
     pub fn attrs(&self) -> HashMap<String, AttrValue> {
-        get_block_attrs(*self.0.runtime(), self.0.raw())
+        block_attrs(self.block)
     }
 
     /// Check if this is a setup script block.
     pub fn is_setup(&self) -> bool {
-        unsafe { ffi::vue_script_has_setup(*self.0.runtime(), self.0.raw()) }
+        self.block.has_setup
     }
 
     /// Get the setup attribute value if it's a string.
     /// Returns None if setup is boolean true or not present.
-    pub fn setup_value(&self) -> Option<&str> {
+    pub fn setup_value(&self) -> Option<&'d str> {
         if !self.is_setup() {
             return None;
         }
-        let s = unsafe { ptr_to_str(ffi::vue_script_setup_value(*self.0.runtime(), self.0.raw())) };
+        let s = unsafe { vue_str(self.block.setup) };
         if s.is_empty() {
             None
         } else {
@@ -71,7 +132,9 @@ impl ScriptBlock<'_> {
 
     /// Get the number of bindings in the script block.
     pub fn bindings_count(&self) -> usize {
-        unsafe { ffi::vue_script_bindings_count(*self.0.runtime(), self.0.raw()) }
+        self.handle().map_or(0, |h| unsafe {
+            ffi::vue_script_bindings_count(*h.runtime(), h.raw())
+        })
     }
 
     /// Get the variable bindings as a map of variable name to binding type.
@@ -79,117 +142,57 @@ impl ScriptBlock<'_> {
     /// Binding types are strings like "setup-const", "setup-ref", "setup-maybe-ref",
     /// "setup-reactive-const", "props", "props-aliased", "data", "options", etc.
     pub fn bindings(&self) -> HashMap<String, String> {
-        let count = self.bindings_count();
-        let mut bindings = HashMap::with_capacity(count);
-
-        for i in 0..count {
-            let key = unsafe {
-                ptr_to_str(ffi::vue_script_bindings_key_at(
-                    *self.0.runtime(),
-                    self.0.raw(),
-                    i,
-                ))
-                .to_string()
-            };
-            let value = unsafe {
-                ptr_to_str(ffi::vue_script_bindings_value_at(
-                    *self.0.runtime(),
-                    self.0.raw(),
-                    i,
-                ))
-                .to_string()
-            };
-            bindings.insert(key, value);
-        }
-
-        bindings
+        let Some(h) = self.handle() else {
+            return HashMap::new();
+        };
+        collect_pairs(|callback, user_data| unsafe {
+            ffi::vue_script_bindings_for_each(*h.runtime(), h.raw(), callback, user_data)
+        })
     }
 
     /// Get the number of imports in the script block.
     pub fn imports_count(&self) -> usize {
-        unsafe { ffi::vue_script_imports_count(*self.0.runtime(), self.0.raw()) }
+        self.handle().map_or(0, |h| unsafe {
+            ffi::vue_script_imports_count(*h.runtime(), h.raw())
+        })
     }
 
     /// Get the import bindings as a map of local name to import metadata.
     pub fn imports(&self) -> HashMap<String, ImportBinding> {
-        let count = self.imports_count();
-        let mut imports = HashMap::with_capacity(count);
-
-        let rt = *self.0.runtime();
-
-        for i in 0..count {
-            let key = unsafe {
-                ptr_to_str(ffi::vue_script_imports_key_at(rt, self.0.raw(), i)).to_string()
-            };
-            let handle = unsafe { ffi::vue_script_imports_value_at(rt, self.0.raw(), i) };
-
-            if handle.is_valid() {
-                // Extract data directly from the handle
-                let is_type = unsafe { ffi::vue_import_binding_is_type(rt, handle) };
-                let imported =
-                    unsafe { ptr_to_str(ffi::vue_import_binding_imported(rt, handle)).to_string() };
-                let source =
-                    unsafe { ptr_to_str(ffi::vue_import_binding_source(rt, handle)).to_string() };
-                let is_from_setup = unsafe { ffi::vue_import_binding_is_from_setup(rt, handle) };
-
-                let binding = ImportBinding {
-                    is_type,
-                    imported,
-                    source,
-                    is_from_setup,
-                };
-                imports.insert(key, binding);
-
-                // Free the handle
-                unsafe { ffi::hermes_handle_free(rt, handle) };
-            }
-        }
-
-        imports
+        self.handle().map_or_else(HashMap::new, collect_imports)
     }
 
     /// Get the number of warnings in the script block.
     pub fn warnings_count(&self) -> usize {
-        unsafe { ffi::vue_script_warnings_count(*self.0.runtime(), self.0.raw()) }
+        self.handle().map_or(0, |h| unsafe {
+            ffi::vue_script_warnings_count(*h.runtime(), h.raw())
+        })
     }
 
     /// Get the warnings from the script block.
     pub fn warnings(&self) -> Vec<String> {
-        let count = self.warnings_count();
-        let mut warnings = Vec::with_capacity(count);
-
-        for i in 0..count {
-            let warning = unsafe {
-                ptr_to_str(ffi::vue_script_warning_at(
-                    *self.0.runtime(),
-                    self.0.raw(),
-                    i,
-                ))
-                .to_string()
-            };
-            warnings.push(warning);
-        }
-
-        warnings
+        let Some(h) = self.handle() else {
+            return Vec::new();
+        };
+        collect_strings(|callback, user_data| unsafe {
+            ffi::vue_script_warnings_for_each(*h.runtime(), h.raw(), callback, user_data)
+        })
     }
 
     /// Get the number of dependencies in the script block.
     pub fn deps_count(&self) -> usize {
-        unsafe { ffi::vue_script_deps_count(*self.0.runtime(), self.0.raw()) }
+        self.handle().map_or(0, |h| unsafe {
+            ffi::vue_script_deps_count(*h.runtime(), h.raw())
+        })
     }
 
     /// Get the dependencies (imported modules) from the script block.
     pub fn deps(&self) -> Vec<String> {
-        let count = self.deps_count();
-        let mut deps = Vec::with_capacity(count);
-
-        for i in 0..count {
-            let dep = unsafe {
-                ptr_to_str(ffi::vue_script_dep_at(*self.0.runtime(), self.0.raw(), i)).to_string()
-            };
-            deps.push(dep);
-        }
-
-        deps
+        let Some(h) = self.handle() else {
+            return Vec::new();
+        };
+        collect_strings(|callback, user_data| unsafe {
+            ffi::vue_script_deps_for_each(*h.runtime(), h.raw(), callback, user_data)
+        })
     }
 }
@@ -1,8 +1,13 @@
 //! Script compilation output type.
 
+use std::collections::HashMap;
+use std::io;
+
 use super::handle::Handle;
+use super::import_binding::ImportBinding;
+use super::script_block::collect_imports;
 use crate::ffi::{self, HermesHandle};
-use crate::util::ptr_to_str;
+use crate::util::{collect_pairs, collect_strings, ptr_to_str, write_chunks};
 
 /// Output of compiling script blocks.
 pub struct ScriptOutput<'c>(Handle<'c>);
@@ -22,8 +27,65 @@ impl<'c> ScriptOutput<'c> {
         }
     }
 
+    /// Write the compiled script content to `out` straight from the JS heap, without caching
+    /// it on this output as [`content`](Self::content) does.
+    ///
+    /// Returns the number of bytes written.
+    ///
+    /// # Errors
+    ///
+    /// Returns the first error reported by `out`.
+    pub fn write_content<W: io::Write>(&self, out: &mut W) -> io::Result<usize> {
+        write_chunks(out, |callback, user_data| unsafe {
+            ffi::vue_script_result_content_write(
+                *self.0.runtime(),
+                self.0.raw(),
+                callback,
+                user_data,
+            )
+        })
+    }
+
+    /// Get the bindings as a map of variable name to binding type.
+    pub fn bindings(&self) -> HashMap<String, String> {
+        collect_pairs(|callback, user_data| unsafe {
+            ffi::vue_script_bindings_for_each(*self.0.runtime(), self.0.raw(), callback, user_data)
+        })
+    }
+
+    /// Get the imports as a map of local name to import metadata.
+    pub fn imports(&self) -> HashMap<String, ImportBinding> {
+        collect_imports(&self.0)
+    }
+
+    /// Get the warnings reported while compiling the script.
+    pub fn warnings(&self) -> Vec<String> {
+        collect_strings(|callback, user_data| unsafe {
+            ffi::vue_script_warnings_for_each(*self.0.runtime(), self.0.raw(), callback, user_data)
+        })
+    }
+
     /// Get the internal bindings handle for template compilation.
     pub(crate) fn bindings_handle(&self) -> HermesHandle {
         unsafe { ffi::vue_script_result_bindings(*self.0.runtime(), self.0.raw()) }
     }
+
+    /// Get the source map as JSON.
+    ///
+    /// `None` unless the script was compiled with
+    /// [`CompileOptions::source_map`](crate::CompileOptions::source_map).
+    pub fn map(&self) -> Option<&str> {
+        let map =
+            unsafe { ptr_to_str(ffi::vue_script_result_map(*self.0.runtime(), self.0.raw())) };
+        (!map.is_empty()).then_some(map)
+    }
+
+    /// Returns `true` if the render function was inlined into the content.
+    ///
+    /// Only set when compiled with
+    /// [`CompileOptions::inline_template`](crate::CompileOptions::inline_template)
+    /// and the component has `<script setup>` and an inline template.
+    pub fn has_inline_template(&self) -> bool {
+        unsafe { ffi::vue_script_result_has_inline_template(*self.0.runtime(), self.0.raw()) }
+    }
 }
@@ -0,0 +1,39 @@
+//! Batch input type.
+
+use std::os::raw::c_char;
+
+use crate::ffi;
+
+/// One SFC to compile in a batch.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct SfcInput<'a> {
+    /// SFC source code.
+    pub source: &'a str,
+    /// Filename used for error messages and source maps.
+    pub filename: &'a str,
+    /// Scope ID for scoped styles.
+    pub id: &'a str,
+}
+
+impl<'a> SfcInput<'a> {
+    /// Create an input.
+    pub fn new(source: &'a str, filename: &'a str, id: &'a str) -> Self {
+        SfcInput {
+            source,
+            filename,
+            id,
+        }
+    }
+
+    /// Convert to the FFI representation. Borrows the input's strings.
+    pub(crate) fn to_ffi(self) -> ffi::VueSfcInput {
+        ffi::VueSfcInput {
+            source: self.source.as_ptr() as *const c_char,
+            source_len: self.source.len(),
+            filename: self.filename.as_ptr() as *const c_char,
+            filename_len: self.filename.len(),
+            id: self.id.as_ptr() as *const c_char,
+            id_len: self.id.len(),
+        }
+    }
+}
@@ -0,0 +1,168 @@
+//! Full SFC pipeline output type.
+
+use std::io;
+
+use super::handle::Handle;
+use crate::ffi::{self, HermesHandle, HermesRuntime};
+use crate::util::{ptr_to_str, write_chunks};
+
+/// Parts of an SFC recompiled by
+/// [`Compiler::compile_sfc_incremental`](crate::Compiler::compile_sfc_incremental).
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub struct DirtyParts(u32);
+
+impl DirtyParts {
+    /// Every part: a full compile.
+    pub const ALL: DirtyParts = DirtyParts(ffi::VUE_SFC_DIRTY_ALL);
+
+    /// The script was recompiled.
+    pub fn script(self) -> bool {
+        self.0 & ffi::VUE_SFC_DIRTY_SCRIPT != 0
+    }
+
+    /// The template (render function) was recompiled.
+    pub fn template(self) -> bool {
+        self.0 & ffi::VUE_SFC_DIRTY_TEMPLATE != 0
+    }
+
+    /// At least one style block was recompiled.
+    pub fn style(self) -> bool {
+        self.0 & ffi::VUE_SFC_DIRTY_STYLE != 0
+    }
+
+    /// Custom blocks changed. They are not compiled; this only reports it.
+    pub fn custom(self) -> bool {
+        self.0 & ffi::VUE_SFC_DIRTY_CUSTOM != 0
+    }
+
+    /// Nothing was recompiled: the new source compiles to the same output.
+    pub fn is_clean(self) -> bool {
+        self.0 == 0
+    }
+
+    /// Only styles changed, so a style-only HMR update suffices.
+    pub fn is_style_only(self) -> bool {
+        self.0 == ffi::VUE_SFC_DIRTY_STYLE
+    }
+
+    /// Only the template changed, so a rerender suffices.
+    pub fn is_template_only(self) -> bool {
+        self.0 == ffi::VUE_SFC_DIRTY_TEMPLATE
+    }
+
+    /// The raw `VUE_SFC_DIRTY_*` mask.
+    pub fn bits(self) -> u32 {
+        self.0
+    }
+}
+
+/// Output of compiling a complete SFC with [`Compiler::compile_sfc`](crate::Compiler::compile_sfc)
+/// or [`Compiler::compile_sfc_incremental`](crate::Compiler::compile_sfc_incremental).
+pub struct SfcOutput<'c>(Handle<'c>);
+
+impl<'c> SfcOutput<'c> {
+    pub(crate) fn from_raw(handle: HermesHandle, runtime: &'c HermesRuntime) -> Self {
+        SfcOutput(Handle::new(handle, runtime).expect("Invalid handle"))
+    }
+
+    /// Get the compiled JavaScript (script content followed by the render function).
+    pub fn js(&self) -> &str {
+        unsafe { ptr_to_str(ffi::vue_sfc_result_js(*self.0.runtime(), self.0.raw())) }
+    }
+
+    /// Write the compiled JavaScript to `out` straight from the JS heap, without caching
+    /// it on this output as [`js`](Self::js) does.
+    ///
+    /// Returns the number of bytes written.
+    ///
+    /// # Errors
+    ///
+    /// Returns the first error reported by `out`.
+    pub fn write_js<W: io::Write>(&self, out: &mut W) -> io::Result<usize> {
+        write_chunks(out, |callback, user_data| unsafe {
+            ffi::vue_sfc_result_js_write(*self.0.runtime(), self.0.raw(), callback, user_data)
+        })
+    }
+
+    /// Get the compiled CSS of all style blocks.
+    pub fn css(&self) -> &str {
+        unsafe { ptr_to_str(ffi::vue_sfc_result_css(*self.0.runtime(), self.0.raw())) }
+    }
+
+    /// Write the compiled CSS to `out` straight from the JS heap, without caching
+    /// it on this output as [`css`](Self::css) does.
+    ///
+    /// Returns the number of bytes written.
+    ///
+    /// # Errors
+    ///
+    /// Returns the first error reported by `out`.
+    pub fn write_css<W: io::Write>(&self, out: &mut W) -> io::Result<usize> {
+        write_chunks(out, |callback, user_data| unsafe {
+            ffi::vue_sfc_result_css_write(*self.0.runtime(), self.0.raw(), callback, user_data)
+        })
+    }
+
+    /// Get the render function alone, for rerender updates. Empty unless this
+    /// is an incremental result of an SFC with a template.
+    pub fn render(&self) -> &str {
+        unsafe { ptr_to_str(ffi::vue_sfc_result_render(*self.0.runtime(), self.0.raw())) }
+    }
+
+    /// Get the parts recompiled by an incremental compile. Full compiles
+    /// report [`DirtyParts::ALL`].
+    pub fn dirty(&self) -> DirtyParts {
+        DirtyParts(unsafe { ffi::vue_sfc_result_dirty(*self.0.runtime(), self.0.raw()) })
+    }
+
+    pub(crate) fn raw(&self) -> HermesHandle {
+        self.0.raw()
+    }
+
+    /// Get the number of errors reported by any pipeline step.
+    pub fn error_count(&self) -> usize {
+        unsafe { ffi::vue_sfc_result_error_count(*self.0.runtime(), self.0.raw()) }
+    }
+
+    /// Get an error message by index.
+    pub fn error_message(&self, index: usize) -> &str {
+        unsafe {
+            ptr_to_str(ffi::vue_sfc_result_error_at(
+                *self.0.runtime(),
+                self.0.raw(),
+                index,
+            ))
+        }
+    }
+
+    /// Check if any pipeline step produced errors.
+    pub fn has_errors(&self) -> bool {
+        self.error_count() > 0
+    }
+
+    /// Iterate over all error messages.
+    pub fn errors(&self) -> impl Iterator<Item = &str> {
+        (0..self.error_count()).map(move |i| self.error_message(i))
+    }
+
+    /// Get the number of warnings reported by any pipeline step.
+    pub fn warning_count(&self) -> usize {
+        unsafe { ffi::vue_sfc_result_warning_count(*self.0.runtime(), self.0.raw()) }
+    }
+
+    /// Get a warning message by index.
+    pub fn warning_message(&self, index: usize) -> &str {
+        unsafe {
+            ptr_to_str(ffi::vue_sfc_result_warning_at(
+                *self.0.runtime(),
+                self.0.raw(),
+                index,
+            ))
+        }
+    }
+
+    /// Iterate over all warning messages.
+    pub fn warnings(&self) -> impl Iterator<Item = &str> {
+        (0..self.warning_count()).map(move |i| self.warning_message(i))
+    }
+}
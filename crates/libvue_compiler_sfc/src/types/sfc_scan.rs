@@ -0,0 +1,54 @@
+//! Runtime-free block scan of an SFC.
+
+use super::descriptor_buffer::DescriptorBuffer;
+use crate::ffi;
+use crate::util::ffi_slice;
+
+/// The blocks of an SFC, split natively without a runtime.
+///
+/// For tools that only need the block structure, scanning replaces
+/// [`Compiler::parse`](crate::Compiler::parse): the result is the descriptor
+/// the parser would produce, as a [`DescriptorBuffer`], so it is `Send` and
+/// `Sync`, needs no [`Compiler`](crate::Compiler), and can still be compiled
+/// with [`Compiler::load_descriptor`](crate::Compiler::load_descriptor).
+/// Template markup is only scanned for the end of the template block, not
+/// parsed or validated.
+pub struct SfcScan(ffi::VueSfcScan);
+
+// SAFETY: the scan is immutable heap data that does not reference any runtime.
+unsafe impl Send for SfcScan {}
+unsafe impl Sync for SfcScan {}
+
+impl SfcScan {
+    /// Scan an SFC.
+    ///
+    /// Returns `None` if the source has block-level parse errors (duplicate
+    /// or unclosed blocks, no template or script, ...) or uses one of the rare
+    /// constructs the scanner does not reproduce, such as directives on block
+    /// tags or `v-pre`; parse those with [`Compiler::parse`](crate::Compiler::parse).
+    pub fn new(source: &str, filename: &str) -> Option<Self> {
+        let raw = unsafe {
+            ffi::vue_sfc_scan(
+                source.as_ptr().cast(),
+                source.len(),
+                filename.as_ptr().cast(),
+                filename.len(),
+            )
+        };
+        (!raw.is_null()).then_some(SfcScan(raw))
+    }
+
+    /// Get the scanned descriptor.
+    pub fn descriptor(&self) -> DescriptorBuffer<'_> {
+        let mut len = 0;
+        let data = unsafe { ffi::vue_sfc_scan_data(self.0, &mut len) };
+        DescriptorBuffer::new(unsafe { ffi_slice(data, len) })
+            .expect("the scanner writes valid descriptors")
+    }
+}
+
+impl Drop for SfcScan {
+    fn drop(&mut self) {
+        unsafe { ffi::vue_sfc_scan_free(self.0) }
+    }
+}
@@ -1,71 +1,75 @@
 //! Style block type for SFC parsing.
 
 use std::collections::HashMap;
+use std::ops::Range;
 
 use super::attr_value::AttrValue;
-use super::custom_block::{get_block_attrs, get_block_loc};
-use super::handle::Handle;
+use super::custom_block::{block_attrs, block_content_range, block_loc, block_src};
 use super::source_location::SourceLocation;
-use crate::ffi;
-use crate::util::ptr_to_str;
+use crate::ffi::VueBlockSnapshot;
+use crate::util::vue_str;
 
 /// Style block from an SFC.
-pub struct StyleBlock<'c>(pub(crate) Handle<'c>);
+///
+/// A view into the descriptor snapshot; borrows the parent [`Descriptor`](super::Descriptor).
+pub struct StyleBlock<'d>(pub(crate) &'d VueBlockSnapshot);
 
-impl<'c> StyleBlock<'c> {
-    pub(crate) fn from_handle(handle: Handle<'c>) -> Self {
-        StyleBlock(handle)
+impl<'d> StyleBlock<'d> {
+    pub(crate) fn from_snapshot(block: &'d VueBlockSnapshot) -> Self {
+        StyleBlock(block)
     }
-}
 
-impl StyleBlock<'_> {
     /// Get the style content.
-    pub fn content(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_block_content(*self.0.runtime(), self.0.raw())) }
+    pub fn content(&self) -> &'d str {
+        unsafe { vue_str(self.0.content) }
     }
 
     /// Get the style language (e.g., "scss").
-    pub fn lang(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_block_lang(*self.0.runtime(), self.0.raw())) }
+    pub fn lang(&self) -> &'d str {
+        unsafe { vue_str(self.0.lang) }
     }
 
     /// Check if the style is scoped.
     pub fn is_scoped(&self) -> bool {
-        unsafe { ffi::vue_style_is_scoped(*self.0.runtime(), self.0.raw()) }
+        self.0.scoped
     }
 
     /// Get the src attribute if present (external file reference).
-    pub fn src(&self) -> Option<&str> {
-        let s = unsafe { ptr_to_str(ffi::vue_block_src(*self.0.runtime(), self.0.raw())) };
-        if s.is_empty() {
-            None
-        } else {
-            Some(s)
-        }
+    pub fn src(&self) -> Option<&'d str> {
+        block_src(self.0)
+    }
+
+    /// Get the byte range of the content within the source passed to
+    /// [`Compiler::parse_borrowed`](crate::Compiler::parse_borrowed).
+    ///
+    /// Returns None if the content was copied (regular `parse`, or content
+    /// the parser transformed).
+    pub fn content_range(&self) -> Option<Range<usize>> {
+        block_content_range(self.0)
     }
 
     /// Get the source location of the block.
     pub fn loc(&self) -> SourceLocation {
-        get_block_loc(*self.0.runtime(), self.0.raw())
+        block_loc(self.0)
     }
 
     /// Get all attributes on the block.
     pub fn attrs(&self) -> HashMap<String, AttrValue> {
-        get_block_attrs(*self.0.runtime(), self.0.raw())
+        block_attrs(self.0)
     }
 
     /// Check if the style uses CSS modules.
     pub fn has_module(&self) -> bool {
-        unsafe { ffi::vue_style_has_module(*self.0.runtime(), self.0.raw()) }
+        self.0.has_module
     }
 
     /// Get the module attribute value if it's a string (custom module name).
     /// Returns None if module is boolean true or not present.
-    pub fn module_name(&self) -> Option<&str> {
+    pub fn module_name(&self) -> Option<&'d str> {
         if !self.has_module() {
             return None;
         }
-        let s = unsafe { ptr_to_str(ffi::vue_style_module_value(*self.0.runtime(), self.0.raw())) };
+        let s = unsafe { vue_str(self.0.module) };
         if s.is_empty() {
             None
         } else {
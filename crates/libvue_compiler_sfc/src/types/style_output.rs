@@ -1,8 +1,10 @@
 //! Style compilation output type.
 
+use std::io;
+
 use super::handle::Handle;
 use crate::ffi::{self, HermesHandle, HermesRuntime};
-use crate::util::ptr_to_str;
+use crate::util::{ptr_to_str, write_chunks};
 
 /// Output of compiling a style block.
 pub struct StyleOutput<'c>(Handle<'c>);
@@ -16,4 +18,18 @@ impl<'c> StyleOutput<'c> {
     pub fn code(&self) -> &str {
         unsafe { ptr_to_str(ffi::vue_style_result_code(*self.0.runtime(), self.0.raw())) }
     }
+
+    /// Write the compiled CSS to `out` straight from the JS heap, without caching
+    /// it on this output as [`code`](Self::code) does.
+    ///
+    /// Returns the number of bytes written.
+    ///
+    /// # Errors
+    ///
+    /// Returns the first error reported by `out`.
+    pub fn write_code<W: io::Write>(&self, out: &mut W) -> io::Result<usize> {
+        write_chunks(out, |callback, user_data| unsafe {
+            ffi::vue_style_result_code_write(*self.0.runtime(), self.0.raw(), callback, user_data)
+        })
+    }
 }
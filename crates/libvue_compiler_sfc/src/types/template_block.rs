@@ -1,51 +1,55 @@
 //! Template block type for SFC parsing.
 
 use std::collections::HashMap;
+use std::ops::Range;
 
 use super::attr_value::AttrValue;
-use super::custom_block::{get_block_attrs, get_block_loc};
-use super::handle::Handle;
+use super::custom_block::{block_attrs, block_content_range, block_loc, block_src};
 use super::source_location::SourceLocation;
-use crate::ffi;
-use crate::util::ptr_to_str;
+use crate::ffi::VueBlockSnapshot;
+use crate::util::vue_str;
 
 /// Template block from an SFC.
-pub struct TemplateBlock<'c>(pub(crate) Handle<'c>);
+///
+/// A view into the descriptor snapshot; borrows the parent [`Descriptor`](super::Descriptor).
+pub struct TemplateBlock<'d>(pub(crate) &'d VueBlockSnapshot);
 
-impl<'c> TemplateBlock<'c> {
-    pub(crate) fn from_handle(handle: Handle<'c>) -> Self {
-        TemplateBlock(handle)
+impl<'d> TemplateBlock<'d> {
+    pub(crate) fn from_snapshot(block: &'d VueBlockSnapshot) -> Self {
+        TemplateBlock(block)
     }
-}
 
-impl TemplateBlock<'_> {
     /// Get the template content.
-    pub fn content(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_block_content(*self.0.runtime(), self.0.raw())) }
+    pub fn content(&self) -> &'d str {
+        unsafe { vue_str(self.0.content) }
     }
 
     /// Get the template language (e.g., "pug").
-    pub fn lang(&self) -> &str {
-        unsafe { ptr_to_str(ffi::vue_block_lang(*self.0.runtime(), self.0.raw())) }
+    pub fn lang(&self) -> &'d str {
+        unsafe { vue_str(self.0.lang) }
     }
 
     /// Get the src attribute if present (external file reference).
-    pub fn src(&self) -> Option<&str> {
-        let s = unsafe { ptr_to_str(ffi::vue_block_src(*self.0.runtime(), self.0.raw())) };
-        if s.is_empty() {
-            None
-        } else {
-            Some(s)
-        }
+    pub fn src(&self) -> Option<&'d str> {
+        block_src(self.0)
+    }
+
+    /// Get the byte range of the content within the source passed to
+    /// [`Compiler::parse_borrowed`](crate::Compiler::parse_borrowed).
+    ///
+    /// Returns None if the content was copied (regular `parse`, or content
+    /// the parser transformed).
+    pub fn content_range(&self) -> Option<Range<usize>> {
+        block_content_range(self.0)
     }
 
     /// Get the source location of the block.
     pub fn loc(&self) -> SourceLocation {
-        get_block_loc(*self.0.runtime(), self.0.raw())
+        block_loc(self.0)
     }
 
     /// Get all attributes on the block.
     pub fn attrs(&self) -> HashMap<String, AttrValue> {
-        get_block_attrs(*self.0.runtime(), self.0.raw())
+        block_attrs(self.0)
     }
 }
@@ -1,8 +1,10 @@
 //! Template compilation output type.
 
+use std::io;
+
 use super::handle::Handle;
 use crate::ffi::{self, HermesHandle, HermesRuntime};
-use crate::util::ptr_to_str;
+use crate::util::{collect_strings, ptr_to_str, write_chunks};
 
 /// Output of compiling a template.
 pub struct TemplateOutput<'c>(Handle<'c>);
@@ -22,6 +24,25 @@ impl<'c> TemplateOutput<'c> {
         }
     }
 
+    /// Write the compiled template code to `out` straight from the JS heap, without caching
+    /// it on this output as [`code`](Self::code) does.
+    ///
+    /// Returns the number of bytes written.
+    ///
+    /// # Errors
+    ///
+    /// Returns the first error reported by `out`.
+    pub fn write_code<W: io::Write>(&self, out: &mut W) -> io::Result<usize> {
+        write_chunks(out, |callback, user_data| unsafe {
+            ffi::vue_template_result_code_write(
+                *self.0.runtime(),
+                self.0.raw(),
+                callback,
+                user_data,
+            )
+        })
+    }
+
     /// Get the number of compilation errors.
     pub fn error_count(&self) -> usize {
         unsafe { ffi::vue_template_result_error_count(*self.0.runtime(), self.0.raw()) }
@@ -31,4 +52,59 @@ impl<'c> TemplateOutput<'c> {
     pub fn has_errors(&self) -> bool {
         self.error_count() > 0
     }
+
+    /// Get all error messages.
+    pub fn errors(&self) -> Vec<String> {
+        collect_strings(|callback, user_data| unsafe {
+            ffi::vue_template_result_errors_for_each(
+                *self.0.runtime(),
+                self.0.raw(),
+                callback,
+                user_data,
+            )
+        })
+    }
+
+    /// Get the source map as JSON.
+    ///
+    /// `None` unless the template was compiled with
+    /// [`CompileOptions::source_map`](crate::CompileOptions::source_map).
+    pub fn map(&self) -> Option<&str> {
+        let map = unsafe {
+            ptr_to_str(ffi::vue_template_result_map(
+                *self.0.runtime(),
+                self.0.raw(),
+            ))
+        };
+        (!map.is_empty()).then_some(map)
+    }
+
+    /// Get the preamble (hoisted imports for inline mode).
+    ///
+    /// `None` unless the template was compiled with
+    /// [`CompileOptions::keep_preamble`](crate::CompileOptions::keep_preamble).
+    pub fn preamble(&self) -> Option<&str> {
+        let preamble = unsafe {
+            ptr_to_str(ffi::vue_template_result_preamble(
+                *self.0.runtime(),
+                self.0.raw(),
+            ))
+        };
+        (!preamble.is_empty()).then_some(preamble)
+    }
+
+    /// Get the compiler tips.
+    ///
+    /// Empty unless the template was compiled with
+    /// [`CompileOptions::keep_tips`](crate::CompileOptions::keep_tips).
+    pub fn tips(&self) -> Vec<String> {
+        collect_strings(|callback, user_data| unsafe {
+            ffi::vue_template_result_tips_for_each(
+                *self.0.runtime(),
+                self.0.raw(),
+                callback,
+                user_data,
+            )
+        })
+    }
 }
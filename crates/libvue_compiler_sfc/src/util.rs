@@ -1,8 +1,12 @@
 //! Internal utility functions.
 
-use std::ffi::CStr;
+use std::collections::HashMap;
+use std::ffi::{c_void, CStr};
+use std::io;
 use std::os::raw::c_char;
 
+use crate::ffi;
+
 /// Convert a C string pointer to a Rust &str.
 ///
 /// # Safety
@@ -15,3 +19,102 @@ pub(crate) unsafe fn ptr_to_str<'a>(ptr: *const c_char) -> &'a str {
         CStr::from_ptr(ptr).to_str().unwrap_or("")
     }
 }
+
+/// Convert an FFI string view to a Rust &str.
+///
+/// # Safety
+/// `s.data` must be null or point to `s.len` bytes of UTF-8.
+/// The bytes must remain valid for the lifetime 'a.
+pub(crate) unsafe fn vue_str<'a>(s: ffi::VueStr) -> &'a str {
+    if s.data.is_null() || s.len == 0 {
+        ""
+    } else {
+        std::str::from_utf8(std::slice::from_raw_parts(s.data as *const u8, s.len)).unwrap_or("")
+    }
+}
+
+/// Collect the strings passed by a `*_for_each` accessor.
+///
+/// `for_each` receives the callback and user data to forward to the FFI call.
+pub(crate) fn collect_strings(
+    for_each: impl FnOnce(ffi::VueStrCallback, *mut c_void) -> usize,
+) -> Vec<String> {
+    unsafe extern "C" fn push(user_data: *mut c_void, value: ffi::VueStr) -> bool {
+        let out = &mut *(user_data as *mut Vec<String>);
+        out.push(vue_str(value).to_owned());
+        true
+    }
+
+    let mut out = Vec::new();
+    for_each(push, &mut out as *mut Vec<String> as *mut c_void);
+    out
+}
+
+/// Write the chunks passed by a `*_write` accessor to `out`.
+///
+/// Stops the accessor at the first write error and returns that error.
+pub(crate) fn write_chunks<W: io::Write>(
+    out: &mut W,
+    write: impl FnOnce(ffi::VueStrCallback, *mut c_void) -> usize,
+) -> io::Result<usize> {
+    struct Sink<'a> {
+        out: &'a mut dyn io::Write,
+        error: Option<io::Error>,
+    }
+
+    unsafe extern "C" fn chunk(user_data: *mut c_void, value: ffi::VueStr) -> bool {
+        let sink = &mut *(user_data as *mut Sink<'_>);
+        match sink
+            .out
+            .write_all(ffi_slice(value.data as *const u8, value.len))
+        {
+            Ok(()) => true,
+            Err(error) => {
+                sink.error = Some(error);
+                false
+            }
+        }
+    }
+
+    let mut sink = Sink { out, error: None };
+    let written = write(chunk, &mut sink as *mut Sink<'_> as *mut c_void);
+    match sink.error {
+        Some(error) => Err(error),
+        None => Ok(written),
+    }
+}
+
+/// Collect the key/value pairs passed by a `*_for_each` accessor.
+pub(crate) fn collect_pairs(
+    for_each: impl FnOnce(ffi::VueStrPairCallback, *mut c_void) -> usize,
+) -> HashMap<String, String> {
+    unsafe extern "C" fn insert(
+        user_data: *mut c_void,
+        key: ffi::VueStr,
+        value: ffi::VueStr,
+    ) -> bool {
+        let out = &mut *(user_data as *mut HashMap<String, String>);
+        out.insert(vue_str(key).to_owned(), vue_str(value).to_owned());
+        true
+    }
+
+    let mut out = HashMap::new();
+    for_each(
+        insert,
+        &mut out as *mut HashMap<String, String> as *mut c_void,
+    );
+    out
+}
+
+/// Convert an FFI pointer/count pair to a Rust slice.
+///
+/// # Safety
+/// `ptr` must be null or point to `len` initialized values.
+/// The values must remain valid for the lifetime 'a.
+pub(crate) unsafe fn ffi_slice<'a, T>(ptr: *const T, len: usize) -> &'a [T] {
+    if ptr.is_null() || len == 0 {
+        &[]
+    } else {
+        std::slice::from_raw_parts(ptr, len)
+    }
+}
@@ -0,0 +1,222 @@
+/**
+ * Benchmark: Node.js + @vue/compiler-sfc baseline for `cargo bench --bench sfc`.
+ *
+ * Runs the same workloads over the same corpus as
+ * crates/libvue_compiler_sfc/benches/sfc.rs and prints the same benchmark
+ * names and units, so the outputs can be compared line by line.
+ *
+ * Run: node --experimental-strip-types tools/bench-corpus-node.ts [filter]
+ */
+
+import { parse, compileScript, compileTemplate, compileStyle } from '@vue/compiler-sfc';
+import type { SFCDescriptor } from '@vue/compiler-sfc';
+import { readFileSync } from 'fs';
+import { availableParallelism } from 'os';
+import { Worker, isMainThread, parentPort } from 'worker_threads';
+
+const CORPUS_DIR = new URL('../crates/libvue_compiler_sfc/benches/corpus/', import.meta.url);
+const CORPUS: [string, string][] = ['small', 'medium', 'huge'].map(name => [
+  name,
+  readFileSync(new URL(`${name}.vue`, CORPUS_DIR), 'utf-8'),
+]);
+
+const ID = 'data-v-bench';
+const SCALING_COPIES = 32;
+const WARMUP_MS = 300;
+const MEASURE_MS = 1000;
+const SAMPLES = 10;
+
+type Input = { source: string; filename: string; id: string };
+
+/** Same steps as compileSfc() in the native bridge. */
+function compileSfc({ source, filename, id }: Input): { js: string; css: string } {
+  const { descriptor } = parse(source, { filename, sourceMap: false });
+  let js = '';
+  let bindings;
+  if (descriptor.script || descriptor.scriptSetup) {
+    const script = compileScript(descriptor, { id, isProd: false, sourceMap: false });
+    js = script.content;
+    bindings = script.bindings;
+  }
+  if (descriptor.template) {
+    const template = compileTemplate({
+      source: descriptor.template.content,
+      ast: descriptor.template.ast,
+      filename,
+      id,
+      scoped: descriptor.styles.some(s => s.scoped),
+      slotted: descriptor.slotted,
+      isProd: false,
+      ssr: false,
+      compilerOptions: { bindingMetadata: bindings },
+    });
+    js = js ? `${js}\n${template.code}` : template.code;
+  }
+  const css = descriptor.styles
+    .map(style => compileStyle({ source: style.content, filename, id, scoped: style.scoped, isProd: false }).code)
+    .join('\n');
+  return { js, css };
+}
+
+if (!isMainThread) {
+  // Scaling worker: compiles each batch it is sent.
+  parentPort!.on('message', (inputs: Input[]) => {
+    let bytes = 0;
+    for (const input of inputs) {
+      const { js, css } = compileSfc(input);
+      bytes += js.length + css.length;
+    }
+    parentPort!.postMessage(bytes);
+  });
+} else {
+  await main();
+}
+
+function report(name: string, perCallMs: number, itemsPerCall = 1) {
+  const us = (perCallMs * 1000).toFixed(3).padStart(12);
+  const rate = Math.round((itemsPerCall * 1000) / perCallMs).toString().padStart(12);
+  console.log(`${name.padEnd(32)} ${us} us/op ${rate} items/s`);
+}
+
+/** Times `f` and prints the median time per call across samples. */
+function run(filter: string | undefined, name: string, f: () => unknown) {
+  if (filter && !name.includes(filter)) {
+    return;
+  }
+
+  let sink: unknown;
+  let calls = 0;
+  const start = performance.now();
+  while (calls < 3 || performance.now() - start < WARMUP_MS) {
+    sink = f();
+    calls++;
+  }
+  const estimate = (performance.now() - start) / calls;
+  const iterations = Math.max(1, Math.floor(MEASURE_MS / SAMPLES / estimate));
+
+  const samples: number[] = [];
+  for (let s = 0; s < SAMPLES; s++) {
+    const t = performance.now();
+    for (let i = 0; i < iterations; i++) {
+      sink = f();
+    }
+    samples.push((performance.now() - t) / iterations);
+  }
+  samples.sort((a, b) => a - b);
+  report(name, samples[Math.floor(samples.length / 2)]);
+  return sink;
+}
+
+/** Reads every block of a descriptor the way a bundler plugin does. */
+function readDescriptor(desc: SFCDescriptor): number {
+  let total = desc.source.length + desc.filename.length;
+  if (desc.template) {
+    const t = desc.template;
+    total += t.content.length + (t.lang ?? 'html').length + Object.keys(t.attrs).length + t.loc.start.offset;
+  }
+  for (const script of [desc.script, desc.scriptSetup]) {
+    if (script) {
+      total += script.content.length + (script.lang ?? 'js').length + Object.keys(script.attrs).length;
+      total += script.loc.end.offset;
+    }
+  }
+  for (const style of desc.styles) {
+    total += style.content.length + (style.lang ?? 'css').length + Object.keys(style.attrs).length;
+    total += (style.scoped ? 1 : 0) + style.loc.end.line;
+  }
+  return total + desc.cssVars.length;
+}
+
+async function benchScaling(filter: string | undefined) {
+  const max = availableParallelism();
+  const counts: number[] = [];
+  for (let n = 1; n < max; n *= 2) {
+    counts.push(n);
+  }
+  counts.push(max);
+
+  const inputs: Input[] = [];
+  for (let i = 0; i < SCALING_COPIES * CORPUS.length; i++) {
+    const id = `data-v-${i.toString(16).padStart(4, '0')}`;
+    inputs.push({ source: CORPUS[i % CORPUS.length][1], filename: 'Corpus.vue', id });
+  }
+
+  let baseline: number | undefined;
+  for (const workers of counts) {
+    const name = `scaling/threads_${workers}`;
+    if (filter && !name.includes(filter)) {
+      continue;
+    }
+
+    const pool = Array.from({ length: workers }, () => new Worker(new URL(import.meta.url)));
+    const batch = () =>
+      Promise.all(
+        pool.map(
+          (worker, w) =>
+            new Promise<number>(resolve => {
+              worker.once('message', resolve);
+              worker.postMessage(inputs.filter((_, i) => i % workers === w));
+            }),
+        ),
+      );
+
+    await batch();
+    let rounds = 0;
+    const start = performance.now();
+    while (rounds < 2 || performance.now() - start < MEASURE_MS) {
+      await batch();
+      rounds++;
+    }
+    const perBatch = (performance.now() - start) / rounds;
+    report(name, perBatch, inputs.length);
+
+    baseline ??= perBatch;
+    console.log(`${''.padEnd(32)} ${(baseline / perBatch).toFixed(2).padStart(12)}x speedup`);
+    await Promise.all(pool.map(worker => worker.terminate()));
+  }
+}
+
+async function main() {
+  const filter = process.argv.slice(2).find(arg => !arg.startsWith('-'));
+
+  for (const [name, source] of CORPUS) {
+    const filename = `${name}.vue`;
+    run(filter, `parse/${name}`, () => parse(source, { filename }));
+
+    const { descriptor } = parse(source, { filename });
+    const script = descriptor.script || descriptor.scriptSetup
+      ? compileScript(descriptor, { id: ID, isProd: false })
+      : undefined;
+    run(filter, `compile_script/${name}`, () =>
+      script ? compileScript(descriptor, { id: ID, isProd: false }).content.length : 0,
+    );
+    run(filter, `compile_template/${name}`, () =>
+      descriptor.template
+        ? compileTemplate({
+            source: descriptor.template.content,
+            filename,
+            id: ID,
+            scoped: descriptor.styles.some(s => s.scoped),
+            compilerOptions: { bindingMetadata: script?.bindings },
+          }).code.length
+        : 0,
+    );
+    run(filter, `compile_style/${name}`, () => {
+      let total = 0;
+      for (const style of descriptor.styles) {
+        total += compileStyle({ source: style.content, filename, id: ID, scoped: style.scoped }).code.length;
+      }
+      return total;
+    });
+    run(filter, `descriptor_reads/${name}`, () => readDescriptor(descriptor));
+  }
+
+  for (const [name, source] of CORPUS) {
+    const input = { source, filename: `${name}.vue`, id: ID };
+    run(filter, `pipeline/${name}`, () => compileSfc(input));
+  }
+  const corpusInputs = CORPUS.map(([, source]) => ({ source, filename: 'Corpus.vue', id: ID }));
+  run(filter, 'pipeline/corpus_batch', () => corpusInputs.map(compileSfc));
+
+  await benchScaling(filter);
+}
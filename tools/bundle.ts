@@ -4,10 +4,14 @@ import { fileURLToPath } from "node:url";
 
 const __dirname = dirname(fileURLToPath(import.meta.url));
 const projectRoot = resolve(__dirname, "..");
+const bridgeDir = resolve(projectRoot, "crates/lib_vue_compiler_sfc_sys/ffi/js");
 
-async function bundle(): Promise<void> {
+/** Compiler units bundled on their own with `--units`. */
+const UNITS = ["parse", "script", "template", "style"];
+
+async function bundleEntry(input: string, file: string, name: string): Promise<void> {
   const bundler = await rolldown({
-    input: resolve(projectRoot, "crates/lib_vue_compiler_sfc_sys/ffi/js/vue_compiler_sfc_bridge.js"),
+    input,
     platform: "browser",
     resolve: {
       conditionNames: ["module", "import", "browser", "default"],
@@ -17,12 +21,24 @@ async function bundle(): Promise<void> {
   });
 
   await bundler.write({
-    file: resolve(projectRoot, "dist/vue-compiler.js"),
+    file: resolve(projectRoot, file),
     format: "iife",
-    name: "VueCompiler",
+    name,
   });
 
-  console.log("Bundle created: dist/vue-compiler.js");
+  console.log(`Bundle created: ${file}`);
+}
+
+async function bundle(): Promise<void> {
+  await bundleEntry(resolve(bridgeDir, "vue_compiler_sfc_bridge.js"), "dist/vue-compiler.js", "VueCompiler");
+
+  // Tree-shaken bundles of each unit, for separately loadable units
+  if (process.argv.includes("--units")) {
+    for (const unit of UNITS) {
+      const name = "VueCompiler" + unit[0].toUpperCase() + unit.slice(1);
+      await bundleEntry(resolve(bridgeDir, `units/${unit}.js`), `dist/vue-compiler-${unit}.js`, name);
+    }
+  }
 }
 
 bundle().catch((err) => {